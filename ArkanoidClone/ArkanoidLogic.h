@@ -4,8 +4,7 @@
 #include "Camera.h"
 #include "InputManager.h"
 #include "Dimensions.h"
-#include "Quadtree.h"
-#include <vector>
+#include "FixedTimestepSimulation.h"
 
 namespace ArkanoidEngine
 {
@@ -14,8 +13,6 @@ namespace ArkanoidEngine
 
 namespace ArkanoidGame
 {	
-	class AABB;
-
 	class ArkanoidLogic : public WindowSizeEventsObserver
 	{
 	public:
@@ -58,75 +55,19 @@ namespace ArkanoidGame
 		void onBrickShuffleKeyDown();
 		void onBrickShuffleKeyUp();
 
-		static constexpr unsigned int sk_quadtreeMaxDepth = 2;
-		using Quadtree = Quadtree<unsigned int, sk_quadtreeMaxDepth>;
-
 	private:		
 				
 		void update();
 
-		void setupLevel();
+		void setupColors();
+		void updateBricksColors();
 		
-		void placeBricks();
-		unsigned int placeBricksRowByRow(AABB& bricksAABB);
-		unsigned int placeBricksDiamond(AABB& bricksAABB);
-		unsigned int placeBricksColumnsByColumns(AABB& bricksAABB);
-
-		void assignBrickType(unsigned int brickIndex, unsigned int brickTypeIndex);
-
-		void buildQuadtree(const AABB& bricksAABB, unsigned int bricksCount);
-
 		void restartLevel();
 
-		void movePlayer(float deltaTime);
-		void moveBall(float deltaTime);
-		void moveBonus(float deltaTime);
-
-		void checkBounds(const XMFLOAT2& playerAABBMin, const XMFLOAT2& playerAABBMax,
-						 const XMFLOAT2& ballAABBMin, const XMFLOAT2& ballAABBMax);
-
-		struct CollisionData
-		{
-			//the following are either 0 or 1 to indicate the direction from which the ball hits an AABB
-			unsigned int fromRight;
-			unsigned int fromLeft;
-			unsigned int fromTop;
-			unsigned int fromBottom;
-		};
-
-		CollisionData ballAABBCollisionData(const AABB& aabb,
-											const XMFLOAT2& currBallAABBMin, const XMFLOAT2& currBallAABBMax,
-											const XMFLOAT2& lastBallAABBMin, const XMFLOAT2& lastBallAABBMax);
-
-		void checkBricksCollision(const AABB& currBallAABB,
-								  const XMFLOAT2& currBallAABBMin, const XMFLOAT2& currBallAABBMax,
-								  const XMFLOAT2& lastBallAABBMin, const XMFLOAT2& lastBallAABBMax);
-				
-		void checkBonusCollision(const AABB& playerAABB);
-
-		void handleSpawnBonus(const XMFLOAT2& spawnPosition);
-		unsigned int generateNextBonusBricksHitCount();
+		unsigned int inputFlags()const;
 
 		void updateCameraProjection();
 
-		void translateOutOfArena(XMFLOAT4& transform);
-
-
-		XMFLOAT4& ballTransform();
-		const XMFLOAT4& ballTransform()const;
-
-		XMFLOAT4& playerTransform();
-		const XMFLOAT4& playerTransform()const;
-
-		XMFLOAT4& arenaTransform();
-		const XMFLOAT4& arenaTransform()const;
-
-		XMFLOAT4& bonusTransform();
-		const XMFLOAT4& bonusTransform()const;
-
-		XMFLOAT4& brickTransform(unsigned int brickIndex);
-		const XMFLOAT4& brickTransform(unsigned int brickIndex)const;
-
 		XMFLOAT4& ballColorAndUVTransform();
 		const XMFLOAT4& ballColorAndUVTransform()const;
 
@@ -157,39 +98,16 @@ namespace ArkanoidGame
 		XMFLOAT4& bricksUVTransform();
 		const XMFLOAT4& bricksUVTransform()const;
 
-		unsigned int& brickRemainingHits(unsigned int brickIndex);
-		const unsigned int& brickRemainingHits(unsigned int brickIndex)const;
-		
-		using BrickPlacerFunction = unsigned int (ArkanoidLogic::*)(AABB&);
-		static constexpr BrickPlacerFunction sk_brickPlacers[] =
-		{
-			&ArkanoidLogic::placeBricksRowByRow,
-			&ArkanoidLogic::placeBricksDiamond,
-			&ArkanoidLogic::placeBricksColumnsByColumns
-		};
-		static constexpr unsigned int sk_brickPlacersCount = sizeof(sk_brickPlacers) / sizeof(BrickPlacerFunction);
-
 		Application& m_application;
 		ArkanoidRenderer* m_renderer{ nullptr };
 		
 		InputManager m_inputManager;
 
-		ArkanoidRenderer::TransformsConstantBuffer m_transforms{};
+		FixedTimestepSimulation m_simulation;
+
 		ArkanoidRenderer::ColorsAndUVTransformsConstantBuffer m_colorsAndUVTransforms{};
 		
 		Camera m_camera{};
-		
-		Quadtree m_quadtree;
-			
-		XMFLOAT2 m_ballVelocity{};
-
-		unsigned int m_ballColliders[gk_bricksCount];
-
-		unsigned int m_bricksRemainingHits[gk_bricksCount];
-
-		unsigned int m_bonusBricksHit{ 0 };
-		unsigned int m_nextBonusBricksHitCount{ 0 };
-		bool m_bonusAlive{ false };
 	};
 
 	inline Application& ArkanoidLogic::application()
@@ -199,7 +117,7 @@ namespace ArkanoidGame
 
 	inline const ArkanoidRenderer::TransformsConstantBuffer* ArkanoidLogic::transforms()const
 	{
-		return &m_transforms;
+		return m_simulation.transforms();
 	}
 
 	inline const ArkanoidRenderer::ColorsAndUVTransformsConstantBuffer* ArkanoidLogic::colorsAndUVTransforms()const
@@ -0,0 +1,129 @@
+#pragma once
+#include "Dimensions.h"
+#include <cassert>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace ArkanoidGame
+{
+	//the number of bits set in word
+	inline unsigned int countSetBits(unsigned int word)
+	{
+#if defined(_MSC_VER)
+		return __popcnt(word);
+#elif defined(__GNUC__)
+		return static_cast<unsigned int>(__builtin_popcount(word));
+#else
+		word = word - ((word >> 1) & 0x55555555u);
+		word = (word & 0x33333333u) + ((word >> 2) & 0x33333333u);
+		return (((word + (word >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+#endif
+	}
+
+	/*
+	one bit per brick, set while the brick is alive, packed in words of 32 bricks.
+	the count of the alive bricks is the popcount of the few words, so it needs not to be kept aside.
+	the words are given to findTouchingBoxes() to skip the dead bricks 4 or 8 at a time
+	*/
+	class BricksBitset
+	{
+	public:
+		static constexpr unsigned int sk_bitsPerWord = 32;
+		static constexpr unsigned int sk_wordsCount = (gk_bricksCount + sk_bitsPerWord - 1) / sk_bitsPerWord;
+
+		//ctors
+		//all the bricks are dead
+		BricksBitset() = default;
+
+		//dtor
+		~BricksBitset() = default;
+
+		//copy
+		BricksBitset(const BricksBitset&) = default;
+		BricksBitset& operator=(const BricksBitset&) = default;
+
+		//move
+		BricksBitset(BricksBitset&&) = default;
+		BricksBitset& operator=(BricksBitset&&) = default;
+
+		//the first bricksCount bricks are alive, the others are dead
+		void setFirst(unsigned int bricksCount);
+
+		void set(unsigned int brickIndex);
+		void reset(unsigned int brickIndex);
+
+		bool test(unsigned int brickIndex)const;
+
+		unsigned int count()const;
+
+		//true if all the bricks are dead
+		bool none()const;
+
+		//sk_wordsCount elements, brick i is bit (i % sk_bitsPerWord) of word (i / sk_bitsPerWord)
+		const unsigned int* words()const;
+
+	private:
+		unsigned int m_words[sk_wordsCount]{};
+	};
+
+	inline void BricksBitset::setFirst(unsigned int bricksCount)
+	{
+		assert(bricksCount <= gk_bricksCount);
+
+		for (unsigned int wordIndex = 0; wordIndex < sk_wordsCount; ++wordIndex)
+		{
+			const unsigned int firstBrickIndex = wordIndex * sk_bitsPerWord;
+
+			//the bricks of the word below bricksCount, clamped to [0, sk_bitsPerWord]
+			const unsigned int wordBricksCount = bricksCount > firstBrickIndex ? bricksCount - firstBrickIndex : 0;
+
+			const unsigned int fullWord[2] = { (1u << (wordBricksCount & (sk_bitsPerWord - 1))) - 1, ~0u };
+			m_words[wordIndex] = fullWord[static_cast<unsigned int>(wordBricksCount >= sk_bitsPerWord)];
+		}
+	}
+
+	inline void BricksBitset::set(unsigned int brickIndex)
+	{
+		assert(brickIndex < gk_bricksCount);
+		m_words[brickIndex / sk_bitsPerWord] |= 1u << (brickIndex % sk_bitsPerWord);
+	}
+
+	inline void BricksBitset::reset(unsigned int brickIndex)
+	{
+		assert(brickIndex < gk_bricksCount);
+		m_words[brickIndex / sk_bitsPerWord] &= ~(1u << (brickIndex % sk_bitsPerWord));
+	}
+
+	inline bool BricksBitset::test(unsigned int brickIndex)const
+	{
+		assert(brickIndex < gk_bricksCount);
+		return ((m_words[brickIndex / sk_bitsPerWord] >> (brickIndex % sk_bitsPerWord)) & 1) != 0;
+	}
+
+	inline unsigned int BricksBitset::count()const
+	{
+		unsigned int bitsCount = 0;
+		for (unsigned int word : m_words)
+		{
+			bitsCount += countSetBits(word);
+		}
+		return bitsCount;
+	}
+
+	inline bool BricksBitset::none()const
+	{
+		unsigned int allWords = 0;
+		for (unsigned int word : m_words)
+		{
+			allWords |= word;
+		}
+		return allWords == 0;
+	}
+
+	inline const unsigned int* BricksBitset::words()const
+	{
+		return m_words;
+	}
+}
\ No newline at end of file
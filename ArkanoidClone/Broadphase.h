@@ -0,0 +1,305 @@
+#pragma once
+#include "Engine.h"
+#include "MathCommon.h"
+#include "AABB.h"
+#include "Quadtree.h"
+#include "QuadtreeQueryCache.h"
+#include "GridBroadphase.h"
+#include "SweepAndPruneBroadphase.h"
+#include "SimdBroadphase.h"
+#include <algorithm>
+#include <cassert>
+
+namespace ArkanoidGame
+{
+	/*
+	a broadphase stores objects of the same size, each one given by its center and an unsigned int data, and finds the ones
+	which can touch an AABB. Quadtree, GridBroadphase, SweepAndPruneBroadphase and SimdBroadphase share this interface,
+	so any of them can be chosen at compile time by a type and SwitchableBroadphase chooses one of them at run time:
+
+	Broadphase(const AABB& area, const XMFLOAT2& objectsHalfExtents, unsigned int objectsCapacity);
+	void insert(const XMFLOAT2& objectCenter, unsigned int objectData);
+	void build(const AABB& area, const XMFLOAT2* objectsCenters, const unsigned int* objectsDatas, unsigned int objectsCount);
+	void buildBulk(const AABB& area, const XMFLOAT2* objectsCenters, const unsigned int* objectsDatas, unsigned int objectsCount);
+	unsigned int findPotentialColliders(const AABB& objectAABB, unsigned int* foundObjects)const;
+	bool remove(const XMFLOAT2& objectCenter, unsigned int objectData);
+	bool update(const XMFLOAT2& oldObjectCenter, const XMFLOAT2& newObjectCenter, unsigned int objectData);
+	unsigned int objectsCount()const;
+
+	findPotentialColliders() writes each object at most once to the caller buffer, which has room for objectsCount() objects.
+	the objects touching the AABB, as AABB::intersects() tells, are always found, others may be found too.
+	the order of the objects found depends on the broadphase
+	*/
+
+	//the objects which can touch an object of objectHalfExtents moving from objectStart by objectDisplacement. a Quadtree
+	//visits only the quadrants crossed by the motion, the other broadphases search the AABB enclosing it
+	template<typename Broadphase>
+	unsigned int findSweptPotentialColliders(const Broadphase& broadphase, const XMFLOAT2& objectStart, const XMFLOAT2& objectDisplacement,
+											 const XMFLOAT2& objectHalfExtents, unsigned int* foundObjects);
+
+	template<unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	unsigned int findSweptPotentialColliders(const Quadtree<unsigned int, MAX_DEPTH, SubdivisionPolicy>& quadtree,
+											 const XMFLOAT2& objectStart, const XMFLOAT2& objectDisplacement,
+											 const XMFLOAT2& objectHalfExtents, unsigned int* foundObjects);
+
+	enum EBroadphaseType : unsigned int
+	{
+		BROADPHASE_QUADTREE = 0,
+		BROADPHASE_GRID = 1,
+		BROADPHASE_SWEEP_AND_PRUNE = 2,
+		BROADPHASE_SIMD_SCAN = 3
+	};
+
+	constexpr unsigned int gk_broadphaseTypesCount = 4;
+
+	/*
+	one broadphase of each type, the one of type() stores the objects and answers the queries.
+	the others are constructed without capacity, so they don't hold memory for the objects.
+	the switch on the type costs a predictable branch per call
+	*/
+	template<unsigned int QUADTREE_MAX_DEPTH, typename SubdivisionPolicy = DefaultSubdivisionPolicy>
+	class SwitchableBroadphase
+	{
+	public:
+		using Quadtree = ArkanoidGame::Quadtree<unsigned int, QUADTREE_MAX_DEPTH, SubdivisionPolicy>;
+
+		//ctors
+		explicit SwitchableBroadphase(const AABB& area, const XMFLOAT2& objectsHalfExtents, unsigned int objectsCapacity,
+									  EBroadphaseType type = BROADPHASE_QUADTREE);
+
+		//dtor
+		~SwitchableBroadphase() = default;
+
+		//copy
+		SwitchableBroadphase(const SwitchableBroadphase&) = default;
+		SwitchableBroadphase& operator=(const SwitchableBroadphase&) = default;
+
+		//move
+		SwitchableBroadphase(SwitchableBroadphase&&) = default;
+		SwitchableBroadphase& operator=(SwitchableBroadphase&&) = default;
+
+		EBroadphaseType type()const;
+
+		//removes all the objects: they must be given again to the broadphase of the new type
+		void setType(EBroadphaseType type);
+
+		//the Quadtree derives from its policy, whose settings are kept by setType() and apply from the next build
+		SubdivisionPolicy& quadtreeSubdivisionPolicy();
+		const SubdivisionPolicy& quadtreeSubdivisionPolicy()const;
+
+		void insert(const XMFLOAT2& objectCenter, unsigned int objectData);
+		void build(const AABB& area, const XMFLOAT2* objectsCenters, const unsigned int* objectsDatas, unsigned int objectsCount);
+		void buildBulk(const AABB& area, const XMFLOAT2* objectsCenters, const unsigned int* objectsDatas, unsigned int objectsCount);
+		unsigned int findPotentialColliders(const AABB& objectAABB, unsigned int* foundObjects)const;
+		unsigned int findSweptPotentialColliders(const XMFLOAT2& objectStart, const XMFLOAT2& objectDisplacement,
+												 const XMFLOAT2& objectHalfExtents, unsigned int* foundObjects)const;
+
+		//as findPotentialColliders(), the Quadtree answers from the cache while it is valid and foundObjects points to the
+		//cached objects. the others ignore the cache, write to foundObjectsBuffer and foundObjects points to it
+		unsigned int findPotentialColliders(const AABB& objectAABB, unsigned int* foundObjectsBuffer, const unsigned int*& foundObjects,
+											QuadtreeQueryCache<>& queryCache)const;
+
+		//binds the cache to the Quadtree, after its build
+		void bindQueryCache(QuadtreeQueryCache<>& queryCache)const;
+
+		bool remove(const XMFLOAT2& objectCenter, unsigned int objectData);
+		bool update(const XMFLOAT2& oldObjectCenter, const XMFLOAT2& newObjectCenter, unsigned int objectData);
+		unsigned int objectsCount()const;
+
+	private:
+		//calls function with the broadphase of m_type and returns its result
+		template<typename Function>
+		decltype(auto) visitBroadphase(Function&& function);
+
+		template<typename Function>
+		decltype(auto) visitBroadphase(Function&& function)const;
+
+		AABB m_area;
+		XMFLOAT2 m_objectsHalfExtents;
+		unsigned int m_objectsCapacity;
+
+		EBroadphaseType m_type;
+
+		Quadtree m_quadtree;
+		GridBroadphase m_grid;
+		SweepAndPruneBroadphase m_sweepAndPrune;
+		SimdBroadphase m_simdScan;
+	};
+
+	template<typename Broadphase>
+	inline unsigned int findSweptPotentialColliders(const Broadphase& broadphase, const XMFLOAT2& objectStart, const XMFLOAT2& objectDisplacement,
+													const XMFLOAT2& objectHalfExtents, unsigned int* foundObjects)
+	{
+		//the enclosing AABB is grown by a margin: the rounding errors of its center and half extents never drop the objects
+		//just touched on the way, as the ones an object slides along
+		constexpr float sweptMargin = 0.001f;
+		const XMFLOAT2 grownHalfExtents = objectHalfExtents + XMFLOAT2{ sweptMargin, sweptMargin };
+
+		const XMFLOAT2 objectEnd = objectStart + objectDisplacement;
+		const XMFLOAT2 sweptMin{ std::min(objectStart.x, objectEnd.x), std::min(objectStart.y, objectEnd.y) };
+		const XMFLOAT2 sweptMax{ std::max(objectStart.x, objectEnd.x), std::max(objectStart.y, objectEnd.y) };
+		const AABB sweptAABB = AABB::computeFromMinMax(sweptMin - grownHalfExtents, sweptMax + grownHalfExtents);
+
+		return broadphase.findPotentialColliders(sweptAABB, foundObjects);
+	}
+
+	template<unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline unsigned int findSweptPotentialColliders(const Quadtree<unsigned int, MAX_DEPTH, SubdivisionPolicy>& quadtree,
+													const XMFLOAT2& objectStart, const XMFLOAT2& objectDisplacement,
+													const XMFLOAT2& objectHalfExtents, unsigned int* foundObjects)
+	{
+		return quadtree.findSweptPotentialColliders(objectStart, objectDisplacement, objectHalfExtents, foundObjects);
+	}
+
+	template<unsigned int QUADTREE_MAX_DEPTH, typename SubdivisionPolicy>
+	inline SwitchableBroadphase<QUADTREE_MAX_DEPTH, SubdivisionPolicy>::SwitchableBroadphase(const AABB& area, const XMFLOAT2& objectsHalfExtents,
+																							  unsigned int objectsCapacity, EBroadphaseType type)
+																							  : m_area{ area },
+																								m_objectsHalfExtents{ objectsHalfExtents },
+																								m_objectsCapacity{ objectsCapacity },
+																								m_type{ type },
+																								m_quadtree{ area, objectsHalfExtents, type == BROADPHASE_QUADTREE ? objectsCapacity : 0 },
+																								m_grid{ area, objectsHalfExtents, type == BROADPHASE_GRID ? objectsCapacity : 0 },
+																								m_sweepAndPrune{ area, objectsHalfExtents, type == BROADPHASE_SWEEP_AND_PRUNE ? objectsCapacity : 0 },
+																								m_simdScan{ area, objectsHalfExtents, type == BROADPHASE_SIMD_SCAN ? objectsCapacity : 0 }
+	{
+		assert(type < gk_broadphaseTypesCount);
+	}
+
+	template<unsigned int QUADTREE_MAX_DEPTH, typename SubdivisionPolicy>
+	inline EBroadphaseType SwitchableBroadphase<QUADTREE_MAX_DEPTH, SubdivisionPolicy>::type()const
+	{
+		return m_type;
+	}
+
+	template<unsigned int QUADTREE_MAX_DEPTH, typename SubdivisionPolicy>
+	inline void SwitchableBroadphase<QUADTREE_MAX_DEPTH, SubdivisionPolicy>::setType(EBroadphaseType type)
+	{
+		const SubdivisionPolicy subdivisionPolicy = quadtreeSubdivisionPolicy();
+		*this = SwitchableBroadphase{ m_area, m_objectsHalfExtents, m_objectsCapacity, type };
+		quadtreeSubdivisionPolicy() = subdivisionPolicy;
+	}
+
+	template<unsigned int QUADTREE_MAX_DEPTH, typename SubdivisionPolicy>
+	inline SubdivisionPolicy& SwitchableBroadphase<QUADTREE_MAX_DEPTH, SubdivisionPolicy>::quadtreeSubdivisionPolicy()
+	{
+		return m_quadtree;
+	}
+
+	template<unsigned int QUADTREE_MAX_DEPTH, typename SubdivisionPolicy>
+	inline const SubdivisionPolicy& SwitchableBroadphase<QUADTREE_MAX_DEPTH, SubdivisionPolicy>::quadtreeSubdivisionPolicy()const
+	{
+		return m_quadtree;
+	}
+
+	template<unsigned int QUADTREE_MAX_DEPTH, typename SubdivisionPolicy>
+	template<typename Function>
+	inline decltype(auto) SwitchableBroadphase<QUADTREE_MAX_DEPTH, SubdivisionPolicy>::visitBroadphase(Function&& function)
+	{
+		switch (m_type)
+		{
+		case BROADPHASE_GRID:
+			return function(m_grid);
+		case BROADPHASE_SWEEP_AND_PRUNE:
+			return function(m_sweepAndPrune);
+		case BROADPHASE_SIMD_SCAN:
+			return function(m_simdScan);
+		default:
+			return function(m_quadtree);
+		}
+	}
+
+	template<unsigned int QUADTREE_MAX_DEPTH, typename SubdivisionPolicy>
+	template<typename Function>
+	inline decltype(auto) SwitchableBroadphase<QUADTREE_MAX_DEPTH, SubdivisionPolicy>::visitBroadphase(Function&& function)const
+	{
+		switch (m_type)
+		{
+		case BROADPHASE_GRID:
+			return function(m_grid);
+		case BROADPHASE_SWEEP_AND_PRUNE:
+			return function(m_sweepAndPrune);
+		case BROADPHASE_SIMD_SCAN:
+			return function(m_simdScan);
+		default:
+			return function(m_quadtree);
+		}
+	}
+
+	template<unsigned int QUADTREE_MAX_DEPTH, typename SubdivisionPolicy>
+	inline void SwitchableBroadphase<QUADTREE_MAX_DEPTH, SubdivisionPolicy>::insert(const XMFLOAT2& objectCenter, unsigned int objectData)
+	{
+		visitBroadphase([&](auto& broadphase) { broadphase.insert(objectCenter, objectData); });
+	}
+
+	template<unsigned int QUADTREE_MAX_DEPTH, typename SubdivisionPolicy>
+	inline void SwitchableBroadphase<QUADTREE_MAX_DEPTH, SubdivisionPolicy>::build(const AABB& area, const XMFLOAT2* objectsCenters,
+																					const unsigned int* objectsDatas, unsigned int objectsCount)
+	{
+		visitBroadphase([&](auto& broadphase) { broadphase.build(area, objectsCenters, objectsDatas, objectsCount); });
+	}
+
+	template<unsigned int QUADTREE_MAX_DEPTH, typename SubdivisionPolicy>
+	inline void SwitchableBroadphase<QUADTREE_MAX_DEPTH, SubdivisionPolicy>::buildBulk(const AABB& area, const XMFLOAT2* objectsCenters,
+																						const unsigned int* objectsDatas, unsigned int objectsCount)
+	{
+		visitBroadphase([&](auto& broadphase) { broadphase.buildBulk(area, objectsCenters, objectsDatas, objectsCount); });
+	}
+
+	template<unsigned int QUADTREE_MAX_DEPTH, typename SubdivisionPolicy>
+	inline unsigned int SwitchableBroadphase<QUADTREE_MAX_DEPTH, SubdivisionPolicy>::findPotentialColliders(const AABB& objectAABB, unsigned int* foundObjects)const
+	{
+		return visitBroadphase([&](const auto& broadphase) { return broadphase.findPotentialColliders(objectAABB, foundObjects); });
+	}
+
+	template<unsigned int QUADTREE_MAX_DEPTH, typename SubdivisionPolicy>
+	inline unsigned int SwitchableBroadphase<QUADTREE_MAX_DEPTH, SubdivisionPolicy>::findSweptPotentialColliders(const XMFLOAT2& objectStart,
+																												  const XMFLOAT2& objectDisplacement,
+																												  const XMFLOAT2& objectHalfExtents,
+																												  unsigned int* foundObjects)const
+	{
+		return visitBroadphase([&](const auto& broadphase)
+		{
+			return ArkanoidGame::findSweptPotentialColliders(broadphase, objectStart, objectDisplacement, objectHalfExtents, foundObjects);
+		});
+	}
+
+	template<unsigned int QUADTREE_MAX_DEPTH, typename SubdivisionPolicy>
+	inline unsigned int SwitchableBroadphase<QUADTREE_MAX_DEPTH, SubdivisionPolicy>::findPotentialColliders(const AABB& objectAABB,
+																											 unsigned int* foundObjectsBuffer,
+																											 const unsigned int*& foundObjects,
+																											 QuadtreeQueryCache<>& queryCache)const
+	{
+		if (m_type == BROADPHASE_QUADTREE)
+		{
+			return queryCache.findPotentialColliders(m_quadtree, objectAABB, foundObjects);
+		}
+
+		foundObjects = foundObjectsBuffer;
+		return findPotentialColliders(objectAABB, foundObjectsBuffer);
+	}
+
+	template<unsigned int QUADTREE_MAX_DEPTH, typename SubdivisionPolicy>
+	inline void SwitchableBroadphase<QUADTREE_MAX_DEPTH, SubdivisionPolicy>::bindQueryCache(QuadtreeQueryCache<>& queryCache)const
+	{
+		queryCache.bind(m_quadtree);
+	}
+
+	template<unsigned int QUADTREE_MAX_DEPTH, typename SubdivisionPolicy>
+	inline bool SwitchableBroadphase<QUADTREE_MAX_DEPTH, SubdivisionPolicy>::remove(const XMFLOAT2& objectCenter, unsigned int objectData)
+	{
+		return visitBroadphase([&](auto& broadphase) { return broadphase.remove(objectCenter, objectData); });
+	}
+
+	template<unsigned int QUADTREE_MAX_DEPTH, typename SubdivisionPolicy>
+	inline bool SwitchableBroadphase<QUADTREE_MAX_DEPTH, SubdivisionPolicy>::update(const XMFLOAT2& oldObjectCenter, const XMFLOAT2& newObjectCenter, unsigned int objectData)
+	{
+		return visitBroadphase([&](auto& broadphase) { return broadphase.update(oldObjectCenter, newObjectCenter, objectData); });
+	}
+
+	template<unsigned int QUADTREE_MAX_DEPTH, typename SubdivisionPolicy>
+	inline unsigned int SwitchableBroadphase<QUADTREE_MAX_DEPTH, SubdivisionPolicy>::objectsCount()const
+	{
+		return visitBroadphase([](const auto& broadphase) { return broadphase.objectsCount(); });
+	}
+}
\ No newline at end of file
@@ -7,4 +7,14 @@ namespace ArkanoidGame
 
 	//1 ball + 1 player + 1 arena + 1 bonus + gk_bricksCount bricks
 	constexpr unsigned int gk_instancesCount = (gk_entitiesCount - 1) + gk_bricksCount; 
+
+	constexpr unsigned int gk_brickTypesCount = 3;
+
+	//instances layout inside the transforms and colors constant buffers
+	constexpr unsigned int gk_arenaIndex = 0;
+	constexpr unsigned int gk_bricksStartIndex = gk_arenaIndex + 1;
+	constexpr unsigned int gk_bricksEndIndex = gk_bricksStartIndex + gk_bricksCount;
+	constexpr unsigned int gk_ballIndex = gk_bricksEndIndex;
+	constexpr unsigned int gk_playerIndex = gk_ballIndex + 1;
+	constexpr unsigned int gk_bonusIndex = gk_playerIndex + 1;
 }
\ No newline at end of file
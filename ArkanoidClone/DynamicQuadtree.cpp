@@ -0,0 +1,6 @@
+#include "DynamicQuadtree.h"
+
+#ifdef _DEBUG
+//explicit instantiation to find compilation errors
+template class ArkanoidGame::DynamicQuadtree<>;
+#endif
\ No newline at end of file
@@ -0,0 +1,898 @@
+#pragma once
+#include <vector>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include "QuadtreeHelper.h"
+#include "Quadrant.h"
+#include "MathHelper.h"
+#include "AABB.h"
+#include "Quadtree.h"
+
+namespace ArkanoidGame
+{
+	/*
+	a Quadtree whose maximum depth is chosen at construction, for levels much bigger than gk_bricksCount.
+	the quadrants and the objects are stored in one contiguous allocation made by the constructor,
+	and the objects of a quadrant are linked as in Quadtree.
+	the insertion, subdivision and query rules are the ones of Quadtree, so the same objects are found in the same order.
+	*/
+	template<typename ObjectData = unsigned int, typename SubdivisionPolicy = DefaultSubdivisionPolicy>
+	class DynamicQuadtree : public SubdivisionPolicy
+	{
+		static_assert(std::is_trivially_copyable<ObjectData>::value, "ObjectData is stored in raw memory");
+
+	public:
+		//ctors
+		//maxDepth must not exceed sk_maxSupportedDepth. at most objectsCapacity objects can be inserted
+		explicit DynamicQuadtree(const AABB& quadtreeArea, const XMFLOAT2& objectsHalfExtents,
+								 unsigned int maxDepth, unsigned int objectsCapacity);
+
+		//dtor
+		~DynamicQuadtree() = default;
+
+		//copy
+		DynamicQuadtree(const DynamicQuadtree&) = default;
+		DynamicQuadtree& operator=(const DynamicQuadtree&) = default;
+
+		//move
+		DynamicQuadtree(DynamicQuadtree&&) = default;
+		DynamicQuadtree& operator=(DynamicQuadtree&&) = default;
+
+		void insert(const XMFLOAT2& objectCenter, const ObjectData& objectData);
+
+		//foundObjects must point to an array of ObjectData which size is enough to contain all the objects
+		//the number of objects actually found is returned
+		unsigned int findPotentialColliders(const AABB& objectAABB, ObjectData* foundObjects)const;
+
+		//see Quadtree::remove(). the object slot is reused by the next insert()
+		bool remove(const XMFLOAT2& objectCenter, const ObjectData& objectData);
+
+		//see Quadtree::update()
+		bool update(const XMFLOAT2& oldObjectCenter, const XMFLOAT2& newObjectCenter, const ObjectData& objectData);
+
+		//removes all the objects and merges all the quadrants, keeping the allocation
+		void clear();
+
+		unsigned int maxDepth()const;
+		unsigned int objectsCapacity()const;
+		unsigned int objectsCount()const;
+
+		//bytes owned by the quadtree, this object included
+		size_t memoryUsage()const;
+
+		//the quadrants are allocated up front: 4^(depth + 1) / 3 of them
+		static constexpr unsigned int sk_maxSupportedDepth = 10;
+
+	private:
+		static constexpr unsigned int sk_invalidObjectIndex = ~0u;
+
+		//appends an array of count T to the arena layout and returns its offset
+		template<typename T>
+		static size_t reserveArenaArray(size_t& arenaSize, size_t count);
+
+		template<typename T>
+		T* arenaArray(size_t offset);
+
+		template<typename T>
+		const T* arenaArray(size_t offset)const;
+
+		void buildQuadrant(unsigned int quadrantIndex, unsigned int currDepth);
+
+		bool shouldSubdivide(unsigned int quadrantIndex)const;
+		void subdivide(unsigned int quadrantIndex, unsigned int currDepth);
+
+		//true if all the children are leaves without objects
+		bool canMergeChildren(unsigned int quadrantIndex, unsigned int quadrantDepth)const;
+
+		unsigned int allocateObject();
+		void freeObject(unsigned int objectIndex);
+
+		void addObjectToQuadrant(unsigned int quadrantIndex, unsigned int objectIndex);
+		void clearQuadrantObjects(unsigned int quadrantIndex);
+
+		Quadrant& quadrant(unsigned int quadrantIndex);
+		const Quadrant& quadrant(unsigned int quadrantIndex)const;
+
+		unsigned int& quadrantFirstObject(unsigned int quadrantIndex);
+		unsigned int quadrantFirstObject(unsigned int quadrantIndex)const;
+
+		unsigned int& quadrantLastObject(unsigned int quadrantIndex);
+
+		unsigned int& quadrantObjectsCount(unsigned int quadrantIndex);
+		unsigned int quadrantObjectsCount(unsigned int quadrantIndex)const;
+
+		XMFLOAT2& objectsCenters(unsigned int objectIndex);
+		ObjectData& objectsDatas(unsigned int objectIndex);
+		const ObjectData& objectsDatas(unsigned int objectIndex)const;
+
+		unsigned int& nextObject(unsigned int objectIndex);
+		unsigned int nextObject(unsigned int objectIndex)const;
+
+		XMFLOAT2& perDepthQuadrantSize(unsigned int depth);
+		const XMFLOAT2& perDepthQuadrantSize(unsigned int depth)const;
+
+		unsigned int& childrenOffsets(unsigned int depth);
+		unsigned int childrenOffsets(unsigned int depth)const;
+
+		void setQuadrantDepth(unsigned int quadrantIndex, unsigned int quadrantDepth);
+		unsigned int perQuadrantDepth(unsigned int quadrantIndex)const;
+
+		void setQuadrantSubdivided(unsigned int quadrantIndex, bool quadrantSubdivided);
+		bool isQuadrantSubdivided(unsigned int quadrantIndex)const;
+
+		//one allocation for all the arrays below, the offsets are in bytes from the arena start
+		std::vector<unsigned char> m_arena{};
+
+		//per quadrant
+		size_t m_quadrantsStart{ 0 };
+		size_t m_perQuadrantFirstObjectStart{ 0 };
+		size_t m_perQuadrantLastObjectStart{ 0 };
+		size_t m_perQuadrantObjectsCountStart{ 0 };
+		size_t m_perQuadrantDepthStart{ 0 };
+		size_t m_perQuadrantSubdividedStart{ 0 };
+
+		//per depth
+		size_t m_perDepthQuadrantSizeStart{ 0 }; //from depth == 0 (entire area) to maxDepth inclusive
+		size_t m_childrenOffsetsStart{ 0 }; //maxDepth elements, because leaves haven't children
+
+		//per object
+		size_t m_objectsCentersStart{ 0 };
+		size_t m_objectsDatasStart{ 0 };
+		size_t m_nextObjectsStart{ 0 };
+
+		XMFLOAT2 m_objectsHalfExtents;
+		unsigned int m_maxDepth;
+		unsigned int m_quadrantsCount;
+		unsigned int m_objectsCapacity;
+		unsigned int m_objectsCount{ 0 };
+		unsigned int m_usedObjectsSlotsCount{ 0 }; //the slots after it have never been used
+		unsigned int m_firstFreeObject{ sk_invalidObjectIndex }; //removed slots, linked through the next objects array
+	};
+
+	//DynamicQuadtree implementation
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		DynamicQuadtree<ObjectData, SubdivisionPolicy>::
+			DynamicQuadtree(const AABB& quadtreeArea, const XMFLOAT2& objectsHalfExtents,
+							unsigned int maxDepth, unsigned int objectsCapacity) : m_objectsHalfExtents{ objectsHalfExtents },
+																				   m_maxDepth{ maxDepth },
+																				   m_quadrantsCount{ quadrantsCount(maxDepth) },
+																				   m_objectsCapacity{ objectsCapacity }
+	{
+		assert(maxDepth <= sk_maxSupportedDepth);
+
+		size_t arenaSize = 0;
+
+		m_quadrantsStart = reserveArenaArray<Quadrant>(arenaSize, m_quadrantsCount);
+		m_perQuadrantFirstObjectStart = reserveArenaArray<unsigned int>(arenaSize, m_quadrantsCount);
+		m_perQuadrantLastObjectStart = reserveArenaArray<unsigned int>(arenaSize, m_quadrantsCount);
+		m_perQuadrantObjectsCountStart = reserveArenaArray<unsigned int>(arenaSize, m_quadrantsCount);
+		m_perQuadrantDepthStart = reserveArenaArray<unsigned int>(arenaSize, m_quadrantsCount);
+		m_perQuadrantSubdividedStart = reserveArenaArray<bool>(arenaSize, m_quadrantsCount);
+
+		m_perDepthQuadrantSizeStart = reserveArenaArray<XMFLOAT2>(arenaSize, m_maxDepth + 1);
+		m_childrenOffsetsStart = reserveArenaArray<unsigned int>(arenaSize, m_maxDepth);
+
+		m_objectsCentersStart = reserveArenaArray<XMFLOAT2>(arenaSize, m_objectsCapacity);
+		m_objectsDatasStart = reserveArenaArray<ObjectData>(arenaSize, m_objectsCapacity);
+		m_nextObjectsStart = reserveArenaArray<unsigned int>(arenaSize, m_objectsCapacity);
+
+		m_arena.resize(arenaSize);
+
+		quadrant(0).min() = quadtreeArea.min();
+
+		const XMFLOAT2 areaSize = quadtreeArea.max() - quadtreeArea.min();
+
+		XMFLOAT2 currQuadrantSize = areaSize;
+		for (unsigned int depth = 0; depth <= m_maxDepth; ++depth)
+		{
+			perDepthQuadrantSize(depth) = currQuadrantSize;
+			currQuadrantSize = currQuadrantSize * 0.5f;
+		}
+
+		for (unsigned int depth = 0; depth < m_maxDepth; ++depth)
+		{
+			childrenOffsets(depth) = computeSiblingsOffset(depth + 1, m_maxDepth);
+		}
+
+		buildQuadrant(0, 0);
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	template<typename T>
+	inline
+		size_t
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::reserveArenaArray(size_t& arenaSize, size_t count)
+	{
+		//the arena is allocated by operator new, which is aligned for any fundamental type
+		const size_t alignment = alignof(T);
+		const size_t offset = (arenaSize + alignment - 1) / alignment * alignment;
+
+		arenaSize = offset + count * sizeof(T);
+
+		return offset;
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	template<typename T>
+	inline
+		T*
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::arenaArray(size_t offset)
+	{
+		assert(offset <= m_arena.size());
+		return reinterpret_cast<T*>(m_arena.data() + offset);
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	template<typename T>
+	inline
+		const T*
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::arenaArray(size_t offset)const
+	{
+		assert(offset <= m_arena.size());
+		return reinterpret_cast<const T*>(m_arena.data() + offset);
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		void
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::buildQuadrant(unsigned int quadrantIndex, unsigned int currDepth)
+	{
+		assert(quadrantIndex < m_quadrantsCount);
+		assert(currDepth <= m_maxDepth);
+
+		setQuadrantDepth(quadrantIndex, currDepth);
+		setQuadrantSubdivided(quadrantIndex, false);
+		clearQuadrantObjects(quadrantIndex);
+
+		if (currDepth == m_maxDepth)
+		{
+			return;
+		}
+
+		const unsigned int siblingOffset = childrenOffsets(currDepth);
+
+		const unsigned int childrenDepth = currDepth + 1;
+
+		const XMFLOAT2& childrenSize = perDepthQuadrantSize(childrenDepth);
+
+		const unsigned int firstQuadrantIndex = quadrantIndex + 1;
+		const unsigned int secondQuadrantIndex = firstQuadrantIndex + siblingOffset;
+		const unsigned int thirdQuadrantIndex = secondQuadrantIndex + siblingOffset;
+		const unsigned int fourthQuadrantIndex = thirdQuadrantIndex + siblingOffset;
+
+		const XMFLOAT2 parentMin = quadrant(quadrantIndex).min();
+
+		quadrant(firstQuadrantIndex).min() = parentMin;
+		quadrant(secondQuadrantIndex).min() = parentMin + XMFLOAT2{ childrenSize.x + gk_epsilon, 0.0f };
+		quadrant(thirdQuadrantIndex).min() = parentMin + XMFLOAT2{ 0.0f, childrenSize.y + gk_epsilon };
+		quadrant(fourthQuadrantIndex).min() = parentMin + XMFLOAT2{ childrenSize.x + gk_epsilon, childrenSize.y + gk_epsilon };
+
+		buildQuadrant(firstQuadrantIndex, childrenDepth);
+		buildQuadrant(secondQuadrantIndex, childrenDepth);
+		buildQuadrant(thirdQuadrantIndex, childrenDepth);
+		buildQuadrant(fourthQuadrantIndex, childrenDepth);
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		void
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::insert(const XMFLOAT2& objectCenter,
+																   const ObjectData& objectData)
+	{
+		const unsigned int objectIndex = allocateObject();
+		objectsCenters(objectIndex) = objectCenter;
+		objectsDatas(objectIndex) = objectData;
+
+		const AABB objectAABB = AABB::computeFromCenterAndHalfExtents(objectCenter, m_objectsHalfExtents);
+		const XMFLOAT2 objectAABBMin = objectAABB.min();
+		const XMFLOAT2 objectAABBMax = objectAABB.max();
+
+		unsigned int currDepth = 0;
+		unsigned int currQuadrantIndex = 0;
+
+		while (true)
+		{
+			if (!isQuadrantSubdivided(currQuadrantIndex))
+			{
+				addObjectToQuadrant(currQuadrantIndex, objectIndex);
+
+				if (currDepth < m_maxDepth && shouldSubdivide(currQuadrantIndex))
+				{
+					subdivide(currQuadrantIndex, currDepth);
+				}
+
+				break;
+			}
+
+			//isQuadrantSubdivided(currQuadrantIndex) == false for each leaf, so the current quadrant is not a leaf
+
+			//continue the insertion in one child
+			const unsigned int childrenOffset = childrenOffsets(currDepth);
+			++currDepth;
+
+			const XMFLOAT2& childQuadrantsSize = perDepthQuadrantSize(currDepth);
+
+			unsigned int childIndex = currQuadrantIndex + 1;
+
+			unsigned int child = 0;
+			for (; child < 4; ++child)
+			{
+				if (quadrant(childIndex).contains(objectAABBMin, objectAABBMax, childQuadrantsSize))
+				{
+					currQuadrantIndex = childIndex;
+					break;
+				}
+
+				childIndex += childrenOffset;
+			}
+
+			if (child == 4)
+			{
+				//the object doesn't fit any child, so keep it at this level
+				addObjectToQuadrant(currQuadrantIndex, objectIndex);
+				break;
+			}
+		}
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		void
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::subdivide(unsigned int quadrantIndex, unsigned int currDepth)
+	{
+		assert(currDepth < m_maxDepth);
+		assert(!isQuadrantSubdivided(quadrantIndex));
+
+		const unsigned int childrenOffset = childrenOffsets(currDepth);
+		const unsigned int childrenDepth = currDepth + 1;
+		const XMFLOAT2& childrenQuadrantSize = perDepthQuadrantSize(childrenDepth);
+
+		unsigned int childrenIndices[4];
+		computeChildrenIndices(quadrantIndex, childrenIndices, childrenOffset);
+
+		//relink each object either to the child containing it or back to the quadrant, keeping their order
+
+		unsigned int objectIndex = quadrantFirstObject(quadrantIndex);
+		clearQuadrantObjects(quadrantIndex);
+
+		while (objectIndex != sk_invalidObjectIndex)
+		{
+			const unsigned int nextObjectIndex = nextObject(objectIndex);
+
+			const AABB objectAABB = AABB::computeFromCenterAndHalfExtents(objectsCenters(objectIndex), m_objectsHalfExtents);
+			const XMFLOAT2 objectAABBMin = objectAABB.min();
+			const XMFLOAT2 objectAABBMax = objectAABB.max();
+
+			unsigned int destinationQuadrantIndex = quadrantIndex;
+
+			for (unsigned int child = 0; child < 4; ++child)
+			{
+				const unsigned int childrenIndex = childrenIndices[child];
+
+				if (quadrant(childrenIndex).contains(objectAABBMin, objectAABBMax, childrenQuadrantSize))
+				{
+					destinationQuadrantIndex = childrenIndex;
+					break;
+				}
+			}
+
+			addObjectToQuadrant(destinationQuadrantIndex, objectIndex);
+
+			objectIndex = nextObjectIndex;
+		}
+
+		setQuadrantSubdivided(quadrantIndex, true);
+
+		if (childrenDepth == m_maxDepth)
+		{
+			//all done!
+			return;
+		}
+
+		//as in Quadtree::subdivide(), each child satisfying the condition is subdivided
+		for (unsigned int child = 0; child < 4; ++child)
+		{
+			const unsigned int childrenIndex = childrenIndices[child];
+			if (shouldSubdivide(childrenIndex))
+			{
+				subdivide(childrenIndex, childrenDepth);
+			}
+		}
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		unsigned int
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::findPotentialColliders(const AABB& objectAABB,
+																				   ObjectData* foundObjects)const
+	{
+		assert(foundObjects != nullptr);
+
+		unsigned int foundObjectsCount = 0;
+
+		const XMFLOAT2 objectAABBMin = objectAABB.min();
+		const XMFLOAT2 objectAABBMax = objectAABB.max();
+
+		//depth-first navigation, see Quadtree::findPotentialColliders() for the stack size
+		unsigned int quadrantsIndicesStack[3 * sk_maxSupportedDepth + 1];
+		int stackPointer = -1; //-1 => empty stack
+
+		++stackPointer;
+		quadrantsIndicesStack[stackPointer] = 0; //push root
+
+		while (stackPointer != -1)
+		{
+			assert(stackPointer < static_cast<int>(3 * m_maxDepth + 1));
+			const unsigned int quadrantIndex = quadrantsIndicesStack[stackPointer];
+			--stackPointer;
+
+			const unsigned int quadrantDepth = perQuadrantDepth(quadrantIndex);
+
+			const Quadrant& currQuadrant = quadrant(quadrantIndex);
+
+			if (currQuadrant.outside(objectAABBMin, objectAABBMax, perDepthQuadrantSize(quadrantDepth)))
+			{
+				//the object doesn't touch the current quadrant, so skip its objects
+				continue;
+			}
+
+			//add all the quadrant objects
+			for (unsigned int objectIndex = quadrantFirstObject(quadrantIndex); objectIndex != sk_invalidObjectIndex; objectIndex = nextObject(objectIndex))
+			{
+				foundObjects[foundObjectsCount++] = objectsDatas(objectIndex);
+			}
+
+			if (isQuadrantSubdivided(quadrantIndex))
+			{
+				unsigned int childrenIndices[4];
+				computeChildrenIndices(quadrantIndex, childrenIndices, childrenOffsets(quadrantDepth));
+
+				//check the first child before
+				for (int child = 3; child >= 0; --child)
+				{
+					++stackPointer;
+					quadrantsIndicesStack[stackPointer] = childrenIndices[child];
+				}
+			}
+		}
+
+		return foundObjectsCount;
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		bool
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::remove(const XMFLOAT2& objectCenter,
+																   const ObjectData& objectData)
+	{
+		const AABB objectAABB = AABB::computeFromCenterAndHalfExtents(objectCenter, m_objectsHalfExtents);
+		const XMFLOAT2 objectAABBMin = objectAABB.min();
+		const XMFLOAT2 objectAABBMax = objectAABB.max();
+
+		//the object is in the deepest quadrant containing it, as insert() and subdivide() place it.
+		//the quadrants from the root to that one are kept to merge them afterwards
+		unsigned int pathQuadrantsIndices[sk_maxSupportedDepth + 1];
+		unsigned int pathLength = 0;
+
+		unsigned int currDepth = 0;
+		unsigned int currQuadrantIndex = 0;
+		pathQuadrantsIndices[pathLength++] = currQuadrantIndex;
+
+		while (isQuadrantSubdivided(currQuadrantIndex))
+		{
+			const unsigned int childrenOffset = childrenOffsets(currDepth);
+			const XMFLOAT2& childQuadrantsSize = perDepthQuadrantSize(currDepth + 1);
+
+			unsigned int childIndex = currQuadrantIndex + 1;
+
+			unsigned int child = 0;
+			for (; child < 4; ++child)
+			{
+				if (quadrant(childIndex).contains(objectAABBMin, objectAABBMax, childQuadrantsSize))
+				{
+					break;
+				}
+
+				childIndex += childrenOffset;
+			}
+
+			if (child == 4)
+			{
+				//the object doesn't fit any child, so it is at this level
+				break;
+			}
+
+			++currDepth;
+			currQuadrantIndex = childIndex;
+			pathQuadrantsIndices[pathLength++] = currQuadrantIndex;
+		}
+
+		//unlink the object, keeping the order of the remaining ones
+		unsigned int previousObjectIndex = sk_invalidObjectIndex;
+		unsigned int objectIndex = quadrantFirstObject(currQuadrantIndex);
+
+		while (objectIndex != sk_invalidObjectIndex && !(objectsDatas(objectIndex) == objectData))
+		{
+			previousObjectIndex = objectIndex;
+			objectIndex = nextObject(objectIndex);
+		}
+
+		if (objectIndex == sk_invalidObjectIndex)
+		{
+			return false;
+		}
+
+		const unsigned int nextObjectIndex = nextObject(objectIndex);
+
+		unsigned int& previousLink = previousObjectIndex == sk_invalidObjectIndex ? quadrantFirstObject(currQuadrantIndex) : nextObject(previousObjectIndex);
+		previousLink = nextObjectIndex;
+
+		if (quadrantLastObject(currQuadrantIndex) == objectIndex)
+		{
+			quadrantLastObject(currQuadrantIndex) = previousObjectIndex;
+		}
+
+		--quadrantObjectsCount(currQuadrantIndex);
+
+		freeObject(objectIndex);
+
+		//merge the emptied quadrants, bottom-up: a quadrant is merged only if its children are empty leaves
+		for (int pathIndex = static_cast<int>(pathLength) - 1; pathIndex >= 0; --pathIndex)
+		{
+			const unsigned int pathQuadrantIndex = pathQuadrantsIndices[pathIndex];
+
+			if (!isQuadrantSubdivided(pathQuadrantIndex))
+			{
+				continue;
+			}
+
+			if (!canMergeChildren(pathQuadrantIndex, static_cast<unsigned int>(pathIndex)))
+			{
+				break;
+			}
+
+			setQuadrantSubdivided(pathQuadrantIndex, false);
+		}
+
+		return true;
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		bool
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::update(const XMFLOAT2& oldObjectCenter,
+																   const XMFLOAT2& newObjectCenter,
+																   const ObjectData& objectData)
+	{
+		if (!remove(oldObjectCenter, objectData))
+		{
+			return false;
+		}
+
+		insert(newObjectCenter, objectData);
+		return true;
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		bool
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::canMergeChildren(unsigned int quadrantIndex, unsigned int quadrantDepth)const
+	{
+		assert(isQuadrantSubdivided(quadrantIndex));
+
+		unsigned int childrenIndices[4];
+		computeChildrenIndices(quadrantIndex, childrenIndices, childrenOffsets(quadrantDepth));
+
+		for (unsigned int child = 0; child < 4; ++child)
+		{
+			const unsigned int childrenIndex = childrenIndices[child];
+
+			if (isQuadrantSubdivided(childrenIndex) || quadrantObjectsCount(childrenIndex) != 0)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		void
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::clear()
+	{
+		for (unsigned int quadrantIndex = 0; quadrantIndex < m_quadrantsCount; ++quadrantIndex)
+		{
+			setQuadrantSubdivided(quadrantIndex, false);
+			clearQuadrantObjects(quadrantIndex);
+		}
+
+		m_objectsCount = 0;
+		m_usedObjectsSlotsCount = 0;
+		m_firstFreeObject = sk_invalidObjectIndex;
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		unsigned int
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::allocateObject()
+	{
+		assert(m_objectsCount < m_objectsCapacity);
+
+		++m_objectsCount;
+
+		if (m_firstFreeObject == sk_invalidObjectIndex)
+		{
+			return m_usedObjectsSlotsCount++;
+		}
+
+		const unsigned int objectIndex = m_firstFreeObject;
+		m_firstFreeObject = nextObject(objectIndex);
+
+		return objectIndex;
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		void
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::freeObject(unsigned int objectIndex)
+	{
+		assert(m_objectsCount > 0);
+
+		--m_objectsCount;
+
+		nextObject(objectIndex) = m_firstFreeObject;
+		m_firstFreeObject = objectIndex;
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		void
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::addObjectToQuadrant(unsigned int quadrantIndex, unsigned int objectIndex)
+	{
+		//append, so that the objects are found in insertion order as in Quadtree
+		nextObject(objectIndex) = sk_invalidObjectIndex;
+
+		unsigned int& lastObjectIndex = quadrantLastObject(quadrantIndex);
+
+		unsigned int& previousLink = lastObjectIndex == sk_invalidObjectIndex ? quadrantFirstObject(quadrantIndex) : nextObject(lastObjectIndex);
+		previousLink = objectIndex;
+
+		lastObjectIndex = objectIndex;
+		++quadrantObjectsCount(quadrantIndex);
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		void
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::clearQuadrantObjects(unsigned int quadrantIndex)
+	{
+		quadrantFirstObject(quadrantIndex) = sk_invalidObjectIndex;
+		quadrantLastObject(quadrantIndex) = sk_invalidObjectIndex;
+		quadrantObjectsCount(quadrantIndex) = 0;
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		bool
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::shouldSubdivide(unsigned int quadrantIndex) const
+	{
+		return SubdivisionPolicy::shouldSubdivideQuadrant(quadrantObjectsCount(quadrantIndex));
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		unsigned int
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::maxDepth()const
+	{
+		return m_maxDepth;
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		unsigned int
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::objectsCapacity()const
+	{
+		return m_objectsCapacity;
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		unsigned int
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::objectsCount()const
+	{
+		return m_objectsCount;
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		size_t
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::memoryUsage()const
+	{
+		return sizeof(*this) + m_arena.capacity();
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		Quadrant&
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::quadrant(unsigned int quadrantIndex)
+	{
+		assert(quadrantIndex < m_quadrantsCount);
+		return arenaArray<Quadrant>(m_quadrantsStart)[quadrantIndex];
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		const Quadrant&
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::quadrant(unsigned int quadrantIndex) const
+	{
+		assert(quadrantIndex < m_quadrantsCount);
+		return arenaArray<Quadrant>(m_quadrantsStart)[quadrantIndex];
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		unsigned int&
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::quadrantFirstObject(unsigned int quadrantIndex)
+	{
+		assert(quadrantIndex < m_quadrantsCount);
+		return arenaArray<unsigned int>(m_perQuadrantFirstObjectStart)[quadrantIndex];
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		unsigned int
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::quadrantFirstObject(unsigned int quadrantIndex) const
+	{
+		assert(quadrantIndex < m_quadrantsCount);
+		return arenaArray<unsigned int>(m_perQuadrantFirstObjectStart)[quadrantIndex];
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		unsigned int&
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::quadrantLastObject(unsigned int quadrantIndex)
+	{
+		assert(quadrantIndex < m_quadrantsCount);
+		return arenaArray<unsigned int>(m_perQuadrantLastObjectStart)[quadrantIndex];
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		unsigned int&
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::quadrantObjectsCount(unsigned int quadrantIndex)
+	{
+		assert(quadrantIndex < m_quadrantsCount);
+		return arenaArray<unsigned int>(m_perQuadrantObjectsCountStart)[quadrantIndex];
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		unsigned int
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::quadrantObjectsCount(unsigned int quadrantIndex) const
+	{
+		assert(quadrantIndex < m_quadrantsCount);
+		return arenaArray<unsigned int>(m_perQuadrantObjectsCountStart)[quadrantIndex];
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		XMFLOAT2&
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::objectsCenters(unsigned int objectIndex)
+	{
+		assert(objectIndex < m_objectsCapacity);
+		return arenaArray<XMFLOAT2>(m_objectsCentersStart)[objectIndex];
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		ObjectData&
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::objectsDatas(unsigned int objectIndex)
+	{
+		assert(objectIndex < m_objectsCapacity);
+		return arenaArray<ObjectData>(m_objectsDatasStart)[objectIndex];
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		const ObjectData&
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::objectsDatas(unsigned int objectIndex) const
+	{
+		assert(objectIndex < m_objectsCapacity);
+		return arenaArray<ObjectData>(m_objectsDatasStart)[objectIndex];
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		unsigned int&
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::nextObject(unsigned int objectIndex)
+	{
+		assert(objectIndex < m_objectsCapacity);
+		return arenaArray<unsigned int>(m_nextObjectsStart)[objectIndex];
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		unsigned int
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::nextObject(unsigned int objectIndex) const
+	{
+		assert(objectIndex < m_objectsCapacity);
+		return arenaArray<unsigned int>(m_nextObjectsStart)[objectIndex];
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		XMFLOAT2&
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::perDepthQuadrantSize(unsigned int depth)
+	{
+		assert(depth <= m_maxDepth);
+		return arenaArray<XMFLOAT2>(m_perDepthQuadrantSizeStart)[depth];
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		const XMFLOAT2&
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::perDepthQuadrantSize(unsigned int depth) const
+	{
+		assert(depth <= m_maxDepth);
+		return arenaArray<XMFLOAT2>(m_perDepthQuadrantSizeStart)[depth];
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		unsigned int&
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::childrenOffsets(unsigned int depth)
+	{
+		assert(depth < m_maxDepth);
+		return arenaArray<unsigned int>(m_childrenOffsetsStart)[depth];
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		unsigned int
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::childrenOffsets(unsigned int depth) const
+	{
+		assert(depth < m_maxDepth);
+		return arenaArray<unsigned int>(m_childrenOffsetsStart)[depth];
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		unsigned int
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::perQuadrantDepth(unsigned int quadrantIndex) const
+	{
+		assert(quadrantIndex < m_quadrantsCount);
+		return arenaArray<unsigned int>(m_perQuadrantDepthStart)[quadrantIndex];
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		void
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::setQuadrantDepth(unsigned int quadrantIndex, unsigned int quadrantDepth)
+	{
+		assert(quadrantIndex < m_quadrantsCount);
+		assert(quadrantDepth <= m_maxDepth);
+		arenaArray<unsigned int>(m_perQuadrantDepthStart)[quadrantIndex] = quadrantDepth;
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		void
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::setQuadrantSubdivided(unsigned int quadrantIndex, bool quadrantSubdivided)
+	{
+		assert(quadrantIndex < m_quadrantsCount);
+		arenaArray<bool>(m_perQuadrantSubdividedStart)[quadrantIndex] = quadrantSubdivided;
+	}
+
+	template<typename ObjectData, typename SubdivisionPolicy>
+	inline
+		bool
+			DynamicQuadtree<ObjectData, SubdivisionPolicy>::isQuadrantSubdivided(unsigned int quadrantIndex) const
+	{
+		assert(quadrantIndex < m_quadrantsCount);
+		return arenaArray<bool>(m_perQuadrantSubdividedStart)[quadrantIndex];
+	}
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include "FixedTimestepSimulation.h"
+#include <algorithm>
+
+using namespace ArkanoidGame;
+
+constexpr unsigned int FixedTimestepSimulation::sk_defaultStepsPerSecond;
+constexpr unsigned int FixedTimestepSimulation::sk_defaultMaxStepsPerUpdate;
+constexpr float FixedTimestepSimulation::sk_maxInterpolatedDistance;
+
+FixedTimestepSimulation::FixedTimestepSimulation(unsigned int randomSeed,
+												 unsigned int stepsPerSecond,
+												 unsigned int maxStepsPerUpdate) : m_simulation{ randomSeed }
+{
+	setStepsPerSecond(stepsPerSecond);
+	setMaxStepsPerUpdate(maxStepsPerUpdate);
+
+	m_previousTransforms = *m_simulation.transforms();
+	interpolateTransforms();
+}
+
+bool FixedTimestepSimulation::update(float frameTime, unsigned int inputFlags)
+{
+	assert(frameTime >= 0.0f);
+
+	const double stepTime = static_cast<double>(m_stepTime);
+
+	m_accumulatedTime += frameTime;
+
+	unsigned int stepsToRun = static_cast<unsigned int>(m_accumulatedTime / stepTime);
+	if (stepsToRun > m_maxStepsPerUpdate)
+	{
+		//the simulation can't keep up: drop whole steps and keep the fractional part for the interpolation
+		const unsigned int stepsToDrop = stepsToRun - m_maxStepsPerUpdate;
+		m_accumulatedTime -= stepsToDrop * stepTime;
+		m_droppedStepsCount += stepsToDrop;
+		stepsToRun = m_maxStepsPerUpdate;
+	}
+
+	bool levelRestarted = false;
+
+	for (unsigned int stepIndex = 0; stepIndex < stepsToRun; ++stepIndex)
+	{
+		//only the state before the last step is needed for the interpolation
+		if (stepIndex + 1 == stepsToRun)
+		{
+			m_previousTransforms = *m_simulation.transforms();
+		}
+
+		if (m_simulation.step(m_stepTime, inputFlags))
+		{
+			levelRestarted = true;
+			m_previousTransforms = *m_simulation.transforms();
+		}
+
+		m_accumulatedTime -= stepTime;
+	}
+
+	m_accumulatedTime = std::max(m_accumulatedTime, 0.0);
+	m_stepsCount += stepsToRun;
+
+	interpolateTransforms();
+
+	return levelRestarted;
+}
+
+void FixedTimestepSimulation::restartLevel()
+{
+	m_simulation.restartLevel();
+
+	m_previousTransforms = *m_simulation.transforms();
+	interpolateTransforms();
+}
+
+void FixedTimestepSimulation::interpolateTransforms()
+{
+	const float alpha = std::min(interpolationFactor(), 1.0f);
+	const float maxSquaredDistance = sk_maxInterpolatedDistance * sk_maxInterpolatedDistance;
+
+	const ArkanoidRenderer::TransformsConstantBuffer& currentTransforms = *m_simulation.transforms();
+
+	for (unsigned int instanceIndex = 0; instanceIndex < gk_instancesCount; ++instanceIndex)
+	{
+		const XMFLOAT4& previous = m_previousTransforms.translationAndScales[instanceIndex];
+		const XMFLOAT4& current = currentTransforms.translationAndScales[instanceIndex];
+
+		const float dx = current.x - previous.x;
+		const float dy = current.y - previous.y;
+		const bool teleported = dx * dx + dy * dy > maxSquaredDistance;
+
+		//a teleported instance is put at its current position, which previous + (current - previous) misses by the rounding errors
+		const float positionsX[2] = { previous.x + dx * alpha, current.x };
+		const float positionsY[2] = { previous.y + dy * alpha, current.y };
+
+		//scales are not interpolated: they only change when the level is rebuilt
+		m_interpolatedTransforms.translationAndScales[instanceIndex] = XMFLOAT4{ positionsX[static_cast<unsigned int>(teleported)],
+																				 positionsY[static_cast<unsigned int>(teleported)],
+																				 current.z,
+																				 current.w };
+	}
+}
\ No newline at end of file
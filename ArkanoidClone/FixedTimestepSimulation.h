@@ -0,0 +1,139 @@
+#pragma once
+#include "Engine.h"
+#include "MathCommon.h"
+#include "ArkanoidRenderer.h"
+#include "SimulationCore.h"
+#include <cassert>
+
+namespace ArkanoidGame
+{
+	/*
+	steps a SimulationCore with a constant deltaTime, whatever the frame time is.
+	the frame time is accumulated and consumed in whole steps, up to a maximum number of steps per update,
+	so the simulation cost per frame is bounded and the same seed and per-step inputs give the same results on any machine.
+	the transforms used for rendering are blended between the last two steps by the time left in the accumulator.
+	*/
+	class FixedTimestepSimulation
+	{
+	public:
+		//ctors
+		explicit FixedTimestepSimulation(unsigned int randomSeed,
+										 unsigned int stepsPerSecond = sk_defaultStepsPerSecond,
+										 unsigned int maxStepsPerUpdate = sk_defaultMaxStepsPerUpdate);
+
+		//dtor
+		~FixedTimestepSimulation() = default;
+
+		//copy
+		FixedTimestepSimulation(const FixedTimestepSimulation&) = default;
+		FixedTimestepSimulation& operator=(const FixedTimestepSimulation&) = default;
+
+		//move
+		FixedTimestepSimulation(FixedTimestepSimulation&&) = default;
+		FixedTimestepSimulation& operator=(FixedTimestepSimulation&&) = default;
+
+		//frameTime is in seconds. inputFlags are applied to every step run by this update.
+		//the accumulated time exceeding maxStepsPerUpdate steps is dropped.
+		//returns true if the level has been restarted during the update
+		bool update(float frameTime, unsigned int inputFlags);
+
+		void restartLevel();
+
+		const SimulationCore& simulation()const;
+
+		//interpolated transforms to render
+		const ArkanoidRenderer::TransformsConstantBuffer* transforms()const;
+
+		unsigned int stepsPerSecond()const;
+		void setStepsPerSecond(unsigned int stepsPerSecond);
+
+		unsigned int maxStepsPerUpdate()const;
+		void setMaxStepsPerUpdate(unsigned int maxStepsPerUpdate);
+
+		//in seconds
+		float stepTime()const;
+
+		//in [0, 1): how far the rendered transforms are from the previous step towards the last one
+		float interpolationFactor()const;
+
+		unsigned long long stepsCount()const;
+		unsigned long long droppedStepsCount()const;
+
+		static constexpr unsigned int sk_defaultStepsPerSecond = 120;
+		static constexpr unsigned int sk_defaultMaxStepsPerUpdate = 8;
+
+		//instances moving more than this in a single step have been teleported (e.g. destroyed bricks) and are not interpolated
+		static constexpr float sk_maxInterpolatedDistance = 10.0f;
+
+	private:
+
+		void interpolateTransforms();
+
+		SimulationCore m_simulation;
+
+		ArkanoidRenderer::TransformsConstantBuffer m_previousTransforms{};
+		ArkanoidRenderer::TransformsConstantBuffer m_interpolatedTransforms{};
+
+		double m_accumulatedTime{ 0.0 };
+		float m_stepTime{ 0.0f };
+
+		unsigned int m_stepsPerSecond{ 0 };
+		unsigned int m_maxStepsPerUpdate{ 0 };
+
+		unsigned long long m_stepsCount{ 0 };
+		unsigned long long m_droppedStepsCount{ 0 };
+	};
+
+	inline const SimulationCore& FixedTimestepSimulation::simulation()const
+	{
+		return m_simulation;
+	}
+
+	inline const ArkanoidRenderer::TransformsConstantBuffer* FixedTimestepSimulation::transforms()const
+	{
+		return &m_interpolatedTransforms;
+	}
+
+	inline unsigned int FixedTimestepSimulation::stepsPerSecond()const
+	{
+		return m_stepsPerSecond;
+	}
+
+	inline void FixedTimestepSimulation::setStepsPerSecond(unsigned int stepsPerSecond)
+	{
+		assert(stepsPerSecond > 0);
+		m_stepsPerSecond = stepsPerSecond;
+		m_stepTime = 1.0f / static_cast<float>(stepsPerSecond);
+	}
+
+	inline unsigned int FixedTimestepSimulation::maxStepsPerUpdate()const
+	{
+		return m_maxStepsPerUpdate;
+	}
+
+	inline void FixedTimestepSimulation::setMaxStepsPerUpdate(unsigned int maxStepsPerUpdate)
+	{
+		assert(maxStepsPerUpdate > 0);
+		m_maxStepsPerUpdate = maxStepsPerUpdate;
+	}
+
+	inline float FixedTimestepSimulation::stepTime()const
+	{
+		return m_stepTime;
+	}
+
+	inline float FixedTimestepSimulation::interpolationFactor()const
+	{
+		return static_cast<float>(m_accumulatedTime / m_stepTime);
+	}
+
+	inline unsigned long long FixedTimestepSimulation::stepsCount()const
+	{
+		return m_stepsCount;
+	}
+
+	inline unsigned long long FixedTimestepSimulation::droppedStepsCount()const
+	{
+		return m_droppedStepsCount;
+	}
+}
\ No newline at end of file
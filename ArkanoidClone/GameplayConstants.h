@@ -0,0 +1,63 @@
+#pragma once
+#include "Engine.h"
+#include "MathCommon.h"
+#include "Dimensions.h"
+
+namespace ArkanoidGame
+{
+	//arena
+
+	constexpr unsigned int gk_arenaWidth = 40;
+	constexpr unsigned int gk_arenaHeight = 60;
+	constexpr unsigned int gk_arenaHalfWidth = gk_arenaWidth / 2;
+	constexpr unsigned int gk_arenaHalfHeight = gk_arenaHeight / 2;
+
+	constexpr int gk_arenaMinX = -static_cast<int>(gk_arenaHalfWidth);
+	constexpr int gk_arenaMaxX = gk_arenaHalfWidth;
+	constexpr int gk_arenaMinY = -static_cast<int>(gk_arenaHalfHeight);
+	constexpr int gk_arenaMaxY = gk_arenaHalfHeight;
+
+	constexpr float gk_outOfArenaX = gk_arenaMaxX * 10.0f;
+	constexpr float gk_outOfArenaY = gk_arenaMaxY * 10.0f;
+
+	//sizes
+
+	constexpr float gk_bricksWidth = 4.0f;
+	constexpr float gk_bricksHeight = 2.0f;
+	constexpr float gk_bricksHalfWidth = gk_bricksWidth*0.5f;
+	constexpr float gk_bricksHalfHeight = gk_bricksHeight * 0.5f;
+
+	constexpr float gk_playerHalfWidth = 3.0f;
+	constexpr float gk_playerHalfHeight = 0.5f;
+
+	constexpr float gk_ballHalfWidth = 1.0f;
+	constexpr float gk_ballHalfHeight = 1.0f;
+
+	constexpr float gk_bonusHalfWidth = 1.0f;
+	constexpr float gk_bonusHalfHeight = 0.5f;
+
+	const XMFLOAT2 gk_ballHalfExtents{ gk_ballHalfWidth, gk_ballHalfHeight };
+	const XMFLOAT2 gk_playerHalfExtents{ gk_playerHalfWidth, gk_playerHalfHeight };
+	const XMFLOAT2 gk_bricksHalfExtents{ gk_bricksHalfWidth, gk_bricksHalfHeight };
+	const XMFLOAT2 gk_bonusHalfExtents{ gk_bonusHalfWidth, gk_bonusHalfHeight };
+
+	//rules
+
+	constexpr unsigned int gk_maxBonusBricksHitCount = 5;
+
+	constexpr float gk_playerSpeed = 24.0f;
+	constexpr float gk_startBallSpeed = 35.0f;
+	constexpr float gk_startBallVelocityX = 0.5f;
+	constexpr float gk_startBallVelocityY = 1.0f;
+	constexpr float gk_bonusSpeedY = 8.0f;
+
+	constexpr float gk_gameOverBallY = gk_arenaMinY - 15.0f;
+	constexpr float gk_destroyBonusY = gk_arenaMinY - 1.0f;
+
+	constexpr unsigned int gk_bricksHitsCounts[gk_brickTypesCount] =
+	{
+		3,
+		2,
+		1
+	};
+}
\ No newline at end of file
@@ -0,0 +1,204 @@
+#include "GridBroadphase.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace ArkanoidGame;
+
+constexpr unsigned int GridBroadphase::sk_invalidEntryIndex;
+constexpr unsigned int GridBroadphase::sk_maxCellsPerObject;
+constexpr float GridBroadphase::sk_cellsEpsilon;
+
+//the index of the cell containing the coordinate, in cells units from the origin, clamped to [0, cellsCount)
+static unsigned int clampedCellIndex(float cellsCoordinate, unsigned int cellsCount)
+{
+	//once clamped the coordinate is not negative, so the conversion truncates it as std::floor() would
+	const float maxCellIndex = static_cast<float>(cellsCount - 1);
+	return static_cast<unsigned int>(std::min(std::max(cellsCoordinate, 0.0f), maxCellIndex));
+}
+
+GridBroadphase::GridBroadphase(const AABB& area, const XMFLOAT2& objectsHalfExtents,
+							   unsigned int objectsCapacity) : m_entriesPool(objectsCapacity * sk_maxCellsPerObject),
+															   m_objectsHalfExtents{ objectsHalfExtents },
+															   m_cellsSize{ objectsHalfExtents * 2.0f },
+															   m_inverseCellsSize{ 1.0f / m_cellsSize.x, 1.0f / m_cellsSize.y },
+															   m_areaMin{ area.min() },
+															   m_origin{ m_areaMin }
+{
+	assert(objectsHalfExtents.x > 0.0f && objectsHalfExtents.y > 0.0f);
+
+	//one more cell per axis, so the area is covered wherever the cells are aligned
+	const XMFLOAT2 areaSize = area.halfExtents() * 2.0f;
+	m_columnsCount = static_cast<unsigned int>(std::ceil(areaSize.x * m_inverseCellsSize.x)) + 1;
+	m_rowsCount = static_cast<unsigned int>(std::ceil(areaSize.y * m_inverseCellsSize.y)) + 1;
+
+	m_perCellFirstEntry.resize(m_columnsCount * m_rowsCount);
+
+	clear();
+}
+
+void GridBroadphase::insert(const XMFLOAT2& objectCenter, unsigned int objectData)
+{
+	const CellsRange objectCells = computeObjectCellsRange(objectCenter);
+
+	assert((objectCells.lastColumn - objectCells.firstColumn + 1) * (objectCells.lastRow - objectCells.firstRow + 1) <= sk_maxCellsPerObject);
+
+	for (unsigned int row = objectCells.firstRow; row <= objectCells.lastRow; ++row)
+	{
+		for (unsigned int column = objectCells.firstColumn; column <= objectCells.lastColumn; ++column)
+		{
+			const unsigned int entryIndex = allocateEntry();
+			unsigned int& firstEntryIndex = m_perCellFirstEntry[cellIndex(column, row)];
+
+			CellEntry& entry = m_entriesPool[entryIndex];
+			entry.objectData = objectData;
+			entry.objectFirstColumn = objectCells.firstColumn;
+			entry.objectFirstRow = objectCells.firstRow;
+			entry.nextEntry = firstEntryIndex;
+
+			firstEntryIndex = entryIndex;
+		}
+	}
+
+	++m_objectsCount;
+}
+
+void GridBroadphase::build(const AABB&, const XMFLOAT2* objectsCenters, const unsigned int* objectsDatas, unsigned int objectsCount)
+{
+	assert(objectsCount == 0 || (objectsCenters != nullptr && objectsDatas != nullptr));
+	assert(objectsCount * sk_maxCellsPerObject <= m_entriesPool.size());
+
+	clear();
+
+	m_origin = m_areaMin;
+
+	if (objectsCount > 0)
+	{
+		//move the origin back from m_areaMin by the part of a cell which puts a cell corner on the first object corner
+		const XMFLOAT2 firstObjectMin = objectsCenters[0] - m_objectsHalfExtents;
+		const float cellsOffsetX = (m_areaMin.x - firstObjectMin.x) * m_inverseCellsSize.x;
+		const float cellsOffsetY = (m_areaMin.y - firstObjectMin.y) * m_inverseCellsSize.y;
+
+		m_origin.x -= (cellsOffsetX - std::floor(cellsOffsetX)) * m_cellsSize.x;
+		m_origin.y -= (cellsOffsetY - std::floor(cellsOffsetY)) * m_cellsSize.y;
+	}
+
+	for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+	{
+		insert(objectsCenters[objectIndex], objectsDatas[objectIndex]);
+	}
+}
+
+unsigned int GridBroadphase::findPotentialColliders(const AABB& objectAABB, unsigned int* foundObjects)const
+{
+	assert(foundObjects != nullptr);
+
+	const CellsRange queryCells = computeCellsRange(objectAABB.min(), objectAABB.max(), -2.0f * sk_cellsEpsilon, 2.0f * sk_cellsEpsilon);
+
+	unsigned int foundObjectsCount = 0;
+
+	for (unsigned int row = queryCells.firstRow; row <= queryCells.lastRow; ++row)
+	{
+		for (unsigned int column = queryCells.firstColumn; column <= queryCells.lastColumn; ++column)
+		{
+			for (unsigned int entryIndex = m_perCellFirstEntry[cellIndex(column, row)]; entryIndex != sk_invalidEntryIndex; entryIndex = m_entriesPool[entryIndex].nextEntry)
+			{
+				const CellEntry& entry = m_entriesPool[entryIndex];
+
+				//an object overlapping more of the query cells is found in the first of them
+				const unsigned int reportingColumn = std::max(entry.objectFirstColumn, queryCells.firstColumn);
+				const unsigned int reportingRow = std::max(entry.objectFirstRow, queryCells.firstRow);
+
+				if (reportingColumn == column && reportingRow == row)
+				{
+					foundObjects[foundObjectsCount++] = entry.objectData;
+				}
+			}
+		}
+	}
+
+	return foundObjectsCount;
+}
+
+bool GridBroadphase::remove(const XMFLOAT2& objectCenter, unsigned int objectData)
+{
+	const CellsRange objectCells = computeObjectCellsRange(objectCenter);
+
+	unsigned int removedEntriesCount = 0;
+
+	for (unsigned int row = objectCells.firstRow; row <= objectCells.lastRow; ++row)
+	{
+		for (unsigned int column = objectCells.firstColumn; column <= objectCells.lastColumn; ++column)
+		{
+			unsigned int* previousLink = &m_perCellFirstEntry[cellIndex(column, row)];
+
+			while (*previousLink != sk_invalidEntryIndex && m_entriesPool[*previousLink].objectData != objectData)
+			{
+				previousLink = &m_entriesPool[*previousLink].nextEntry;
+			}
+
+			if (*previousLink == sk_invalidEntryIndex)
+			{
+				//an object is linked to all its cells or to none of them
+				assert(removedEntriesCount == 0);
+				return false;
+			}
+
+			const unsigned int entryIndex = *previousLink;
+			*previousLink = m_entriesPool[entryIndex].nextEntry;
+
+			freeEntry(entryIndex);
+			++removedEntriesCount;
+		}
+	}
+
+	assert(m_objectsCount > 0);
+	--m_objectsCount;
+
+	return true;
+}
+
+GridBroadphase::CellsRange GridBroadphase::computeCellsRange(const XMFLOAT2& min, const XMFLOAT2& max, float minOffset, float maxOffset)const
+{
+	CellsRange cellsRange;
+	cellsRange.firstColumn = clampedCellIndex((min.x - m_origin.x) * m_inverseCellsSize.x + minOffset, m_columnsCount);
+	cellsRange.firstRow = clampedCellIndex((min.y - m_origin.y) * m_inverseCellsSize.y + minOffset, m_rowsCount);
+	cellsRange.lastColumn = clampedCellIndex((max.x - m_origin.x) * m_inverseCellsSize.x + maxOffset, m_columnsCount);
+	cellsRange.lastRow = clampedCellIndex((max.y - m_origin.y) * m_inverseCellsSize.y + maxOffset, m_rowsCount);
+
+	return cellsRange;
+}
+
+GridBroadphase::CellsRange GridBroadphase::computeObjectCellsRange(const XMFLOAT2& objectCenter)const
+{
+	//an object on the lattice of the cells doesn't spill into its neighbours because of the rounding errors
+	return computeCellsRange(objectCenter - m_objectsHalfExtents, objectCenter + m_objectsHalfExtents, sk_cellsEpsilon, -sk_cellsEpsilon);
+}
+
+void GridBroadphase::clear()
+{
+	std::fill(m_perCellFirstEntry.begin(), m_perCellFirstEntry.end(), sk_invalidEntryIndex);
+
+	m_objectsCount = 0;
+	m_usedEntriesCount = 0;
+	m_firstFreeEntry = sk_invalidEntryIndex;
+}
+
+unsigned int GridBroadphase::allocateEntry()
+{
+	if (m_firstFreeEntry == sk_invalidEntryIndex)
+	{
+		assert(m_usedEntriesCount < m_entriesPool.size());
+		return m_usedEntriesCount++;
+	}
+
+	const unsigned int entryIndex = m_firstFreeEntry;
+	m_firstFreeEntry = m_entriesPool[entryIndex].nextEntry;
+
+	return entryIndex;
+}
+
+void GridBroadphase::freeEntry(unsigned int entryIndex)
+{
+	m_entriesPool[entryIndex].nextEntry = m_firstFreeEntry;
+	m_firstFreeEntry = entryIndex;
+}
\ No newline at end of file
@@ -0,0 +1,163 @@
+#pragma once
+#include "Engine.h"
+#include "MathCommon.h"
+#include "AABB.h"
+#include <vector>
+#include <cassert>
+
+namespace ArkanoidGame
+{
+	/*
+	a broadphase for objects of the same size, which are placed on a lattice: the area is split in cells of the objects size
+	and each cell links the objects overlapping it. build() aligns the cells to the first object, so the objects on its
+	lattice overlap one cell each and an object not larger than a cell touches at most 2x2 cells, found without any search.
+	the objects out of the lattice (as the spaced columns of bricks) overlap up to 2x2 cells, and a query spanning more
+	of them finds such an object only in the first cell they share.
+	it exposes the construction, insertion and query interface of Quadtree, so the two can be swapped.
+	*/
+	class GridBroadphase
+	{
+	public:
+		//ctors
+		//the cells cover the area wherever build() aligns them. the objects and the queries out of the area are clamped
+		//to its border cells. the cells entries are allocated for objectsCapacity objects, so insert() and build() don't allocate
+		explicit GridBroadphase(const AABB& area, const XMFLOAT2& objectsHalfExtents, unsigned int objectsCapacity);
+
+		//dtor
+		~GridBroadphase() = default;
+
+		//copy
+		GridBroadphase(const GridBroadphase&) = default;
+		GridBroadphase& operator=(const GridBroadphase&) = default;
+
+		//move
+		GridBroadphase(GridBroadphase&&) = default;
+		GridBroadphase& operator=(GridBroadphase&&) = default;
+
+		void insert(const XMFLOAT2& objectCenter, unsigned int objectData);
+
+		//replaces all the objects with the given ones, aligning the cells to the first of them.
+		//the area is not needed, the cells cover the one given to the constructor
+		void build(const AABB& area, const XMFLOAT2* objectsCenters, const unsigned int* objectsDatas, unsigned int objectsCount);
+
+		//the same as build(): the objects are linked to their cells in one pass anyway
+		void buildBulk(const AABB& area, const XMFLOAT2* objectsCenters, const unsigned int* objectsDatas, unsigned int objectsCount);
+
+		//foundObjects must point to an array of objectsCount() elements at least
+		//the number of objects actually found is returned
+		unsigned int findPotentialColliders(const AABB& objectAABB, unsigned int* foundObjects)const;
+
+		//objectCenter must be the one given to insert(). returns false if the object is not in the broadphase
+		bool remove(const XMFLOAT2& objectCenter, unsigned int objectData);
+
+		//returns false if the object is not in the broadphase
+		bool update(const XMFLOAT2& oldObjectCenter, const XMFLOAT2& newObjectCenter, unsigned int objectData);
+
+		unsigned int objectsCount()const;
+
+		unsigned int columnsCount()const;
+		unsigned int rowsCount()const;
+
+	private:
+		static constexpr unsigned int sk_invalidEntryIndex = ~0u;
+
+		//an object overlaps at most 2x2 cells
+		static constexpr unsigned int sk_maxCellsPerObject = 4;
+
+		//in cells units: the cells of an object are shrunk by it and the cells of a query are grown by twice it,
+		//so the rounding errors never drop the objects just touched, which AABB::intersects() reports
+		static constexpr float sk_cellsEpsilon = 0.001f;
+
+		struct CellEntry
+		{
+			unsigned int objectData;
+
+			//the first cell overlapped by the object, to report it only once
+			unsigned int objectFirstColumn;
+			unsigned int objectFirstRow;
+
+			unsigned int nextEntry;
+		};
+
+		struct CellsRange
+		{
+			unsigned int firstColumn;
+			unsigned int firstRow;
+			unsigned int lastColumn;
+			unsigned int lastRow;
+		};
+
+		//the cells touched by [min, max], from the first one whose far side is over min + minOffset
+		//to the last one whose near side is under max + maxOffset. minOffset and maxOffset are in cells units
+		CellsRange computeCellsRange(const XMFLOAT2& min, const XMFLOAT2& max, float minOffset, float maxOffset)const;
+
+		CellsRange computeObjectCellsRange(const XMFLOAT2& objectCenter)const;
+
+		void clear();
+
+		unsigned int allocateEntry();
+		void freeEntry(unsigned int entryIndex);
+
+		unsigned int cellIndex(unsigned int column, unsigned int row)const;
+
+		//one element per cell, row by row
+		std::vector<unsigned int> m_perCellFirstEntry;
+
+		//objectsCapacity * sk_maxCellsPerObject elements, sized by the constructor
+		std::vector<CellEntry> m_entriesPool;
+
+		XMFLOAT2 m_objectsHalfExtents;
+		XMFLOAT2 m_cellsSize;
+		XMFLOAT2 m_inverseCellsSize;
+
+		XMFLOAT2 m_areaMin;
+
+		//the corner of the first cell, within a cell from m_areaMin
+		XMFLOAT2 m_origin;
+
+		unsigned int m_columnsCount;
+		unsigned int m_rowsCount;
+
+		unsigned int m_objectsCount{ 0 };
+		unsigned int m_usedEntriesCount{ 0 }; //the entries after it have never been used
+		unsigned int m_firstFreeEntry{ sk_invalidEntryIndex }; //removed entries, linked through the pool
+	};
+
+	inline void GridBroadphase::buildBulk(const AABB& area, const XMFLOAT2* objectsCenters, const unsigned int* objectsDatas, unsigned int objectsCount)
+	{
+		build(area, objectsCenters, objectsDatas, objectsCount);
+	}
+
+	inline bool GridBroadphase::update(const XMFLOAT2& oldObjectCenter, const XMFLOAT2& newObjectCenter, unsigned int objectData)
+	{
+		if (!remove(oldObjectCenter, objectData))
+		{
+			return false;
+		}
+
+		insert(newObjectCenter, objectData);
+
+		return true;
+	}
+
+	inline unsigned int GridBroadphase::objectsCount()const
+	{
+		return m_objectsCount;
+	}
+
+	inline unsigned int GridBroadphase::columnsCount()const
+	{
+		return m_columnsCount;
+	}
+
+	inline unsigned int GridBroadphase::rowsCount()const
+	{
+		return m_rowsCount;
+	}
+
+	inline unsigned int GridBroadphase::cellIndex(unsigned int column, unsigned int row)const
+	{
+		assert(column < m_columnsCount && row < m_rowsCount);
+		return row * m_columnsCount + column;
+	}
+}
\ No newline at end of file
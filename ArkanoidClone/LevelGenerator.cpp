@@ -0,0 +1,205 @@
+#include "LevelGenerator.h"
+#include "GameplayConstants.h"
+#include <cassert>
+
+using namespace ArkanoidGame;
+
+static unsigned int placeBricksRowByRow(BricksLayout& bricksLayout)
+{
+	constexpr unsigned int columnsCount = gk_arenaWidth / static_cast<unsigned int>(gk_bricksWidth);
+	constexpr unsigned int rowsCount = gk_bricksCount / columnsCount;
+
+	XMFLOAT4 currPos{ gk_bricksHalfWidth, gk_arenaMaxY - gk_bricksHeight*2.0f, gk_bricksHalfWidth, gk_bricksHalfHeight };
+
+	unsigned int brickIndex = 0;
+
+	for (unsigned int row = 0; row < rowsCount; ++row)
+	{
+		const unsigned int brickTypeIndex = row % gk_brickTypesCount;
+
+		for (unsigned int column = 0; column < columnsCount / 2; ++column)
+		{
+			assert(brickIndex < gk_bricksCount);
+			unsigned int index = brickIndex++;
+
+			bricksLayout.transforms[index] = currPos;
+			bricksLayout.types[index] = brickTypeIndex;
+
+			assert(brickIndex < gk_bricksCount);
+			index = brickIndex++;
+
+			bricksLayout.transforms[index] = currPos;
+			//reflect about y axis
+			bricksLayout.transforms[index].x = -currPos.x;
+			bricksLayout.types[index] = brickTypeIndex;
+
+			currPos.x += gk_bricksWidth;
+		}
+		currPos.x = gk_bricksHalfWidth;
+		currPos.y -= gk_bricksHeight;
+	}
+
+	const XMFLOAT2 aabbMin{ static_cast<float>(gk_arenaMinX), currPos.y };
+	const XMFLOAT2 aabbMax{ static_cast<float>(gk_arenaMaxX), gk_arenaMaxY - gk_bricksHeight };
+
+	bricksLayout.aabb = AABB::computeFromMinMax(aabbMin, aabbMax);
+
+	return brickIndex;
+}
+
+static unsigned int placeBricksDiamond(BricksLayout& bricksLayout)
+{
+	unsigned int brickIndex = 0;
+
+	auto placeHalfDiamond = [&bricksLayout, &brickIndex](XMFLOAT4& currPos,
+														unsigned int rowsCount,
+														unsigned int columnsCount,
+														float rowIncrementMultiplier)
+	{
+		unsigned int currColumnsCount = columnsCount;
+		for (unsigned int row = 0; currColumnsCount > 0 && row < rowsCount; ++row)
+		{
+			const unsigned int brickTypeIndex = row % gk_brickTypesCount;
+
+			for (unsigned int column = 0; column < currColumnsCount/2; ++column)
+			{
+				assert(brickIndex < gk_bricksCount);
+				unsigned int index = brickIndex++;
+
+				bricksLayout.transforms[index] = currPos;
+				bricksLayout.types[index] = brickTypeIndex;
+
+				assert(brickIndex < gk_bricksCount);
+				index = brickIndex++;
+
+				bricksLayout.transforms[index] = currPos;
+				//reflect about y axis
+				bricksLayout.transforms[index].x = -currPos.x;
+				bricksLayout.types[index] = brickTypeIndex;
+
+				currPos.x += gk_bricksWidth;
+			}
+			currPos.x = gk_bricksHalfWidth;
+			currPos.y += rowIncrementMultiplier * gk_bricksHeight;
+			currColumnsCount -= 2;
+		}
+	};
+
+	constexpr unsigned int columnsCount = gk_arenaWidth / static_cast<unsigned int>(gk_bricksWidth);
+	constexpr unsigned int rowsCount = gk_bricksCount / columnsCount; //like a box
+	constexpr unsigned int halfRowsCount = rowsCount / 2;
+
+	const float startX = gk_bricksHalfWidth;
+	const float startY = gk_arenaMaxY - gk_bricksHeight*(halfRowsCount + 2);
+
+	XMFLOAT4 currPos{ startX, startY, gk_bricksHalfWidth, gk_bricksHalfHeight };
+
+	placeHalfDiamond(currPos, halfRowsCount, columnsCount, 1.0f);
+
+	const float maxY = currPos.y;
+
+	currPos.x = startX;
+	currPos.y = startY - gk_bricksHeight;
+
+	placeHalfDiamond(currPos, halfRowsCount, columnsCount, -1.0f);
+
+	const XMFLOAT2 aabbMin{ static_cast<float>(gk_arenaMinX), currPos.y };
+	const XMFLOAT2 aabbMax{ static_cast<float>(gk_arenaMaxX), maxY };
+
+	bricksLayout.aabb = AABB::computeFromMinMax(aabbMin, aabbMax);
+
+	return brickIndex;
+}
+
+static unsigned int placeBricksColumnsByColumns(BricksLayout& bricksLayout)
+{
+	constexpr unsigned int availableColumnsCount = gk_arenaWidth / static_cast<unsigned int>(gk_bricksWidth);
+	constexpr unsigned int columnsCount = 6;
+	constexpr unsigned int rowsCount = gk_bricksCount / columnsCount;
+
+	constexpr float columnsSpacing = gk_bricksWidth *( static_cast<float>(availableColumnsCount - columnsCount)/(columnsCount - 1) + 1.0f);
+
+	constexpr float startX = gk_arenaMinX + gk_bricksHalfWidth;
+
+	XMFLOAT4 currPos{ startX, gk_arenaMaxY - gk_bricksHeight*2.0f, gk_bricksHalfWidth, gk_bricksHalfHeight };
+
+	unsigned int brickIndex = 0;
+
+	for (unsigned int row = 0; row < rowsCount; ++row)
+	{
+		const unsigned int brickTypeIndex = row % gk_brickTypesCount;
+
+		for (unsigned int column = 0; column < columnsCount; ++column)
+		{
+			assert(brickIndex < gk_bricksCount);
+			unsigned int index = brickIndex++;
+
+			bricksLayout.transforms[index] = currPos;
+			bricksLayout.types[index] = brickTypeIndex;
+
+			currPos.x += columnsSpacing;
+		}
+		currPos.x = startX;
+		currPos.y -= gk_bricksHeight;
+	}
+
+	const XMFLOAT2 aabbMin{ static_cast<float>(gk_arenaMinX), currPos.y };
+	const XMFLOAT2 aabbMax{ static_cast<float>(gk_arenaMaxX), static_cast<float>(gk_arenaMaxY) - gk_bricksHeight };
+
+	bricksLayout.aabb = AABB::computeFromMinMax(aabbMin, aabbMax);
+
+	return brickIndex;
+}
+
+using BricksPlacerFunction = unsigned int(*)(BricksLayout&);
+
+static constexpr BricksPlacerFunction gk_bricksPlacers[] =
+{
+	&placeBricksRowByRow,
+	&placeBricksDiamond,
+	&placeBricksColumnsByColumns
+};
+
+static constexpr unsigned int gk_bricksPlacersCount = sizeof(gk_bricksPlacers) / sizeof(BricksPlacerFunction);
+
+static_assert(gk_bricksPlacersCount == gk_bricksLayoutsCount, "a bricks layout for each placer");
+
+void ArkanoidGame::generateBricksLayout(std::minstd_rand& randomEngine, BricksLayout& bricksLayout)
+{
+	const unsigned int bricksPlacerFunctionIndex = randomEngine() % gk_bricksPlacersCount;
+	bricksLayout.placedBricksCount = gk_bricksPlacers[bricksPlacerFunctionIndex](bricksLayout);
+	bricksLayout.layoutIndex = bricksPlacerFunctionIndex;
+}
+
+unsigned int ArkanoidGame::generateNextBonusBricksHitCount(std::minstd_rand& randomEngine)
+{
+	return (randomEngine() % gk_maxBonusBricksHitCount) + 1;
+}
+
+XMFLOAT4 ArkanoidGame::startBallTransform()
+{
+	return XMFLOAT4{ 0.0f, static_cast<float>(gk_arenaMinY) + 1.0f + 1.0f, gk_ballHalfWidth, gk_ballHalfHeight };
+}
+
+XMFLOAT2 ArkanoidGame::startBallVelocity()
+{
+	XMFLOAT2 startBallVelocity;
+	XMVECTOR ballVelocity = XMVectorScale(XMVector2Normalize(XMVectorSet(gk_startBallVelocityX, gk_startBallVelocityY, 0.0f, 0.0f)), gk_startBallSpeed);
+	XMStoreFloat2(&startBallVelocity, ballVelocity);
+	return startBallVelocity;
+}
+
+XMFLOAT4 ArkanoidGame::startPlayerTransform()
+{
+	return XMFLOAT4{ 0.0f, static_cast<float>(gk_arenaMinY), gk_playerHalfWidth, gk_playerHalfHeight };
+}
+
+XMFLOAT4 ArkanoidGame::startArenaTransform()
+{
+	return XMFLOAT4{ 0.0f, 0.0f, static_cast<float>(gk_arenaMaxX + 1.5f), static_cast<float>(gk_arenaMaxY + 1.5f) };
+}
+
+XMFLOAT4 ArkanoidGame::startBonusTransform()
+{
+	return XMFLOAT4{ gk_outOfArenaX, 0.0f, gk_bonusHalfWidth, gk_bonusHalfHeight };
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+#include "Engine.h"
+#include "MathCommon.h"
+#include "Dimensions.h"
+#include "AABB.h"
+#include <random>
+
+namespace ArkanoidGame
+{
+	//the bricks of a new level, in placement order: only the first placedBricksCount elements are meaningful
+	struct BricksLayout
+	{
+		XMFLOAT4 transforms[gk_bricksCount];
+		unsigned int types[gk_bricksCount];
+		unsigned int placedBricksCount;
+		AABB aabb; //bounds of the placed bricks
+		unsigned int layoutIndex; //which of the gk_bricksLayoutsCount layouts
+	};
+
+	constexpr unsigned int gk_bricksLayoutsCount = 3;
+
+	//the level setup shared by every simulation, so that the same random engine state gives the same level
+
+	//picks randomly one of the bricks layouts
+	void generateBricksLayout(std::minstd_rand& randomEngine, BricksLayout& bricksLayout);
+
+	unsigned int generateNextBonusBricksHitCount(std::minstd_rand& randomEngine);
+
+	XMFLOAT4 startBallTransform();
+	XMFLOAT2 startBallVelocity();
+	XMFLOAT4 startPlayerTransform();
+	XMFLOAT4 startArenaTransform();
+	XMFLOAT4 startBonusTransform();
+}
\ No newline at end of file
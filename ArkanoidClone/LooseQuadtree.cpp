@@ -0,0 +1,6 @@
+#include "LooseQuadtree.h"
+
+#ifdef _DEBUG
+//explicit instantiation to find compilation errors
+template class ArkanoidGame::LooseQuadtree<>;
+#endif
\ No newline at end of file
@@ -0,0 +1,480 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include "QuadtreeHelper.h"
+#include "MathHelper.h"
+#include "AABB.h"
+
+namespace ArkanoidGame
+{
+	/*
+	a quadtree for moving objects, each one with its own half extents, where all the quadrants always exist.
+	an object is placed at the deepest depth whose quadrants are at least as big as it, in the quadrant containing its center,
+	and the quadrant holds the objects within its loose bounds: the quadrant grown by half of its size on each side.
+	an object stays in its quadrant while it moves within the loose bounds, so update() is a few compares for most of the
+	moves and a relink in two lists otherwise: the quadtree is never rebuilt.
+	a query scans, at each depth, the few quadrants whose loose bounds can touch it, as a grid per depth: no tree is descended.
+	the objects outside the area are kept by the border quadrants, or by the root when they stick out of their loose bounds
+	*/
+	template<typename ObjectData = unsigned int, unsigned int MAX_DEPTH = 4>
+	class LooseQuadtree
+	{
+	public:
+		static constexpr unsigned int sk_invalidObjectId = ~0u;
+
+		//ctors
+		//at most objectsCapacity objects can be inserted
+		explicit LooseQuadtree(const AABB& quadtreeArea, unsigned int objectsCapacity);
+
+		//dtor
+		~LooseQuadtree() = default;
+
+		//copy
+		LooseQuadtree(const LooseQuadtree&) = default;
+		LooseQuadtree& operator=(const LooseQuadtree&) = default;
+
+		//move
+		LooseQuadtree(LooseQuadtree&&) = default;
+		LooseQuadtree& operator=(LooseQuadtree&&) = default;
+
+		//returns the id of the object, valid until remove() or clear()
+		unsigned int insert(const XMFLOAT2& objectCenter, const XMFLOAT2& objectHalfExtents, const ObjectData& objectData);
+
+		//moves the object, relocating it only if it leaves the loose bounds of its quadrant or it can go deeper.
+		//returns true if the object has been relocated
+		bool update(unsigned int objectId, const XMFLOAT2& newObjectCenter);
+
+		void remove(unsigned int objectId);
+
+		//foundObjects must point to an array of ObjectData which size is enough to contain all the objects.
+		//only the objects touching objectAABB, as AABB::intersects() tells, are found.
+		//the number of objects actually found is returned
+		unsigned int findPotentialColliders(const AABB& objectAABB, ObjectData* foundObjects)const;
+
+		//removes all the objects, keeping the pool
+		void clear();
+
+		const XMFLOAT2& objectCenter(unsigned int objectId)const;
+		const XMFLOAT2& objectHalfExtents(unsigned int objectId)const;
+		const ObjectData& objectData(unsigned int objectId)const;
+
+		unsigned int objectsCapacity()const;
+		unsigned int objectsCount()const;
+
+		//the update() calls which relocated the object, since the construction
+		unsigned long long relocationsCount()const;
+
+	private:
+		static constexpr unsigned int sk_maxDepth = MAX_DEPTH;
+		static constexpr unsigned int sk_maxQuadrantsCount = quadrantsCount(sk_maxDepth);
+
+		//the loose bounds tested by a query are grown by it, so the rounding errors never drop the objects just touched
+		static constexpr float sk_looseMargin = 0.001f;
+
+		struct PooledObject
+		{
+			XMFLOAT2 center;
+			XMFLOAT2 halfExtents;
+			XMFLOAT2 quadrantCenter; //of the quadrant holding the object, so update() needs not to compute it
+			ObjectData data;
+			unsigned int quadrantIndex;
+			unsigned int depth; //of the quadrant holding the object
+			unsigned int preferredDepth; //the deepest one whose quadrants are at least as big as the object
+			unsigned int previousObject;
+			unsigned int nextObject; //the next free object for the removed objects
+		};
+
+		//the quadrants of a depth follow the ones of the depth before, row by row
+		static unsigned int quadrantIndex(unsigned int depth, unsigned int cellX, unsigned int cellY);
+
+		//finds the deepest quadrant, up to the preferred depth of the object, whose loose bounds contain it
+		void placeObject(PooledObject& object)const;
+
+		//true if the object is within the loose bounds of the quadrant centered in quadrantCenter, at depth
+		bool isWithinLooseBounds(const XMFLOAT2& objectCenter, const XMFLOAT2& objectHalfExtents,
+								 const XMFLOAT2& quadrantCenter, unsigned int depth)const;
+
+		//the cell of the quadrant containing coordinate at depth, clamped to the area
+		unsigned int clampedCellIndex(float coordinate, float areaMin, float quadrantSize, unsigned int depth)const;
+
+		//link and unlink also count the object in the objects of its depth
+		void linkObject(unsigned int objectId);
+		void unlinkObject(unsigned int objectId);
+
+		PooledObject& pooledObject(unsigned int objectId);
+		const PooledObject& pooledObject(unsigned int objectId)const;
+
+		std::vector<PooledObject> m_objectsPool;
+
+		unsigned int m_perQuadrantFirstObject[sk_maxQuadrantsCount];
+
+		XMFLOAT2 m_areaMin;
+		XMFLOAT2 m_perDepthQuadrantSize[sk_maxDepth + 1]; //from depth == 0 (entire area) to sk_maxDepth inclusive
+
+		//the queries skip the depths without objects
+		unsigned int m_perDepthObjectsCount[sk_maxDepth + 1];
+
+		unsigned int m_objectsCount{ 0 };
+		unsigned int m_firstFreeObject{ sk_invalidObjectId };
+
+		unsigned long long m_relocationsCount{ 0 };
+	};
+
+	//LooseQuadtree implementation
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	constexpr unsigned int LooseQuadtree<ObjectData, MAX_DEPTH>::sk_invalidObjectId;
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	inline
+		LooseQuadtree<ObjectData, MAX_DEPTH>::
+			LooseQuadtree(const AABB& quadtreeArea, unsigned int objectsCapacity) : m_objectsPool(objectsCapacity),
+																					m_areaMin{ quadtreeArea.min() }
+	{
+		XMFLOAT2 currQuadrantSize = quadtreeArea.max() - quadtreeArea.min();
+		for (unsigned int depth = 0; depth <= sk_maxDepth; ++depth)
+		{
+			m_perDepthQuadrantSize[depth] = currQuadrantSize;
+			currQuadrantSize = currQuadrantSize * 0.5f;
+		}
+
+		clear();
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	inline
+		unsigned int
+			LooseQuadtree<ObjectData, MAX_DEPTH>::insert(const XMFLOAT2& objectCenter, const XMFLOAT2& objectHalfExtents,
+														 const ObjectData& objectData)
+	{
+		assert(m_firstFreeObject != sk_invalidObjectId);
+		assert(objectHalfExtents.x > 0.0f && objectHalfExtents.y > 0.0f);
+
+		const unsigned int objectId = m_firstFreeObject;
+		PooledObject& object = pooledObject(objectId);
+		m_firstFreeObject = object.nextObject;
+
+		object.center = objectCenter;
+		object.halfExtents = objectHalfExtents;
+		object.data = objectData;
+
+		unsigned int preferredDepth = 0;
+		while (preferredDepth < sk_maxDepth)
+		{
+			const XMFLOAT2& childrenSize = m_perDepthQuadrantSize[preferredDepth + 1];
+			if (objectHalfExtents.x * 2.0f > childrenSize.x || objectHalfExtents.y * 2.0f > childrenSize.y)
+			{
+				break;
+			}
+			++preferredDepth;
+		}
+
+		object.preferredDepth = preferredDepth;
+
+		placeObject(object);
+		linkObject(objectId);
+
+		++m_objectsCount;
+
+		return objectId;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	inline
+		bool
+			LooseQuadtree<ObjectData, MAX_DEPTH>::update(unsigned int objectId, const XMFLOAT2& newObjectCenter)
+	{
+		PooledObject& object = pooledObject(objectId);
+		object.center = newObjectCenter;
+
+		if (object.depth == object.preferredDepth &&
+			isWithinLooseBounds(newObjectCenter, object.halfExtents, object.quadrantCenter, object.depth))
+		{
+			return false;
+		}
+
+		//an object placed shallower, because it was outside the area, tries to go deeper again
+		const unsigned int oldQuadrantIndex = object.quadrantIndex;
+
+		unlinkObject(objectId);
+		placeObject(object);
+		linkObject(objectId);
+
+		if (object.quadrantIndex == oldQuadrantIndex)
+		{
+			return false;
+		}
+
+		++m_relocationsCount;
+
+		return true;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	inline
+		void
+			LooseQuadtree<ObjectData, MAX_DEPTH>::remove(unsigned int objectId)
+	{
+		unlinkObject(objectId);
+
+		pooledObject(objectId).nextObject = m_firstFreeObject;
+		m_firstFreeObject = objectId;
+
+		--m_objectsCount;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	inline
+		unsigned int
+			LooseQuadtree<ObjectData, MAX_DEPTH>::findPotentialColliders(const AABB& objectAABB, ObjectData* foundObjects)const
+	{
+		assert(foundObjects != nullptr);
+
+		const XMFLOAT2& center = objectAABB.center();
+		const XMFLOAT2& halfExtents = objectAABB.halfExtents();
+
+		unsigned int foundObjectsCount = 0;
+
+		for (unsigned int depth = 0; depth <= sk_maxDepth; ++depth)
+		{
+			if (m_perDepthObjectsCount[depth] == 0)
+			{
+				continue;
+			}
+
+			/*
+			the loose bounds of a quadrant have half extents as big as the quadrant, so the objects it holds can touch
+			the query only if its center is within halfExtents + quadrantSize of the query center
+			*/
+			const XMFLOAT2& quadrantSize = m_perDepthQuadrantSize[depth];
+
+			const unsigned int firstCellX = clampedCellIndex(center.x - halfExtents.x - quadrantSize.x * 1.5f - sk_looseMargin, m_areaMin.x, quadrantSize.x, depth);
+			const unsigned int lastCellX = clampedCellIndex(center.x + halfExtents.x + quadrantSize.x * 0.5f + sk_looseMargin, m_areaMin.x, quadrantSize.x, depth);
+			const unsigned int firstCellY = clampedCellIndex(center.y - halfExtents.y - quadrantSize.y * 1.5f - sk_looseMargin, m_areaMin.y, quadrantSize.y, depth);
+			const unsigned int lastCellY = clampedCellIndex(center.y + halfExtents.y + quadrantSize.y * 0.5f + sk_looseMargin, m_areaMin.y, quadrantSize.y, depth);
+
+			for (unsigned int cellY = firstCellY; cellY <= lastCellY; ++cellY)
+			{
+				for (unsigned int cellX = firstCellX; cellX <= lastCellX; ++cellX)
+				{
+					for (unsigned int objectId = m_perQuadrantFirstObject[quadrantIndex(depth, cellX, cellY)]; objectId != sk_invalidObjectId;)
+					{
+						const PooledObject& object = pooledObject(objectId);
+
+						const bool xIntersects = lessEqualf(std::abs(center.x - object.center.x), halfExtents.x + object.halfExtents.x);
+						const bool yIntersects = lessEqualf(std::abs(center.y - object.center.y), halfExtents.y + object.halfExtents.y);
+
+						foundObjects[foundObjectsCount] = object.data;
+						foundObjectsCount += static_cast<unsigned int>(xIntersects) & static_cast<unsigned int>(yIntersects);
+
+						objectId = object.nextObject;
+					}
+				}
+			}
+		}
+
+		return foundObjectsCount;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	inline
+		void
+			LooseQuadtree<ObjectData, MAX_DEPTH>::clear()
+	{
+		std::fill(std::begin(m_perQuadrantFirstObject), std::end(m_perQuadrantFirstObject), sk_invalidObjectId);
+		std::fill(std::begin(m_perDepthObjectsCount), std::end(m_perDepthObjectsCount), 0u);
+
+		//the free objects are linked in increasing order, so the ids are given as the pool slots
+		m_firstFreeObject = sk_invalidObjectId;
+		for (unsigned int objectId = objectsCapacity(); objectId > 0; --objectId)
+		{
+			pooledObject(objectId - 1).nextObject = m_firstFreeObject;
+			m_firstFreeObject = objectId - 1;
+		}
+
+		m_objectsCount = 0;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	inline
+		const XMFLOAT2&
+			LooseQuadtree<ObjectData, MAX_DEPTH>::objectCenter(unsigned int objectId)const
+	{
+		return pooledObject(objectId).center;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	inline
+		const XMFLOAT2&
+			LooseQuadtree<ObjectData, MAX_DEPTH>::objectHalfExtents(unsigned int objectId)const
+	{
+		return pooledObject(objectId).halfExtents;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	inline
+		const ObjectData&
+			LooseQuadtree<ObjectData, MAX_DEPTH>::objectData(unsigned int objectId)const
+	{
+		return pooledObject(objectId).data;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	inline
+		unsigned int
+			LooseQuadtree<ObjectData, MAX_DEPTH>::objectsCapacity()const
+	{
+		return static_cast<unsigned int>(m_objectsPool.size());
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	inline
+		unsigned int
+			LooseQuadtree<ObjectData, MAX_DEPTH>::objectsCount()const
+	{
+		return m_objectsCount;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	inline
+		unsigned long long
+			LooseQuadtree<ObjectData, MAX_DEPTH>::relocationsCount()const
+	{
+		return m_relocationsCount;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	inline
+		unsigned int
+			LooseQuadtree<ObjectData, MAX_DEPTH>::quadrantIndex(unsigned int depth, unsigned int cellX, unsigned int cellY)
+	{
+		assert(depth <= sk_maxDepth);
+		assert(cellX < (1u << depth) && cellY < (1u << depth));
+
+		//the quadrants of the depths before: (4^depth - 1) / 3
+		return ((1u << (2 * depth)) - 1) / 3 + (cellY << depth) + cellX;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	inline
+		void
+			LooseQuadtree<ObjectData, MAX_DEPTH>::placeObject(PooledObject& object)const
+	{
+		unsigned int depth = object.preferredDepth;
+
+		while (true)
+		{
+			const XMFLOAT2& quadrantSize = m_perDepthQuadrantSize[depth];
+
+			const unsigned int cellX = clampedCellIndex(object.center.x, m_areaMin.x, quadrantSize.x, depth);
+			const unsigned int cellY = clampedCellIndex(object.center.y, m_areaMin.y, quadrantSize.y, depth);
+
+			const XMFLOAT2 quadrantCenter{ m_areaMin.x + (static_cast<float>(cellX) + 0.5f) * quadrantSize.x,
+										   m_areaMin.y + (static_cast<float>(cellY) + 0.5f) * quadrantSize.y };
+
+			//the center is in the quadrant and the object is not bigger than it, unless the center has been clamped to the area
+			if (depth == 0 || isWithinLooseBounds(object.center, object.halfExtents, quadrantCenter, depth))
+			{
+				object.quadrantIndex = quadrantIndex(depth, cellX, cellY);
+				object.quadrantCenter = quadrantCenter;
+				object.depth = depth;
+				return;
+			}
+
+			--depth;
+		}
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	inline
+		bool
+			LooseQuadtree<ObjectData, MAX_DEPTH>::isWithinLooseBounds(const XMFLOAT2& objectCenter, const XMFLOAT2& objectHalfExtents,
+																	   const XMFLOAT2& quadrantCenter, unsigned int depth)const
+	{
+		const XMFLOAT2& quadrantSize = m_perDepthQuadrantSize[depth];
+
+		const bool xWithin = std::abs(objectCenter.x - quadrantCenter.x) + objectHalfExtents.x <= quadrantSize.x;
+		const bool yWithin = std::abs(objectCenter.y - quadrantCenter.y) + objectHalfExtents.y <= quadrantSize.y;
+
+		return (static_cast<unsigned int>(xWithin) & static_cast<unsigned int>(yWithin)) == 1;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	inline
+		unsigned int
+			LooseQuadtree<ObjectData, MAX_DEPTH>::clampedCellIndex(float coordinate, float areaMin, float quadrantSize,
+																   unsigned int depth)const
+	{
+		//clamped before the conversion, so the objects far outside the area never overflow it
+		const float lastCell = static_cast<float>((1u << depth) - 1);
+		const float cell = std::min(std::max((coordinate - areaMin) / quadrantSize, 0.0f), lastCell);
+		return static_cast<unsigned int>(cell);
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	inline
+		void
+			LooseQuadtree<ObjectData, MAX_DEPTH>::linkObject(unsigned int objectId)
+	{
+		PooledObject& object = pooledObject(objectId);
+
+		unsigned int& firstObject = m_perQuadrantFirstObject[object.quadrantIndex];
+
+		object.previousObject = sk_invalidObjectId;
+		object.nextObject = firstObject;
+
+		if (firstObject != sk_invalidObjectId)
+		{
+			pooledObject(firstObject).previousObject = objectId;
+		}
+
+		firstObject = objectId;
+
+		++m_perDepthObjectsCount[object.depth];
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	inline
+		void
+			LooseQuadtree<ObjectData, MAX_DEPTH>::unlinkObject(unsigned int objectId)
+	{
+		PooledObject& object = pooledObject(objectId);
+
+		if (object.previousObject != sk_invalidObjectId)
+		{
+			pooledObject(object.previousObject).nextObject = object.nextObject;
+		}
+		else
+		{
+			assert(m_perQuadrantFirstObject[object.quadrantIndex] == objectId);
+			m_perQuadrantFirstObject[object.quadrantIndex] = object.nextObject;
+		}
+
+		if (object.nextObject != sk_invalidObjectId)
+		{
+			pooledObject(object.nextObject).previousObject = object.previousObject;
+		}
+
+		assert(m_perDepthObjectsCount[object.depth] > 0);
+		--m_perDepthObjectsCount[object.depth];
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	inline
+		typename LooseQuadtree<ObjectData, MAX_DEPTH>::PooledObject&
+			LooseQuadtree<ObjectData, MAX_DEPTH>::pooledObject(unsigned int objectId)
+	{
+		assert(objectId < objectsCapacity());
+		return m_objectsPool[objectId];
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	inline
+		const typename LooseQuadtree<ObjectData, MAX_DEPTH>::PooledObject&
+			LooseQuadtree<ObjectData, MAX_DEPTH>::pooledObject(unsigned int objectId)const
+	{
+		assert(objectId < objectsCapacity());
+		return m_objectsPool[objectId];
+	}
+}
\ No newline at end of file
@@ -0,0 +1,566 @@
+#include "MultiBallSimulation.h"
+#include "GameplayConstants.h"
+#include "LevelGenerator.h"
+#include "SimulationRules.h"
+#include <algorithm>
+
+using namespace ArkanoidGame;
+
+static SimulationCore::BricksBroadphase createBricksBroadphase(const XMFLOAT2& bricksHalfExtents)
+{
+	const AABB arenaAABB = AABB::computeFromCenterAndHalfExtents(XMFLOAT2{ 0.0f, 0.0f },
+																 XMFLOAT2{ static_cast<float>(gk_arenaHalfWidth),
+																		   static_cast<float>(gk_arenaHalfHeight) });
+	SimulationCore::BricksBroadphase bricksBroadphase{ arenaAABB, bricksHalfExtents, gk_bricksCount, SimulationCore::sk_defaultBricksBroadphaseType };
+	bricksBroadphase.quadtreeSubdivisionPolicy().setSubdivisionSettings(SimulationCore::defaultBricksSubdivision());
+	return bricksBroadphase;
+}
+
+//a ball of the structure of arrays
+class MultiBallSimulation::BallState
+{
+public:
+	//ctors
+	explicit BallState(float& ballX, float& ballY, float& ballVelocityX, float& ballVelocityY);
+
+	float& ballX();
+	float& ballY();
+	float& ballVelocityX();
+	float& ballVelocityY();
+
+private:
+	float& m_ballX;
+	float& m_ballY;
+	float& m_ballVelocityX;
+	float& m_ballVelocityY;
+};
+
+inline MultiBallSimulation::BallState::BallState(float& ballX, float& ballY, float& ballVelocityX, float& ballVelocityY) : m_ballX(ballX),
+																															m_ballY(ballY),
+																															m_ballVelocityX(ballVelocityX),
+																															m_ballVelocityY(ballVelocityY)
+{
+}
+
+inline float& MultiBallSimulation::BallState::ballX()
+{
+	return m_ballX;
+}
+
+inline float& MultiBallSimulation::BallState::ballY()
+{
+	return m_ballY;
+}
+
+inline float& MultiBallSimulation::BallState::ballVelocityX()
+{
+	return m_ballVelocityX;
+}
+
+inline float& MultiBallSimulation::BallState::ballVelocityY()
+{
+	return m_ballVelocityY;
+}
+
+//the game seen from one of the balls, the one hitting the bricks
+class MultiBallSimulation::GameState
+{
+public:
+	//ctors
+	explicit GameState(MultiBallSimulation& simulation, unsigned int ballIndex);
+
+	float& ballX();
+	float& ballY();
+	float& ballVelocityX();
+	float& ballVelocityY();
+
+	float& bonusX();
+	float& bonusY();
+	bool isBonusAlive()const;
+	void setBonusAlive(bool alive);
+	unsigned int& bonusBricksHit();
+	unsigned int& nextBonusBricksHitCount();
+	std::minstd_rand& randomEngine();
+
+	XMFLOAT2 brickPosition(unsigned int brickIndex)const;
+	unsigned int& brickRemainingHits(unsigned int brickIndex);
+	void destroyBrick(unsigned int brickIndex);
+	unsigned int findTouchingBrick(const AABB& ballAABB);
+
+private:
+	MultiBallSimulation& m_simulation;
+	unsigned int m_ballIndex;
+};
+
+inline MultiBallSimulation::GameState::GameState(MultiBallSimulation& simulation, unsigned int ballIndex) : m_simulation(simulation),
+																										   m_ballIndex{ ballIndex }
+{
+	assert(ballIndex < simulation.ballsCount());
+}
+
+inline float& MultiBallSimulation::GameState::ballX()
+{
+	return m_simulation.m_ballsX[m_ballIndex];
+}
+
+inline float& MultiBallSimulation::GameState::ballY()
+{
+	return m_simulation.m_ballsY[m_ballIndex];
+}
+
+inline float& MultiBallSimulation::GameState::ballVelocityX()
+{
+	return m_simulation.m_ballsVelocityX[m_ballIndex];
+}
+
+inline float& MultiBallSimulation::GameState::ballVelocityY()
+{
+	return m_simulation.m_ballsVelocityY[m_ballIndex];
+}
+
+inline float& MultiBallSimulation::GameState::bonusX()
+{
+	return m_simulation.m_bonusX;
+}
+
+inline float& MultiBallSimulation::GameState::bonusY()
+{
+	return m_simulation.m_bonusY;
+}
+
+inline bool MultiBallSimulation::GameState::isBonusAlive()const
+{
+	return m_simulation.m_bonusAlive;
+}
+
+inline void MultiBallSimulation::GameState::setBonusAlive(bool alive)
+{
+	m_simulation.m_bonusAlive = alive;
+}
+
+inline unsigned int& MultiBallSimulation::GameState::bonusBricksHit()
+{
+	return m_simulation.m_bonusBricksHit;
+}
+
+inline unsigned int& MultiBallSimulation::GameState::nextBonusBricksHitCount()
+{
+	return m_simulation.m_nextBonusBricksHitCount;
+}
+
+inline std::minstd_rand& MultiBallSimulation::GameState::randomEngine()
+{
+	return m_simulation.m_randomEngine;
+}
+
+inline XMFLOAT2 MultiBallSimulation::GameState::brickPosition(unsigned int brickIndex)const
+{
+	return m_simulation.brickPosition(brickIndex);
+}
+
+inline unsigned int& MultiBallSimulation::GameState::brickRemainingHits(unsigned int brickIndex)
+{
+	assert(brickIndex < gk_bricksCount);
+	return m_simulation.m_bricksRemainingHits[brickIndex];
+}
+
+inline void MultiBallSimulation::GameState::destroyBrick(unsigned int brickIndex)
+{
+	m_simulation.destroyBrick(brickIndex);
+}
+
+inline unsigned int MultiBallSimulation::GameState::findTouchingBrick(const AABB& ballAABB)
+{
+	return m_simulation.findTouchingBrick(ballAABB);
+}
+
+MultiBallSimulation::MultiBallSimulation(unsigned int randomSeed, unsigned int ballsCapacity) : m_ballsCapacity{ ballsCapacity },
+																								m_bricksBroadphase{ createBricksBroadphase(gk_bricksHalfExtents) },
+																								m_randomEngine{ randomSeed }
+{
+	assert(ballsCapacity > 0);
+
+	m_ballsX.reserve(ballsCapacity);
+	m_ballsY.reserve(ballsCapacity);
+	m_ballsVelocityX.reserve(ballsCapacity);
+	m_ballsVelocityY.reserve(ballsCapacity);
+	m_ballsHalfWidths.reserve(ballsCapacity);
+	m_ballsHalfHeights.reserve(ballsCapacity);
+
+	m_lastBallsX.resize(ballsCapacity);
+	m_lastBallsY.resize(ballsCapacity);
+	m_movedBallsX.resize(ballsCapacity);
+	m_movedBallsY.resize(ballsCapacity);
+	m_ballsTouchingPlayer.resize(ballsCapacity);
+	m_bricksCandidateBalls.resize(ballsCapacity);
+
+	restartLevel();
+}
+
+void MultiBallSimulation::restartLevel()
+{
+	placeBricks();
+
+	//balls
+	m_ballsX.clear();
+	m_ballsY.clear();
+	m_ballsVelocityX.clear();
+	m_ballsVelocityY.clear();
+	m_ballsHalfWidths.clear();
+	m_ballsHalfHeights.clear();
+
+	const XMFLOAT4 ballTransform = startBallTransform();
+	addBall(XMFLOAT2{ ballTransform.x, ballTransform.y }, startBallVelocity(), XMFLOAT2{ ballTransform.z, ballTransform.w });
+
+	//player
+	m_playerX = startPlayerTransform().x;
+
+	//bonus
+	const XMFLOAT4 bonusTransform = startBonusTransform();
+	m_bonusX = bonusTransform.x;
+	m_bonusY = bonusTransform.y;
+
+	m_bonusAlive = false;
+	m_bonusBricksHit = 0;
+	m_nextBonusBricksHitCount = generateNextBonusBricksHitCount(m_randomEngine);
+}
+
+bool MultiBallSimulation::addBall(const XMFLOAT2& position, const XMFLOAT2& velocity, const XMFLOAT2& halfExtents)
+{
+	assert(halfExtents.x > 0.0f && halfExtents.y > 0.0f);
+
+	if (ballsCount() == m_ballsCapacity)
+	{
+		return false;
+	}
+
+	m_ballsX.push_back(position.x);
+	m_ballsY.push_back(position.y);
+	m_ballsVelocityX.push_back(velocity.x);
+	m_ballsVelocityY.push_back(velocity.y);
+	m_ballsHalfWidths.push_back(halfExtents.x);
+	m_ballsHalfHeights.push_back(halfExtents.y);
+
+	return true;
+}
+
+void MultiBallSimulation::placeBricks()
+{
+	BricksLayout bricksLayout;
+	generateBricksLayout(m_randomEngine, bricksLayout);
+
+	const unsigned int placedBricks = bricksLayout.placedBricksCount;
+
+	XMFLOAT2 bricksCenters[gk_bricksCount];
+	unsigned int bricksIndices[gk_bricksCount];
+
+	XMFLOAT2 bricksMin{ gk_outOfArenaX, gk_outOfArenaY };
+	XMFLOAT2 bricksMax{ -gk_outOfArenaX, -gk_outOfArenaY };
+
+	for (unsigned int brickIndex = 0; brickIndex < gk_bricksCount; ++brickIndex)
+	{
+		if (brickIndex < placedBricks)
+		{
+			const unsigned int brickTypeIndex = bricksLayout.types[brickIndex];
+			assert(brickTypeIndex < gk_brickTypesCount);
+
+			m_bricksX[brickIndex] = bricksLayout.transforms[brickIndex].x;
+			m_bricksY[brickIndex] = bricksLayout.transforms[brickIndex].y;
+			m_bricksTypes[brickIndex] = brickTypeIndex;
+			m_bricksRemainingHits[brickIndex] = gk_bricksHitsCounts[brickTypeIndex];
+
+			bricksCenters[brickIndex] = XMFLOAT2{ m_bricksX[brickIndex], m_bricksY[brickIndex] };
+			bricksIndices[brickIndex] = brickIndex;
+
+			bricksMin = XMFLOAT2{ std::min(bricksMin.x, m_bricksX[brickIndex]), std::min(bricksMin.y, m_bricksY[brickIndex]) };
+			bricksMax = XMFLOAT2{ std::max(bricksMax.x, m_bricksX[brickIndex]), std::max(bricksMax.y, m_bricksY[brickIndex]) };
+		}
+		else
+		{
+			//hide unplaced bricks, like SimulationCore the y is left untouched
+			m_bricksX[brickIndex] = gk_outOfArenaX;
+			m_bricksRemainingHits[brickIndex] = 0;
+		}
+	}
+
+	m_bricksBroadphase.buildBulk(bricksLayout.aabb, bricksCenters, bricksIndices, placedBricks);
+
+	m_aliveBricks.setFirst(placedBricks);
+
+	//the bricks AABB only discards the balls which can't touch a brick, so it is grown to be safe from the rounding errors
+	const XMFLOAT2 margin{ 1.0f, 1.0f };
+
+	if (placedBricks == 0)
+	{
+		m_bricksAABB = AABB::computeFromCenterAndHalfExtents(XMFLOAT2{ gk_outOfArenaX, gk_outOfArenaY }, margin);
+		return;
+	}
+
+	m_bricksAABB = AABB::computeFromMinMax(bricksMin - gk_bricksHalfExtents - margin, bricksMax + gk_bricksHalfExtents + margin);
+}
+
+bool MultiBallSimulation::step(float deltaTime, unsigned int inputFlags)
+{
+	//the rules of SimulationCore::step(), in the same order, applied to each ball
+
+	//there is always a ball at the start of the step. the player and the bonus rules don't reach it
+	GameState state{ *this, 0 };
+
+	SimulationRules::movePlayer(m_playerX, deltaTime, inputFlags);
+	SimulationRules::moveBonus(state, deltaTime);
+
+	//balls
+	moveBalls(deltaTime);
+	removeLostBalls();
+
+	if (ballsCount() == 0)
+	{
+		restartLevel();
+		return true;
+	}
+
+	const XMFLOAT2 playerPosition{ m_playerX, static_cast<float>(gk_arenaMinY) };
+	const AABB playerAABB = AABB::computeFromCenterAndHalfExtents(playerPosition, gk_playerHalfExtents);
+
+	checkBounds(playerAABB.min().x, playerAABB.max().x);
+	SimulationRules::checkBonusCollision(state, playerAABB);
+
+	//a ball touching the player doesn't touch the bricks in the same step
+	checkPlayerCollision(playerAABB);
+	checkBricksCollision();
+
+	return false;
+}
+
+void MultiBallSimulation::moveBalls(float deltaTime)
+{
+	const unsigned int ballsCount = this->ballsCount();
+
+	float* ballsX = m_ballsX.data();
+	float* ballsY = m_ballsY.data();
+	float* ballsVelocityX = m_ballsVelocityX.data();
+	float* ballsVelocityY = m_ballsVelocityY.data();
+
+	float* lastBallsX = m_lastBallsX.data();
+	float* lastBallsY = m_lastBallsY.data();
+	float* movedBallsX = m_movedBallsX.data();
+	float* movedBallsY = m_movedBallsY.data();
+
+	for (unsigned int ballIndex = 0; ballIndex < ballsCount; ++ballIndex)
+	{
+		lastBallsX[ballIndex] = ballsX[ballIndex];
+		lastBallsY[ballIndex] = ballsY[ballIndex];
+
+		BallState ball{ ballsX[ballIndex], ballsY[ballIndex], ballsVelocityX[ballIndex], ballsVelocityY[ballIndex] };
+		SimulationRules::moveBall(ball, deltaTime);
+
+		movedBallsX[ballIndex] = ballsX[ballIndex];
+		movedBallsY[ballIndex] = ballsY[ballIndex];
+	}
+}
+
+void MultiBallSimulation::removeLostBalls()
+{
+	const unsigned int ballsCount = this->ballsCount();
+
+	//the kept balls are compacted in place, in the same order
+	unsigned int keptBallsCount = 0;
+
+	for (unsigned int ballIndex = 0; ballIndex < ballsCount; ++ballIndex)
+	{
+		m_ballsX[keptBallsCount] = m_ballsX[ballIndex];
+		m_ballsY[keptBallsCount] = m_ballsY[ballIndex];
+		m_ballsVelocityX[keptBallsCount] = m_ballsVelocityX[ballIndex];
+		m_ballsVelocityY[keptBallsCount] = m_ballsVelocityY[ballIndex];
+		m_ballsHalfWidths[keptBallsCount] = m_ballsHalfWidths[ballIndex];
+		m_ballsHalfHeights[keptBallsCount] = m_ballsHalfHeights[ballIndex];
+		m_lastBallsX[keptBallsCount] = m_lastBallsX[ballIndex];
+		m_lastBallsY[keptBallsCount] = m_lastBallsY[ballIndex];
+		m_movedBallsX[keptBallsCount] = m_movedBallsX[ballIndex];
+		m_movedBallsY[keptBallsCount] = m_movedBallsY[ballIndex];
+
+		keptBallsCount += static_cast<unsigned int>(!(m_movedBallsY[ballIndex] < gk_gameOverBallY));
+	}
+
+	if (keptBallsCount == ballsCount)
+	{
+		return;
+	}
+
+	//shrinking doesn't free the reserved memory
+	m_ballsX.resize(keptBallsCount);
+	m_ballsY.resize(keptBallsCount);
+	m_ballsVelocityX.resize(keptBallsCount);
+	m_ballsVelocityY.resize(keptBallsCount);
+	m_ballsHalfWidths.resize(keptBallsCount);
+	m_ballsHalfHeights.resize(keptBallsCount);
+}
+
+void MultiBallSimulation::checkBounds(float playerAABBMinX, float playerAABBMaxX)
+{
+	//player
+
+	SimulationRules::checkPlayerBounds(m_playerX, playerAABBMinX, playerAABBMaxX);
+
+	//balls
+
+	const unsigned int ballsCount = this->ballsCount();
+
+	float* ballsX = m_ballsX.data();
+	float* ballsY = m_ballsY.data();
+	float* ballsVelocityX = m_ballsVelocityX.data();
+	float* ballsVelocityY = m_ballsVelocityY.data();
+	const float* ballsHalfWidths = m_ballsHalfWidths.data();
+	const float* ballsHalfHeights = m_ballsHalfHeights.data();
+	const float* movedBallsX = m_movedBallsX.data();
+	const float* movedBallsY = m_movedBallsY.data();
+
+	for (unsigned int ballIndex = 0; ballIndex < ballsCount; ++ballIndex)
+	{
+		const XMFLOAT2 ballHalfExtents{ ballsHalfWidths[ballIndex], ballsHalfHeights[ballIndex] };
+		const XMFLOAT2 movedBallPosition{ movedBallsX[ballIndex], movedBallsY[ballIndex] };
+
+		BallState ball{ ballsX[ballIndex], ballsY[ballIndex], ballsVelocityX[ballIndex], ballsVelocityY[ballIndex] };
+		SimulationRules::checkBallBounds(ball, movedBallPosition - ballHalfExtents, movedBallPosition + ballHalfExtents, ballHalfExtents);
+	}
+}
+
+void MultiBallSimulation::checkPlayerCollision(const AABB& playerAABB)
+{
+	const unsigned int ballsCount = this->ballsCount();
+
+	const float* ballsHalfWidths = m_ballsHalfWidths.data();
+	const float* ballsHalfHeights = m_ballsHalfHeights.data();
+	const float* movedBallsX = m_movedBallsX.data();
+	const float* movedBallsY = m_movedBallsY.data();
+	unsigned char* ballsTouchingPlayer = m_ballsTouchingPlayer.data();
+
+	const XMFLOAT2& playerPosition = playerAABB.center();
+	const XMFLOAT2& playerHalfExtents = playerAABB.halfExtents();
+
+	//the same test of AABB::intersects(), for all the balls at once
+	unsigned int touchingBallsCount = 0;
+
+	for (unsigned int ballIndex = 0; ballIndex < ballsCount; ++ballIndex)
+	{
+		const bool xIntersects = lessEqualf(std::abs(playerPosition.x - movedBallsX[ballIndex]), (playerHalfExtents.x + ballsHalfWidths[ballIndex]));
+		const bool yIntersects = lessEqualf(std::abs(playerPosition.y - movedBallsY[ballIndex]), (playerHalfExtents.y + ballsHalfHeights[ballIndex]));
+
+		ballsTouchingPlayer[ballIndex] = static_cast<unsigned char>(xIntersects & yIntersects);
+		touchingBallsCount += ballsTouchingPlayer[ballIndex];
+	}
+
+	if (touchingBallsCount == 0)
+	{
+		return;
+	}
+
+	for (unsigned int ballIndex = 0; ballIndex < ballsCount; ++ballIndex)
+	{
+		if (ballsTouchingPlayer[ballIndex] == 0)
+		{
+			continue;
+		}
+
+		const XMFLOAT2 ballHalfExtents{ ballsHalfWidths[ballIndex], ballsHalfHeights[ballIndex] };
+		const XMFLOAT2 ballPosition{ movedBallsX[ballIndex], movedBallsY[ballIndex] };
+		const XMFLOAT2 lastBallPosition{ m_lastBallsX[ballIndex], m_lastBallsY[ballIndex] };
+
+		const SimulationCore::CollisionData collisionData =
+			SimulationCore::ballAABBCollisionData(playerAABB, ballPosition - ballHalfExtents, ballPosition + ballHalfExtents,
+												  lastBallPosition - ballHalfExtents, lastBallPosition + ballHalfExtents);
+
+		BallState ball{ m_ballsX[ballIndex], m_ballsY[ballIndex], m_ballsVelocityX[ballIndex], m_ballsVelocityY[ballIndex] };
+		SimulationRules::bounceBallOnPlayer(ball, collisionData.fromTop | collisionData.fromBottom, ballPosition.x, ballHalfExtents.x, playerPosition.x);
+	}
+}
+
+void MultiBallSimulation::checkBricksCollision()
+{
+	//a cleared level has nothing left to hit
+	if (m_aliveBricks.none())
+	{
+		return;
+	}
+
+	const unsigned int ballsCount = this->ballsCount();
+
+	const float* ballsHalfWidths = m_ballsHalfWidths.data();
+	const float* ballsHalfHeights = m_ballsHalfHeights.data();
+	const float* movedBallsX = m_movedBallsX.data();
+	const float* movedBallsY = m_movedBallsY.data();
+	const unsigned char* ballsTouchingPlayer = m_ballsTouchingPlayer.data();
+	unsigned int* bricksCandidateBalls = m_bricksCandidateBalls.data();
+
+	const XMFLOAT2& bricksPosition = m_bricksAABB.center();
+	const XMFLOAT2& bricksHalfExtents = m_bricksAABB.halfExtents();
+
+	//most balls are far from the bricks: they are discarded all at once, the others query the broadphase
+	unsigned int candidateBallsCount = 0;
+
+	for (unsigned int ballIndex = 0; ballIndex < ballsCount; ++ballIndex)
+	{
+		const bool xIntersects = std::abs(bricksPosition.x - movedBallsX[ballIndex]) <= bricksHalfExtents.x + ballsHalfWidths[ballIndex];
+		const bool yIntersects = std::abs(bricksPosition.y - movedBallsY[ballIndex]) <= bricksHalfExtents.y + ballsHalfHeights[ballIndex];
+
+		bricksCandidateBalls[candidateBallsCount] = ballIndex;
+		candidateBallsCount += static_cast<unsigned int>(xIntersects & yIntersects & (ballsTouchingPlayer[ballIndex] == 0));
+	}
+
+	//in index order: the first balls hit the bricks first
+	for (unsigned int candidateBallIndex = 0; candidateBallIndex < candidateBallsCount; ++candidateBallIndex)
+	{
+		const unsigned int ballIndex = bricksCandidateBalls[candidateBallIndex];
+
+		const XMFLOAT2 ballHalfExtents{ ballsHalfWidths[ballIndex], ballsHalfHeights[ballIndex] };
+		const AABB currBallAABB = AABB::computeFromCenterAndHalfExtents(XMFLOAT2{ movedBallsX[ballIndex], movedBallsY[ballIndex] }, ballHalfExtents);
+		const XMFLOAT2 lastBallPosition{ m_lastBallsX[ballIndex], m_lastBallsY[ballIndex] };
+
+		GameState state{ *this, ballIndex };
+		SimulationRules::checkBricksCollision(state, currBallAABB, lastBallPosition - ballHalfExtents, lastBallPosition + ballHalfExtents);
+	}
+}
+
+unsigned int MultiBallSimulation::findTouchingBrick(const AABB& currBallAABB)
+{
+	const unsigned int ballCollidersCount = m_bricksBroadphase.findPotentialColliders(currBallAABB, m_ballColliders);
+
+	//when the ball touches more bricks, the one with the lowest index is hit, as in SimulationCore
+	unsigned int hitBrickIndex = gk_bricksCount;
+
+	for (unsigned int colliderIndex = 0; colliderIndex < ballCollidersCount; ++colliderIndex)
+	{
+		const unsigned int brickIndex = m_ballColliders[colliderIndex];
+		assert(brickIndex < gk_bricksCount);
+
+		if (brickIndex >= hitBrickIndex)
+		{
+			continue;
+		}
+
+		const AABB aabb = AABB::computeFromCenterAndHalfExtents(XMFLOAT2{ m_bricksX[brickIndex], m_bricksY[brickIndex] }, gk_bricksHalfExtents);
+
+		if (currBallAABB.intersects(aabb))
+		{
+			hitBrickIndex = brickIndex;
+		}
+	}
+
+	return hitBrickIndex;
+}
+
+void MultiBallSimulation::destroyBrick(unsigned int brickIndex)
+{
+	assert(m_aliveBricks.test(brickIndex));
+
+	const XMFLOAT2 brickAABBCenter{ m_bricksX[brickIndex], m_bricksY[brickIndex] };
+
+	m_aliveBricks.reset(brickIndex);
+
+	//the destroyed bricks are not returned by the next queries
+	const bool brickRemoved = m_bricksBroadphase.remove(brickAABBCenter, brickIndex);
+	assert(brickRemoved && "the broadphase is out of sync with the bricks");
+	(void)brickRemoved; //read by the assert only
+
+	m_bricksX[brickIndex] = gk_outOfArenaX;
+}
\ No newline at end of file
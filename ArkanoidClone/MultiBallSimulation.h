@@ -0,0 +1,208 @@
+#pragma once
+#include "Engine.h"
+#include "MathCommon.h"
+#include "Dimensions.h"
+#include "AABB.h"
+#include "SimulationCore.h"
+#include "BricksBitset.h"
+#include <vector>
+#include <random>
+#include <cassert>
+
+namespace ArkanoidGame
+{
+	/*
+	a single game played with any number of balls, for the workloads which don't need a window.
+	each ball follows the rules of SimulationCore::COLLISION_DISCRETE: with one ball, the same seed and per-step inputs
+	give the same state of a SimulationCore. the balls are stored as structure of arrays and each rule is a loop over all of them,
+	the bricks are hit by the balls in index order. a ball leaving the arena is removed, the level is restarted when the last one is lost.
+	*/
+	class MultiBallSimulation
+	{
+	public:
+		//ctors
+		//the balls arrays are reserved for ballsCapacity balls, so addBall() doesn't allocate up to it
+		explicit MultiBallSimulation(unsigned int randomSeed, unsigned int ballsCapacity);
+
+		//dtor
+		~MultiBallSimulation() = default;
+
+		//copy
+		MultiBallSimulation(const MultiBallSimulation&) = default;
+		MultiBallSimulation& operator=(const MultiBallSimulation&) = default;
+
+		//move
+		MultiBallSimulation(MultiBallSimulation&&) = default;
+		MultiBallSimulation& operator=(MultiBallSimulation&&) = default;
+
+		//deltaTime is in seconds. inputFlags is a SimulationCore::EInputFlags bitmask.
+		//returns true if the level has been restarted during the step
+		bool step(float deltaTime, unsigned int inputFlags);
+
+		//the level restarts with the single ball of SimulationCore
+		void restartLevel();
+
+		//returns false if ballsCapacity() balls are already in play
+		bool addBall(const XMFLOAT2& position, const XMFLOAT2& velocity, const XMFLOAT2& halfExtents);
+
+		unsigned int ballsCount()const;
+		unsigned int ballsCapacity()const;
+
+		XMFLOAT2 ballPosition(unsigned int ballIndex)const;
+		XMFLOAT2 ballVelocity(unsigned int ballIndex)const;
+		XMFLOAT2 ballHalfExtents(unsigned int ballIndex)const;
+
+		float playerPositionX()const;
+		XMFLOAT2 bonusPosition()const;
+		bool isBonusAlive()const;
+
+		XMFLOAT2 brickPosition(unsigned int brickIndex)const;
+		unsigned int brickType(unsigned int brickIndex)const;
+		unsigned int brickRemainingHits(unsigned int brickIndex)const;
+
+		//the placed bricks not destroyed yet
+		unsigned int aliveBricksCount()const;
+
+		//true if all the bricks have been destroyed
+		bool isLevelCleared()const;
+
+	private:
+		//the accessors given to the SimulationRules: a ball of the arrays, or the game seen from one of the balls
+		class BallState;
+		class GameState;
+
+		void placeBricks();
+
+		void moveBalls(float deltaTime);
+
+		//drops the balls below gk_gameOverBallY, keeping the order of the others
+		void removeLostBalls();
+
+		void checkBounds(float playerAABBMinX, float playerAABBMaxX);
+
+		//the balls touching the player bounce on it and are flagged in m_ballsTouchingPlayer
+		void checkPlayerCollision(const AABB& playerAABB);
+
+		void checkBricksCollision();
+
+		//the alive brick with the lowest index touching the ball, gk_bricksCount if none
+		unsigned int findTouchingBrick(const AABB& currBallAABB);
+
+		//out of the arena, the alive bricks and the broadphase
+		void destroyBrick(unsigned int brickIndex);
+
+		unsigned int m_ballsCapacity;
+
+		//one element per ball
+		std::vector<float> m_ballsX;
+		std::vector<float> m_ballsY;
+		std::vector<float> m_ballsVelocityX;
+		std::vector<float> m_ballsVelocityY;
+		std::vector<float> m_ballsHalfWidths;
+		std::vector<float> m_ballsHalfHeights;
+
+		//one element per ball, scratch of step(): the positions before and after the move, before the collisions adjust them
+		std::vector<float> m_lastBallsX;
+		std::vector<float> m_lastBallsY;
+		std::vector<float> m_movedBallsX;
+		std::vector<float> m_movedBallsY;
+		std::vector<unsigned char> m_ballsTouchingPlayer;
+		std::vector<unsigned int> m_bricksCandidateBalls;
+
+		float m_playerX{ 0.0f }; //the player never leaves the bottom of the arena
+
+		float m_bonusX{ 0.0f };
+		float m_bonusY{ 0.0f };
+		unsigned int m_bonusBricksHit{ 0 };
+		unsigned int m_nextBonusBricksHitCount{ 0 };
+		bool m_bonusAlive{ false };
+
+		float m_bricksX[gk_bricksCount]{};
+		float m_bricksY[gk_bricksCount]{};
+		unsigned int m_bricksRemainingHits[gk_bricksCount]{};
+		unsigned int m_bricksTypes[gk_bricksCount]{};
+
+		//kept in sync with m_bricksRemainingHits
+		BricksBitset m_aliveBricks{};
+
+		//bounds of the placed bricks: the balls outside of it don't query the broadphase
+		AABB m_bricksAABB{};
+
+		SimulationCore::BricksBroadphase m_bricksBroadphase;
+
+		unsigned int m_ballColliders[gk_bricksCount];
+
+		std::minstd_rand m_randomEngine;
+	};
+
+	inline unsigned int MultiBallSimulation::ballsCount()const
+	{
+		return static_cast<unsigned int>(m_ballsX.size());
+	}
+
+	inline unsigned int MultiBallSimulation::ballsCapacity()const
+	{
+		return m_ballsCapacity;
+	}
+
+	inline XMFLOAT2 MultiBallSimulation::ballPosition(unsigned int ballIndex)const
+	{
+		assert(ballIndex < ballsCount());
+		return XMFLOAT2{ m_ballsX[ballIndex], m_ballsY[ballIndex] };
+	}
+
+	inline XMFLOAT2 MultiBallSimulation::ballVelocity(unsigned int ballIndex)const
+	{
+		assert(ballIndex < ballsCount());
+		return XMFLOAT2{ m_ballsVelocityX[ballIndex], m_ballsVelocityY[ballIndex] };
+	}
+
+	inline XMFLOAT2 MultiBallSimulation::ballHalfExtents(unsigned int ballIndex)const
+	{
+		assert(ballIndex < ballsCount());
+		return XMFLOAT2{ m_ballsHalfWidths[ballIndex], m_ballsHalfHeights[ballIndex] };
+	}
+
+	inline float MultiBallSimulation::playerPositionX()const
+	{
+		return m_playerX;
+	}
+
+	inline XMFLOAT2 MultiBallSimulation::bonusPosition()const
+	{
+		return XMFLOAT2{ m_bonusX, m_bonusY };
+	}
+
+	inline bool MultiBallSimulation::isBonusAlive()const
+	{
+		return m_bonusAlive;
+	}
+
+	inline XMFLOAT2 MultiBallSimulation::brickPosition(unsigned int brickIndex)const
+	{
+		assert(brickIndex < gk_bricksCount);
+		return XMFLOAT2{ m_bricksX[brickIndex], m_bricksY[brickIndex] };
+	}
+
+	inline unsigned int MultiBallSimulation::brickType(unsigned int brickIndex)const
+	{
+		assert(brickIndex < gk_bricksCount);
+		return m_bricksTypes[brickIndex];
+	}
+
+	inline unsigned int MultiBallSimulation::brickRemainingHits(unsigned int brickIndex)const
+	{
+		assert(brickIndex < gk_bricksCount);
+		return m_bricksRemainingHits[brickIndex];
+	}
+
+	inline unsigned int MultiBallSimulation::aliveBricksCount()const
+	{
+		return m_aliveBricks.count();
+	}
+
+	inline bool MultiBallSimulation::isLevelCleared()const
+	{
+		return m_aliveBricks.none();
+	}
+}
\ No newline at end of file
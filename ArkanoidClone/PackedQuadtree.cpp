@@ -0,0 +1,6 @@
+#include "PackedQuadtree.h"
+
+#ifdef _DEBUG
+//explicit instantiation to find compilation errors
+template class ArkanoidGame::PackedQuadtree<>;
+#endif
\ No newline at end of file
@@ -0,0 +1,267 @@
+#pragma once
+#include <vector>
+#include <cassert>
+#include "QuadtreeHelper.h"
+#include "Quadrant.h"
+#include "MathHelper.h"
+#include "AABB.h"
+#include "Quadtree.h"
+
+namespace ArkanoidGame
+{
+	/*
+	a read-only copy of a Quadtree, packed for the queries: only the quadrants which exist are stored, in depth-first order,
+	as nodes of 16 bytes, so 4 of them share a cache line. the objects are in one contiguous array, in the same order,
+	so the objects of a quadrant are the range up to the first object of the next node: no list is followed.
+	each node knows the node after its subtree, so a query is a forward scan which jumps over the subtrees it misses
+	and needs no stack. build() must be called again after the quadtree changes
+	*/
+	template<typename ObjectData = unsigned int, unsigned int MAX_DEPTH = 1>
+	class PackedQuadtree
+	{
+	public:
+		//ctors
+		PackedQuadtree() = default;
+
+		//dtor
+		~PackedQuadtree() = default;
+
+		//copy
+		PackedQuadtree(const PackedQuadtree&) = default;
+		PackedQuadtree& operator=(const PackedQuadtree&) = default;
+
+		//move
+		PackedQuadtree(PackedQuadtree&&) = default;
+		PackedQuadtree& operator=(PackedQuadtree&&) = default;
+
+		//replaces the content with the one of quadtree. the arrays grow only when the quadtree is bigger than before
+		template<typename SubdivisionPolicy>
+		void build(const Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>& quadtree);
+
+		//as Quadtree::findPotentialColliders(): the same objects are found, in the same order
+		unsigned int findPotentialColliders(const AABB& objectAABB, ObjectData* foundObjects)const;
+
+		//as above, visitedQuadrantsCount is set to the number of nodes tested against objectAABB: the same as Quadtree
+		unsigned int findPotentialColliders(const AABB& objectAABB, ObjectData* foundObjects, unsigned int& visitedQuadrantsCount)const;
+
+		//as Quadtree::visitPotentialColliders(), in the quadrants order
+		template<typename Visitor>
+		bool visitPotentialColliders(const AABB& objectAABB, Visitor&& visitor)const;
+
+		unsigned int quadrantsCount()const;
+		unsigned int objectsCount()const;
+
+		//bytes owned by the packed quadtree, this object included
+		size_t memoryUsage()const;
+
+	private:
+		static constexpr unsigned int sk_maxDepth = MAX_DEPTH;
+
+		//the indices of the nodes fit 16 bits
+		static_assert(ArkanoidGame::quadrantsCount(MAX_DEPTH) < 0xffff, "PackedQuadtree supports MAX_DEPTH up to 7");
+
+		struct PackedQuadrant
+		{
+			Quadrant quadrant;
+			unsigned int firstObject; //the objects of the node end where the ones of the next node begin
+			unsigned short depth;
+			unsigned short nextQuadrant; //the node after the subtree of this one
+		};
+
+		static_assert(sizeof(PackedQuadrant) == 16, "4 PackedQuadrant per cache line");
+
+		struct PackedObject
+		{
+			XMFLOAT2 center;
+			ObjectData data;
+		};
+
+		//the scan of visitPotentialColliders(), counting the nodes tested
+		template<typename Visitor>
+		bool visitQuadrantsPotentialColliders(const AABB& objectAABB, Visitor& visitor, unsigned int& visitedQuadrantsCount)const;
+
+		//appends the node of quadrantIndex, its objects and its subtree
+		template<typename SubdivisionPolicy>
+		void packQuadrant(const Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>& quadtree, unsigned int quadrantIndex);
+
+		//the nodes, followed by a last one whose firstObject is the objects count
+		std::vector<PackedQuadrant> m_quadrants;
+		std::vector<PackedObject> m_objects;
+
+		XMFLOAT2 m_perDepthQuadrantSize[sk_maxDepth + 1]{}; //from depth == 0 (entire area) to sk_maxDepth inclusive
+	};
+
+	//PackedQuadtree implementation
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	template<typename SubdivisionPolicy>
+	inline
+		void
+			PackedQuadtree<ObjectData, MAX_DEPTH>::build(const Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>& quadtree)
+	{
+		m_quadrants.clear();
+		m_objects.clear();
+
+		for (unsigned int depth = 0; depth <= sk_maxDepth; ++depth)
+		{
+			m_perDepthQuadrantSize[depth] = quadtree.perDepthQuadrantSize(depth);
+		}
+
+		packQuadrant(quadtree, 0);
+
+		m_quadrants.push_back(PackedQuadrant{ Quadrant{}, static_cast<unsigned int>(m_objects.size()), 0, 0 });
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	template<typename SubdivisionPolicy>
+	inline
+		void
+			PackedQuadtree<ObjectData, MAX_DEPTH>::packQuadrant(const Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>& quadtree,
+																unsigned int quadrantIndex)
+	{
+		const unsigned int packedQuadrantIndex = static_cast<unsigned int>(m_quadrants.size());
+		const unsigned int quadrantDepth = quadtree.perQuadrantDepth(quadrantIndex);
+
+		m_quadrants.push_back(PackedQuadrant{ quadtree.quadrant(quadrantIndex), static_cast<unsigned int>(m_objects.size()),
+											  static_cast<unsigned short>(quadrantDepth), 0 });
+
+		for (unsigned int objectIndex = quadtree.quadrantFirstObject(quadrantIndex); objectIndex != quadtree.sk_invalidObjectIndex;
+			 objectIndex = quadtree.pooledObject(objectIndex).nextObject)
+		{
+			const auto& object = quadtree.pooledObject(objectIndex);
+			m_objects.push_back(PackedObject{ object.center, object.data });
+		}
+
+		if (quadtree.isQuadrantSubdivided(quadrantIndex))
+		{
+			unsigned int childrenIndices[4];
+			computeChildrenIndices(quadrantIndex, childrenIndices, quadtree.childrenOffsets(quadrantDepth));
+
+			for (unsigned int child = 0; child < 4; ++child)
+			{
+				packQuadrant(quadtree, childrenIndices[child]);
+			}
+		}
+
+		m_quadrants[packedQuadrantIndex].nextQuadrant = static_cast<unsigned short>(m_quadrants.size());
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	inline
+		unsigned int
+			PackedQuadtree<ObjectData, MAX_DEPTH>::findPotentialColliders(const AABB& objectAABB, ObjectData* foundObjects)const
+	{
+		assert(foundObjects != nullptr);
+
+		unsigned int foundObjectsCount = 0;
+
+		visitPotentialColliders(objectAABB, [foundObjects, &foundObjectsCount](const ObjectData& objectData, const XMFLOAT2&)
+		{
+			foundObjects[foundObjectsCount++] = objectData;
+			return true;
+		});
+
+		return foundObjectsCount;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	inline
+		unsigned int
+			PackedQuadtree<ObjectData, MAX_DEPTH>::findPotentialColliders(const AABB& objectAABB, ObjectData* foundObjects,
+																		  unsigned int& visitedQuadrantsCount)const
+	{
+		assert(foundObjects != nullptr);
+
+		unsigned int foundObjectsCount = 0;
+
+		auto visitor = [foundObjects, &foundObjectsCount](const ObjectData& objectData, const XMFLOAT2&)
+		{
+			foundObjects[foundObjectsCount++] = objectData;
+			return true;
+		};
+
+		visitedQuadrantsCount = 0;
+		visitQuadrantsPotentialColliders(objectAABB, visitor, visitedQuadrantsCount);
+
+		return foundObjectsCount;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	template<typename Visitor>
+	inline
+		bool
+			PackedQuadtree<ObjectData, MAX_DEPTH>::visitPotentialColliders(const AABB& objectAABB, Visitor&& visitor)const
+	{
+		unsigned int visitedQuadrantsCount = 0;
+		return visitQuadrantsPotentialColliders(objectAABB, visitor, visitedQuadrantsCount);
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	template<typename Visitor>
+	inline
+		bool
+			PackedQuadtree<ObjectData, MAX_DEPTH>::visitQuadrantsPotentialColliders(const AABB& objectAABB, Visitor& visitor,
+																					unsigned int& visitedQuadrantsCount)const
+	{
+		const XMFLOAT2 objectAABBMin = objectAABB.min();
+		const XMFLOAT2 objectAABBMax = objectAABB.max();
+
+		const unsigned int packedQuadrantsCount = quadrantsCount();
+
+		unsigned int quadrantIndex = 0;
+		while (quadrantIndex < packedQuadrantsCount)
+		{
+			const PackedQuadrant& currQuadrant = m_quadrants[quadrantIndex];
+
+			++visitedQuadrantsCount;
+
+			if (currQuadrant.quadrant.outside(objectAABBMin, objectAABBMax, m_perDepthQuadrantSize[currQuadrant.depth]))
+			{
+				//skip the objects of the quadrant and its subtree
+				quadrantIndex = currQuadrant.nextQuadrant;
+				continue;
+			}
+
+			const unsigned int endObject = m_quadrants[quadrantIndex + 1].firstObject;
+			for (unsigned int objectIndex = currQuadrant.firstObject; objectIndex < endObject; ++objectIndex)
+			{
+				const PackedObject& object = m_objects[objectIndex];
+
+				if (!visitor(object.data, object.center))
+				{
+					return false;
+				}
+			}
+
+			//the first child, or the node after the subtree for a leaf
+			++quadrantIndex;
+		}
+
+		return true;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	inline
+		unsigned int
+			PackedQuadtree<ObjectData, MAX_DEPTH>::quadrantsCount()const
+	{
+		//the last node only ends the objects, none exists before build()
+		return static_cast<unsigned int>(m_quadrants.size()) - static_cast<unsigned int>(!m_quadrants.empty());
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	inline
+		unsigned int
+			PackedQuadtree<ObjectData, MAX_DEPTH>::objectsCount()const
+	{
+		return static_cast<unsigned int>(m_objects.size());
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	inline
+		size_t
+			PackedQuadtree<ObjectData, MAX_DEPTH>::memoryUsage()const
+	{
+		return sizeof(*this) + m_quadrants.capacity() * sizeof(PackedQuadrant) + m_objects.capacity() * sizeof(PackedObject);
+	}
+}
\ No newline at end of file
@@ -26,6 +26,14 @@ namespace ArkanoidGame
 		bool contains(const XMFLOAT2& aabbMin, const XMFLOAT2& aabbMax, const XMFLOAT2& quadrantSize)const;
 		bool outside(const XMFLOAT2& aabbMin, const XMFLOAT2& aabbMax, const XMFLOAT2& quadrantSize)const;
 
+		/*
+		true if a box of boxHalfExtents moving from boxStart by a displacement touches the quadrant, as outside() tells for
+		each box on the way. enterTime is the fraction of the displacement done when it starts touching, 0 if it already does.
+		boxInverseDisplacement is 1 / displacement on each axis, 0 on the axes without displacement
+		*/
+		bool crossed(const XMFLOAT2& boxStart, const XMFLOAT2& boxInverseDisplacement, const XMFLOAT2& boxHalfExtents,
+					 const XMFLOAT2& quadrantSize, float& enterTime)const;
+
 	private:
 		XMFLOAT2 m_min;
 	};
@@ -61,15 +69,54 @@ namespace ArkanoidGame
 	{
 		XMFLOAT2 max = m_min + quadrantSize;
 
-		const unsigned int outsideXLeft = static_cast<unsigned int>(aabbMax.x < m_min.x);
-		const unsigned int outsideXRight = static_cast<unsigned int>(max.x < aabbMin.x);
+		//the tolerance covers the gk_epsilon gap between sibling quadrants:
+		//an aabb touching an object (as in AABB::intersects()) is never outside the quadrant of that object
+		const XMFLOAT2 min = m_min - XMFLOAT2{ gk_epsilon, gk_epsilon };
+
+		const unsigned int outsideXLeft = static_cast<unsigned int>(!lessEqualf(min.x, aabbMax.x));
+		const unsigned int outsideXRight = static_cast<unsigned int>(!lessEqualf(aabbMin.x, max.x));
 		const unsigned int outsideX = outsideXLeft | outsideXRight;
 
-		const unsigned int outsideYBottom = static_cast<unsigned int>(aabbMax.y < m_min.y);
-		const unsigned int outsideYTop = static_cast<unsigned int>(max.y < aabbMin.y);
+		const unsigned int outsideYBottom = static_cast<unsigned int>(!lessEqualf(min.y, aabbMax.y));
+		const unsigned int outsideYTop = static_cast<unsigned int>(!lessEqualf(aabbMin.y, max.y));
 		const unsigned int outsideY = outsideYBottom | outsideYTop;
 		
 		return (outsideX | outsideY) == 1;
 	}
 
+	inline bool Quadrant::crossed(const XMFLOAT2& boxStart, const XMFLOAT2& boxInverseDisplacement, const XMFLOAT2& boxHalfExtents,
+								  const XMFLOAT2& quadrantSize, float& enterTime)const
+	{
+		//the box center is clipped against the quadrant grown by the box half extents and by the tolerance of outside()
+		const XMFLOAT2 tolerance{ 2.0f * gk_epsilon, 2.0f * gk_epsilon };
+		const XMFLOAT2 min = m_min - boxHalfExtents - tolerance;
+		const XMFLOAT2 max = m_min + quadrantSize + boxHalfExtents + tolerance;
+
+		auto axisTimes = [](float min, float max, float start, float inverseDisplacement, float& axisEnterTime, float& axisExitTime)
+		{
+			if (inverseDisplacement == 0.0f)
+			{
+				//between the faces for the whole displacement or never
+				const bool inside = min <= start && start <= max;
+				axisEnterTime = inside ? 0.0f : 1.0f;
+				axisExitTime = inside ? 1.0f : 0.0f;
+				return;
+			}
+
+			const float minTime = (min - start) * inverseDisplacement;
+			const float maxTime = (max - start) * inverseDisplacement;
+			axisEnterTime = std::min(minTime, maxTime);
+			axisExitTime = std::max(minTime, maxTime);
+		};
+
+		float enterTimeX, exitTimeX;
+		float enterTimeY, exitTimeY;
+		axisTimes(min.x, max.x, boxStart.x, boxInverseDisplacement.x, enterTimeX, exitTimeX);
+		axisTimes(min.y, max.y, boxStart.y, boxInverseDisplacement.y, enterTimeY, exitTimeY);
+
+		enterTime = std::max(std::max(enterTimeX, enterTimeY), 0.0f);
+		const float exitTime = std::min(std::min(exitTimeX, exitTimeY), 1.0f);
+
+		return enterTime <= exitTime;
+	}
 }
\ No newline at end of file
@@ -1,5 +1,8 @@
 #pragma once
 #include <vector>
+#include <utility>
+#include <type_traits>
+#include <algorithm>
 #include <cassert>
 #include "QuadtreeHelper.h"
 #include "Quadrant.h"
@@ -8,20 +11,50 @@
 
 namespace ArkanoidGame
 {
+	/*
+	a policy must accept any objects count greater than one it accepts, so that Quadtree::build() subdivides as Quadtree::insert().
+	Quadtree gives it the depth and the size of the quadrant too, DynamicQuadtree only the objects count.
+	Quadtree derives from the policy, so a policy can hold settings: they apply to the quadrants subdivided afterwards
+	*/
 	struct DefaultSubdivisionPolicy
 	{
 		static bool shouldSubdivideQuadrant(unsigned int pointsCount)
 		{
 			return pointsCount > 0;
 		}
+
+		static bool shouldSubdivideQuadrant(unsigned int pointsCount, unsigned int /*depth*/, const XMFLOAT2& /*quadrantSize*/)
+		{
+			return shouldSubdivideQuadrant(pointsCount);
+		}
+	};
+
+	//the order in which Quadtree::visitPotentialColliders() visits the children of a quadrant
+	enum EQuadrantsVisitOrder : unsigned int
+	{
+		QUADRANTS_VISIT_IN_ORDER = 0, //the quadrants order (min, +x, +y, +x+y), as findPotentialColliders()
+		QUADRANTS_VISIT_NEAREST_FIRST = 1 //by increasing distance of their centers from the query center
 	};
-	
+
+	template<typename ObjectData, unsigned int MAX_DEPTH>
+	class PackedQuadtree;
+
+	/*
+	the objects are stored in a pool allocated by the constructor, with room for objectsCapacity objects:
+	the objects of a quadrant are a list linked through the pool, so insert() never allocates
+	and subdivide() moves the objects to the children by relinking them.
+	build() replaces all the objects at once, placing the objects of each quadrant in consecutive pool slots.
+	each object belongs to a class, which gives its half extents: objects of different sizes, e.g. the bricks, the player
+	and the bonus, can share a quadtree. the classes are 0 unless given, and all of them start with objectsHalfExtents.
+	the queries modify nothing, so many threads can query a quadtree at once while none of them modifies it
+	*/
 	template<typename ObjectData = unsigned int, unsigned int MAX_DEPTH = 1, typename SubdivisionPolicy = DefaultSubdivisionPolicy>
 	class Quadtree : public SubdivisionPolicy
 	{
 	public:
 		//ctors
-		explicit Quadtree(const AABB& quadtreeArea, const XMFLOAT2& objectsHalfExtents);
+		//at most objectsCapacity objects can be inserted
+		explicit Quadtree(const AABB& quadtreeArea, const XMFLOAT2& objectsHalfExtents, unsigned int objectsCapacity);
 
 		//dtor
 		~Quadtree() = default;
@@ -33,45 +66,220 @@ namespace ArkanoidGame
 		//move
 		Quadtree(Quadtree&&) = default;
 		Quadtree& operator=(Quadtree&&) = default;
-		
-		void insert(const XMFLOAT2& objectCenter, const ObjectData& objectData);
+
+		void insert(const XMFLOAT2& objectCenter, const ObjectData& objectData, unsigned int objectClass = 0);
+
+		/*
+		removes all the objects and covers quadtreeArea with the quadrants, then adds the given objects in two passes:
+		the first counts the objects of each quadrant, the second scatters them to their pool slots.
+		the objects are found as if they were inserted in the given order, without allocating
+		*/
+		void build(const AABB& quadtreeArea, const XMFLOAT2* objectsCenters, const ObjectData* objectsDatas, unsigned int objectsCount,
+				   const unsigned int* objectsClasses = nullptr);
+
+		/*
+		as build(), but each object is descended along the Morton code of its center and the objects are radix sorted
+		by the quadrant containing them, then the quadrants take their objects in one linear sweep: the time is linear in
+		the objects count. the objects of a quadrant are found in the given order when the quadrant is subdivided,
+		otherwise in the order of the descendants containing them, as with a policy stopping the subdivision earlier.
+		the objects half extents must be greater than the epsilon gaps between sibling quadrants
+		*/
+		void buildBulk(const AABB& quadtreeArea, const XMFLOAT2* objectsCenters, const ObjectData* objectsDatas, unsigned int objectsCount,
+					   const unsigned int* objectsClasses = nullptr);
 
 		//foundObjects must point to an array of ObjectData which size is enough to contain all the objects
 		//the number of objects actually found is returned
 		unsigned int findPotentialColliders(const AABB& objectAABB, ObjectData* foundObjects)const;
-		
-	private:		
-		void buildQuadrant(unsigned int quadrantIndex, unsigned int currDepth);
+
+		//as above, visitedQuadrantsCount is set to the number of quadrants tested against objectAABB
+		unsigned int findPotentialColliders(const AABB& objectAABB, ObjectData* foundObjects, unsigned int& visitedQuadrantsCount)const;
+
+		/*
+		calls visitor(const ObjectData& objectData, const XMFLOAT2& objectCenter) for each object findPotentialColliders()
+		would find, without copying them: the visitor returns false to stop the visit, e.g. on the first object actually hit.
+		the objects of a quadrant are visited before the ones of its children.
+		returns false if the visitor stopped the visit
+		*/
+		template<typename Visitor>
+		bool visitPotentialColliders(const AABB& objectAABB, Visitor&& visitor,
+									 EQuadrantsVisitOrder visitOrder = QUADRANTS_VISIT_IN_ORDER)const;
+
+		/*
+		as findPotentialColliders(), for an object of objectHalfExtents moving from objectStart by objectDisplacement:
+		only the quadrants crossed by the motion are visited, rather than all the ones touching the AABB enclosing it.
+		the objects touched by the object on its way are always found, others may be found too
+		*/
+		unsigned int findSweptPotentialColliders(const XMFLOAT2& objectStart, const XMFLOAT2& objectDisplacement,
+												 const XMFLOAT2& objectHalfExtents, ObjectData* foundObjects)const;
+
+		/*
+		as visitPotentialColliders(), for the objects findSweptPotentialColliders() would find. the children of a quadrant
+		are visited in the order the motion reaches them, so a visitor looking for the first object hit on the way, e.g. to
+		predict a trajectory, can stop once the objects it has seen are hit before the motion reaches the next quadrants
+		*/
+		template<typename Visitor>
+		bool visitSweptPotentialColliders(const XMFLOAT2& objectStart, const XMFLOAT2& objectDisplacement,
+										  const XMFLOAT2& objectHalfExtents, Visitor&& visitor)const;
+
+		//objectCenter and objectClass must be the ones given to insert(), objectData is found with operator==.
+		//the quadrants left without objects are merged into their parent, so the queries stop visiting them.
+		//returns false if the object is not in the quadtree
+		bool remove(const XMFLOAT2& objectCenter, const ObjectData& objectData, unsigned int objectClass = 0);
+
+		//moves an object, as remove() followed by insert(). returns false if the object is not in the quadtree
+		bool update(const XMFLOAT2& oldObjectCenter, const XMFLOAT2& newObjectCenter, const ObjectData& objectData,
+					unsigned int objectClass = 0);
+
+		//the quadtree must hold no object of objectClass
+		void setObjectClassHalfExtents(unsigned int objectClass, const XMFLOAT2& halfExtents);
+		const XMFLOAT2& objectClassHalfExtents(unsigned int objectClass)const;
+
+		static constexpr unsigned int sk_maxObjectClassesCount = 4;
+
+		//removes all the objects and merges all the quadrants, keeping the pool
+		void clear();
+
+		//the area covered by the root quadrant
+		AABB area()const;
+
+		unsigned int objectsCapacity()const;
+		unsigned int objectsCount()const;
+
+		//changes with each insertion, removal and clear() of the objects, so the results of a query kept aside
+		//are known to be still valid while it doesn't change
+		unsigned int modificationsCount()const;
+
+		//bytes owned by the quadtree, this object included
+		size_t memoryUsage()const;
+
+	private:
+		//PackedQuadtree::build() copies the quadrants and their objects
+		template<typename, unsigned int>
+		friend class PackedQuadtree;
+
+		static constexpr unsigned int sk_invalidObjectIndex = ~0u;
+
+		//buildBulk() sorts 8 bits of the quadrants indices per pass
+		static constexpr unsigned int sk_radixBits = 8;
+		static constexpr unsigned int sk_radixBucketsCount = 1 << sk_radixBits;
+
+		//the class fits a byte, after the data: an ObjectData smaller than 4 bytes shares its padding with it
+		struct PooledObject
+		{
+			XMFLOAT2 center;
+			unsigned int nextObject;
+			ObjectData data;
+			unsigned char objectClass;
+		};
+
+		static_assert(sk_maxObjectClassesCount <= 256, "the object class is stored as unsigned char");
+
+		//places the quadrants on the area, from their parents: the topology comes from the Topology tables
+		void setArea(const AABB& quadtreeArea);
+
+		//visits the objects of the quadrant at DEPTH and of its subtree, as visitPotentialColliders().
+		//the recursion is unrolled by depth, so the quadrants size and the children offset are known to the compiler
+		template<unsigned int DEPTH, typename Visitor>
+		bool visitQuadrantPotentialColliders(unsigned int quadrantIndex, const XMFLOAT2& objectAABBMin, const XMFLOAT2& objectAABBMax,
+											 const XMFLOAT2& objectAABBCenter, Visitor& visitor, EQuadrantsVisitOrder visitOrder,
+											 unsigned int& visitedQuadrantsCount)const;
+
+		//std::false_type for the leaves depth, which ends the recursion
+		template<unsigned int DEPTH, typename Visitor>
+		bool visitChildrenPotentialColliders(unsigned int quadrantIndex, const XMFLOAT2& objectAABBMin, const XMFLOAT2& objectAABBMax,
+											 const XMFLOAT2& objectAABBCenter, Visitor& visitor, EQuadrantsVisitOrder visitOrder,
+											 unsigned int& visitedQuadrantsCount, std::true_type)const;
+
+		template<unsigned int DEPTH, typename Visitor>
+		bool visitChildrenPotentialColliders(unsigned int quadrantIndex, const XMFLOAT2& objectAABBMin, const XMFLOAT2& objectAABBMax,
+											 const XMFLOAT2& objectAABBCenter, Visitor& visitor, EQuadrantsVisitOrder visitOrder,
+											 unsigned int& visitedQuadrantsCount, std::false_type)const;
+
+		//an object moving along a segment, as given to visitSweptPotentialColliders()
+		struct SweptObject
+		{
+			XMFLOAT2 start;
+			XMFLOAT2 inverseDisplacement; //as Quadrant::crossed() takes it
+			XMFLOAT2 halfExtents;
+		};
+
+		//visits the objects of the quadrant at DEPTH, which the motion crosses, and of its subtree, as visitSweptPotentialColliders()
+		template<unsigned int DEPTH, typename Visitor>
+		bool visitQuadrantSweptPotentialColliders(unsigned int quadrantIndex, const SweptObject& sweptObject, Visitor& visitor)const;
+
+		//std::false_type for the leaves depth, which ends the recursion
+		template<unsigned int DEPTH, typename Visitor>
+		bool visitChildrenSweptPotentialColliders(unsigned int quadrantIndex, const SweptObject& sweptObject, Visitor& visitor,
+												  std::true_type)const;
+
+		template<unsigned int DEPTH, typename Visitor>
+		bool visitChildrenSweptPotentialColliders(unsigned int quadrantIndex, const SweptObject& sweptObject, Visitor& visitor,
+												  std::false_type)const;
 
 		bool shouldSubdivide(unsigned int quadrantIndex)const;
 		void subdivide(unsigned int quadrantIndex, unsigned int currDepth);
 
+		//true if all the children are leaves without objects
+		bool canMergeChildren(unsigned int quadrantIndex, unsigned int quadrantDepth)const;
+
+		//writes the quadrants from the root to the one where insert() places the object and returns their number.
+		//if allQuadrantsSubdivided, the path ends in the deepest quadrant containing the object
+		unsigned int computeObjectPath(const XMFLOAT2& objectCenter, unsigned int objectClass, bool allQuadrantsSubdivided,
+									   unsigned int(&pathQuadrantsIndices)[MAX_DEPTH + 1])const;
+
+		//the quadrant where insert() places an object, given the deepest quadrant containing it
+		unsigned int placedObjectQuadrant(unsigned int containingQuadrantIndex)const;
+
+		//the deepest quadrant containing the object, descending towards the leaf which contains its center
+		unsigned int computeContainingQuadrant(const XMFLOAT2& objectCenter, unsigned int objectClass, unsigned int centerMortonCode)const;
+
+		//links the pool slots in [firstSlot, endSlot) as the objects of the quadrant
+		void assignQuadrantSlots(unsigned int quadrantIndex, unsigned int firstSlot, unsigned int endSlot);
+
+		unsigned int allocateObject();
+		void freeObject(unsigned int objectIndex);
+
+		void addObjectToQuadrant(unsigned int quadrantIndex, unsigned int objectIndex);
+		void clearQuadrantObjects(unsigned int quadrantIndex);
+
 		Quadrant& quadrant(unsigned int quadrantIndex);
 		const Quadrant& quadrant(unsigned int quadrantIndex)const;
 
-		std::vector<XMFLOAT2>& quadrantObjectsCenters(unsigned int quadrantIndex);
-		const std::vector<XMFLOAT2>& quadrantObjectsCenters(unsigned int quadrantIndex)const;
+		unsigned int& quadrantFirstObject(unsigned int quadrantIndex);
+		unsigned int quadrantFirstObject(unsigned int quadrantIndex)const;
+
+		unsigned int& quadrantLastObject(unsigned int quadrantIndex);
+
+		unsigned int& quadrantObjectsCount(unsigned int quadrantIndex);
+		unsigned int quadrantObjectsCount(unsigned int quadrantIndex)const;
+
+		PooledObject& pooledObject(unsigned int objectIndex);
+		const PooledObject& pooledObject(unsigned int objectIndex)const;
 
-		std::vector<ObjectData>& quadrantObjectsDatas(unsigned int quadrantIndex);
-		const std::vector<ObjectData>& quadrantObjectsDatas(unsigned int quadrantIndex)const;
-		
 		XMFLOAT2& perDepthQuadrantSize(unsigned int depth);
 		const XMFLOAT2& perDepthQuadrantSize(unsigned int depth)const;
-		
+
 		unsigned int childrenOffsets(unsigned int depth)const;
 
-		void setQuadrantDepth(unsigned int quadrantIndex, unsigned int quadrantDepth);
 		unsigned int perQuadrantDepth(unsigned int quadrantIndex)const;
 
-		void setQuadrantSubdivided(unsigned int quadrantIndex, bool quadrantSubdivided);				
+		void setQuadrantSubdivided(unsigned int quadrantIndex, bool quadrantSubdivided);
 		bool isQuadrantSubdivided(unsigned int quadrantIndex)const;
-		
+
 
 		static constexpr unsigned int sk_maxDepth = MAX_DEPTH;
 		static constexpr unsigned int sk_maxQuadrantsCount = quadrantsCount(sk_maxDepth);
 
-		std::vector<XMFLOAT2> m_perQuadrantObjectsCenters[sk_maxQuadrantsCount];
-		std::vector<ObjectData> m_perQuadrantObjectsDatas[sk_maxQuadrantsCount];
+		//the depths, parents and children offsets of the quadrants, which depend only on MAX_DEPTH
+		using Topology = QuadtreeTopology<MAX_DEPTH>;
+
+		//objectsCapacity elements each, sized by the constructor
+		std::vector<PooledObject> m_objectsPool;
+		std::vector<PooledObject> m_sortingPool; //buildBulk() sorts back and forth between the two pools
+
+		unsigned int m_perQuadrantFirstObject[sk_maxQuadrantsCount];
+		unsigned int m_perQuadrantLastObject[sk_maxQuadrantsCount];
+		unsigned int m_perQuadrantObjectsCount[sk_maxQuadrantsCount];
 
 		/*
 		starting from the first quadrant, which cover the entire area,
@@ -79,111 +287,91 @@ namespace ArkanoidGame
 		*/
 		Quadrant m_quadrants[sk_maxQuadrantsCount];
 
-		XMFLOAT2 m_objectsHalfExtents;
+		XMFLOAT2 m_perClassHalfExtents[sk_maxObjectClassesCount];
 		XMFLOAT2 m_perDepthQuadrantSize[sk_maxDepth + 1]; //from depth == 0 (entire area) to sk_maxDepth inclusive
-		unsigned int m_perQuadrantDepth[sk_maxQuadrantsCount];
-		unsigned int m_childrenOffsets[sk_maxDepth]; //not sk_maxDepth + 1 because leaves haven't children
 		bool m_perQuadrantSubdivided[sk_maxQuadrantsCount];
+
+		unsigned int m_objectsCount{ 0 };
+		unsigned int m_usedObjectsSlotsCount{ 0 }; //the slots after it have never been used
+		unsigned int m_firstFreeObject{ sk_invalidObjectIndex }; //removed slots, linked through the pool
+
+		unsigned int m_modificationsCount{ 0 };
 	};
-	
+
 	//Quadtree implementation
 
 	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
-	inline 
+	inline
 		Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::
-			Quadtree(const AABB& quadtreeArea, const XMFLOAT2& objectsHalfExtents) : m_objectsHalfExtents{ objectsHalfExtents }
+			Quadtree(const AABB& quadtreeArea, const XMFLOAT2& objectsHalfExtents,
+					 unsigned int objectsCapacity) : m_objectsPool(objectsCapacity),
+													 m_sortingPool(objectsCapacity)
 	{
-		quadrant(0).min() = quadtreeArea.min();
-
-		const XMFLOAT2 areaSize = quadtreeArea.max() - quadtreeArea.min();
-
-		XMFLOAT2 currQuadrantSize = areaSize;
-		for (unsigned int depth = 0; depth <= sk_maxDepth; ++depth)
-		{
-			perDepthQuadrantSize(depth) = currQuadrantSize;
-			currQuadrantSize = currQuadrantSize * 0.5f;
-		}
-
-		for (unsigned int depth = 0; depth < sk_maxDepth; ++depth)
+		for (unsigned int objectClass = 0; objectClass < sk_maxObjectClassesCount; ++objectClass)
 		{
-			m_childrenOffsets[depth] = computeSiblingsOffset(depth + 1, sk_maxDepth);
+			m_perClassHalfExtents[objectClass] = objectsHalfExtents;
 		}
 
-		buildQuadrant(0, 0);
+		setArea(quadtreeArea);
+		clear();
 	}
 
 	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
 	inline
-		void 
-			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::buildQuadrant(unsigned int quadrantIndex, unsigned int currDepth)
+		void
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::setArea(const AABB& quadtreeArea)
 	{
-		assert(quadrantIndex < sk_maxQuadrantsCount);
-		assert(currDepth <= sk_maxDepth);
-
-		Quadrant& parent = quadrant(quadrantIndex);
+		quadrant(0).min() = quadtreeArea.min();
 
-		setQuadrantDepth(quadrantIndex, currDepth);
-		setQuadrantSubdivided(quadrantIndex, false);
+		const XMFLOAT2 areaSize = quadtreeArea.max() - quadtreeArea.min();
 
-		if (currDepth == sk_maxDepth)
+		XMFLOAT2 currQuadrantSize = areaSize;
+		for (unsigned int depth = 0; depth <= sk_maxDepth; ++depth)
 		{
-			return;
+			perDepthQuadrantSize(depth) = currQuadrantSize;
+			currQuadrantSize = currQuadrantSize * 0.5f;
 		}
 
-		unsigned int siblingOffset = childrenOffsets(currDepth);
-
-		unsigned int childrenDepth = currDepth + 1;
-
-		const XMFLOAT2& childrenSize = perDepthQuadrantSize(childrenDepth);
-		
-		const unsigned int firstQuadrantIndex = quadrantIndex + 1;
-		const unsigned int secondQuadrantIndex = firstQuadrantIndex + siblingOffset;
-		const unsigned int thirdQuadrantIndex = secondQuadrantIndex + siblingOffset;
-		const unsigned int fourthQuadrantIndex = thirdQuadrantIndex + siblingOffset;
-
-		Quadrant& firstQuadrant = quadrant(firstQuadrantIndex);
-		firstQuadrant.min() = parent.min();
-
-		Quadrant& secondQuadrant = quadrant(secondQuadrantIndex);
-		secondQuadrant.min() = firstQuadrant.min() + XMFLOAT2{ childrenSize.x + gk_epsilon, 0.0f };
+		//a quadrant follows its parent, so the parent is placed first. the children are placed in the quadrants
+		//order (min, +x, +y, +x+y), gk_epsilon apart
+		for (unsigned int quadrantIndex = 1; quadrantIndex < sk_maxQuadrantsCount; ++quadrantIndex)
+		{
+			const XMFLOAT2& quadrantSize = perDepthQuadrantSize(perQuadrantDepth(quadrantIndex));
 
-		Quadrant& thirdQuadrant = quadrant(thirdQuadrantIndex);
-		thirdQuadrant.min() = firstQuadrant.min() + XMFLOAT2{ 0.0f, childrenSize.y + gk_epsilon };
+			const float offsetsX[4] = { 0.0f, quadrantSize.x + gk_epsilon, 0.0f, quadrantSize.x + gk_epsilon };
+			const float offsetsY[4] = { 0.0f, 0.0f, quadrantSize.y + gk_epsilon, quadrantSize.y + gk_epsilon };
 
-		Quadrant& fourthQuadrant = quadrant(fourthQuadrantIndex);
-		fourthQuadrant.min() = firstQuadrant.min() + XMFLOAT2{ childrenSize.x + gk_epsilon, childrenSize.y + gk_epsilon };
+			const unsigned int siblingIndex = Topology::sk_perQuadrantSiblingIndex[quadrantIndex];
 
-		buildQuadrant(firstQuadrantIndex, childrenDepth);
-		buildQuadrant(secondQuadrantIndex, childrenDepth);
-		buildQuadrant(thirdQuadrantIndex, childrenDepth);
-		buildQuadrant(fourthQuadrantIndex, childrenDepth);
+			quadrant(quadrantIndex).min() = quadrant(Topology::sk_perQuadrantParent[quadrantIndex]).min() + XMFLOAT2{ offsetsX[siblingIndex], offsetsY[siblingIndex] };
+		}
 	}
 
 	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
 	inline
 		void
 			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::insert(const XMFLOAT2& objectCenter,
-																	   const ObjectData& objectData)
+																	   const ObjectData& objectData,
+																	   unsigned int objectClass)
 	{
-		const AABB objectAABB = AABB::computeFromCenterAndHalfExtents(objectCenter, m_objectsHalfExtents);
+		const unsigned int objectIndex = allocateObject();
+		pooledObject(objectIndex).center = objectCenter;
+		pooledObject(objectIndex).data = objectData;
+		pooledObject(objectIndex).objectClass = static_cast<unsigned char>(objectClass);
+
+		const AABB objectAABB = AABB::computeFromCenterAndHalfExtents(objectCenter, objectClassHalfExtents(objectClass));
 		const XMFLOAT2 objectAABBMin = objectAABB.min();
 		const XMFLOAT2 objectAABBMax = objectAABB.max();
 
 		unsigned int currDepth = 0;
 		unsigned int currQuadrantIndex = 0;
 
-		auto addObjectToQuadrant = [this, &currQuadrantIndex, &objectCenter, &objectData]()
-		{
-			quadrantObjectsCenters(currQuadrantIndex).push_back(objectCenter);
-			quadrantObjectsDatas(currQuadrantIndex).push_back(objectData);			
-		};
-		
 		while (true)
 		{
 			if (!isQuadrantSubdivided(currQuadrantIndex))
 			{
-				addObjectToQuadrant();
-				
+				addObjectToQuadrant(currQuadrantIndex, objectIndex);
+
 				if (currDepth < sk_maxDepth && shouldSubdivide(currQuadrantIndex))
 				{
 					subdivide(currQuadrantIndex, currDepth);
@@ -197,7 +385,7 @@ namespace ArkanoidGame
 			//continue the insertion in one child
 			const unsigned int childrenOffset = childrenOffsets(currDepth);
 			++currDepth;
-			
+
 			const XMFLOAT2& childQuadrantsSize = perDepthQuadrantSize(currDepth);
 
 			unsigned int childIndex = currQuadrantIndex + 1;
@@ -217,9 +405,9 @@ namespace ArkanoidGame
 			if (child == 4)
 			{
 				//the object doesn't fit any child, so keep it at this level
-				addObjectToQuadrant();
+				addObjectToQuadrant(currQuadrantIndex, objectIndex);
 				break;
-			}			
+			}
 		}
 	}
 
@@ -231,201 +419,1023 @@ namespace ArkanoidGame
 		assert(currDepth < sk_maxDepth);
 		assert(!isQuadrantSubdivided(quadrantIndex));
 
-		bool done = false;
+		const unsigned int childrenOffset = childrenOffsets(currDepth);
+		const unsigned int childrenDepth = currDepth + 1;
+		const XMFLOAT2& childrenQuadrantSize = perDepthQuadrantSize(childrenDepth);
+
+		unsigned int childrenIndices[4];
+		computeChildrenIndices(quadrantIndex, childrenIndices, childrenOffset);
+
+		//relink each object either to the child containing it or back to the quadrant, keeping their order
+
+		unsigned int objectIndex = quadrantFirstObject(quadrantIndex);
+		clearQuadrantObjects(quadrantIndex);
 
-		while (!done)
+		while (objectIndex != sk_invalidObjectIndex)
 		{
-			unsigned int childrenOffset = childrenOffsets(currDepth);
-			++currDepth;
-			const XMFLOAT2& childrenQuadrantSize = perDepthQuadrantSize(currDepth);
+			const unsigned int nextObjectIndex = pooledObject(objectIndex).nextObject;
+
+			const PooledObject& object = pooledObject(objectIndex);
+			const AABB objectAABB = AABB::computeFromCenterAndHalfExtents(object.center, objectClassHalfExtents(object.objectClass));
+			const XMFLOAT2 objectAABBMin = objectAABB.min();
+			const XMFLOAT2 objectAABBMax = objectAABB.max();
+
+			unsigned int destinationQuadrantIndex = quadrantIndex;
+
+			for (unsigned int child = 0; child < 4; ++child)
+			{
+				const unsigned int childrenIndex = childrenIndices[child];
+
+				if (quadrant(childrenIndex).contains(objectAABBMin, objectAABBMax, childrenQuadrantSize))
+				{
+					destinationQuadrantIndex = childrenIndex;
+					break;
+				}
+			}
+
+			addObjectToQuadrant(destinationQuadrantIndex, objectIndex);
 
-			unsigned int childrenIndices[4];
-			computeChildrenIndices(quadrantIndex, childrenIndices, childrenOffset);
-			
-			std::vector<XMFLOAT2>& objectsCenters = quadrantObjectsCenters(quadrantIndex);
-			std::vector<ObjectData>& objectsDatas = quadrantObjectsDatas(quadrantIndex);
+			objectIndex = nextObjectIndex;
+		}
 
-			//remove from the quadrant's objects the ones belonging to the children
-			//and keep the remaining ones
+		setQuadrantSubdivided(quadrantIndex, true);
 
-			int objectsCount = static_cast<int>(objectsCenters.size()); 
+		if (childrenDepth == sk_maxDepth)
+		{
+			//all done!
+			return;
+		}
 
-			for (int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+		//the objects may have been spread among the children, and each child may satisfy the condition on its own
+		for (unsigned int child = 0; child < 4; ++child)
+		{
+			const unsigned int childrenIndex = childrenIndices[child];
+			if (shouldSubdivide(childrenIndex))
 			{
-				const XMFLOAT2& objectCenter = objectsCenters[objectIndex];
+				subdivide(childrenIndex, childrenDepth);
+			}
+		}
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		void
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::build(const AABB& quadtreeArea,
+																	  const XMFLOAT2* objectsCenters,
+																	  const ObjectData* objectsDatas,
+																	  unsigned int objectsCount,
+																	  const unsigned int* objectsClasses)
+	{
+		assert(objectsCount <= objectsCapacity());
+		assert(objectsCount == 0 || (objectsCenters != nullptr && objectsDatas != nullptr));
 
-				const AABB objectAABB = AABB::computeFromCenterAndHalfExtents(objectCenter, m_objectsHalfExtents);
-				const XMFLOAT2 objectAABBMin = objectAABB.min();
-				const XMFLOAT2 objectAABBMax = objectAABB.max();
+		setArea(quadtreeArea);
+		clear();
 
-				for (unsigned int child = 0; child < 4; ++child)
-				{
-					const unsigned int childrenIndex = childrenIndices[child];
-					const Quadrant& childQuadrant = quadrant(childrenIndex);
+		//first pass: copy the objects to the pool, each one with the deepest quadrant containing it,
+		//and count the objects contained by each quadrant
+		unsigned int perQuadrantContainedObjectsCount[sk_maxQuadrantsCount]{};
 
-					if (childQuadrant.contains(objectAABBMin, objectAABBMax, childrenQuadrantSize))
-					{
-						quadrantObjectsCenters(childrenIndex).push_back(std::move(objectCenter));
-						quadrantObjectsDatas(childrenIndex).push_back(std::move(objectsDatas[objectIndex]));
+		unsigned int pathQuadrantsIndices[sk_maxDepth + 1];
 
-						objectsCenters.erase(objectsCenters.begin() + objectIndex);
-						objectsDatas.erase(objectsDatas.begin() + objectIndex);
+		for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+		{
+			const XMFLOAT2& objectCenter = objectsCenters[objectIndex];
+			const unsigned int objectClass = objectsClasses != nullptr ? objectsClasses[objectIndex] : 0;
 
-						--objectIndex;
-						--objectsCount;
+			const unsigned int pathLength = computeObjectPath(objectCenter, objectClass, true, pathQuadrantsIndices);
 
-						break;
-					}
-				}				
+			for (unsigned int pathIndex = 0; pathIndex < pathLength; ++pathIndex)
+			{
+				++perQuadrantContainedObjectsCount[pathQuadrantsIndices[pathIndex]];
 			}
 
-			setQuadrantSubdivided(quadrantIndex, true);
+			PooledObject& object = pooledObject(objectIndex);
+			object.center = objectCenter;
+			object.data = objectsDatas[objectIndex];
+			object.objectClass = static_cast<unsigned char>(objectClass);
+			object.nextObject = pathQuadrantsIndices[pathLength - 1];
+		}
+
+		//subdivide the quadrants as insert() would do: a quadrant is reached by all the objects it contains
+		//once its ancestors are subdivided, so the counts are final.
+		//the quadrants are visited in depth-first order, so a parent is decided before its children
+		unsigned int currQuadrantIndex = 0;
+		while (currQuadrantIndex < sk_maxQuadrantsCount)
+		{
+			const unsigned int currDepth = perQuadrantDepth(currQuadrantIndex);
 
 			if (currDepth == sk_maxDepth)
 			{
-				//all done!
-				break;
+				++currQuadrantIndex;
+				continue;
 			}
 
-			//check if a child needs to be subdivided...just one, because we subdivide a quadrant as soon as it satisfy a condition.
-			//thus, in the worst case the situation is repeated iff all objects have been transferred entirely to a child.
+			if (SubdivisionPolicy::shouldSubdivideQuadrant(perQuadrantContainedObjectsCount[currQuadrantIndex], currDepth,
+														   perDepthQuadrantSize(currDepth)))
+			{
+				//continue with the first child
+				setQuadrantSubdivided(currQuadrantIndex, true);
+				++currQuadrantIndex;
+				continue;
+			}
 
-			unsigned int child = 0;
-			for (; child < 4; ++child)
+			//a leaf: no object reaches its descendants, which stay leaves too
+			currQuadrantIndex += 1 + 4 * childrenOffsets(currDepth);
+		}
+
+		//second pass: count the objects placed in each quadrant...
+		for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+		{
+			unsigned int& objectQuadrantIndex = pooledObject(objectIndex).nextObject;
+			objectQuadrantIndex = placedObjectQuadrant(objectQuadrantIndex);
+
+			++quadrantObjectsCount(objectQuadrantIndex);
+		}
+
+		//...give to the objects of each quadrant consecutive slots, in the quadrants order and then in the given order...
+		unsigned int(&perQuadrantNextSlot)[sk_maxQuadrantsCount] = perQuadrantContainedObjectsCount;
+
+		unsigned int firstSlot = 0;
+		for (unsigned int quadrantIndex = 0; quadrantIndex < sk_maxQuadrantsCount; ++quadrantIndex)
+		{
+			const unsigned int quadrantObjects = quadrantObjectsCount(quadrantIndex);
+
+			if (quadrantObjects != 0)
 			{
-				const unsigned int childrenIndex = childrenIndices[child];
-				if (shouldSubdivide(childrenIndex))
-				{
-					quadrantIndex = childrenIndex;
-					break;
-				}
+				quadrantFirstObject(quadrantIndex) = firstSlot;
+				quadrantLastObject(quadrantIndex) = firstSlot + quadrantObjects - 1;
+			}
+
+			perQuadrantNextSlot[quadrantIndex] = firstSlot;
+			firstSlot += quadrantObjects;
+		}
+
+		for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+		{
+			unsigned int& objectSlot = pooledObject(objectIndex).nextObject;
+			objectSlot = perQuadrantNextSlot[objectSlot]++;
+		}
+
+		//...and scatter them there: each swap moves one object to its final slot
+		for (unsigned int slot = 0; slot < objectsCount; ++slot)
+		{
+			PooledObject& object = pooledObject(slot);
+
+			while (object.nextObject != slot)
+			{
+				std::swap(object, pooledObject(object.nextObject));
 			}
+		}
+
+		//the objects of a quadrant are linked in slots order
+		for (unsigned int slot = 0; slot < objectsCount; ++slot)
+		{
+			pooledObject(slot).nextObject = slot + 1;
+		}
 
-			done = (child == 4);
+		for (unsigned int quadrantIndex = 0; quadrantIndex < sk_maxQuadrantsCount; ++quadrantIndex)
+		{
+			if (quadrantObjectsCount(quadrantIndex) != 0)
+			{
+				pooledObject(quadrantLastObject(quadrantIndex)).nextObject = sk_invalidObjectIndex;
+			}
 		}
+
+		m_objectsCount = objectsCount;
+		m_usedObjectsSlotsCount = objectsCount;
 	}
-		
+
 	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
 	inline
-		unsigned int
-			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::findPotentialColliders(const AABB& objectAABB,
-																					   ObjectData* foundObjects)const
+		void
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::buildBulk(const AABB& quadtreeArea,
+																		  const XMFLOAT2* objectsCenters,
+																		  const ObjectData* objectsDatas,
+																		  unsigned int objectsCount,
+																		  const unsigned int* objectsClasses)
 	{
-		assert(foundObjects != nullptr);
-		
-		unsigned int foundObjectsCount = 0;
+		static_assert(sk_maxDepth <= 16, "the Morton codes hold 16 bits per axis");
 
-		const XMFLOAT2 objectAABBMin = objectAABB.min();
-		const XMFLOAT2 objectAABBMax = objectAABB.max();
+		assert(objectsCount <= objectsCapacity());
+		assert(objectsCount == 0 || (objectsCenters != nullptr && objectsDatas != nullptr));
+
+		setArea(quadtreeArea);
+		clear();
+
+		//the leaves cells, the centers outside the area are clamped to the border cells
+		const XMFLOAT2& areaMin = quadrant(0).min();
+		const XMFLOAT2& leafSize = perDepthQuadrantSize(sk_maxDepth);
+		const XMFLOAT2 cellsPerUnit{ 1.0f / leafSize.x, 1.0f / leafSize.y };
+		const float maxCell = static_cast<float>((1 << sk_maxDepth) - 1);
+
+		//copy the objects to the pool, each one with the deepest quadrant containing it as sorting key
+		for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+		{
+			const XMFLOAT2& objectCenter = objectsCenters[objectIndex];
+
+			const float cellX = std::min(std::max((objectCenter.x - areaMin.x) * cellsPerUnit.x, 0.0f), maxCell);
+			const float cellY = std::min(std::max((objectCenter.y - areaMin.y) * cellsPerUnit.y, 0.0f), maxCell);
+			const unsigned int centerMortonCode = computeMortonCode(static_cast<unsigned int>(cellX), static_cast<unsigned int>(cellY));
+			const unsigned int objectClass = objectsClasses != nullptr ? objectsClasses[objectIndex] : 0;
+
+			PooledObject& object = pooledObject(objectIndex);
+			object.center = objectCenter;
+			object.data = objectsDatas[objectIndex];
+			object.objectClass = static_cast<unsigned char>(objectClass);
+			object.nextObject = computeContainingQuadrant(objectCenter, objectClass, centerMortonCode);
+		}
 
 		/*
-		quadrantsIndicesStack is a stack used to navigate the quadtree in a depth-first fashion.
-		initially, it contains only the root. on each iteration of the next
-		while-loop, one element of the stack is popped out and AT MOST four are pushed in.
-		this continues until leaves are found, in which case they are popped out until a non-leaf node is found again.
-		because of this, we can compute an upper-bound of the stack size:
-		(((1 - 1) + 4) - 1 + 4)...etc, until max_depth passes have been done
+		the quadrants are in depth-first order, which is the Morton order of their cells with each quadrant before its descendants.
+		the least significant digit radix sort is stable, so the objects of a quadrant keep the given order
 		*/
-		unsigned int quadrantsIndicesStack[3 * sk_maxDepth + 1];
-		int stackPointer = -1; //-1 => empty stack
+		PooledObject* sourceObjects = m_objectsPool.data();
+		PooledObject* sortedObjects = m_sortingPool.data();
 
-		++stackPointer;
-		quadrantsIndicesStack[stackPointer] = 0; //push root
-				
-		while (stackPointer != -1)
+		for (unsigned int shift = 0; ((sk_maxQuadrantsCount - 1) >> shift) != 0; shift += sk_radixBits)
 		{
-			assert(stackPointer < 3 * sk_maxDepth + 1);
-			const unsigned int quadrantIndex = quadrantsIndicesStack[stackPointer];
-			--stackPointer;
+			unsigned int bucketsFirstObject[sk_radixBucketsCount]{};
 
-			const unsigned int quadrantDepth = perQuadrantDepth(quadrantIndex);
+			for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+			{
+				++bucketsFirstObject[(sourceObjects[objectIndex].nextObject >> shift) & (sk_radixBucketsCount - 1)];
+			}
 
-			const Quadrant& currQuadrant = quadrant(quadrantIndex);
-			
-			if (currQuadrant.outside(objectAABBMin, objectAABBMax, perDepthQuadrantSize(quadrantDepth)))
+			unsigned int firstObject = 0;
+			for (unsigned int bucket = 0; bucket < sk_radixBucketsCount; ++bucket)
 			{
-				//the object doesn't touch the current quadrant, so skip its objects
-				continue;
+				const unsigned int bucketObjectsCount = bucketsFirstObject[bucket];
+				bucketsFirstObject[bucket] = firstObject;
+				firstObject += bucketObjectsCount;
 			}
 
-			//add all the quadrant objects
-			for (auto& quadrantObjectData : quadrantObjectsDatas(quadrantIndex))
+			for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
 			{
-				foundObjects[foundObjectsCount++] = quadrantObjectData;
+				const PooledObject& object = sourceObjects[objectIndex];
+				sortedObjects[bucketsFirstObject[(object.nextObject >> shift) & (sk_radixBucketsCount - 1)]++] = object;
 			}
 
-			if (isQuadrantSubdivided(quadrantIndex))
+			std::swap(sourceObjects, sortedObjects);
+		}
+
+		if (sourceObjects != m_objectsPool.data())
+		{
+			m_objectsPool.swap(m_sortingPool);
+		}
+
+		//the sweep: the objects of each quadrant are contiguous, and a quadrant's descendants follow it
+		unsigned int perQuadrantFirstSlot[sk_maxQuadrantsCount + 1];
+
+		unsigned int slot = 0;
+		for (unsigned int quadrantIndex = 0; quadrantIndex < sk_maxQuadrantsCount; ++quadrantIndex)
+		{
+			perQuadrantFirstSlot[quadrantIndex] = slot;
+
+			while (slot < objectsCount && pooledObject(slot).nextObject == quadrantIndex)
 			{
-				unsigned int childrenIndices[4];
-				computeChildrenIndices(quadrantIndex, childrenIndices, childrenOffsets(quadrantDepth));
+				++slot;
+			}
+		}
 
-				//check the first child before
-				for (int child = 3; child >= 0; --child)
-				{
-					++stackPointer;
-					quadrantsIndicesStack[stackPointer] = childrenIndices[child];
-				}
+		perQuadrantFirstSlot[sk_maxQuadrantsCount] = objectsCount;
+
+		//subdivide as build() does: the objects contained by a quadrant are the slots of its descendants too
+		unsigned int currQuadrantIndex = 0;
+		while (currQuadrantIndex < sk_maxQuadrantsCount)
+		{
+			const unsigned int currDepth = perQuadrantDepth(currQuadrantIndex);
+
+			const unsigned int descendantsEnd = currDepth == sk_maxDepth ? currQuadrantIndex + 1 : currQuadrantIndex + 1 + 4 * childrenOffsets(currDepth);
+			const unsigned int containedObjectsCount = perQuadrantFirstSlot[descendantsEnd] - perQuadrantFirstSlot[currQuadrantIndex];
+
+			if (currDepth < sk_maxDepth &&
+				SubdivisionPolicy::shouldSubdivideQuadrant(containedObjectsCount, currDepth, perDepthQuadrantSize(currDepth)))
+			{
+				//the quadrant keeps the objects which don't fit any child, then continue with the first child
+				setQuadrantSubdivided(currQuadrantIndex, true);
+				assignQuadrantSlots(currQuadrantIndex, perQuadrantFirstSlot[currQuadrantIndex], perQuadrantFirstSlot[currQuadrantIndex + 1]);
+				++currQuadrantIndex;
+				continue;
 			}
+
+			//a leaf: it takes the objects of its descendants too
+			assignQuadrantSlots(currQuadrantIndex, perQuadrantFirstSlot[currQuadrantIndex], perQuadrantFirstSlot[descendantsEnd]);
+			currQuadrantIndex = descendantsEnd;
 		}
 
-		return foundObjectsCount;
+		m_objectsCount = objectsCount;
+		m_usedObjectsSlotsCount = objectsCount;
 	}
-	
+
 	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
 	inline
-		bool
-			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::shouldSubdivide(unsigned int quadrantIndex) const
-	{
-		return SubdivisionPolicy::shouldSubdivideQuadrant(static_cast<unsigned int>(quadrantObjectsCenters(quadrantIndex).size()));		
-	}
-		
-	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
-	inline 
-		std::vector<XMFLOAT2>&
-			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::quadrantObjectsCenters(unsigned int quadrantIndex)
+		unsigned int
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::findPotentialColliders(const AABB& objectAABB,
+																					   ObjectData* foundObjects)const
 	{
-		assert(quadrantIndex < sk_maxQuadrantsCount);
-		return m_perQuadrantObjectsCenters[quadrantIndex];
-	}
+		assert(foundObjects != nullptr);
 
-	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
-	inline 
-		const std::vector<XMFLOAT2>&
-			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::quadrantObjectsCenters(unsigned int quadrantIndex) const
-	{
-		assert(quadrantIndex < sk_maxQuadrantsCount);
-		return m_perQuadrantObjectsCenters[quadrantIndex];
+		unsigned int foundObjectsCount = 0;
+
+		visitPotentialColliders(objectAABB, [foundObjects, &foundObjectsCount](const ObjectData& objectData, const XMFLOAT2&)
+		{
+			foundObjects[foundObjectsCount++] = objectData;
+			return true;
+		});
+
+		return foundObjectsCount;
 	}
 
 	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
-	inline 
-		std::vector<ObjectData>&
-			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::quadrantObjectsDatas(unsigned int quadrantIndex)
+	inline
+		unsigned int
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::findPotentialColliders(const AABB& objectAABB,
+																					   ObjectData* foundObjects,
+																					   unsigned int& visitedQuadrantsCount)const
 	{
-		assert(quadrantIndex < sk_maxQuadrantsCount);
-		return m_perQuadrantObjectsDatas[quadrantIndex];
+		assert(foundObjects != nullptr);
+
+		unsigned int foundObjectsCount = 0;
+
+		auto visitor = [foundObjects, &foundObjectsCount](const ObjectData& objectData, const XMFLOAT2&)
+		{
+			foundObjects[foundObjectsCount++] = objectData;
+			return true;
+		};
+
+		visitedQuadrantsCount = 0;
+		visitQuadrantPotentialColliders<0>(0, objectAABB.min(), objectAABB.max(), objectAABB.center(), visitor,
+										   QUADRANTS_VISIT_IN_ORDER, visitedQuadrantsCount);
+
+		return foundObjectsCount;
 	}
 
 	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
-	inline 
-		const std::vector<ObjectData>&
-			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::quadrantObjectsDatas(unsigned int quadrantIndex) const
+	template<typename Visitor>
+	inline
+		bool
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::visitPotentialColliders(const AABB& objectAABB, Visitor&& visitor,
+																						EQuadrantsVisitOrder visitOrder)const
 	{
-		assert(quadrantIndex < sk_maxQuadrantsCount);
-		return m_perQuadrantObjectsDatas[quadrantIndex];
+		const XMFLOAT2 objectAABBMin = objectAABB.min();
+		const XMFLOAT2 objectAABBMax = objectAABB.max();
+
+		unsigned int visitedQuadrantsCount = 0;
+		return visitQuadrantPotentialColliders<0>(0, objectAABBMin, objectAABBMax, objectAABB.center(), visitor, visitOrder, visitedQuadrantsCount);
 	}
 
 	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
-	inline 
-		Quadrant&
-			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::quadrant(unsigned int quadrantIndex)
+	template<unsigned int DEPTH, typename Visitor>
+	inline
+		bool
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::visitQuadrantPotentialColliders(unsigned int quadrantIndex,
+																								const XMFLOAT2& objectAABBMin,
+																								const XMFLOAT2& objectAABBMax,
+																								const XMFLOAT2& objectAABBCenter,
+																								Visitor& visitor,
+																								EQuadrantsVisitOrder visitOrder,
+																								unsigned int& visitedQuadrantsCount)const
 	{
-		assert(quadrantIndex < sk_maxQuadrantsCount);
+		assert(perQuadrantDepth(quadrantIndex) == DEPTH);
+
+		++visitedQuadrantsCount;
+
+		if (quadrant(quadrantIndex).outside(objectAABBMin, objectAABBMax, perDepthQuadrantSize(DEPTH)))
+		{
+			//the object doesn't touch the current quadrant, so skip its objects
+			return true;
+		}
+
+		//visit all the quadrant objects
+		for (unsigned int objectIndex = quadrantFirstObject(quadrantIndex); objectIndex != sk_invalidObjectIndex; objectIndex = pooledObject(objectIndex).nextObject)
+		{
+			const PooledObject& object = pooledObject(objectIndex);
+
+			if (!visitor(object.data, object.center))
+			{
+				return false;
+			}
+		}
+
+		return visitChildrenPotentialColliders<DEPTH>(quadrantIndex, objectAABBMin, objectAABBMax, objectAABBCenter, visitor, visitOrder,
+													  visitedQuadrantsCount, std::integral_constant<bool, (DEPTH < sk_maxDepth)>{});
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	template<unsigned int DEPTH, typename Visitor>
+	inline
+		bool
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::visitChildrenPotentialColliders(unsigned int quadrantIndex,
+																								const XMFLOAT2& objectAABBMin,
+																								const XMFLOAT2& objectAABBMax,
+																								const XMFLOAT2& objectAABBCenter,
+																								Visitor& visitor,
+																								EQuadrantsVisitOrder visitOrder,
+																								unsigned int& visitedQuadrantsCount,
+																								std::true_type)const
+	{
+		if (!isQuadrantSubdivided(quadrantIndex))
+		{
+			return true;
+		}
+
+		constexpr unsigned int siblingsOffset = Topology::sk_childrenOffsets[DEPTH];
+
+		unsigned int childrenIndices[4] = { quadrantIndex + 1,
+											quadrantIndex + 1 + siblingsOffset,
+											quadrantIndex + 1 + 2 * siblingsOffset,
+											quadrantIndex + 1 + 3 * siblingsOffset };
+
+		if (visitOrder == QUADRANTS_VISIT_NEAREST_FIRST)
+		{
+			//insertion sort of the 4 children by increasing distance
+			const XMFLOAT2 childrenHalfSize = perDepthQuadrantSize(DEPTH + 1) * 0.5f;
+
+			float childrenDistances[4];
+			for (unsigned int child = 0; child < 4; ++child)
+			{
+				const unsigned int childIndex = childrenIndices[child];
+				const XMFLOAT2 childCenter = quadrant(childIndex).min() + childrenHalfSize;
+				const XMFLOAT2 offset = childCenter - objectAABBCenter;
+				const float distance = offset.x * offset.x + offset.y * offset.y;
+
+				unsigned int sortedChild = child;
+				for (; sortedChild > 0 && childrenDistances[sortedChild - 1] > distance; --sortedChild)
+				{
+					childrenDistances[sortedChild] = childrenDistances[sortedChild - 1];
+					childrenIndices[sortedChild] = childrenIndices[sortedChild - 1];
+				}
+
+				childrenDistances[sortedChild] = distance;
+				childrenIndices[sortedChild] = childIndex;
+			}
+		}
+
+		for (unsigned int child = 0; child < 4; ++child)
+		{
+			if (!visitQuadrantPotentialColliders<DEPTH + 1>(childrenIndices[child], objectAABBMin, objectAABBMax, objectAABBCenter,
+															 visitor, visitOrder, visitedQuadrantsCount))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	template<unsigned int DEPTH, typename Visitor>
+	inline
+		bool
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::visitChildrenPotentialColliders(unsigned int,
+																								const XMFLOAT2&,
+																								const XMFLOAT2&,
+																								const XMFLOAT2&,
+																								Visitor&,
+																								EQuadrantsVisitOrder,
+																								unsigned int&,
+																								std::false_type)const
+	{
+		return true;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		unsigned int
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::findSweptPotentialColliders(const XMFLOAT2& objectStart,
+																							const XMFLOAT2& objectDisplacement,
+																							const XMFLOAT2& objectHalfExtents,
+																							ObjectData* foundObjects)const
+	{
+		assert(foundObjects != nullptr);
+
+		unsigned int foundObjectsCount = 0;
+
+		visitSweptPotentialColliders(objectStart, objectDisplacement, objectHalfExtents,
+									 [foundObjects, &foundObjectsCount](const ObjectData& objectData, const XMFLOAT2&)
+		{
+			foundObjects[foundObjectsCount++] = objectData;
+			return true;
+		});
+
+		return foundObjectsCount;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	template<typename Visitor>
+	inline
+		bool
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::visitSweptPotentialColliders(const XMFLOAT2& objectStart,
+																							 const XMFLOAT2& objectDisplacement,
+																							 const XMFLOAT2& objectHalfExtents,
+																							 Visitor&& visitor)const
+	{
+		//the divisions are done once for all the quadrants
+		const float inverseDisplacementsX[2] = { 0.0f, 1.0f / objectDisplacement.x };
+		const float inverseDisplacementsY[2] = { 0.0f, 1.0f / objectDisplacement.y };
+		const XMFLOAT2 inverseDisplacement{ inverseDisplacementsX[static_cast<unsigned int>(objectDisplacement.x != 0.0f)],
+											inverseDisplacementsY[static_cast<unsigned int>(objectDisplacement.y != 0.0f)] };
+
+		const SweptObject sweptObject{ objectStart, inverseDisplacement, objectHalfExtents };
+
+		float enterTime;
+		if (!quadrant(0).crossed(objectStart, inverseDisplacement, objectHalfExtents, perDepthQuadrantSize(0), enterTime))
+		{
+			return true;
+		}
+
+		return visitQuadrantSweptPotentialColliders<0>(0, sweptObject, visitor);
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	template<unsigned int DEPTH, typename Visitor>
+	inline
+		bool
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::visitQuadrantSweptPotentialColliders(unsigned int quadrantIndex,
+																									 const SweptObject& sweptObject,
+																									 Visitor& visitor)const
+	{
+		assert(perQuadrantDepth(quadrantIndex) == DEPTH);
+
+		for (unsigned int objectIndex = quadrantFirstObject(quadrantIndex); objectIndex != sk_invalidObjectIndex; objectIndex = pooledObject(objectIndex).nextObject)
+		{
+			const PooledObject& object = pooledObject(objectIndex);
+
+			if (!visitor(object.data, object.center))
+			{
+				return false;
+			}
+		}
+
+		return visitChildrenSweptPotentialColliders<DEPTH>(quadrantIndex, sweptObject, visitor,
+														   std::integral_constant<bool, (DEPTH < sk_maxDepth)>{});
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	template<unsigned int DEPTH, typename Visitor>
+	inline
+		bool
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::visitChildrenSweptPotentialColliders(unsigned int quadrantIndex,
+																									 const SweptObject& sweptObject,
+																									 Visitor& visitor,
+																									 std::true_type)const
+	{
+		if (!isQuadrantSubdivided(quadrantIndex))
+		{
+			return true;
+		}
+
+		constexpr unsigned int siblingsOffset = Topology::sk_childrenOffsets[DEPTH];
+
+		const XMFLOAT2& childrenSize = perDepthQuadrantSize(DEPTH + 1);
+
+		//insertion sort of the crossed children by increasing enter time, the missed ones are skipped
+		unsigned int crossedChildrenIndices[4];
+		float crossedChildrenEnterTimes[4];
+		unsigned int crossedChildrenCount = 0;
+
+		for (unsigned int child = 0; child < 4; ++child)
+		{
+			const unsigned int childIndex = quadrantIndex + 1 + child * siblingsOffset;
+
+			float enterTime;
+			if (!quadrant(childIndex).crossed(sweptObject.start, sweptObject.inverseDisplacement, sweptObject.halfExtents, childrenSize, enterTime))
+			{
+				continue;
+			}
+
+			unsigned int sortedChild = crossedChildrenCount;
+			for (; sortedChild > 0 && crossedChildrenEnterTimes[sortedChild - 1] > enterTime; --sortedChild)
+			{
+				crossedChildrenEnterTimes[sortedChild] = crossedChildrenEnterTimes[sortedChild - 1];
+				crossedChildrenIndices[sortedChild] = crossedChildrenIndices[sortedChild - 1];
+			}
+
+			crossedChildrenEnterTimes[sortedChild] = enterTime;
+			crossedChildrenIndices[sortedChild] = childIndex;
+			++crossedChildrenCount;
+		}
+
+		for (unsigned int child = 0; child < crossedChildrenCount; ++child)
+		{
+			if (!visitQuadrantSweptPotentialColliders<DEPTH + 1>(crossedChildrenIndices[child], sweptObject, visitor))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	template<unsigned int DEPTH, typename Visitor>
+	inline
+		bool
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::visitChildrenSweptPotentialColliders(unsigned int,
+																									 const SweptObject&,
+																									 Visitor&,
+																									 std::false_type)const
+	{
+		return true;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		bool
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::remove(const XMFLOAT2& objectCenter,
+																	   const ObjectData& objectData,
+																	   unsigned int objectClass)
+	{
+		//the object is in the deepest quadrant containing it, as insert() and subdivide() place it.
+		//the quadrants from the root to that one are kept to merge them afterwards
+		unsigned int pathQuadrantsIndices[sk_maxDepth + 1];
+		const unsigned int pathLength = computeObjectPath(objectCenter, objectClass, false, pathQuadrantsIndices);
+
+		const unsigned int objectQuadrantIndex = pathQuadrantsIndices[pathLength - 1];
+
+		//unlink the object, keeping the order of the remaining ones
+		unsigned int previousObjectIndex = sk_invalidObjectIndex;
+		unsigned int objectIndex = quadrantFirstObject(objectQuadrantIndex);
+
+		while (objectIndex != sk_invalidObjectIndex && !(pooledObject(objectIndex).data == objectData))
+		{
+			previousObjectIndex = objectIndex;
+			objectIndex = pooledObject(objectIndex).nextObject;
+		}
+
+		if (objectIndex == sk_invalidObjectIndex)
+		{
+			return false;
+		}
+
+		const unsigned int nextObjectIndex = pooledObject(objectIndex).nextObject;
+
+		unsigned int& previousLink = previousObjectIndex == sk_invalidObjectIndex ? quadrantFirstObject(objectQuadrantIndex) : pooledObject(previousObjectIndex).nextObject;
+		previousLink = nextObjectIndex;
+
+		if (quadrantLastObject(objectQuadrantIndex) == objectIndex)
+		{
+			quadrantLastObject(objectQuadrantIndex) = previousObjectIndex;
+		}
+
+		--quadrantObjectsCount(objectQuadrantIndex);
+
+		freeObject(objectIndex);
+
+		//merge the emptied quadrants, bottom-up: a quadrant is merged only if its children are empty leaves
+		for (int pathIndex = static_cast<int>(pathLength) - 1; pathIndex >= 0; --pathIndex)
+		{
+			const unsigned int pathQuadrantIndex = pathQuadrantsIndices[pathIndex];
+
+			if (!isQuadrantSubdivided(pathQuadrantIndex))
+			{
+				continue;
+			}
+
+			if (!canMergeChildren(pathQuadrantIndex, static_cast<unsigned int>(pathIndex)))
+			{
+				break;
+			}
+
+			setQuadrantSubdivided(pathQuadrantIndex, false);
+		}
+
+		return true;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		bool
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::update(const XMFLOAT2& oldObjectCenter,
+																	   const XMFLOAT2& newObjectCenter,
+																	   const ObjectData& objectData,
+																	   unsigned int objectClass)
+	{
+		if (!remove(oldObjectCenter, objectData, objectClass))
+		{
+			return false;
+		}
+
+		insert(newObjectCenter, objectData, objectClass);
+		return true;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		bool
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::canMergeChildren(unsigned int quadrantIndex, unsigned int quadrantDepth)const
+	{
+		assert(isQuadrantSubdivided(quadrantIndex));
+
+		unsigned int childrenIndices[4];
+		computeChildrenIndices(quadrantIndex, childrenIndices, childrenOffsets(quadrantDepth));
+
+		for (unsigned int child = 0; child < 4; ++child)
+		{
+			const unsigned int childrenIndex = childrenIndices[child];
+
+			if (isQuadrantSubdivided(childrenIndex) || quadrantObjectsCount(childrenIndex) != 0)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		unsigned int
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::computeObjectPath(const XMFLOAT2& objectCenter, unsigned int objectClass,
+																				  bool allQuadrantsSubdivided,
+																				  unsigned int(&pathQuadrantsIndices)[MAX_DEPTH + 1])const
+	{
+		const AABB objectAABB = AABB::computeFromCenterAndHalfExtents(objectCenter, objectClassHalfExtents(objectClass));
+		const XMFLOAT2 objectAABBMin = objectAABB.min();
+		const XMFLOAT2 objectAABBMax = objectAABB.max();
+
+		unsigned int pathLength = 0;
+
+		unsigned int currDepth = 0;
+		unsigned int currQuadrantIndex = 0;
+		pathQuadrantsIndices[pathLength++] = currQuadrantIndex;
+
+		//the leaves are never subdivided
+		while (currDepth < sk_maxDepth && (allQuadrantsSubdivided || isQuadrantSubdivided(currQuadrantIndex)))
+		{
+			const unsigned int childrenOffset = childrenOffsets(currDepth);
+			const XMFLOAT2& childQuadrantsSize = perDepthQuadrantSize(currDepth + 1);
+
+			unsigned int childIndex = currQuadrantIndex + 1;
+
+			unsigned int child = 0;
+			for (; child < 4; ++child)
+			{
+				if (quadrant(childIndex).contains(objectAABBMin, objectAABBMax, childQuadrantsSize))
+				{
+					break;
+				}
+
+				childIndex += childrenOffset;
+			}
+
+			if (child == 4)
+			{
+				//the object doesn't fit any child, so it is at this level
+				break;
+			}
+
+			++currDepth;
+			currQuadrantIndex = childIndex;
+			pathQuadrantsIndices[pathLength++] = currQuadrantIndex;
+		}
+
+		return pathLength;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		unsigned int
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::placedObjectQuadrant(unsigned int containingQuadrantIndex)const
+	{
+		assert(containingQuadrantIndex < sk_maxQuadrantsCount);
+
+		unsigned int currDepth = 0;
+		unsigned int currQuadrantIndex = 0;
+
+		//descend towards the containing quadrant: a child is followed by all its descendants in the quadrants array
+		while (currQuadrantIndex != containingQuadrantIndex && isQuadrantSubdivided(currQuadrantIndex))
+		{
+			const unsigned int childrenOffset = childrenOffsets(currDepth);
+			const unsigned int containingQuadrantOffset = containingQuadrantIndex - currQuadrantIndex - 1;
+
+			const unsigned int child = static_cast<unsigned int>(containingQuadrantOffset >= childrenOffset) +
+									   static_cast<unsigned int>(containingQuadrantOffset >= 2 * childrenOffset) +
+									   static_cast<unsigned int>(containingQuadrantOffset >= 3 * childrenOffset);
+
+			currQuadrantIndex += 1 + child * childrenOffset;
+			++currDepth;
+		}
+
+		return currQuadrantIndex;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		unsigned int
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::computeContainingQuadrant(const XMFLOAT2& objectCenter,
+																						  unsigned int objectClass,
+																						  unsigned int centerMortonCode)const
+	{
+		const AABB objectAABB = AABB::computeFromCenterAndHalfExtents(objectCenter, objectClassHalfExtents(objectClass));
+		const XMFLOAT2 objectAABBMin = objectAABB.min();
+		const XMFLOAT2 objectAABBMax = objectAABB.max();
+
+		//a child containing the object contains its center too, so it is the only child to test
+		unsigned int currQuadrantIndex = 0;
+
+		for (unsigned int currDepth = 0; currDepth < sk_maxDepth; ++currDepth)
+		{
+			const unsigned int child = (centerMortonCode >> (2 * (sk_maxDepth - 1 - currDepth))) & 3;
+			const unsigned int childIndex = currQuadrantIndex + 1 + child * childrenOffsets(currDepth);
+
+			if (!quadrant(childIndex).contains(objectAABBMin, objectAABBMax, perDepthQuadrantSize(currDepth + 1)))
+			{
+				break;
+			}
+
+			currQuadrantIndex = childIndex;
+		}
+
+		return currQuadrantIndex;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		void
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::assignQuadrantSlots(unsigned int quadrantIndex,
+																					unsigned int firstSlot, unsigned int endSlot)
+	{
+		assert(firstSlot <= endSlot);
+
+		if (firstSlot == endSlot)
+		{
+			return;
+		}
+
+		for (unsigned int slot = firstSlot; slot < endSlot; ++slot)
+		{
+			pooledObject(slot).nextObject = slot + 1;
+		}
+
+		pooledObject(endSlot - 1).nextObject = sk_invalidObjectIndex;
+
+		quadrantFirstObject(quadrantIndex) = firstSlot;
+		quadrantLastObject(quadrantIndex) = endSlot - 1;
+		quadrantObjectsCount(quadrantIndex) = endSlot - firstSlot;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		void
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::clear()
+	{
+		for (unsigned int quadrantIndex = 0; quadrantIndex < sk_maxQuadrantsCount; ++quadrantIndex)
+		{
+			setQuadrantSubdivided(quadrantIndex, false);
+			clearQuadrantObjects(quadrantIndex);
+		}
+
+		m_objectsCount = 0;
+		m_usedObjectsSlotsCount = 0;
+		m_firstFreeObject = sk_invalidObjectIndex;
+
+		++m_modificationsCount;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		unsigned int
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::allocateObject()
+	{
+		assert(m_objectsCount < objectsCapacity());
+
+		++m_objectsCount;
+		++m_modificationsCount;
+
+		if (m_firstFreeObject == sk_invalidObjectIndex)
+		{
+			return m_usedObjectsSlotsCount++;
+		}
+
+		const unsigned int objectIndex = m_firstFreeObject;
+		m_firstFreeObject = pooledObject(objectIndex).nextObject;
+
+		return objectIndex;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		void
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::freeObject(unsigned int objectIndex)
+	{
+		assert(m_objectsCount > 0);
+
+		--m_objectsCount;
+		++m_modificationsCount;
+
+		pooledObject(objectIndex).nextObject = m_firstFreeObject;
+		m_firstFreeObject = objectIndex;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		void
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::addObjectToQuadrant(unsigned int quadrantIndex, unsigned int objectIndex)
+	{
+		//append, so that the objects are found in insertion order
+		pooledObject(objectIndex).nextObject = sk_invalidObjectIndex;
+
+		unsigned int& lastObjectIndex = quadrantLastObject(quadrantIndex);
+
+		unsigned int& previousLink = lastObjectIndex == sk_invalidObjectIndex ? quadrantFirstObject(quadrantIndex) : pooledObject(lastObjectIndex).nextObject;
+		previousLink = objectIndex;
+
+		lastObjectIndex = objectIndex;
+		++quadrantObjectsCount(quadrantIndex);
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		void
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::clearQuadrantObjects(unsigned int quadrantIndex)
+	{
+		quadrantFirstObject(quadrantIndex) = sk_invalidObjectIndex;
+		quadrantLastObject(quadrantIndex) = sk_invalidObjectIndex;
+		quadrantObjectsCount(quadrantIndex) = 0;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		AABB
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::area()const
+	{
+		return AABB::computeFromMinMax(quadrant(0).min(), quadrant(0).min() + perDepthQuadrantSize(0));
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		unsigned int
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::objectsCapacity()const
+	{
+		return static_cast<unsigned int>(m_objectsPool.size());
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		unsigned int
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::objectsCount()const
+	{
+		return m_objectsCount;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		void
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::setObjectClassHalfExtents(unsigned int objectClass,
+																						  const XMFLOAT2& halfExtents)
+	{
+		assert(objectClass < sk_maxObjectClassesCount);
+		assert(halfExtents.x > 0.0f && halfExtents.y > 0.0f);
+		m_perClassHalfExtents[objectClass] = halfExtents;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		const XMFLOAT2&
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::objectClassHalfExtents(unsigned int objectClass)const
+	{
+		assert(objectClass < sk_maxObjectClassesCount);
+		return m_perClassHalfExtents[objectClass];
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		unsigned int
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::modificationsCount()const
+	{
+		return m_modificationsCount;
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		size_t
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::memoryUsage()const
+	{
+		return sizeof(*this) + (m_objectsPool.capacity() + m_sortingPool.capacity()) * sizeof(PooledObject);
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		bool
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::shouldSubdivide(unsigned int quadrantIndex) const
+	{
+		const unsigned int depth = perQuadrantDepth(quadrantIndex);
+		return SubdivisionPolicy::shouldSubdivideQuadrant(quadrantObjectsCount(quadrantIndex), depth, perDepthQuadrantSize(depth));
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		Quadrant&
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::quadrant(unsigned int quadrantIndex)
+	{
+		assert(quadrantIndex < sk_maxQuadrantsCount);
 		return m_quadrants[quadrantIndex];
 	}
 
 	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
-	inline 
+	inline
 		const Quadrant&
 			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::quadrant(unsigned int quadrantIndex) const
 	{
@@ -434,7 +1444,70 @@ namespace ArkanoidGame
 	}
 
 	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
-	inline 
+	inline
+		unsigned int&
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::quadrantFirstObject(unsigned int quadrantIndex)
+	{
+		assert(quadrantIndex < sk_maxQuadrantsCount);
+		return m_perQuadrantFirstObject[quadrantIndex];
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		unsigned int
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::quadrantFirstObject(unsigned int quadrantIndex) const
+	{
+		assert(quadrantIndex < sk_maxQuadrantsCount);
+		return m_perQuadrantFirstObject[quadrantIndex];
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		unsigned int&
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::quadrantLastObject(unsigned int quadrantIndex)
+	{
+		assert(quadrantIndex < sk_maxQuadrantsCount);
+		return m_perQuadrantLastObject[quadrantIndex];
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		unsigned int&
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::quadrantObjectsCount(unsigned int quadrantIndex)
+	{
+		assert(quadrantIndex < sk_maxQuadrantsCount);
+		return m_perQuadrantObjectsCount[quadrantIndex];
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		unsigned int
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::quadrantObjectsCount(unsigned int quadrantIndex) const
+	{
+		assert(quadrantIndex < sk_maxQuadrantsCount);
+		return m_perQuadrantObjectsCount[quadrantIndex];
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		typename Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::PooledObject&
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::pooledObject(unsigned int objectIndex)
+	{
+		assert(objectIndex < objectsCapacity());
+		return m_objectsPool[objectIndex];
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
+		const typename Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::PooledObject&
+			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::pooledObject(unsigned int objectIndex) const
+	{
+		assert(objectIndex < objectsCapacity());
+		return m_objectsPool[objectIndex];
+	}
+
+	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline
 		XMFLOAT2&
 			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::perDepthQuadrantSize(unsigned int depth)
 	{
@@ -443,7 +1516,7 @@ namespace ArkanoidGame
 	}
 
 	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
-	inline 
+	inline
 		const XMFLOAT2&
 			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::perDepthQuadrantSize(unsigned int depth) const
 	{
@@ -452,44 +1525,34 @@ namespace ArkanoidGame
 	}
 
 	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
-	inline 
+	inline
 		unsigned int
 			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::childrenOffsets(unsigned int depth)const
 	{
 		assert(depth < sk_maxDepth);
-		return m_childrenOffsets[depth];
+		return Topology::sk_childrenOffsets[depth];
 	}
 
 	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
-	inline 
-		unsigned int 
+	inline
+		unsigned int
 			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::perQuadrantDepth(unsigned int quadrantIndex) const
 	{
 		assert(quadrantIndex < sk_maxQuadrantsCount);
-		return m_perQuadrantDepth[quadrantIndex];
+		return Topology::sk_perQuadrantDepth[quadrantIndex];
 	}
 
 	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
-	inline 
-		void
-			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::setQuadrantDepth(unsigned int quadrantIndex, unsigned int quadrantDepth)
-	{
-		assert(quadrantIndex < sk_maxQuadrantsCount);
-		assert(quadrantDepth <= sk_maxDepth);
-		m_perQuadrantDepth[quadrantIndex] = quadrantDepth;
-	}
-
-	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
-	inline 
+	inline
 		void
 			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::setQuadrantSubdivided(unsigned int quadrantIndex, bool quadrantSubdivided)
 	{
 		assert(quadrantIndex < sk_maxQuadrantsCount);
 		m_perQuadrantSubdivided[quadrantIndex] = quadrantSubdivided;
 	}
-	
+
 	template<typename ObjectData, unsigned int MAX_DEPTH, typename SubdivisionPolicy>
-	inline 
+	inline
 		bool
 			Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>::isQuadrantSubdivided(unsigned int quadrantIndex) const
 	{
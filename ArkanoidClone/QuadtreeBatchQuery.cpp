@@ -0,0 +1,6 @@
+#include "QuadtreeBatchQuery.h"
+
+#ifdef _DEBUG
+//explicit instantiation to find compilation errors
+template class ArkanoidGame::QuadtreeBatchQuery<>;
+#endif
\ No newline at end of file
@@ -0,0 +1,257 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include "ThreadPool.h"
+#include "QuadtreeHelper.h"
+#include "MathHelper.h"
+#include "AABB.h"
+#include "Quadtree.h"
+
+namespace ArkanoidGame
+{
+	//the objects found for one query of a batch
+	template<typename ObjectData = unsigned int>
+	struct QuadtreeFoundObjects
+	{
+		const ObjectData* objects;
+		unsigned int objectsCount;
+	};
+
+	/*
+	answers many AABB queries against one Quadtree at once, for the workloads with far more queries than a frame of the game
+	(bots training, replays, many balls). the queries are split in tasks of sk_queriesPerTask, which a work-stealing
+	ThreadPool answers in parallel: each task appends the objects it finds to its own buffer, kept for the next batches,
+	so the threads share nothing but the quadtree and the results don't depend on which thread answers a task.
+	the buffers grow with the objects actually found, not with the quadtree size
+	*/
+	template<typename ObjectData = unsigned int>
+	class QuadtreeBatchQuery
+	{
+	public:
+		//ctors
+		//threadsCount == 0 uses one thread per hardware thread
+		explicit QuadtreeBatchQuery(unsigned int threadsCount = 0);
+
+		//dtor
+		~QuadtreeBatchQuery() = default;
+
+		//copy
+		QuadtreeBatchQuery(const QuadtreeBatchQuery&) = delete;
+		QuadtreeBatchQuery& operator=(const QuadtreeBatchQuery&) = delete;
+
+		//move
+		QuadtreeBatchQuery(QuadtreeBatchQuery&&) = delete;
+		QuadtreeBatchQuery& operator=(QuadtreeBatchQuery&&) = delete;
+
+		/*
+		as Quadtree::findPotentialColliders() for each AABB of queriesAABBs: foundObjectsRanges, which has queriesCount elements,
+		receives the objects found for each query, in the given order. they stay valid until the next queryBatch().
+		the quadtree must not be modified during the call.
+		if sortQueries, the tasks take the queries in the Morton order of their centers, so the queries of a task visit
+		the same quadrants and objects: it pays off for many queries scattered over the area.
+		returns the number of objects found by all the queries
+		*/
+		template<unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+		unsigned int queryBatch(const Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>& quadtree,
+								const AABB* queriesAABBs, unsigned int queriesCount,
+								QuadtreeFoundObjects<ObjectData>* foundObjectsRanges, bool sortQueries = false);
+
+		//workers plus the calling thread
+		unsigned int threadsCount()const;
+
+		//bytes of the found objects and of the sorting buffers, this object included
+		size_t memoryUsage()const;
+
+		//queries answered by a single task: big enough to amortize the stealing, small enough to balance the load
+		static constexpr unsigned int sk_queriesPerTask = 256;
+
+		//the queries are sorted by the Morton code of the cell containing their center, on a grid of 2^sk_sortingCellsBits
+		//cells per axis covering the quadtree area
+		static constexpr unsigned int sk_sortingCellsBits = 8;
+
+	private:
+		//sorts m_sortedQueries by m_queriesMortonCodes, 8 bits per pass
+		void sortQueriesByMortonCode(unsigned int queriesCount);
+
+		ArkanoidEngine::ThreadPool m_threadPool;
+
+		//one per task: the objects found by its queries, one query after another. their capacity only grows
+		std::vector<std::vector<ObjectData>> m_perTaskFoundObjects;
+
+		//the queries indices in the order the tasks take them, when sorted
+		std::vector<unsigned int> m_sortedQueries;
+		std::vector<unsigned int> m_sortingQueries; //the radix sort goes back and forth between the two
+		std::vector<unsigned int> m_queriesMortonCodes;
+	};
+
+	template<typename ObjectData>
+	constexpr unsigned int QuadtreeBatchQuery<ObjectData>::sk_queriesPerTask;
+
+	template<typename ObjectData>
+	constexpr unsigned int QuadtreeBatchQuery<ObjectData>::sk_sortingCellsBits;
+
+	template<typename ObjectData>
+	inline QuadtreeBatchQuery<ObjectData>::QuadtreeBatchQuery(unsigned int threadsCount) : m_threadPool{ threadsCount }
+	{
+	}
+
+	template<typename ObjectData>
+	template<unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline unsigned int QuadtreeBatchQuery<ObjectData>::queryBatch(const Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>& quadtree,
+																   const AABB* queriesAABBs, unsigned int queriesCount,
+																   QuadtreeFoundObjects<ObjectData>* foundObjectsRanges, bool sortQueries)
+	{
+		assert(queriesCount == 0 || (queriesAABBs != nullptr && foundObjectsRanges != nullptr));
+
+		const unsigned int tasksCount = (queriesCount + sk_queriesPerTask - 1) / sk_queriesPerTask;
+
+		if (m_perTaskFoundObjects.size() < tasksCount)
+		{
+			m_perTaskFoundObjects.resize(tasksCount);
+		}
+
+		if (sortQueries)
+		{
+			if (m_sortedQueries.size() < queriesCount)
+			{
+				m_sortedQueries.resize(queriesCount);
+				m_sortingQueries.resize(queriesCount);
+				m_queriesMortonCodes.resize(queriesCount);
+			}
+
+			//the cells of the centers, the centers outside the area are clamped to the border cells
+			const AABB area = quadtree.area();
+			const XMFLOAT2 areaMin = area.min();
+			const float cellsPerAxis = static_cast<float>(1 << sk_sortingCellsBits);
+			const XMFLOAT2 cellsPerUnit{ cellsPerAxis / (2.0f * area.halfExtents().x), cellsPerAxis / (2.0f * area.halfExtents().y) };
+			const float maxCell = cellsPerAxis - 1.0f;
+
+			m_threadPool.parallelFor(tasksCount, [this, queriesAABBs, queriesCount, &areaMin, &cellsPerUnit, maxCell](unsigned int taskIndex)
+			{
+				const unsigned int firstQueryIndex = taskIndex * sk_queriesPerTask;
+				const unsigned int lastQueryIndex = std::min(firstQueryIndex + sk_queriesPerTask, queriesCount);
+
+				for (unsigned int queryIndex = firstQueryIndex; queryIndex < lastQueryIndex; ++queryIndex)
+				{
+					const XMFLOAT2& queryCenter = queriesAABBs[queryIndex].center();
+
+					const float cellX = std::min(std::max((queryCenter.x - areaMin.x) * cellsPerUnit.x, 0.0f), maxCell);
+					const float cellY = std::min(std::max((queryCenter.y - areaMin.y) * cellsPerUnit.y, 0.0f), maxCell);
+
+					m_queriesMortonCodes[queryIndex] = computeMortonCode(static_cast<unsigned int>(cellX), static_cast<unsigned int>(cellY));
+					m_sortedQueries[queryIndex] = queryIndex;
+				}
+			});
+
+			sortQueriesByMortonCode(queriesCount);
+		}
+
+		const unsigned int* sortedQueries = sortQueries ? m_sortedQueries.data() : nullptr;
+
+		m_threadPool.parallelFor(tasksCount, [this, &quadtree, queriesAABBs, queriesCount, foundObjectsRanges, sortedQueries](unsigned int taskIndex)
+		{
+			const unsigned int firstQueryIndex = taskIndex * sk_queriesPerTask;
+			const unsigned int lastQueryIndex = std::min(firstQueryIndex + sk_queriesPerTask, queriesCount);
+
+			std::vector<ObjectData>& foundObjects = m_perTaskFoundObjects[taskIndex];
+			foundObjects.clear();
+
+			auto visitor = [&foundObjects](const ObjectData& objectData, const XMFLOAT2&)
+			{
+				foundObjects.push_back(objectData);
+				return true;
+			};
+
+			for (unsigned int orderIndex = firstQueryIndex; orderIndex < lastQueryIndex; ++orderIndex)
+			{
+				const unsigned int queryIndex = sortedQueries != nullptr ? sortedQueries[orderIndex] : orderIndex;
+
+				//the objects are visited in the order findPotentialColliders() finds them
+				const size_t previousFoundObjectsCount = foundObjects.size();
+				quadtree.visitPotentialColliders(queriesAABBs[queryIndex], visitor);
+
+				foundObjectsRanges[queryIndex].objectsCount = static_cast<unsigned int>(foundObjects.size() - previousFoundObjectsCount);
+			}
+
+			//the buffer doesn't move anymore: the ranges point to it, in the order the objects were found
+			const ObjectData* nextObjects = foundObjects.data();
+			for (unsigned int orderIndex = firstQueryIndex; orderIndex < lastQueryIndex; ++orderIndex)
+			{
+				const unsigned int queryIndex = sortedQueries != nullptr ? sortedQueries[orderIndex] : orderIndex;
+
+				foundObjectsRanges[queryIndex].objects = nextObjects;
+				nextObjects += foundObjectsRanges[queryIndex].objectsCount;
+			}
+		});
+
+		unsigned int foundObjectsCount = 0;
+		for (unsigned int taskIndex = 0; taskIndex < tasksCount; ++taskIndex)
+		{
+			foundObjectsCount += static_cast<unsigned int>(m_perTaskFoundObjects[taskIndex].size());
+		}
+
+		return foundObjectsCount;
+	}
+
+	template<typename ObjectData>
+	inline unsigned int QuadtreeBatchQuery<ObjectData>::threadsCount()const
+	{
+		return m_threadPool.threadsCount();
+	}
+
+	template<typename ObjectData>
+	inline size_t QuadtreeBatchQuery<ObjectData>::memoryUsage()const
+	{
+		size_t memoryUsage = sizeof(*this) + m_perTaskFoundObjects.capacity() * sizeof(std::vector<ObjectData>);
+
+		for (const std::vector<ObjectData>& foundObjects : m_perTaskFoundObjects)
+		{
+			memoryUsage += foundObjects.capacity() * sizeof(ObjectData);
+		}
+
+		return memoryUsage + (m_sortedQueries.capacity() + m_sortingQueries.capacity() + m_queriesMortonCodes.capacity()) * sizeof(unsigned int);
+	}
+
+	template<typename ObjectData>
+	inline void QuadtreeBatchQuery<ObjectData>::sortQueriesByMortonCode(unsigned int queriesCount)
+	{
+		static constexpr unsigned int radixBits = 8;
+		static constexpr unsigned int radixBucketsCount = 1 << radixBits;
+
+		//the least significant digit radix sort is stable, so the queries of a cell keep the given order
+		unsigned int* sourceQueries = m_sortedQueries.data();
+		unsigned int* sortedQueries = m_sortingQueries.data();
+
+		for (unsigned int shift = 0; shift < 2 * sk_sortingCellsBits; shift += radixBits)
+		{
+			unsigned int bucketsFirstQuery[radixBucketsCount]{};
+
+			for (unsigned int orderIndex = 0; orderIndex < queriesCount; ++orderIndex)
+			{
+				++bucketsFirstQuery[(m_queriesMortonCodes[sourceQueries[orderIndex]] >> shift) & (radixBucketsCount - 1)];
+			}
+
+			unsigned int firstQuery = 0;
+			for (unsigned int bucket = 0; bucket < radixBucketsCount; ++bucket)
+			{
+				const unsigned int bucketQueriesCount = bucketsFirstQuery[bucket];
+				bucketsFirstQuery[bucket] = firstQuery;
+				firstQuery += bucketQueriesCount;
+			}
+
+			for (unsigned int orderIndex = 0; orderIndex < queriesCount; ++orderIndex)
+			{
+				const unsigned int queryIndex = sourceQueries[orderIndex];
+				sortedQueries[bucketsFirstQuery[(m_queriesMortonCodes[queryIndex] >> shift) & (radixBucketsCount - 1)]++] = queryIndex;
+			}
+
+			std::swap(sourceQueries, sortedQueries);
+		}
+
+		if (sourceQueries != m_sortedQueries.data())
+		{
+			m_sortedQueries.swap(m_sortingQueries);
+		}
+	}
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include "MathHelper.h"
+#include <utility>
 
 namespace ArkanoidGame
 {
@@ -8,9 +9,10 @@ namespace ArkanoidGame
 		return exponent > 0 ? base*uiPow(base, exponent - 1) : 1;
 	}
 
+	//4^(depth + 1) as a shift, so the topology tables don't recurse for each element
 	inline constexpr unsigned int quadrantsCount(unsigned int depth)
 	{
-		return (uiPow(4, depth + 1) - 1) / (4 - 1);
+		return ((1u << (2 * (depth + 1))) - 1) / (4 - 1);
 	}
 
 	inline void computeChildrenIndices(unsigned int quadrantIndex, unsigned int(&childrenIndices)[4], unsigned int childrenOffset)
@@ -22,6 +24,24 @@ namespace ArkanoidGame
 		}
 	}
 
+	//spreads the lower 16 bits of value to the even bits of the result
+	inline unsigned int spreadBits(unsigned int value)
+	{
+		value &= 0x0000ffff;
+		value = (value | (value << 8)) & 0x00ff00ff;
+		value = (value | (value << 4)) & 0x0f0f0f0f;
+		value = (value | (value << 2)) & 0x33333333;
+		value = (value | (value << 1)) & 0x55555555;
+		return value;
+	}
+
+	//the Z-order code of a cell: its x and y bits interleaved, x in the even bits.
+	//from the most significant pair, each pair of bits selects the child in the quadrants order (min, +x, +y, +x+y)
+	inline unsigned int computeMortonCode(unsigned int cellX, unsigned int cellY)
+	{
+		return spreadBits(cellX) | (spreadBits(cellY) << 1);
+	}
+
 	inline unsigned int computeSiblingsOffset(unsigned int depth, unsigned int maxDepth)
 	{
 		unsigned int siblingOffset = 0;
@@ -31,4 +51,76 @@ namespace ArkanoidGame
 		}
 		return siblingOffset;
 	}	
+
+	/*
+	the topology of a full tree of maxDepth laid out as Quadtree does: a quadrant's first child follows it and each child
+	is followed by its subtree, so the children of a quadrant at depth are childrenOffset(depth, maxDepth) apart.
+	the functions are single expressions, so the tables below are filled by the compiler
+	*/
+	inline constexpr unsigned int childrenOffset(unsigned int depth, unsigned int maxDepth)
+	{
+		return quadrantsCount(maxDepth - depth - 1);
+	}
+
+	//the child of the quadrant at subtreeRoot, whose subtree has maxDepth, which holds quadrantIndex
+	inline constexpr unsigned int subtreeChildIndex(unsigned int quadrantIndex, unsigned int subtreeRoot, unsigned int maxDepth)
+	{
+		return (quadrantIndex - subtreeRoot - 1) / quadrantsCount(maxDepth - 1);
+	}
+
+	inline constexpr unsigned int subtreeChildRoot(unsigned int quadrantIndex, unsigned int subtreeRoot, unsigned int maxDepth)
+	{
+		return subtreeRoot + 1 + subtreeChildIndex(quadrantIndex, subtreeRoot, maxDepth) * quadrantsCount(maxDepth - 1);
+	}
+
+	//the quadrant at quadrantIndex is descended from the root through the children holding it
+	inline constexpr unsigned int quadrantDepth(unsigned int quadrantIndex, unsigned int maxDepth, unsigned int subtreeRoot = 0)
+	{
+		return quadrantIndex == subtreeRoot ? 0 :
+			1 + quadrantDepth(quadrantIndex, maxDepth - 1, subtreeChildRoot(quadrantIndex, subtreeRoot, maxDepth));
+	}
+
+	//the root is its own parent
+	inline constexpr unsigned int quadrantParent(unsigned int quadrantIndex, unsigned int maxDepth, unsigned int subtreeRoot = 0)
+	{
+		return quadrantIndex == subtreeRoot || quadrantIndex == subtreeChildRoot(quadrantIndex, subtreeRoot, maxDepth) ? subtreeRoot :
+			quadrantParent(quadrantIndex, maxDepth - 1, subtreeChildRoot(quadrantIndex, subtreeRoot, maxDepth));
+	}
+
+	//the position among the siblings, in the quadrants order (min, +x, +y, +x+y). the root is the first one
+	inline constexpr unsigned int quadrantSiblingIndex(unsigned int quadrantIndex, unsigned int maxDepth, unsigned int subtreeRoot = 0)
+	{
+		return quadrantIndex == subtreeRoot ? 0 :
+			quadrantIndex == subtreeChildRoot(quadrantIndex, subtreeRoot, maxDepth) ? subtreeChildIndex(quadrantIndex, subtreeRoot, maxDepth) :
+			quadrantSiblingIndex(quadrantIndex, maxDepth - 1, subtreeChildRoot(quadrantIndex, subtreeRoot, maxDepth));
+	}
+
+	template<unsigned int MAX_DEPTH,
+			 typename QuadrantsIndices = std::make_index_sequence<quadrantsCount(MAX_DEPTH)>,
+			 typename Depths = std::make_index_sequence<MAX_DEPTH>>
+	struct QuadtreeTopology;
+
+	//the per-quadrant and per-depth tables of the tree of MAX_DEPTH, computed at compile time
+	template<unsigned int MAX_DEPTH, size_t... QUADRANTS_INDICES, size_t... DEPTHS>
+	struct QuadtreeTopology<MAX_DEPTH, std::index_sequence<QUADRANTS_INDICES...>, std::index_sequence<DEPTHS...>>
+	{
+		static constexpr unsigned int sk_perQuadrantDepth[] = { quadrantDepth(QUADRANTS_INDICES, MAX_DEPTH)... };
+		static constexpr unsigned int sk_perQuadrantParent[] = { quadrantParent(QUADRANTS_INDICES, MAX_DEPTH)... };
+		static constexpr unsigned int sk_perQuadrantSiblingIndex[] = { quadrantSiblingIndex(QUADRANTS_INDICES, MAX_DEPTH)... };
+
+		//the last element is for the leaves, which have no children
+		static constexpr unsigned int sk_childrenOffsets[] = { childrenOffset(DEPTHS, MAX_DEPTH)..., 0 };
+	};
+
+	template<unsigned int MAX_DEPTH, size_t... QUADRANTS_INDICES, size_t... DEPTHS>
+	constexpr unsigned int QuadtreeTopology<MAX_DEPTH, std::index_sequence<QUADRANTS_INDICES...>, std::index_sequence<DEPTHS...>>::sk_perQuadrantDepth[];
+
+	template<unsigned int MAX_DEPTH, size_t... QUADRANTS_INDICES, size_t... DEPTHS>
+	constexpr unsigned int QuadtreeTopology<MAX_DEPTH, std::index_sequence<QUADRANTS_INDICES...>, std::index_sequence<DEPTHS...>>::sk_perQuadrantParent[];
+
+	template<unsigned int MAX_DEPTH, size_t... QUADRANTS_INDICES, size_t... DEPTHS>
+	constexpr unsigned int QuadtreeTopology<MAX_DEPTH, std::index_sequence<QUADRANTS_INDICES...>, std::index_sequence<DEPTHS...>>::sk_perQuadrantSiblingIndex[];
+
+	template<unsigned int MAX_DEPTH, size_t... QUADRANTS_INDICES, size_t... DEPTHS>
+	constexpr unsigned int QuadtreeTopology<MAX_DEPTH, std::index_sequence<QUADRANTS_INDICES...>, std::index_sequence<DEPTHS...>>::sk_childrenOffsets[];
 }
\ No newline at end of file
@@ -0,0 +1,6 @@
+#include "QuadtreeQueryCache.h"
+
+#ifdef _DEBUG
+//explicit instantiation to find compilation errors
+template class ArkanoidGame::QuadtreeQueryCache<>;
+#endif
\ No newline at end of file
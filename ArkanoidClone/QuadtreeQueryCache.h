@@ -0,0 +1,178 @@
+#pragma once
+#include <vector>
+#include <cassert>
+#include "MathHelper.h"
+#include "AABB.h"
+#include "Quadtree.h"
+
+namespace ArkanoidGame
+{
+	struct QuadtreeQueryCacheCounters
+	{
+		unsigned long long hitsCount{ 0 }; //queries answered from the cache
+		unsigned long long missesCount{ 0 }; //queries which searched the quadtree
+		unsigned long long savedQuadrantVisitsCount{ 0 }; //quadrants the hits didn't visit, as many as the query filling the cache
+	};
+
+	/*
+	the objects a Quadtree query found for an AABB grown by a margin, for an object which moves little between its queries,
+	as the ball does between two frames. the next queries of an AABB inside the grown one are answered from them,
+	without visiting the quadtree, until the quadtree is modified.
+	the objects found are the ones the quadtree finds for the grown AABB: all the ones touching the query AABB and a few more.
+	a cache serves the queries of one object against one quadtree: bind() must be called with the quadtree before its
+	first query, and invalidate() when another quadtree takes its place at the same address, e.g. by assignment
+	*/
+	template<typename ObjectData = unsigned int>
+	class QuadtreeQueryCache
+	{
+	public:
+		//ctors
+		explicit QuadtreeQueryCache(const XMFLOAT2& margin);
+
+		//dtor
+		~QuadtreeQueryCache() = default;
+
+		//copy
+		QuadtreeQueryCache(const QuadtreeQueryCache&) = default;
+		QuadtreeQueryCache& operator=(const QuadtreeQueryCache&) = default;
+
+		//move
+		QuadtreeQueryCache(QuadtreeQueryCache&&) = default;
+		QuadtreeQueryCache& operator=(QuadtreeQueryCache&&) = default;
+
+		//sizes the cache for the objects of quadtree, so that its queries don't allocate, and invalidates it.
+		//must be called before the first query of a quadtree
+		template<unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+		void bind(const Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>& quadtree);
+
+		//as Quadtree::findPotentialColliders(), foundObjects is set to the cached objects, valid until the next query.
+		//the cache is filled again when objectAABB leaves the cached bounds, the quadtree has been modified or it is not
+		//the quadtree of the last query
+		template<unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+		unsigned int findPotentialColliders(const Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>& quadtree,
+											const AABB& objectAABB, const ObjectData*& foundObjects);
+
+		//the next query searches the quadtree
+		void invalidate();
+
+		const XMFLOAT2& margin()const;
+
+		const QuadtreeQueryCacheCounters& counters()const;
+		void resetCounters();
+
+		//from the counters, 0 before the first query
+		float hitRate()const;
+
+	private:
+		bool containsAABB(const XMFLOAT2& aabbMin, const XMFLOAT2& aabbMax)const;
+
+		std::vector<ObjectData> m_cachedObjects; //sized to the quadtree capacity by bind()
+		unsigned int m_cachedObjectsCount{ 0 };
+
+		XMFLOAT2 m_margin;
+
+		//the grown AABB of the query which filled the cache
+		XMFLOAT2 m_cachedMin{};
+		XMFLOAT2 m_cachedMax{};
+
+		const void* m_cachedQuadtree{ nullptr };
+		unsigned int m_cachedModificationsCount{ 0 };
+		unsigned int m_cachedVisitedQuadrantsCount{ 0 };
+
+		QuadtreeQueryCacheCounters m_counters{};
+	};
+
+	template<typename ObjectData>
+	inline QuadtreeQueryCache<ObjectData>::QuadtreeQueryCache(const XMFLOAT2& margin) : m_margin{ margin }
+	{
+		assert(margin.x >= 0.0f && margin.y >= 0.0f);
+	}
+
+	template<typename ObjectData>
+	template<unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline void QuadtreeQueryCache<ObjectData>::bind(const Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>& quadtree)
+	{
+		if (m_cachedObjects.size() < quadtree.objectsCapacity())
+		{
+			m_cachedObjects.resize(quadtree.objectsCapacity());
+		}
+
+		invalidate();
+	}
+
+	template<typename ObjectData>
+	template<unsigned int MAX_DEPTH, typename SubdivisionPolicy>
+	inline unsigned int QuadtreeQueryCache<ObjectData>::findPotentialColliders(const Quadtree<ObjectData, MAX_DEPTH, SubdivisionPolicy>& quadtree,
+																			   const AABB& objectAABB, const ObjectData*& foundObjects)
+	{
+		//bind() has sized the cache
+		assert(m_cachedObjects.size() >= quadtree.objectsCapacity());
+
+		const bool valid = m_cachedQuadtree == &quadtree &&
+						   m_cachedModificationsCount == quadtree.modificationsCount() &&
+						   containsAABB(objectAABB.min(), objectAABB.max());
+
+		if (valid)
+		{
+			++m_counters.hitsCount;
+			m_counters.savedQuadrantVisitsCount += m_cachedVisitedQuadrantsCount;
+		}
+		else
+		{
+			++m_counters.missesCount;
+
+			const AABB cachedAABB = AABB::computeFromCenterAndHalfExtents(objectAABB.center(), objectAABB.halfExtents() + m_margin);
+
+			m_cachedMin = cachedAABB.min();
+			m_cachedMax = cachedAABB.max();
+			m_cachedQuadtree = &quadtree;
+			m_cachedModificationsCount = quadtree.modificationsCount();
+			m_cachedObjectsCount = quadtree.findPotentialColliders(cachedAABB, m_cachedObjects.data(), m_cachedVisitedQuadrantsCount);
+		}
+
+		foundObjects = m_cachedObjects.data();
+
+		return m_cachedObjectsCount;
+	}
+
+	template<typename ObjectData>
+	inline void QuadtreeQueryCache<ObjectData>::invalidate()
+	{
+		m_cachedQuadtree = nullptr;
+	}
+
+	template<typename ObjectData>
+	inline const XMFLOAT2& QuadtreeQueryCache<ObjectData>::margin()const
+	{
+		return m_margin;
+	}
+
+	template<typename ObjectData>
+	inline const QuadtreeQueryCacheCounters& QuadtreeQueryCache<ObjectData>::counters()const
+	{
+		return m_counters;
+	}
+
+	template<typename ObjectData>
+	inline void QuadtreeQueryCache<ObjectData>::resetCounters()
+	{
+		m_counters = QuadtreeQueryCacheCounters{};
+	}
+
+	template<typename ObjectData>
+	inline float QuadtreeQueryCache<ObjectData>::hitRate()const
+	{
+		const unsigned long long queriesCount = m_counters.hitsCount + m_counters.missesCount;
+		const unsigned long long divisors[2] = { queriesCount, 1 };
+		return static_cast<float>(m_counters.hitsCount) / static_cast<float>(divisors[static_cast<unsigned int>(queriesCount == 0)]);
+	}
+
+	template<typename ObjectData>
+	inline bool QuadtreeQueryCache<ObjectData>::containsAABB(const XMFLOAT2& aabbMin, const XMFLOAT2& aabbMax)const
+	{
+		const unsigned int containsX = static_cast<unsigned int>(m_cachedMin.x <= aabbMin.x) & static_cast<unsigned int>(aabbMax.x <= m_cachedMax.x);
+		const unsigned int containsY = static_cast<unsigned int>(m_cachedMin.y <= aabbMin.y) & static_cast<unsigned int>(aabbMax.y <= m_cachedMax.y);
+
+		return (containsX & containsY) == 1;
+	}
+}
\ No newline at end of file
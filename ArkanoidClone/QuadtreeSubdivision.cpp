@@ -0,0 +1,58 @@
+#include "QuadtreeSubdivision.h"
+
+using namespace ArkanoidGame;
+
+std::vector<SubdivisionSettings> ArkanoidGame::generateSubdivisionCandidates(unsigned int maxDepth, const XMFLOAT2& objectsHalfExtents,
+																			  const XMFLOAT2& queriesHalfExtents)
+{
+	static constexpr unsigned int maxLeafObjectsCounts[] = { 0, 1, 2, 4, 8 };
+	static constexpr float quadrantVisitCosts[] = { 0.25f, 0.5f, 1.0f, 2.0f };
+	static constexpr float maxLeafOccupancies[] = { 0.05f, 0.1f, 0.2f, 0.4f };
+
+	SubdivisionSettings baseSettings{};
+	baseSettings.queriesHalfExtents = queriesHalfExtents;
+	baseSettings.objectsHalfExtents = objectsHalfExtents;
+
+	std::vector<SubdivisionSettings> candidates;
+
+	//the root alone holds all the objects
+	baseSettings.maxDepth = 0;
+	candidates.push_back(baseSettings);
+
+	for (unsigned int depth = 1; depth <= maxDepth; ++depth)
+	{
+		baseSettings.maxDepth = depth;
+
+		SubdivisionSettings settings = baseSettings;
+		settings.type = SUBDIVISION_COUNT_THRESHOLD;
+		for (unsigned int maxLeafObjectsCount : maxLeafObjectsCounts)
+		{
+			settings.maxLeafObjectsCount = maxLeafObjectsCount;
+			candidates.push_back(settings);
+		}
+
+		settings = baseSettings;
+		settings.type = SUBDIVISION_AREA_COST;
+		for (float quadrantVisitCost : quadrantVisitCosts)
+		{
+			settings.quadrantVisitCost = quadrantVisitCost;
+			candidates.push_back(settings);
+		}
+
+		settings = baseSettings;
+		settings.type = SUBDIVISION_LEAF_OCCUPANCY;
+		for (float maxLeafOccupancy : maxLeafOccupancies)
+		{
+			settings.maxLeafOccupancy = maxLeafOccupancy;
+			candidates.push_back(settings);
+		}
+	}
+
+	return candidates;
+}
+
+#ifdef _DEBUG
+//explicit instantiation to find compilation errors
+template class ArkanoidGame::Quadtree<unsigned int, 3, ArkanoidGame::TunableSubdivisionPolicy>;
+template class ArkanoidGame::Quadtree<unsigned int, 3, ArkanoidGame::CountThresholdSubdivisionPolicy<2>>;
+#endif
\ No newline at end of file
@@ -0,0 +1,241 @@
+#pragma once
+#include <vector>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+#include <cassert>
+#include "MathHelper.h"
+#include "AABB.h"
+#include "Quadtree.h"
+
+namespace ArkanoidGame
+{
+	//subdivides the quadrants holding more than MAX_LEAF_OBJECTS objects
+	template<unsigned int MAX_LEAF_OBJECTS>
+	struct CountThresholdSubdivisionPolicy
+	{
+		static bool shouldSubdivideQuadrant(unsigned int objectsCount)
+		{
+			return objectsCount > MAX_LEAF_OBJECTS;
+		}
+
+		static bool shouldSubdivideQuadrant(unsigned int objectsCount, unsigned int /*depth*/, const XMFLOAT2& /*quadrantSize*/)
+		{
+			return shouldSubdivideQuadrant(objectsCount);
+		}
+	};
+
+	enum ESubdivisionPolicyType : unsigned int
+	{
+		//subdivides a quadrant holding more than maxLeafObjectsCount objects
+		SUBDIVISION_COUNT_THRESHOLD = 0,
+		//subdivides a quadrant when the objects its queries find cost more than visiting its children: a query of
+		//queriesHalfExtents touches a quadrant as often as the quadrant grown by the query is large
+		SUBDIVISION_AREA_COST = 1,
+		//subdivides a quadrant when its objects, of objectsHalfExtents, cover more than maxLeafOccupancy of its area
+		SUBDIVISION_LEAF_OCCUPANCY = 2
+	};
+
+	constexpr unsigned int gk_subdivisionPolicyTypesCount = 3;
+
+	//the default settings subdivide as DefaultSubdivisionPolicy
+	struct SubdivisionSettings
+	{
+		ESubdivisionPolicyType type{ SUBDIVISION_COUNT_THRESHOLD };
+		unsigned int maxDepth{ std::numeric_limits<unsigned int>::max() }; //the quadrants at maxDepth are not subdivided
+
+		unsigned int maxLeafObjectsCount{ 0 }; //SUBDIVISION_COUNT_THRESHOLD
+
+		XMFLOAT2 queriesHalfExtents{ 1.0f, 1.0f }; //SUBDIVISION_AREA_COST
+		float quadrantVisitCost{ 1.0f }; //SUBDIVISION_AREA_COST, as many objects found
+
+		XMFLOAT2 objectsHalfExtents{ 1.0f, 1.0f }; //SUBDIVISION_LEAF_OCCUPANCY
+		float maxLeafOccupancy{ 0.25f }; //SUBDIVISION_LEAF_OCCUPANCY
+	};
+
+	//the policy given by SubdivisionSettings, which a Quadtree deriving from it changes at run time
+	class TunableSubdivisionPolicy
+	{
+	public:
+		//ctors
+		explicit TunableSubdivisionPolicy() = default;
+
+		//dtor
+		~TunableSubdivisionPolicy() = default;
+
+		//copy
+		TunableSubdivisionPolicy(const TunableSubdivisionPolicy&) = default;
+		TunableSubdivisionPolicy& operator=(const TunableSubdivisionPolicy&) = default;
+
+		//move
+		TunableSubdivisionPolicy(TunableSubdivisionPolicy&&) = default;
+		TunableSubdivisionPolicy& operator=(TunableSubdivisionPolicy&&) = default;
+
+		const SubdivisionSettings& subdivisionSettings()const;
+
+		//the quadrants already subdivided are kept: the quadtree must be built again to apply the settings to all of them
+		void setSubdivisionSettings(const SubdivisionSettings& settings);
+
+		bool shouldSubdivideQuadrant(unsigned int objectsCount, unsigned int depth, const XMFLOAT2& quadrantSize)const;
+
+	private:
+		SubdivisionSettings m_settings{};
+	};
+
+	//a query recorded to tune the subdivision: an AABB centered in start if displacement is 0, a swept AABB otherwise
+	struct RecordedQuery
+	{
+		XMFLOAT2 start;
+		XMFLOAT2 displacement;
+	};
+
+	struct SubdivisionTuningResult
+	{
+		SubdivisionSettings settings;
+		float queryNanoseconds; //the average time of a recorded query, in the fastest replay
+		float foundObjectsPerQuery;
+	};
+
+	constexpr unsigned int gk_subdivisionTuningReplaysCount = 5;
+
+	//a candidate replaces the fastest one only if its replay takes less than this fraction of the time: the candidates
+	//timed the same within the noise keep the earlier one, which is shallower
+	constexpr float gk_subdivisionTuningMinSpeedup = 0.95f;
+
+	//each policy type with a few settings, for each maxDepth from 1 to maxDepth, and the root alone as the first candidate
+	std::vector<SubdivisionSettings> generateSubdivisionCandidates(unsigned int maxDepth, const XMFLOAT2& objectsHalfExtents,
+																	const XMFLOAT2& queriesHalfExtents);
+
+	/*
+	builds a quadtree of the objects with each candidate and replays the recorded queries, of queriesHalfExtents, against it
+	gk_subdivisionTuningReplaysCount times: the candidate with the fastest replay, by gk_subdivisionTuningMinSpeedup, is returned.
+	the objects touching each query are found with any candidate, so the choice changes only the time taken.
+	perCandidateResults, if not null, receives the result of each candidate
+	*/
+	template<unsigned int MAX_DEPTH>
+	SubdivisionTuningResult tuneSubdivision(const AABB& area, const XMFLOAT2& objectsHalfExtents,
+											const XMFLOAT2* objectsCenters, unsigned int objectsCount,
+											const RecordedQuery* queries, unsigned int queriesCount, const XMFLOAT2& queriesHalfExtents,
+											const SubdivisionSettings* candidates, unsigned int candidatesCount,
+											SubdivisionTuningResult* perCandidateResults = nullptr);
+
+	inline const SubdivisionSettings& TunableSubdivisionPolicy::subdivisionSettings()const
+	{
+		return m_settings;
+	}
+
+	inline void TunableSubdivisionPolicy::setSubdivisionSettings(const SubdivisionSettings& settings)
+	{
+		assert(settings.type < gk_subdivisionPolicyTypesCount);
+		assert(settings.quadrantVisitCost >= 0.0f && settings.maxLeafOccupancy >= 0.0f);
+		m_settings = settings;
+	}
+
+	inline bool TunableSubdivisionPolicy::shouldSubdivideQuadrant(unsigned int objectsCount, unsigned int depth,
+																  const XMFLOAT2& quadrantSize)const
+	{
+		if (depth >= m_settings.maxDepth)
+		{
+			return false;
+		}
+
+		switch (m_settings.type)
+		{
+		case SUBDIVISION_AREA_COST:
+		{
+			//the objects are assumed to be spread among the children, each one touched as often as its grown area
+			//relatively to the quadrant one. the subdivision saves the objects of the children not touched
+			const XMFLOAT2 querySize = m_settings.queriesHalfExtents * 2.0f;
+			const XMFLOAT2 grownSize = quadrantSize + querySize;
+			const XMFLOAT2 grownChildSize = quadrantSize * 0.5f + querySize;
+			const float childTouchedRatio = (grownChildSize.x * grownChildSize.y) / (grownSize.x * grownSize.y);
+
+			return static_cast<float>(objectsCount) * (1.0f - childTouchedRatio) > 4.0f * m_settings.quadrantVisitCost;
+		}
+		case SUBDIVISION_LEAF_OCCUPANCY:
+		{
+			const float objectArea = 4.0f * m_settings.objectsHalfExtents.x * m_settings.objectsHalfExtents.y;
+			return static_cast<float>(objectsCount) * objectArea > m_settings.maxLeafOccupancy * quadrantSize.x * quadrantSize.y;
+		}
+		default:
+			return objectsCount > m_settings.maxLeafObjectsCount;
+		}
+	}
+
+	template<unsigned int MAX_DEPTH>
+	inline SubdivisionTuningResult tuneSubdivision(const AABB& area, const XMFLOAT2& objectsHalfExtents,
+												   const XMFLOAT2* objectsCenters, unsigned int objectsCount,
+												   const RecordedQuery* queries, unsigned int queriesCount, const XMFLOAT2& queriesHalfExtents,
+												   const SubdivisionSettings* candidates, unsigned int candidatesCount,
+												   SubdivisionTuningResult* perCandidateResults)
+	{
+		assert(candidatesCount > 0 && candidates != nullptr);
+		assert(queriesCount == 0 || queries != nullptr);
+
+		std::vector<unsigned int> objectsIndices(objectsCount);
+		for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+		{
+			objectsIndices[objectIndex] = objectIndex;
+		}
+
+		const unsigned int objectsCapacity = std::max(objectsCount, 1u);
+		std::vector<unsigned int> foundObjects(objectsCapacity);
+
+		Quadtree<unsigned int, MAX_DEPTH, TunableSubdivisionPolicy> quadtree{ area, objectsHalfExtents, objectsCapacity };
+
+		const float queriesDivisor = static_cast<float>(std::max(queriesCount, 1u));
+
+		SubdivisionTuningResult bestResult{ candidates[0], std::numeric_limits<float>::max(), 0.0f };
+
+		for (unsigned int candidateIndex = 0; candidateIndex < candidatesCount; ++candidateIndex)
+		{
+			quadtree.setSubdivisionSettings(candidates[candidateIndex]);
+			quadtree.buildBulk(area, objectsCenters, objectsIndices.data(), objectsCount);
+
+			double fastestReplaySeconds = std::numeric_limits<double>::max();
+			unsigned long long foundObjectsCount = 0;
+
+			for (unsigned int replay = 0; replay < gk_subdivisionTuningReplaysCount; ++replay)
+			{
+				foundObjectsCount = 0;
+
+				const auto startTime = std::chrono::steady_clock::now();
+
+				for (unsigned int queryIndex = 0; queryIndex < queriesCount; ++queryIndex)
+				{
+					const RecordedQuery& query = queries[queryIndex];
+
+					if (query.displacement.x != 0.0f || query.displacement.y != 0.0f)
+					{
+						foundObjectsCount += quadtree.findSweptPotentialColliders(query.start, query.displacement, queriesHalfExtents,
+																				  foundObjects.data());
+					}
+					else
+					{
+						const AABB queryAABB = AABB::computeFromCenterAndHalfExtents(query.start, queriesHalfExtents);
+						foundObjectsCount += quadtree.findPotentialColliders(queryAABB, foundObjects.data());
+					}
+				}
+
+				const std::chrono::duration<double> replayTime = std::chrono::steady_clock::now() - startTime;
+				fastestReplaySeconds = std::min(fastestReplaySeconds, replayTime.count());
+			}
+
+			const SubdivisionTuningResult result{ candidates[candidateIndex],
+												  static_cast<float>(fastestReplaySeconds * 1e9) / queriesDivisor,
+												  static_cast<float>(foundObjectsCount) / queriesDivisor };
+
+			if (perCandidateResults != nullptr)
+			{
+				perCandidateResults[candidateIndex] = result;
+			}
+
+			if (result.queryNanoseconds < bestResult.queryNanoseconds * gk_subdivisionTuningMinSpeedup)
+			{
+				bestResult = result;
+			}
+		}
+
+		return bestResult;
+	}
+}
\ No newline at end of file
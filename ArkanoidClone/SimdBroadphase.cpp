@@ -0,0 +1,221 @@
+#include "SimdBroadphase.h"
+#include "MathHelper.h"
+#include <algorithm>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define SIMD_BROADPHASE_SSE2
+#include <emmintrin.h>
+#endif
+
+/*
+the AVX path is built for every x86 target and chosen at run time, when the CPU and the OS support it: MSVC compiles
+the AVX intrinsics anywhere, GCC and Clang compile them in the functions targeting AVX only.
+with /arch:AVX, /arch:AVX2 or -mavx, __AVX__ is defined and the CPU is not checked
+*/
+#if defined(__AVX__) || (defined(SIMD_BROADPHASE_SSE2) && (defined(_MSC_VER) || defined(__GNUC__)))
+#define SIMD_BROADPHASE_AVX
+#include <immintrin.h>
+
+#if defined(_MSC_VER) && !defined(__AVX__)
+#include <intrin.h>
+#endif
+
+#if defined(__GNUC__) && !defined(__AVX__)
+#define SIMD_BROADPHASE_AVX_TARGET __attribute__((target("avx")))
+#else
+#define SIMD_BROADPHASE_AVX_TARGET
+#endif
+#endif
+
+using namespace ArkanoidGame;
+
+//the bits of boxesMask for the lanes starting at boxIndex, all of them without a mask.
+//the groups start at multiples of their lanes count, so they never span two words
+static unsigned int lanesMask(const unsigned int* boxesMask, unsigned int boxIndex, unsigned int allLanesMask)
+{
+	if (boxesMask == nullptr)
+	{
+		return allLanesMask;
+	}
+
+	return (boxesMask[boxIndex / 32] >> (boxIndex % 32)) & allLanesMask;
+}
+
+//the widest instruction set of the CPU the SIMD paths are built for
+static ESimdLevel detectSimdLevel()
+{
+#if defined(__AVX__)
+	return SIMD_LEVEL_AVX;
+#elif defined(SIMD_BROADPHASE_AVX) && defined(_MSC_VER)
+	//AVX needs the CPU support and the OS saving the YMM registers: OSXSAVE, then the SSE and AVX states enabled in XCR0
+	int cpuInfo[4];
+	__cpuid(cpuInfo, 1);
+
+	const bool hasAvx = (cpuInfo[2] & (1 << 28)) != 0;
+	const bool hasOsXSave = (cpuInfo[2] & (1 << 27)) != 0;
+
+	return hasAvx && hasOsXSave && (_xgetbv(0) & 0x6) == 0x6 ? SIMD_LEVEL_AVX : SIMD_LEVEL_SSE2;
+#elif defined(SIMD_BROADPHASE_AVX)
+	//checks the OS support too
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx") ? SIMD_LEVEL_AVX : SIMD_LEVEL_SSE2;
+#elif defined(SIMD_BROADPHASE_SSE2)
+	return SIMD_LEVEL_SSE2;
+#else
+	return SIMD_LEVEL_SCALAR;
+#endif
+}
+
+static ESimdLevel& maxSimdLevel()
+{
+	static ESimdLevel simdLevel = detectSimdLevel();
+	return simdLevel;
+}
+
+ESimdLevel ArkanoidGame::findTouchingBoxesSimdLevel()
+{
+	return maxSimdLevel();
+}
+
+void ArkanoidGame::setFindTouchingBoxesMaxSimdLevel(ESimdLevel simdLevel)
+{
+	maxSimdLevel() = std::min(simdLevel, detectSimdLevel());
+}
+
+/*
+lessEqualf(a, b) is (a < b || |a - b| <= gk_epsilon), that is (a - b <= gk_epsilon):
+the SIMD paths use the latter, which gives the same result of the scalar AABB::intersects()
+*/
+
+#ifdef SIMD_BROADPHASE_AVX
+//the groups of 8 boxes from boxIndex, which is left after the last full group. returns the boxes found
+SIMD_BROADPHASE_AVX_TARGET
+static unsigned int findTouchingBoxesAvx(const float* centersX, const float* centersY, unsigned int boxesCount,
+										 const XMFLOAT2& center, float maxDistanceX, float maxDistanceY,
+										 unsigned int* foundIndices, const unsigned int* boxesMask, unsigned int& boxIndex)
+{
+	const __m256 centerX8 = _mm256_set1_ps(center.x);
+	const __m256 centerY8 = _mm256_set1_ps(center.y);
+	const __m256 maxDistanceX8 = _mm256_set1_ps(maxDistanceX);
+	const __m256 maxDistanceY8 = _mm256_set1_ps(maxDistanceY);
+	const __m256 epsilon8 = _mm256_set1_ps(gk_epsilon);
+	const __m256 signMask8 = _mm256_set1_ps(-0.0f);
+
+	unsigned int foundCount = 0;
+
+	for (; boxIndex + 8 <= boxesCount; boxIndex += 8)
+	{
+		//the groups of dead boxes are skipped without loading them
+		const unsigned int aliveMask = lanesMask(boxesMask, boxIndex, 0xFF);
+		if (aliveMask == 0)
+		{
+			continue;
+		}
+
+		const __m256 distanceX = _mm256_andnot_ps(signMask8, _mm256_sub_ps(centerX8, _mm256_loadu_ps(centersX + boxIndex)));
+		const __m256 distanceY = _mm256_andnot_ps(signMask8, _mm256_sub_ps(centerY8, _mm256_loadu_ps(centersY + boxIndex)));
+
+		const __m256 touchingX = _mm256_cmp_ps(_mm256_sub_ps(distanceX, maxDistanceX8), epsilon8, _CMP_LE_OQ);
+		const __m256 touchingY = _mm256_cmp_ps(_mm256_sub_ps(distanceY, maxDistanceY8), epsilon8, _CMP_LE_OQ);
+
+		const unsigned int touchingMask = static_cast<unsigned int>(_mm256_movemask_ps(_mm256_and_ps(touchingX, touchingY))) & aliveMask;
+
+		//most of the boxes are far from aabb
+		if (touchingMask == 0)
+		{
+			continue;
+		}
+
+		for (unsigned int lane = 0; lane < 8; ++lane)
+		{
+			foundIndices[foundCount] = boxIndex + lane;
+			foundCount += (touchingMask >> lane) & 1;
+		}
+	}
+
+	return foundCount;
+}
+#endif
+
+unsigned int ArkanoidGame::findTouchingBoxes(const float* centersX, const float* centersY, unsigned int boxesCount,
+											 const XMFLOAT2& boxesHalfExtents, const AABB& aabb, unsigned int* foundIndices,
+											 const unsigned int* boxesMask)
+{
+	assert(boxesCount == 0 || (centersX != nullptr && centersY != nullptr && foundIndices != nullptr));
+
+	const XMFLOAT2& center = aabb.center();
+	const XMFLOAT2& halfExtents = aabb.halfExtents();
+
+	//the same sums of AABB::intersects(), where aabb is the left operand
+	const float maxDistanceX = halfExtents.x + boxesHalfExtents.x;
+	const float maxDistanceY = halfExtents.y + boxesHalfExtents.y;
+
+	unsigned int foundCount = 0;
+	unsigned int boxIndex = 0;
+
+	//each lane writes its index and advances foundCount only when touching:
+	//foundCount <= boxIndex, so the writes never exceed boxesCount elements
+
+#if defined(SIMD_BROADPHASE_AVX) || defined(SIMD_BROADPHASE_SSE2)
+	const ESimdLevel simdLevel = findTouchingBoxesSimdLevel();
+#endif
+
+	//the SSE2 path takes the boxes left by the AVX one, the scalar path the boxes left by both
+#ifdef SIMD_BROADPHASE_AVX
+	if (simdLevel >= SIMD_LEVEL_AVX)
+	{
+		foundCount = findTouchingBoxesAvx(centersX, centersY, boxesCount, center, maxDistanceX, maxDistanceY, foundIndices, boxesMask, boxIndex);
+	}
+#endif
+
+#ifdef SIMD_BROADPHASE_SSE2
+	if (simdLevel >= SIMD_LEVEL_SSE2)
+	{
+		const __m128 centerX4 = _mm_set1_ps(center.x);
+		const __m128 centerY4 = _mm_set1_ps(center.y);
+		const __m128 maxDistanceX4 = _mm_set1_ps(maxDistanceX);
+		const __m128 maxDistanceY4 = _mm_set1_ps(maxDistanceY);
+		const __m128 epsilon4 = _mm_set1_ps(gk_epsilon);
+		const __m128 signMask4 = _mm_set1_ps(-0.0f);
+
+		for (; boxIndex + 4 <= boxesCount; boxIndex += 4)
+		{
+			const unsigned int aliveMask = lanesMask(boxesMask, boxIndex, 0xF);
+			if (aliveMask == 0)
+			{
+				continue;
+			}
+
+			const __m128 distanceX = _mm_andnot_ps(signMask4, _mm_sub_ps(centerX4, _mm_loadu_ps(centersX + boxIndex)));
+			const __m128 distanceY = _mm_andnot_ps(signMask4, _mm_sub_ps(centerY4, _mm_loadu_ps(centersY + boxIndex)));
+
+			const __m128 touchingX = _mm_cmple_ps(_mm_sub_ps(distanceX, maxDistanceX4), epsilon4);
+			const __m128 touchingY = _mm_cmple_ps(_mm_sub_ps(distanceY, maxDistanceY4), epsilon4);
+
+			const unsigned int touchingMask = static_cast<unsigned int>(_mm_movemask_ps(_mm_and_ps(touchingX, touchingY))) & aliveMask;
+
+			if (touchingMask == 0)
+			{
+				continue;
+			}
+
+			for (unsigned int lane = 0; lane < 4; ++lane)
+			{
+				foundIndices[foundCount] = boxIndex + lane;
+				foundCount += (touchingMask >> lane) & 1;
+			}
+		}
+	}
+#endif
+
+	for (; boxIndex < boxesCount; ++boxIndex)
+	{
+		const bool touchingX = lessEqualf(std::abs(center.x - centersX[boxIndex]), maxDistanceX);
+		const bool touchingY = lessEqualf(std::abs(center.y - centersY[boxIndex]), maxDistanceY);
+
+		foundIndices[foundCount] = boxIndex;
+		foundCount += static_cast<unsigned int>(touchingX & touchingY) & lanesMask(boxesMask, boxIndex, 1);
+	}
+
+	return foundCount;
+}
\ No newline at end of file
@@ -0,0 +1,200 @@
+#pragma once
+#include "Engine.h"
+#include "MathCommon.h"
+#include "AABB.h"
+#include <vector>
+#include <cassert>
+
+namespace ArkanoidGame
+{
+	//the instruction sets of findTouchingBoxes(), each one including the previous ones
+	enum ESimdLevel : unsigned int
+	{
+		SIMD_LEVEL_SCALAR = 0,
+		SIMD_LEVEL_SSE2 = 1,
+		SIMD_LEVEL_AVX = 2
+	};
+
+	/*
+	writes to foundIndices the index of each box, centered in (centersX[i], centersY[i]) and sized boxesHalfExtents,
+	which touches aabb with the same test of AABB::intersects(). the indices are written in increasing order.
+	the boxes are tested 8 at a time with AVX, 4 at a time with SSE2, one at a time on the other targets: the x86 builds
+	check at run time whether the CPU supports AVX.
+	if boxesMask is given, it holds one bit per box packed in 32 bits words as BricksBitset::words(): the boxes
+	whose bit is 0 are never found, and the groups of boxes without any bit set are not tested.
+	foundIndices must have room for boxesCount elements. the number of boxes found is returned
+	*/
+	unsigned int findTouchingBoxes(const float* centersX, const float* centersY, unsigned int boxesCount,
+								   const XMFLOAT2& boxesHalfExtents, const AABB& aabb, unsigned int* foundIndices,
+								   const unsigned int* boxesMask = nullptr);
+
+	//the widest instruction set findTouchingBoxes() uses
+	ESimdLevel findTouchingBoxesSimdLevel();
+
+	//limits findTouchingBoxes() to simdLevel at most, e.g. to compare the paths. it must not be called during the queries
+	void setFindTouchingBoxesMaxSimdLevel(ESimdLevel simdLevel);
+
+	/*
+	a broadphase without hierarchy: the objects centers are stored as structure of arrays and all of them are tested
+	by findTouchingBoxes(). for the few bricks of a level the linear scan is cheaper than walking a Quadtree,
+	and the colliders are found in insertion order, until an object is removed.
+	it exposes the construction, insertion and query interface of Quadtree, so the two can be swapped.
+	*/
+	class SimdBroadphase
+	{
+	public:
+		//ctors
+		//the area is not needed, it is accepted to be constructed like a Quadtree.
+		//the arrays are reserved for objectsCapacity objects, so insert() and build() don't allocate up to it
+		explicit SimdBroadphase(const AABB& area, const XMFLOAT2& objectsHalfExtents, unsigned int objectsCapacity);
+
+		//dtor
+		~SimdBroadphase() = default;
+
+		//copy
+		SimdBroadphase(const SimdBroadphase&) = default;
+		SimdBroadphase& operator=(const SimdBroadphase&) = default;
+
+		//move
+		SimdBroadphase(SimdBroadphase&&) = default;
+		SimdBroadphase& operator=(SimdBroadphase&&) = default;
+
+		void insert(const XMFLOAT2& objectCenter, unsigned int objectData);
+
+		//replaces all the objects with the given ones, in the given order
+		void build(const AABB& area, const XMFLOAT2* objectsCenters, const unsigned int* objectsDatas, unsigned int objectsCount);
+
+		//the same as build(): without a hierarchy there is nothing to sort
+		void buildBulk(const AABB& area, const XMFLOAT2* objectsCenters, const unsigned int* objectsDatas, unsigned int objectsCount);
+
+		//foundObjects must point to an array of objectsCount() elements at least
+		//the number of objects actually found is returned
+		unsigned int findPotentialColliders(const AABB& objectAABB, unsigned int* foundObjects)const;
+
+		//the last object takes the place of the removed one. returns false if the object is not in the broadphase
+		bool remove(const XMFLOAT2& objectCenter, unsigned int objectData);
+
+		//returns false if the object is not in the broadphase
+		bool update(const XMFLOAT2& oldObjectCenter, const XMFLOAT2& newObjectCenter, unsigned int objectData);
+
+		unsigned int objectsCount()const;
+
+	private:
+		//returns objectsCount() if the object is not in the broadphase
+		unsigned int findObject(const XMFLOAT2& objectCenter, unsigned int objectData)const;
+
+		std::vector<float> m_objectsCentersX{};
+		std::vector<float> m_objectsCentersY{};
+		std::vector<unsigned int> m_objectsDatas{};
+
+		XMFLOAT2 m_objectsHalfExtents;
+	};
+
+	inline SimdBroadphase::SimdBroadphase(const AABB&, const XMFLOAT2& objectsHalfExtents,
+										  unsigned int objectsCapacity) : m_objectsHalfExtents{ objectsHalfExtents }
+	{
+		m_objectsCentersX.reserve(objectsCapacity);
+		m_objectsCentersY.reserve(objectsCapacity);
+		m_objectsDatas.reserve(objectsCapacity);
+	}
+
+	inline void SimdBroadphase::insert(const XMFLOAT2& objectCenter, unsigned int objectData)
+	{
+		m_objectsCentersX.push_back(objectCenter.x);
+		m_objectsCentersY.push_back(objectCenter.y);
+		m_objectsDatas.push_back(objectData);
+	}
+
+	inline void SimdBroadphase::build(const AABB&, const XMFLOAT2* objectsCenters, const unsigned int* objectsDatas, unsigned int objectsCount)
+	{
+		assert(objectsCount == 0 || (objectsCenters != nullptr && objectsDatas != nullptr));
+
+		m_objectsCentersX.clear();
+		m_objectsCentersY.clear();
+		m_objectsDatas.clear();
+
+		for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+		{
+			insert(objectsCenters[objectIndex], objectsDatas[objectIndex]);
+		}
+	}
+
+	inline void SimdBroadphase::buildBulk(const AABB& area, const XMFLOAT2* objectsCenters, const unsigned int* objectsDatas, unsigned int objectsCount)
+	{
+		build(area, objectsCenters, objectsDatas, objectsCount);
+	}
+
+	inline unsigned int SimdBroadphase::findPotentialColliders(const AABB& objectAABB, unsigned int* foundObjects)const
+	{
+		assert(foundObjects != nullptr);
+
+		const unsigned int foundObjectsCount = findTouchingBoxes(m_objectsCentersX.data(), m_objectsCentersY.data(), objectsCount(),
+																 m_objectsHalfExtents, objectAABB, foundObjects);
+
+		//from the positions in the arrays to the objects datas
+		for (unsigned int foundObjectIndex = 0; foundObjectIndex < foundObjectsCount; ++foundObjectIndex)
+		{
+			foundObjects[foundObjectIndex] = m_objectsDatas[foundObjects[foundObjectIndex]];
+		}
+
+		return foundObjectsCount;
+	}
+
+	inline bool SimdBroadphase::remove(const XMFLOAT2& objectCenter, unsigned int objectData)
+	{
+		const unsigned int objectIndex = findObject(objectCenter, objectData);
+		if (objectIndex == objectsCount())
+		{
+			return false;
+		}
+
+		//the order of the objects doesn't matter, so the arrays are kept dense without shifting them
+		m_objectsCentersX[objectIndex] = m_objectsCentersX.back();
+		m_objectsCentersY[objectIndex] = m_objectsCentersY.back();
+		m_objectsDatas[objectIndex] = m_objectsDatas.back();
+
+		m_objectsCentersX.pop_back();
+		m_objectsCentersY.pop_back();
+		m_objectsDatas.pop_back();
+
+		return true;
+	}
+
+	inline bool SimdBroadphase::update(const XMFLOAT2& oldObjectCenter, const XMFLOAT2& newObjectCenter, unsigned int objectData)
+	{
+		const unsigned int objectIndex = findObject(oldObjectCenter, objectData);
+		if (objectIndex == objectsCount())
+		{
+			return false;
+		}
+
+		m_objectsCentersX[objectIndex] = newObjectCenter.x;
+		m_objectsCentersY[objectIndex] = newObjectCenter.y;
+
+		return true;
+	}
+
+	inline unsigned int SimdBroadphase::findObject(const XMFLOAT2& objectCenter, unsigned int objectData)const
+	{
+		const unsigned int objectsCount = this->objectsCount();
+
+		unsigned int objectIndex = 0;
+		for (; objectIndex < objectsCount; ++objectIndex)
+		{
+			if (m_objectsDatas[objectIndex] == objectData)
+			{
+				break;
+			}
+		}
+
+		assert(objectIndex == objectsCount || (m_objectsCentersX[objectIndex] == objectCenter.x && m_objectsCentersY[objectIndex] == objectCenter.y));
+		(void)objectCenter; //read by the assert only
+
+		return objectIndex;
+	}
+
+	inline unsigned int SimdBroadphase::objectsCount()const
+	{
+		return static_cast<unsigned int>(m_objectsDatas.size());
+	}
+}
\ No newline at end of file
@@ -0,0 +1,606 @@
+#include "SimulationCore.h"
+#include "AABB.h"
+#include "GameplayConstants.h"
+#include "LevelGenerator.h"
+#include "SimulationRules.h"
+#include <algorithm>
+#include <limits>
+
+using namespace ArkanoidGame;
+
+constexpr float SimulationCore::sk_noContactTime;
+constexpr unsigned int SimulationCore::sk_maxBallContactsPerStep;
+constexpr unsigned int SimulationCore::sk_maxKineticEventsPerStep;
+constexpr float SimulationCore::sk_kineticSweepTime;
+constexpr float SimulationCore::sk_ballQueryCacheMargin;
+constexpr EBroadphaseType SimulationCore::sk_defaultBricksBroadphaseType;
+constexpr unsigned int SimulationCore::sk_quadtreeMaxDepth;
+constexpr unsigned int SimulationCore::sk_maxRecordedBallQueries;
+
+static SimulationCore::BricksBroadphase createBricksBroadphase(const XMFLOAT2& bricksHalfExtents)
+{
+	const AABB arenaAABB = AABB::computeFromCenterAndHalfExtents(XMFLOAT2{ 0.0f, 0.0f },
+																 XMFLOAT2{ static_cast<float>(gk_arenaHalfWidth),
+																		   static_cast<float>(gk_arenaHalfHeight) });
+	return SimulationCore::BricksBroadphase{ arenaAABB, bricksHalfExtents, gk_bricksCount, SimulationCore::sk_defaultBricksBroadphaseType };
+}
+
+class SimulationCore::GameState
+{
+public:
+	//ctors
+	explicit GameState(SimulationCore& simulation);
+
+	float& ballX();
+	float& ballY();
+	float& ballVelocityX();
+	float& ballVelocityY();
+
+	float& playerX();
+
+	float& bonusX();
+	float& bonusY();
+	bool isBonusAlive()const;
+	void setBonusAlive(bool alive);
+	unsigned int& bonusBricksHit();
+	unsigned int& nextBonusBricksHitCount();
+	std::minstd_rand& randomEngine();
+
+	XMFLOAT2 brickPosition(unsigned int brickIndex)const;
+	unsigned int& brickRemainingHits(unsigned int brickIndex);
+	void destroyBrick(unsigned int brickIndex);
+	unsigned int findTouchingBrick(const AABB& ballAABB);
+	SweptCollisionData findEarliestBrickContact(const XMFLOAT2& ballPosition, const XMFLOAT2& ballDisplacement, unsigned int& hitBrickIndex);
+
+	KineticBallMotion& kineticBallMotion();
+
+	void restartLevel();
+
+private:
+	SimulationCore& m_simulation;
+};
+
+inline SimulationCore::GameState::GameState(SimulationCore& simulation) : m_simulation(simulation)
+{
+}
+
+inline float& SimulationCore::GameState::ballX()
+{
+	return m_simulation.ballTransformToModify().x;
+}
+
+inline float& SimulationCore::GameState::ballY()
+{
+	return m_simulation.ballTransformToModify().y;
+}
+
+inline float& SimulationCore::GameState::ballVelocityX()
+{
+	return m_simulation.m_ballVelocity.x;
+}
+
+inline float& SimulationCore::GameState::ballVelocityY()
+{
+	return m_simulation.m_ballVelocity.y;
+}
+
+inline float& SimulationCore::GameState::playerX()
+{
+	return m_simulation.playerTransformToModify().x;
+}
+
+inline float& SimulationCore::GameState::bonusX()
+{
+	return m_simulation.bonusTransformToModify().x;
+}
+
+inline float& SimulationCore::GameState::bonusY()
+{
+	return m_simulation.bonusTransformToModify().y;
+}
+
+inline bool SimulationCore::GameState::isBonusAlive()const
+{
+	return m_simulation.m_bonusAlive;
+}
+
+inline void SimulationCore::GameState::setBonusAlive(bool alive)
+{
+	m_simulation.m_bonusAlive = alive;
+}
+
+inline unsigned int& SimulationCore::GameState::bonusBricksHit()
+{
+	return m_simulation.m_bonusBricksHit;
+}
+
+inline unsigned int& SimulationCore::GameState::nextBonusBricksHitCount()
+{
+	return m_simulation.m_nextBonusBricksHitCount;
+}
+
+inline std::minstd_rand& SimulationCore::GameState::randomEngine()
+{
+	return m_simulation.m_randomEngine;
+}
+
+inline XMFLOAT2 SimulationCore::GameState::brickPosition(unsigned int brickIndex)const
+{
+	const XMFLOAT4& brickTranslateAndScale = m_simulation.brickTransform(brickIndex);
+	return XMFLOAT2{ brickTranslateAndScale.x, brickTranslateAndScale.y };
+}
+
+inline unsigned int& SimulationCore::GameState::brickRemainingHits(unsigned int brickIndex)
+{
+	return m_simulation.brickRemainingHitsToModify(brickIndex);
+}
+
+inline void SimulationCore::GameState::destroyBrick(unsigned int brickIndex)
+{
+	m_simulation.destroyBrick(brickIndex);
+}
+
+inline unsigned int SimulationCore::GameState::findTouchingBrick(const AABB& ballAABB)
+{
+	return m_simulation.findTouchingBrick(ballAABB);
+}
+
+inline SimulationCore::SweptCollisionData SimulationCore::GameState::findEarliestBrickContact(const XMFLOAT2& ballPosition, const XMFLOAT2& ballDisplacement,
+																							 unsigned int& hitBrickIndex)
+{
+	return m_simulation.findEarliestBrickContact(ballPosition, ballDisplacement, hitBrickIndex);
+}
+
+inline SimulationCore::KineticBallMotion& SimulationCore::GameState::kineticBallMotion()
+{
+	return m_simulation.m_kineticBallMotion;
+}
+
+inline void SimulationCore::GameState::restartLevel()
+{
+	m_simulation.restartLevel();
+}
+
+SimulationCore::SimulationCore(unsigned int randomSeed, ECollisionMode collisionMode) : m_bricksBroadphase{ createBricksBroadphase(gk_bricksHalfExtents) },
+																						 m_randomEngine{ randomSeed },
+																						 m_collisionMode{ collisionMode }
+{
+	std::fill(std::begin(m_perLayoutBricksSubdivision), std::end(m_perLayoutBricksSubdivision), defaultBricksSubdivision());
+
+	restartLevel();
+}
+
+SubdivisionSettings SimulationCore::defaultBricksSubdivision()
+{
+	SubdivisionSettings settings{};
+	settings.maxDepth = 2;
+	return settings;
+}
+
+void SimulationCore::restartLevel()
+{
+	placeBricks();
+
+	//ball
+	ballTransformToModify() = startBallTransform();
+	m_ballVelocity = startBallVelocity();
+
+	//player
+	playerTransformToModify() = startPlayerTransform();
+
+	//arena
+	arenaTransformToModify() = startArenaTransform();
+
+	//bonus
+	bonusTransformToModify() = startBonusTransform();
+
+	m_bonusAlive = false;
+	m_bonusBricksHit = 0;
+	m_nextBonusBricksHitCount = generateNextBonusBricksHitCount(m_randomEngine);
+
+	m_kineticBallMotion.contactValid = false;
+}
+
+void SimulationCore::placeBricks()
+{
+	BricksLayout bricksLayout;
+	generateBricksLayout(m_randomEngine, bricksLayout);
+
+	const unsigned int placedBricks = bricksLayout.placedBricksCount;
+
+	for (unsigned int brickIndex = 0; brickIndex < placedBricks; ++brickIndex)
+	{
+		brickTransformToModify(brickIndex) = bricksLayout.transforms[brickIndex];
+		assignBrickType(brickIndex, bricksLayout.types[brickIndex]);
+	}
+
+	m_aliveBricks.setFirst(placedBricks);
+
+	//the queries recorded against another layout don't tell how to subdivide this one
+	if (bricksLayout.layoutIndex != m_bricksLayoutIndex)
+	{
+		m_recordedBallQueries.clear();
+	}
+
+	m_bricksAABB = bricksLayout.aabb;
+	m_bricksLayoutIndex = bricksLayout.layoutIndex;
+	buildBricksBroadphase();
+
+	//hide unplaced bricks
+	for (unsigned int unPlacedBrickIndex = placedBricks; unPlacedBrickIndex < gk_bricksCount; ++unPlacedBrickIndex)
+	{
+		translateOutOfArena(brickTransformToModify(unPlacedBrickIndex));
+		brickRemainingHitsToModify(unPlacedBrickIndex) = 0;
+	}
+}
+
+void SimulationCore::buildBricksBroadphase()
+{
+	//the broadphase is rebuilt in place, so restarting a level doesn't allocate
+	XMFLOAT2 bricksCenters[gk_bricksCount];
+	unsigned int bricksIndices[gk_bricksCount];
+
+	unsigned int bricksCount = 0;
+
+	for (unsigned int brickIndex = 0; brickIndex < gk_bricksCount; ++brickIndex)
+	{
+		if (!m_aliveBricks.test(brickIndex))
+		{
+			continue;
+		}
+
+		const XMFLOAT4& brickTranslationAndScale = brickTransform(brickIndex);
+		bricksCenters[bricksCount] = XMFLOAT2{ brickTranslationAndScale.x, brickTranslationAndScale.y };
+		bricksIndices[bricksCount] = brickIndex;
+		++bricksCount;
+	}
+
+	m_bricksBroadphase.quadtreeSubdivisionPolicy().setSubdivisionSettings(m_perLayoutBricksSubdivision[m_bricksLayoutIndex]);
+	m_bricksBroadphase.buildBulk(m_bricksAABB, bricksCenters, bricksIndices, bricksCount);
+
+	//sized here rather than on the first query of a step. the broadphase may also have been replaced by another one at
+	//the same address, so the cache is invalidated
+	m_bricksBroadphase.bindQueryCache(m_ballQueryCache);
+}
+
+void SimulationCore::setBricksBroadphaseType(EBroadphaseType type)
+{
+	//the queries find the same bricks, so the step results don't change
+	m_bricksBroadphase.setType(type);
+	buildBricksBroadphase();
+}
+
+void SimulationCore::setBallQueriesRecording(bool recording)
+{
+	if (recording)
+	{
+		m_recordedBallQueries.reserve(sk_maxRecordedBallQueries);
+	}
+
+	m_recordingBallQueries = recording;
+}
+
+SubdivisionTuningResult SimulationCore::tuneBricksSubdivision()
+{
+	SubdivisionSettings& layoutSubdivision = m_perLayoutBricksSubdivision[m_bricksLayoutIndex];
+
+	if (m_recordedBallQueries.empty())
+	{
+		return SubdivisionTuningResult{ layoutSubdivision, 0.0f, 0.0f };
+	}
+
+	XMFLOAT2 bricksCenters[gk_bricksCount];
+	unsigned int bricksCount = 0;
+
+	for (unsigned int brickIndex = 0; brickIndex < gk_bricksCount; ++brickIndex)
+	{
+		if (m_aliveBricks.test(brickIndex))
+		{
+			const XMFLOAT4& brickTranslationAndScale = brickTransform(brickIndex);
+			bricksCenters[bricksCount++] = XMFLOAT2{ brickTranslationAndScale.x, brickTranslationAndScale.y };
+		}
+	}
+
+	const std::vector<SubdivisionSettings> candidates = generateSubdivisionCandidates(sk_quadtreeMaxDepth, gk_bricksHalfExtents,
+																					   gk_ballHalfExtents);
+
+	const SubdivisionTuningResult result = tuneSubdivision<sk_quadtreeMaxDepth>(m_bricksAABB, gk_bricksHalfExtents,
+																				 bricksCenters, bricksCount,
+																				 m_recordedBallQueries.data(),
+																				 recordedBallQueriesCount(), gk_ballHalfExtents,
+																				 candidates.data(), static_cast<unsigned int>(candidates.size()));
+
+	layoutSubdivision = result.settings;
+
+	if (m_bricksBroadphase.type() == BROADPHASE_QUADTREE)
+	{
+		buildBricksBroadphase();
+	}
+
+	return result;
+}
+
+void SimulationCore::recordBallQuery(const XMFLOAT2& ballPosition, const XMFLOAT2& ballDisplacement)
+{
+	if (m_recordedBallQueries.size() < sk_maxRecordedBallQueries)
+	{
+		m_recordedBallQueries.push_back(RecordedQuery{ ballPosition, ballDisplacement });
+	}
+}
+
+bool SimulationCore::step(float deltaTime, unsigned int inputFlags)
+{
+	GameState state{ *this };
+
+	if (m_collisionMode == COLLISION_SWEPT)
+	{
+		return SimulationRules::stepSwept(state, deltaTime, inputFlags);
+	}
+
+	if (m_collisionMode == COLLISION_KINETIC)
+	{
+		return SimulationRules::stepKinetic(state, deltaTime, inputFlags);
+	}
+
+	return SimulationRules::stepDiscrete(state, deltaTime, inputFlags);
+}
+
+SimulationCore::CollisionData SimulationCore::ballAABBCollisionData(const AABB& aabb,
+																	const XMFLOAT2& currBallAABBMin, const XMFLOAT2& currBallAABBMax,
+																	const XMFLOAT2& lastBallAABBMin, const XMFLOAT2& lastBallAABBMax)
+{
+	auto collideFromTop = [](const XMFLOAT2& aabbMax, const XMFLOAT2& currBallAABBMin, const XMFLOAT2& lastBallAABBMin)
+	{
+		const float currBottom = currBallAABBMin.y;
+		const float lastBottom = lastBallAABBMin.y;
+		const unsigned int wasTop = static_cast<unsigned int>(lessEqualf(aabbMax.y, lastBottom));
+		const unsigned int isNotTop = static_cast<unsigned int>(lessEqualf(currBottom, aabbMax.y));
+		return wasTop & isNotTop;
+	};
+
+	auto collideFromBottom = [](const XMFLOAT2& aabbMin, const XMFLOAT2& currBallAABBMax, const XMFLOAT2& lastBallAABBMax)
+	{
+		const float currTop = currBallAABBMax.y;
+		const float lastTop = lastBallAABBMax.y;
+		const unsigned int wasBottom = static_cast<unsigned int>(lessEqualf(lastTop, aabbMin.y));
+		const unsigned int isNotBottom = static_cast<unsigned int>(lessEqualf(aabbMin.y, currTop));
+		return wasBottom & isNotBottom;
+	};
+
+	auto collideFromRight = [](const XMFLOAT2& aabbMax, const XMFLOAT2& currBallAABBMin, const XMFLOAT2& lastBallAABBMin)
+	{
+		const float currLeft = currBallAABBMin.x;
+		const float lastLeft = lastBallAABBMin.x;
+		const unsigned int wasRight = static_cast<unsigned int>(lessEqualf(aabbMax.x, lastLeft));
+		const unsigned int isNotRight = static_cast<unsigned int>(lessEqualf(currLeft, aabbMax.x));
+		return wasRight & isNotRight;
+	};
+
+	auto collideFromLeft = [](const XMFLOAT2& aabbMin, const XMFLOAT2& currBallAABBMax, const XMFLOAT2& lastBallAABBMax)
+	{
+		const float currRight = currBallAABBMax.x;
+		const float lastRight = lastBallAABBMax.x;
+		const unsigned int wasLeft = static_cast<unsigned int>(lessEqualf(lastRight, aabbMin.x));
+		const unsigned int isNotLeft = static_cast<unsigned int>(lessEqualf(aabbMin.x, currRight));
+		return wasLeft & isNotLeft;
+	};
+
+	const XMFLOAT2 aabbMin = aabb.min();
+	const XMFLOAT2 aabbMax = aabb.max();
+
+	CollisionData collisionData;
+	collisionData.fromRight = collideFromRight(aabbMax, currBallAABBMin, lastBallAABBMin);
+	collisionData.fromLeft = collideFromLeft(aabbMin, currBallAABBMax, lastBallAABBMax);
+	collisionData.fromTop = collideFromTop(aabbMax, currBallAABBMin, lastBallAABBMin);
+	collisionData.fromBottom = collideFromBottom(aabbMin, currBallAABBMax, lastBallAABBMax);
+
+	return collisionData;
+}
+
+SimulationCore::SweptCollisionData SimulationCore::ballAABBSweptCollisionData(const AABB& aabb, const XMFLOAT2& ballPosition,
+																			  const XMFLOAT2& ballHalfExtents, const XMFLOAT2& ballDisplacement)
+{
+	//the ball center is swept against the aabb grown by the ball half extents: on each axis it is inside the grown aabb
+	//between the times it crosses the two faces, and it touches the aabb when the two intervals overlap
+	auto axisTimes = [](float facesMin, float facesMax, float position, float displacement,
+						float& enterTime, float& exitTime, float& enterFace)
+	{
+		if (displacement == 0.0f)
+		{
+			//inside the faces for the whole displacement or never
+			const float infinity = std::numeric_limits<float>::infinity();
+			const bool inside = facesMin < position && position < facesMax;
+			enterTime = inside ? -infinity : infinity;
+			exitTime = inside ? infinity : -infinity;
+			enterFace = position;
+			return;
+		}
+
+		const unsigned int positive = static_cast<unsigned int>(displacement > 0.0f);
+		const float enterFaces[2] = { facesMax, facesMin };
+		const float exitFaces[2] = { facesMin, facesMax };
+
+		enterFace = enterFaces[positive];
+		enterTime = (enterFaces[positive] - position) / displacement;
+		exitTime = (exitFaces[positive] - position) / displacement;
+	};
+
+	const XMFLOAT2 facesMin = aabb.min() - ballHalfExtents;
+	const XMFLOAT2 facesMax = aabb.max() + ballHalfExtents;
+
+	float enterTimeX, exitTimeX, enterFaceX;
+	float enterTimeY, exitTimeY, enterFaceY;
+	axisTimes(facesMin.x, facesMax.x, ballPosition.x, ballDisplacement.x, enterTimeX, exitTimeX, enterFaceX);
+	axisTimes(facesMin.y, facesMax.y, ballPosition.y, ballDisplacement.y, enterTimeY, exitTimeY, enterFaceY);
+
+	const float enterTime = std::max(enterTimeX, enterTimeY);
+	const float exitTime = std::min(exitTimeX, exitTimeY);
+
+	//a ball already overlapping the aabb touches it at time 0, and it is pushed out from the last face it crossed
+	const unsigned int touches = static_cast<unsigned int>(enterTime < exitTime && enterTime <= 1.0f && exitTime > 0.0f);
+
+	const float times[2] = { sk_noContactTime, std::max(enterTime, 0.0f) };
+
+	SweptCollisionData collisionData;
+	collisionData.time = times[touches];
+	collisionData.alongX = touches & static_cast<unsigned int>(enterTimeX >= enterTimeY);
+	collisionData.alongY = touches & static_cast<unsigned int>(enterTimeY >= enterTimeX);
+
+	//the contact axes are put exactly on the faces, so the next sweep from there doesn't touch the aabb again
+	const XMFLOAT2 contactPosition = ballPosition + ballDisplacement * collisionData.time;
+	const float contactPositionsX[2] = { contactPosition.x, enterFaceX };
+	const float contactPositionsY[2] = { contactPosition.y, enterFaceY };
+	collisionData.contactPosition = XMFLOAT2{ contactPositionsX[collisionData.alongX], contactPositionsY[collisionData.alongY] };
+
+	return collisionData;
+}
+
+SimulationCore::SweptCollisionData SimulationCore::ballArenaSweptCollisionData(const XMFLOAT2& ballPosition,
+																			   const XMFLOAT2& ballHalfExtents, const XMFLOAT2& ballDisplacement)
+{
+	//the time the ball center reaches the wall it moves towards. a ball already beyond it touches it at time 0
+	auto axisTime = [](float wallMin, float wallMax, float position, float displacement, float& wall)
+	{
+		const unsigned int positive = static_cast<unsigned int>(displacement > 0.0f);
+		const float walls[2] = { wallMin, wallMax };
+		wall = walls[positive];
+
+		if (displacement == 0.0f)
+		{
+			return sk_noContactTime;
+		}
+
+		return std::max((wall - position) / displacement, 0.0f);
+	};
+
+	//there is no wall at the bottom: the ball leaves the arena and the level is restarted
+	const float noWall = -std::numeric_limits<float>::infinity();
+
+	float wallX, wallY;
+	const float timeX = axisTime(gk_arenaMinX + ballHalfExtents.x, gk_arenaMaxX - ballHalfExtents.x, ballPosition.x, ballDisplacement.x, wallX);
+	const float timeY = axisTime(noWall, gk_arenaMaxY - ballHalfExtents.y, ballPosition.y, ballDisplacement.y, wallY);
+
+	const float time = std::min(timeX, timeY);
+	const unsigned int touches = static_cast<unsigned int>(time <= 1.0f);
+
+	const float times[2] = { sk_noContactTime, time };
+
+	SweptCollisionData collisionData;
+	collisionData.time = times[touches];
+	collisionData.alongX = touches & static_cast<unsigned int>(timeX == time);
+	collisionData.alongY = touches & static_cast<unsigned int>(timeY == time);
+
+	const XMFLOAT2 contactPosition = ballPosition + ballDisplacement * collisionData.time;
+	const float contactPositionsX[2] = { contactPosition.x, wallX };
+	const float contactPositionsY[2] = { contactPosition.y, wallY };
+	collisionData.contactPosition = XMFLOAT2{ contactPositionsX[collisionData.alongX], contactPositionsY[collisionData.alongY] };
+
+	return collisionData;
+}
+
+unsigned int SimulationCore::findTouchingBrick(const AABB& currBallAABB)
+{
+	if (m_recordingBallQueries)
+	{
+		recordBallQuery(currBallAABB.center(), XMFLOAT2{ 0.0f, 0.0f });
+	}
+
+	const unsigned int* ballColliders;
+	const unsigned int ballCollidersCount = m_bricksBroadphase.findPotentialColliders(currBallAABB, m_ballColliders, ballColliders, m_ballQueryCache);
+
+	//the result doesn't depend on the order in which the broadphase returns the colliders
+	unsigned int hitBrickIndex = gk_bricksCount;
+
+	for (unsigned int colliderIndex = 0; colliderIndex < ballCollidersCount; ++colliderIndex)
+	{
+		const unsigned int brickIndex = ballColliders[colliderIndex];
+		assert(brickIndex < gk_bricksCount);
+
+		if (brickIndex >= hitBrickIndex)
+		{
+			continue;
+		}
+
+		const XMFLOAT4& brickTranslateAndScale = brickTransform(brickIndex);
+		const XMFLOAT2 brickAABBCenter{ brickTranslateAndScale.x, brickTranslateAndScale.y };
+		const AABB aabb = AABB::computeFromCenterAndHalfExtents(brickAABBCenter, gk_bricksHalfExtents);
+
+		if (currBallAABB.intersects(aabb))
+		{
+			hitBrickIndex = brickIndex;
+		}
+	}
+
+	return hitBrickIndex;
+}
+
+SimulationCore::SweptCollisionData SimulationCore::findEarliestBrickContact(const XMFLOAT2& ballPosition, const XMFLOAT2& ballDisplacement,
+																			unsigned int& hitBrickIndex)
+{
+	//the bricks which can be touched by the ball during the displacement. the quadtree visits only the quadrants crossed
+	//by the ball, so a long displacement doesn't return most of the bricks
+	const XMFLOAT2 endBallPosition = ballPosition + ballDisplacement;
+
+	if (m_recordingBallQueries)
+	{
+		recordBallQuery(ballPosition, ballDisplacement);
+	}
+
+	const unsigned int ballCollidersCount = m_bricksBroadphase.findSweptPotentialColliders(ballPosition, ballDisplacement,
+																						   gk_ballHalfExtents, m_ballColliders);
+
+	SweptCollisionData earliestContact{ sk_noContactTime, 0, 0, endBallPosition };
+	hitBrickIndex = gk_bricksCount;
+
+	for (unsigned int colliderIndex = 0; colliderIndex < ballCollidersCount; ++colliderIndex)
+	{
+		const unsigned int brickIndex = m_ballColliders[colliderIndex];
+		assert(brickIndex < gk_bricksCount);
+
+		const XMFLOAT4& brickTranslateAndScale = brickTransform(brickIndex);
+		const XMFLOAT2 brickAABBCenter{ brickTranslateAndScale.x, brickTranslateAndScale.y };
+		const AABB aabb = AABB::computeFromCenterAndHalfExtents(brickAABBCenter, gk_bricksHalfExtents);
+
+		const SweptCollisionData contact = ballAABBSweptCollisionData(aabb, ballPosition, gk_ballHalfExtents, ballDisplacement);
+
+		//the result doesn't depend on the order in which the broadphase returns the colliders
+		const bool earlier = contact.time < earliestContact.time || (contact.time == earliestContact.time && brickIndex < hitBrickIndex);
+
+		if (contact.time <= 1.0f && earlier)
+		{
+			earliestContact = contact;
+			hitBrickIndex = brickIndex;
+		}
+	}
+
+	return earliestContact;
+}
+
+void SimulationCore::destroyBrick(unsigned int brickIndex)
+{
+	assert(m_aliveBricks.test(brickIndex));
+
+	XMFLOAT4& brickTranslateAndScale = brickTransformToModify(brickIndex);
+	const XMFLOAT2 brickAABBCenter{ brickTranslateAndScale.x, brickTranslateAndScale.y };
+
+	m_aliveBricks.reset(brickIndex);
+
+	//the destroyed bricks are not returned by the next queries
+	const bool brickRemoved = m_bricksBroadphase.remove(brickAABBCenter, brickIndex);
+	assert(brickRemoved && "the broadphase is out of sync with the bricks");
+	(void)brickRemoved; //read by the assert only
+
+	translateOutOfArena(brickTranslateAndScale);
+}
+
+void SimulationCore::assignBrickType(unsigned int brickIndex, unsigned int brickTypeIndex)
+{
+	assert(brickTypeIndex < gk_brickTypesCount);
+	m_bricksTypes[brickIndex] = brickTypeIndex;
+	brickRemainingHitsToModify(brickIndex) = gk_bricksHitsCounts[brickTypeIndex];
+}
+
+void SimulationCore::translateOutOfArena(XMFLOAT4& transform)
+{
+	transform.x = gk_outOfArenaX;
+}
\ No newline at end of file
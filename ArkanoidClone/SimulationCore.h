@@ -0,0 +1,428 @@
+#pragma once
+
+//the bricks broadphase is a Quadtree, unless one of these chooses another one. SimulationCore::setBricksBroadphaseType()
+//changes it at run time
+
+//SimdBroadphase, which tests all the bricks with SIMD instructions
+//#define USE_SIMD_BRICKS_BROADPHASE
+
+//GridBroadphase, which finds the bricks in the cells of their lattice
+//#define USE_GRID_BRICKS_BROADPHASE
+
+//SweepAndPruneBroadphase, which finds the bricks in the slab of columns touched by the ball
+//#define USE_SWEEP_AND_PRUNE_BRICKS_BROADPHASE
+
+#include "Engine.h"
+#include "MathCommon.h"
+#include "ArkanoidRenderer.h"
+#include "Dimensions.h"
+#include "Quadtree.h"
+#include "Broadphase.h"
+#include "QuadtreeQueryCache.h"
+#include "QuadtreeSubdivision.h"
+#include "LevelGenerator.h"
+#include "BricksBitset.h"
+#include <random>
+#include <vector>
+
+namespace ArkanoidGame
+{
+	class AABB;
+
+	/*
+	the gameplay state and rules, without any dependency on the window, the input or the renderer.
+	it can be stepped with any deltaTime and input combination, which allows running it headless.
+	*/
+	class SimulationCore
+	{
+	public:
+		//how step() moves the ball against the walls, the player and the bricks
+		enum ECollisionMode : unsigned int
+		{
+			//the ball is moved by the whole step, then the first overlap is resolved: fast balls can cross the colliders
+			COLLISION_DISCRETE = 0,
+			//the ball is swept along its displacement and stopped at each contact, in time order, within the step
+			COLLISION_SWEPT = 1,
+			//the state is advanced in closed form from an event to the next one (a contact of the ball, the player stopping
+			//at a wall, the bonus taken or missed), with the player moving during the whole step. the next contact of the ball
+			//with the walls and the bricks is searched only when the ball changes direction, so a step can be long
+			COLLISION_KINETIC = 2
+		};
+
+		//ctors
+		explicit SimulationCore(unsigned int randomSeed, ECollisionMode collisionMode = COLLISION_DISCRETE);
+
+		//dtor
+		~SimulationCore() = default;
+
+		//copy
+		SimulationCore(const SimulationCore&) = default;
+		SimulationCore& operator=(const SimulationCore&) = default;
+
+		//move
+		SimulationCore(SimulationCore&&) = default;
+		SimulationCore& operator=(SimulationCore&&) = default;
+
+		//input bitmask accepted by step()
+		enum EInputFlags : unsigned int
+		{
+			INPUT_NONE = 0,
+			INPUT_LEFT = 1 << 0,
+			INPUT_RIGHT = 1 << 1,
+			INPUT_FIRE = 1 << 2
+		};
+
+		//deltaTime is in seconds. returns true if the level has been restarted during the step
+		bool step(float deltaTime, unsigned int inputFlags);
+
+		void restartLevel();
+
+		const ArkanoidRenderer::TransformsConstantBuffer* transforms()const;
+
+		const XMFLOAT4& ballTransform()const;
+		const XMFLOAT4& playerTransform()const;
+		const XMFLOAT4& arenaTransform()const;
+		const XMFLOAT4& bonusTransform()const;
+		const XMFLOAT4& brickTransform(unsigned int brickIndex)const;
+
+		const XMFLOAT2& ballVelocity()const;
+
+		unsigned int brickType(unsigned int brickIndex)const;
+		unsigned int brickRemainingHits(unsigned int brickIndex)const;
+
+		//the placed bricks not destroyed yet
+		unsigned int aliveBricksCount()const;
+
+		//true if all the bricks have been destroyed
+		bool isLevelCleared()const;
+
+		bool isBonusAlive()const;
+
+		ECollisionMode collisionMode()const;
+		void setCollisionMode(ECollisionMode collisionMode);
+
+		struct CollisionData
+		{
+			//the following are either 0 or 1 to indicate the direction from which the ball hits an AABB
+			unsigned int fromRight;
+			unsigned int fromLeft;
+			unsigned int fromTop;
+			unsigned int fromBottom;
+		};
+
+		//stateless, shared with the other simulations so that they resolve the collisions the same way
+		static CollisionData ballAABBCollisionData(const AABB& aabb,
+												   const XMFLOAT2& currBallAABBMin, const XMFLOAT2& currBallAABBMax,
+												   const XMFLOAT2& lastBallAABBMin, const XMFLOAT2& lastBallAABBMax);
+
+		struct SweptCollisionData
+		{
+			//the fraction of the ball displacement done at the contact, in [0, 1]. sk_noContactTime if there is no contact
+			float time;
+
+			//either 0 or 1: the ball reaches the collider moving along x (a vertical side), along y or both (a corner)
+			unsigned int alongX;
+			unsigned int alongY;
+
+			//where the ball center is at the contact, touching the collider from outside
+			XMFLOAT2 contactPosition;
+		};
+
+		//stateless, the earliest contact of the ball with the aabb while moving by ballDisplacement.
+		//a ball touching the aabb and moving away from it doesn't collide
+		static SweptCollisionData ballAABBSweptCollisionData(const AABB& aabb, const XMFLOAT2& ballPosition,
+															 const XMFLOAT2& ballHalfExtents, const XMFLOAT2& ballDisplacement);
+
+		//stateless, the earliest contact of the ball with the left, right and top walls while moving by ballDisplacement
+		static SweptCollisionData ballArenaSweptCollisionData(const XMFLOAT2& ballPosition,
+															  const XMFLOAT2& ballHalfExtents, const XMFLOAT2& ballDisplacement);
+
+		static constexpr float sk_noContactTime = 2.0f;
+
+		//COLLISION_SWEPT: the contacts resolved by a step at most, the rest of a step with more contacts is dropped
+		static constexpr unsigned int sk_maxBallContactsPerStep = 8;
+
+		//COLLISION_KINETIC: the events handled by a step at most, the rest of a step with more events is dropped
+		static constexpr unsigned int sk_maxKineticEventsPerStep = 1024;
+
+		//COLLISION_KINETIC: how far in the future the next contact of the ball is searched, in seconds
+		static constexpr float sk_kineticSweepTime = 2.0f;
+
+		//COLLISION_KINETIC: the motion of the ball since it last changed direction
+		struct KineticBallMotion
+		{
+			//the ball is at origin + ball velocity * elapsedTime
+			XMFLOAT2 origin;
+			float elapsedTime;
+
+			//the next contact with the walls (contactBrickIndex is gk_bricksCount) or a brick, contactTime after the origin
+			SweptCollisionData contact;
+			float contactTime;
+			unsigned int contactBrickIndex;
+
+			//false when the ball has been moved by something else than the motion: the contact is searched again
+			bool contactValid;
+		};
+
+		//the bricks quadtree is subdivided down to sk_quadtreeMaxDepth at most, as the settings of the layout tell
+		static constexpr unsigned int sk_quadtreeMaxDepth = 3;
+		using Quadtree = ArkanoidGame::Quadtree<unsigned int, sk_quadtreeMaxDepth, TunableSubdivisionPolicy>;
+
+		using BricksBroadphase = SwitchableBroadphase<sk_quadtreeMaxDepth, TunableSubdivisionPolicy>;
+
+		//the subdivision of the layouts not tuned: the quadrants holding bricks are subdivided, down to depth 2
+		static SubdivisionSettings defaultBricksSubdivision();
+
+#if defined(USE_SIMD_BRICKS_BROADPHASE)
+		static constexpr EBroadphaseType sk_defaultBricksBroadphaseType = BROADPHASE_SIMD_SCAN;
+#elif defined(USE_GRID_BRICKS_BROADPHASE)
+		static constexpr EBroadphaseType sk_defaultBricksBroadphaseType = BROADPHASE_GRID;
+#elif defined(USE_SWEEP_AND_PRUNE_BRICKS_BROADPHASE)
+		static constexpr EBroadphaseType sk_defaultBricksBroadphaseType = BROADPHASE_SWEEP_AND_PRUNE;
+#else
+		static constexpr EBroadphaseType sk_defaultBricksBroadphaseType = BROADPHASE_QUADTREE;
+#endif
+
+		EBroadphaseType bricksBroadphaseType()const;
+
+		//the alive bricks are moved to a broadphase of the given type, the game goes on as before
+		void setBricksBroadphaseType(EBroadphaseType type);
+
+		//COLLISION_DISCRETE: the ball queries the bricks quadtree through this cache, which is filled again
+		//when the ball moves by more than sk_ballQueryCacheMargin or a brick is destroyed
+		const QuadtreeQueryCache<>& ballQueryCache()const;
+		void resetBallQueryCacheCounters();
+
+		static constexpr float sk_ballQueryCacheMargin = 2.0f;
+
+		//tuning mode: while recording, the bricks queries of the ball are kept, up to sk_maxRecordedBallQueries.
+		//a level with another layout restarts the recording, so the queries are the ones of the current layout
+		void setBallQueriesRecording(bool recording);
+		bool isRecordingBallQueries()const;
+		unsigned int recordedBallQueriesCount()const;
+		const RecordedQuery* recordedBallQueries()const;
+
+		/*
+		replays the recorded queries against the alive bricks with each candidate subdivision of the bricks quadtree, and keeps
+		the fastest one for the layout of the level: the levels with that layout are built with it from now on.
+		the step results don't change. without recorded queries, the subdivision is kept and returned with no time
+		*/
+		SubdivisionTuningResult tuneBricksSubdivision();
+
+		const SubdivisionSettings& bricksSubdivision(unsigned int layoutIndex)const;
+
+		static constexpr unsigned int sk_maxRecordedBallQueries = 16384;
+
+	private:
+		//the accessor of the fields of the game given to the SimulationRules
+		class GameState;
+
+		void placeBricks();
+
+		void assignBrickType(unsigned int brickIndex, unsigned int brickTypeIndex);
+
+		//from the alive bricks
+		void buildBricksBroadphase();
+
+		//the alive brick with the lowest index touching the ball, gk_bricksCount if none
+		unsigned int findTouchingBrick(const AABB& currBallAABB);
+
+		//COLLISION_SWEPT: the earliest contact with the bricks, on the same time the lowest brick index is hit.
+		//hitBrickIndex is gk_bricksCount if there is no contact
+		SweptCollisionData findEarliestBrickContact(const XMFLOAT2& ballPosition, const XMFLOAT2& ballDisplacement,
+													unsigned int& hitBrickIndex);
+
+		//while recording, the ball displacement is 0 for the COLLISION_DISCRETE queries.
+		//the callers test m_recordingBallQueries, so the steps not recording don't pay for the call
+		void recordBallQuery(const XMFLOAT2& ballPosition, const XMFLOAT2& ballDisplacement);
+
+		//out of the arena, the alive bricks and the broadphase
+		void destroyBrick(unsigned int brickIndex);
+
+		void translateOutOfArena(XMFLOAT4& transform);
+
+		XMFLOAT4& ballTransformToModify();
+		XMFLOAT4& playerTransformToModify();
+		XMFLOAT4& arenaTransformToModify();
+		XMFLOAT4& bonusTransformToModify();
+		XMFLOAT4& brickTransformToModify(unsigned int brickIndex);
+
+		unsigned int& brickRemainingHitsToModify(unsigned int brickIndex);
+
+		ArkanoidRenderer::TransformsConstantBuffer m_transforms{};
+
+		BricksBroadphase m_bricksBroadphase;
+
+		std::minstd_rand m_randomEngine;
+
+		XMFLOAT2 m_ballVelocity{};
+
+		unsigned int m_ballColliders[gk_bricksCount];
+
+		QuadtreeQueryCache<> m_ballQueryCache{ XMFLOAT2{ sk_ballQueryCacheMargin, sk_ballQueryCacheMargin } };
+
+		std::vector<RecordedQuery> m_recordedBallQueries; //reserved when the recording starts, so step() doesn't allocate
+		bool m_recordingBallQueries{ false };
+
+		SubdivisionSettings m_perLayoutBricksSubdivision[gk_bricksLayoutsCount];
+		unsigned int m_bricksLayoutIndex{ 0 };
+
+		unsigned int m_bricksRemainingHits[gk_bricksCount]{};
+		unsigned int m_bricksTypes[gk_bricksCount]{};
+
+		//kept in sync with m_bricksRemainingHits
+		BricksBitset m_aliveBricks{};
+
+		AABB m_bricksAABB{}; //bounds of the placed bricks
+
+		unsigned int m_bonusBricksHit{ 0 };
+		unsigned int m_nextBonusBricksHitCount{ 0 };
+		bool m_bonusAlive{ false };
+
+		ECollisionMode m_collisionMode;
+
+		KineticBallMotion m_kineticBallMotion{};
+	};
+
+	inline const ArkanoidRenderer::TransformsConstantBuffer* SimulationCore::transforms()const
+	{
+		return &m_transforms;
+	}
+
+	inline const XMFLOAT4& SimulationCore::ballTransform()const
+	{
+		return m_transforms.translationAndScales[gk_ballIndex];
+	}
+
+	inline const XMFLOAT4& SimulationCore::playerTransform()const
+	{
+		return m_transforms.translationAndScales[gk_playerIndex];
+	}
+
+	inline const XMFLOAT4& SimulationCore::arenaTransform()const
+	{
+		return m_transforms.translationAndScales[gk_arenaIndex];
+	}
+
+	inline const XMFLOAT4& SimulationCore::bonusTransform()const
+	{
+		return m_transforms.translationAndScales[gk_bonusIndex];
+	}
+
+	inline const XMFLOAT4& SimulationCore::brickTransform(unsigned int brickIndex)const
+	{
+		assert(brickIndex < gk_bricksCount);
+		return m_transforms.translationAndScales[gk_bricksStartIndex + brickIndex];
+	}
+
+	inline XMFLOAT4& SimulationCore::ballTransformToModify()
+	{
+		return m_transforms.translationAndScales[gk_ballIndex];
+	}
+
+	inline XMFLOAT4& SimulationCore::playerTransformToModify()
+	{
+		return m_transforms.translationAndScales[gk_playerIndex];
+	}
+
+	inline XMFLOAT4& SimulationCore::arenaTransformToModify()
+	{
+		return m_transforms.translationAndScales[gk_arenaIndex];
+	}
+
+	inline XMFLOAT4& SimulationCore::bonusTransformToModify()
+	{
+		return m_transforms.translationAndScales[gk_bonusIndex];
+	}
+
+	inline XMFLOAT4& SimulationCore::brickTransformToModify(unsigned int brickIndex)
+	{
+		assert(brickIndex < gk_bricksCount);
+		return m_transforms.translationAndScales[gk_bricksStartIndex + brickIndex];
+	}
+
+	inline const XMFLOAT2& SimulationCore::ballVelocity()const
+	{
+		return m_ballVelocity;
+	}
+
+	inline unsigned int SimulationCore::brickType(unsigned int brickIndex)const
+	{
+		assert(brickIndex < gk_bricksCount);
+		return m_bricksTypes[brickIndex];
+	}
+
+	inline unsigned int SimulationCore::brickRemainingHits(unsigned int brickIndex)const
+	{
+		assert(brickIndex < gk_bricksCount);
+		return m_bricksRemainingHits[brickIndex];
+	}
+
+	inline unsigned int& SimulationCore::brickRemainingHitsToModify(unsigned int brickIndex)
+	{
+		assert(brickIndex < gk_bricksCount);
+		return m_bricksRemainingHits[brickIndex];
+	}
+
+	inline unsigned int SimulationCore::aliveBricksCount()const
+	{
+		return m_aliveBricks.count();
+	}
+
+	inline bool SimulationCore::isLevelCleared()const
+	{
+		return m_aliveBricks.none();
+	}
+
+	inline bool SimulationCore::isBonusAlive()const
+	{
+		return m_bonusAlive;
+	}
+
+	inline EBroadphaseType SimulationCore::bricksBroadphaseType()const
+	{
+		return m_bricksBroadphase.type();
+	}
+
+	inline const QuadtreeQueryCache<>& SimulationCore::ballQueryCache()const
+	{
+		return m_ballQueryCache;
+	}
+
+	inline void SimulationCore::resetBallQueryCacheCounters()
+	{
+		m_ballQueryCache.resetCounters();
+	}
+
+	inline bool SimulationCore::isRecordingBallQueries()const
+	{
+		return m_recordingBallQueries;
+	}
+
+	inline unsigned int SimulationCore::recordedBallQueriesCount()const
+	{
+		return static_cast<unsigned int>(m_recordedBallQueries.size());
+	}
+
+	inline const RecordedQuery* SimulationCore::recordedBallQueries()const
+	{
+		return m_recordedBallQueries.data();
+	}
+
+	inline const SubdivisionSettings& SimulationCore::bricksSubdivision(unsigned int layoutIndex)const
+	{
+		assert(layoutIndex < gk_bricksLayoutsCount);
+		return m_perLayoutBricksSubdivision[layoutIndex];
+	}
+
+	inline SimulationCore::ECollisionMode SimulationCore::collisionMode()const
+	{
+		return m_collisionMode;
+	}
+
+	inline void SimulationCore::setCollisionMode(ECollisionMode collisionMode)
+	{
+		m_collisionMode = collisionMode;
+		m_kineticBallMotion.contactValid = false;
+	}
+}
\ No newline at end of file
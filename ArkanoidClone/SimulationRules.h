@@ -0,0 +1,650 @@
+#pragma once
+#include "Engine.h"
+#include "MathCommon.h"
+#include "Dimensions.h"
+#include "AABB.h"
+#include "GameplayConstants.h"
+#include "LevelGenerator.h"
+#include "SimulationCore.h"
+#include <algorithm>
+#include <limits>
+#include <cassert>
+
+namespace ArkanoidGame
+{
+	/*
+	the rules of the game, shared by SimulationCore, WorldBatch and MultiBallSimulation so that they can't drift apart:
+	the same seed and per-step inputs give the same state in all of them.
+	the rules are templates over a GameState, an accessor to the fields of a single game wherever they are stored.
+	a rule calls only some of its members, so a GameState needs only the ones of the rules it is given to:
+
+	ball:	float& ballX(); float& ballY(); float& ballVelocityX(); float& ballVelocityY();
+	player:	float& playerX(); (the player never leaves the bottom of the arena)
+	bonus:	float& bonusX(); float& bonusY(); bool isBonusAlive()const; void setBonusAlive(bool alive);
+			unsigned int& bonusBricksHit(); unsigned int& nextBonusBricksHitCount(); std::minstd_rand& randomEngine();
+	bricks:	XMFLOAT2 brickPosition(unsigned int brickIndex)const; unsigned int& brickRemainingHits(unsigned int brickIndex);
+			//moves the brick out of the arena, out of the alive bricks and of the broadphase
+			void destroyBrick(unsigned int brickIndex);
+			//the lowest index of the alive bricks touching the ball, gk_bricksCount if none
+			unsigned int findTouchingBrick(const AABB& ballAABB);
+			//as SimulationCore::findEarliestBrickContact()
+			SimulationCore::SweptCollisionData findEarliestBrickContact(const XMFLOAT2& ballPosition, const XMFLOAT2& ballDisplacement,
+																		unsigned int& hitBrickIndex);
+	kinetic:	SimulationCore::KineticBallMotion& kineticBallMotion(); (restartLevel() clears its contactValid)
+	level:	void restartLevel();
+	*/
+	namespace SimulationRules
+	{
+		//COLLISION_DISCRETE, returns true if the level has been restarted
+		template<typename GameState>
+		bool stepDiscrete(GameState& state, float deltaTime, unsigned int inputFlags);
+
+		//COLLISION_SWEPT, returns true if the level has been restarted
+		template<typename GameState>
+		bool stepSwept(GameState& state, float deltaTime, unsigned int inputFlags);
+
+		//COLLISION_KINETIC, returns true if the level has been restarted
+		template<typename GameState>
+		bool stepKinetic(GameState& state, float deltaTime, unsigned int inputFlags);
+
+		//the player may be left out of the arena, until checkPlayerBounds()
+		void movePlayer(float& playerX, float deltaTime, unsigned int inputFlags);
+
+		template<typename GameState>
+		void moveBall(GameState& state, float deltaTime);
+
+		template<typename GameState>
+		void moveBonus(GameState& state, float deltaTime);
+
+		void checkPlayerBounds(float& playerX, float playerAABBMinX, float playerAABBMaxX);
+
+		//reflects the ball on the walls it has crossed and puts it back inside the arena
+		template<typename GameState>
+		void checkBallBounds(GameState& state, const XMFLOAT2& ballAABBMin, const XMFLOAT2& ballAABBMax, const XMFLOAT2& ballHalfExtents);
+
+		//reverseVelocityY is either 0 or 1. ballX and playerX are the positions where the ball touches the player
+		template<typename GameState>
+		void bounceBallOnPlayer(GameState& state, unsigned int reverseVelocityY, float ballX, float ballHalfWidth, float playerX);
+
+		//reflects the ball on the sides of the brick it has crossed and puts it out of the brick
+		template<typename GameState>
+		void bounceBallOnBrick(GameState& state, const SimulationCore::CollisionData& collisionData,
+							   const XMFLOAT2& brickAABBCenter, const XMFLOAT2& ballHalfExtents);
+
+		template<typename GameState>
+		void checkBricksCollision(GameState& state, const AABB& currBallAABB,
+								  const XMFLOAT2& lastBallAABBMin, const XMFLOAT2& lastBallAABBMax);
+
+		//COLLISION_SWEPT: moves the ball by deltaTime, resolving its contacts in time order
+		template<typename GameState>
+		void sweepBall(GameState& state, float deltaTime, const AABB& playerAABB);
+
+		//COLLISION_KINETIC: restarts the ball motion from its current position and searches its next contact
+		//with the walls and the bricks
+		template<typename GameState>
+		void updateKineticBallContact(GameState& state);
+
+		template<typename GameState>
+		void hitBrick(GameState& state, unsigned int brickIndex);
+
+		template<typename GameState>
+		void checkBonusCollision(GameState& state, const AABB& playerAABB);
+
+		template<typename GameState>
+		void handleSpawnBonus(GameState& state, const XMFLOAT2& spawnPosition);
+
+		//SimulationRules implementation
+
+		template<typename GameState>
+		inline bool stepDiscrete(GameState& state, float deltaTime, unsigned int inputFlags)
+		{
+			movePlayer(state.playerX(), deltaTime, inputFlags);
+			moveBonus(state, deltaTime);
+
+			const XMFLOAT2 lastBallPosition{ state.ballX(), state.ballY() };
+
+			moveBall(state, deltaTime);
+
+			const XMFLOAT2 ballPosition{ state.ballX(), state.ballY() };
+
+			if (ballPosition.y < gk_gameOverBallY)
+			{
+				state.restartLevel();
+				return true;
+			}
+
+			const XMFLOAT2 playerPosition{ state.playerX(), static_cast<float>(gk_arenaMinY) };
+
+			const AABB playerAABB = AABB::computeFromCenterAndHalfExtents(playerPosition, gk_playerHalfExtents);
+			const AABB currBallAABB = AABB::computeFromCenterAndHalfExtents(ballPosition, gk_ballHalfExtents);
+
+			const XMFLOAT2 currBallAABBMin = currBallAABB.min();
+			const XMFLOAT2 currBallAABBMax = currBallAABB.max();
+
+			checkPlayerBounds(state.playerX(), playerAABB.min().x, playerAABB.max().x);
+			checkBallBounds(state, currBallAABBMin, currBallAABBMax, gk_ballHalfExtents);
+			checkBonusCollision(state, playerAABB);
+
+			const AABB lastBallAABB = AABB::computeFromCenterAndHalfExtents(lastBallPosition, gk_ballHalfExtents);
+			const XMFLOAT2 lastBallAABBMin = lastBallAABB.min();
+			const XMFLOAT2 lastBallAABBMax = lastBallAABB.max();
+
+			//the ball touching the player doesn't touch the bricks in the same step
+			if (playerAABB.intersects(currBallAABB))
+			{
+				const SimulationCore::CollisionData collisionData =
+					SimulationCore::ballAABBCollisionData(playerAABB, currBallAABBMin, currBallAABBMax, lastBallAABBMin, lastBallAABBMax);
+
+				bounceBallOnPlayer(state, collisionData.fromTop | collisionData.fromBottom, ballPosition.x, gk_ballHalfExtents.x, playerPosition.x);
+			}
+			else
+			{
+				checkBricksCollision(state, currBallAABB, lastBallAABBMin, lastBallAABBMax);
+			}
+
+			return false;
+		}
+
+		template<typename GameState>
+		inline bool stepSwept(GameState& state, float deltaTime, unsigned int inputFlags)
+		{
+			movePlayer(state.playerX(), deltaTime, inputFlags);
+			moveBonus(state, deltaTime);
+
+			//the player is moved before the ball, which is swept against its final position
+			const AABB movedPlayerAABB = AABB::computeFromCenterAndHalfExtents(XMFLOAT2{ state.playerX(), static_cast<float>(gk_arenaMinY) }, gk_playerHalfExtents);
+
+			checkPlayerBounds(state.playerX(), movedPlayerAABB.min().x, movedPlayerAABB.max().x);
+
+			const AABB playerAABB = AABB::computeFromCenterAndHalfExtents(XMFLOAT2{ state.playerX(), static_cast<float>(gk_arenaMinY) }, gk_playerHalfExtents);
+
+			sweepBall(state, deltaTime, playerAABB);
+
+			if (state.ballY() < gk_gameOverBallY)
+			{
+				state.restartLevel();
+				return true;
+			}
+
+			checkBonusCollision(state, playerAABB);
+
+			return false;
+		}
+
+		template<typename GameState>
+		inline bool stepKinetic(GameState& state, float deltaTime, unsigned int inputFlags)
+		{
+			const float infinity = std::numeric_limits<float>::infinity();
+
+			const float leftKeyVelocities[2] = { 0.0f, -gk_playerSpeed };
+			const float rightKeyVelocities[2] = { 0.0f, gk_playerSpeed };
+
+			const unsigned int leftKeyPressed = static_cast<unsigned int>((inputFlags & SimulationCore::INPUT_LEFT) != 0);
+			const unsigned int rightKeyPressed = static_cast<unsigned int>((inputFlags & SimulationCore::INPUT_RIGHT) != 0);
+
+			const float inputPlayerVelocityX = leftKeyVelocities[leftKeyPressed] + rightKeyVelocities[rightKeyPressed];
+
+			const float playerPositionsXBounds[2] = { gk_arenaMinX + gk_playerHalfExtents.x, gk_arenaMaxX - gk_playerHalfExtents.x };
+
+			SimulationCore::KineticBallMotion& ballMotion = state.kineticBallMotion();
+
+			if (!ballMotion.contactValid)
+			{
+				updateKineticBallContact(state);
+			}
+
+			float& ballPosX = state.ballX();
+			float& ballPosY = state.ballY();
+			float& ballVelocityX = state.ballVelocityX();
+			float& ballVelocityY = state.ballVelocityY();
+			float& playerPosX = state.playerX();
+
+			float remainingTime = deltaTime;
+
+			for (unsigned int eventIndex = 0; eventIndex < SimulationCore::sk_maxKineticEventsPerStep; ++eventIndex)
+			{
+				//the time to each event, from now. all the motions are linear until the first one
+
+				//the player stops at the walls
+				const unsigned int towardsRightWall = static_cast<unsigned int>(inputPlayerVelocityX > 0.0f);
+				const float playerWallX = playerPositionsXBounds[towardsRightWall];
+				const bool playerStopped = inputPlayerVelocityX == 0.0f || (playerPosX - playerWallX) * inputPlayerVelocityX >= 0.0f;
+				const float playerVelocityX = playerStopped ? 0.0f : inputPlayerVelocityX;
+				const float playerStopTime = playerStopped ? infinity : (playerWallX - playerPosX) / playerVelocityX;
+
+				const float ballContactTime = ballMotion.contactTime - ballMotion.elapsedTime;
+
+				//the ball and the bonus are swept against the player moving with them
+				const XMFLOAT2 playerPosition{ playerPosX, static_cast<float>(gk_arenaMinY) };
+				const AABB playerAABB = AABB::computeFromCenterAndHalfExtents(playerPosition, gk_playerHalfExtents);
+
+				const XMFLOAT2 ballPosition{ ballPosX, ballPosY };
+				const XMFLOAT2 ballRelativeDisplacement{ (ballVelocityX - playerVelocityX) * remainingTime, ballVelocityY * remainingTime };
+				const SimulationCore::SweptCollisionData playerContact =
+					SimulationCore::ballAABBSweptCollisionData(playerAABB, ballPosition, gk_ballHalfExtents, ballRelativeDisplacement);
+				const float playerContactTime = playerContact.time <= 1.0f ? playerContact.time * remainingTime : infinity;
+
+				const float gameOverTime = ballVelocityY < 0.0f ? std::max((gk_gameOverBallY - ballPosition.y) / ballVelocityY, 0.0f) : infinity;
+
+				float bonusDestroyTime = infinity;
+				if (state.isBonusAlive())
+				{
+					const XMFLOAT2 bonusPosition{ state.bonusX(), state.bonusY() };
+					const XMFLOAT2 bonusRelativeDisplacement{ -playerVelocityX * remainingTime, -gk_bonusSpeedY * remainingTime };
+					const SimulationCore::SweptCollisionData bonusContact =
+						SimulationCore::ballAABBSweptCollisionData(playerAABB, bonusPosition, gk_bonusHalfExtents, bonusRelativeDisplacement);
+
+					const float bonusMissedTime = std::max((bonusPosition.y - gk_destroyBonusY) / gk_bonusSpeedY, 0.0f);
+					const float bonusContactTime = bonusContact.time <= 1.0f ? bonusContact.time * remainingTime : infinity;
+					bonusDestroyTime = std::min(bonusContactTime, bonusMissedTime);
+				}
+
+				const float eventTime = std::min(std::min(std::min(playerStopTime, ballContactTime), std::min(playerContactTime, bonusDestroyTime)), gameOverTime);
+
+				//move everything to the event, or to the end of the step
+				const float elapsedTime = std::min(eventTime, remainingTime);
+
+				playerPosX += playerVelocityX * elapsedTime;
+
+				ballMotion.elapsedTime += elapsedTime;
+				ballPosX = ballMotion.origin.x + ballVelocityX * ballMotion.elapsedTime;
+				ballPosY = ballMotion.origin.y + ballVelocityY * ballMotion.elapsedTime;
+
+				state.bonusY() -= static_cast<unsigned int>(state.isBonusAlive()) * gk_bonusSpeedY * elapsedTime;
+
+				if (eventTime > remainingTime)
+				{
+					return false;
+				}
+
+				remainingTime -= elapsedTime;
+
+				//on the same time the player stops first, then the ball hits the walls or the bricks, then the player
+				if (eventTime == playerStopTime)
+				{
+					playerPosX = playerWallX;
+				}
+				else if (eventTime == ballContactTime)
+				{
+					if (ballMotion.contact.time <= 1.0f)
+					{
+						ballPosX = ballMotion.contact.contactPosition.x;
+						ballPosY = ballMotion.contact.contactPosition.y;
+
+						const float velocitiesX[2] = { ballVelocityX, -ballVelocityX };
+						const float velocitiesY[2] = { ballVelocityY, -ballVelocityY };
+
+						ballVelocityX = velocitiesX[ballMotion.contact.alongX];
+						ballVelocityY = velocitiesY[ballMotion.contact.alongY];
+
+						if (ballMotion.contactBrickIndex != gk_bricksCount)
+						{
+							hitBrick(state, ballMotion.contactBrickIndex);
+						}
+					}
+
+					//nothing has been touched within sk_kineticSweepTime otherwise, the search goes on from here
+					updateKineticBallContact(state);
+				}
+				else if (eventTime == playerContactTime)
+				{
+					//the contact has been found in the frame of the player, which has moved since. a contact on a side is put
+					//exactly on the side of the moved player: with the rounding errors of the motion the ball may end inside it,
+					//and the next sweep would push it out from the top
+					const AABB movedPlayerAABB = AABB::computeFromCenterAndHalfExtents(XMFLOAT2{ playerPosX, playerPosition.y }, gk_playerHalfExtents);
+					const unsigned int ballRightSide = static_cast<unsigned int>(playerContact.contactPosition.x > playerPosition.x);
+					const float playerSidesX[2] = { movedPlayerAABB.min().x - gk_ballHalfExtents.x, movedPlayerAABB.max().x + gk_ballHalfExtents.x };
+
+					//a ball pinched between the player and a wall has no room on the side: it would bounce between them without
+					//time passing. it is pushed out from the top instead
+					const float sidesSigns[2] = { -1.0f, 1.0f };
+					const float ballWallsX[2] = { gk_arenaMinX + gk_ballHalfExtents.x, gk_arenaMaxX - gk_ballHalfExtents.x };
+					const float sideSign = sidesSigns[ballRightSide];
+					const unsigned int pinched = playerContact.alongX & static_cast<unsigned int>(playerVelocityX * sideSign > 0.0f &&
+																								 (playerSidesX[ballRightSide] - ballWallsX[ballRightSide]) * sideSign >= 0.0f);
+
+					const float sideBallPositionsX[2] = { playerSidesX[ballRightSide], ballWallsX[ballRightSide] };
+					const float ballPositionsX[2] = { playerContact.contactPosition.x + playerVelocityX * elapsedTime, sideBallPositionsX[pinched] };
+					const float ballPositionsY[2] = { playerContact.contactPosition.y, movedPlayerAABB.max().y + gk_ballHalfExtents.y };
+
+					ballPosX = ballPositionsX[playerContact.alongX];
+					ballPosY = ballPositionsY[pinched];
+
+					const unsigned int reverseVelocityY = playerContact.alongY | (pinched & static_cast<unsigned int>(ballVelocityY < 0.0f));
+					bounceBallOnPlayer(state, reverseVelocityY, ballPosX, gk_ballHalfExtents.x, playerPosX);
+
+					updateKineticBallContact(state);
+				}
+				else if (eventTime == bonusDestroyTime)
+				{
+					state.setBonusAlive(false);
+					state.bonusX() = gk_outOfArenaX;
+				}
+				else
+				{
+					state.restartLevel();
+					return true;
+				}
+			}
+
+			//too many events in a single step: the rest of the step is dropped
+			return false;
+		}
+
+		inline void movePlayer(float& playerX, float deltaTime, unsigned int inputFlags)
+		{
+			const float displacementValue = gk_playerSpeed*deltaTime;
+
+			const float leftKeyDisplacements[2] = { 0.0f, -displacementValue };
+			const float rightKeyDisplacements[2] = { 0.0f, displacementValue };
+
+			const unsigned int leftKeyPressed = static_cast<unsigned int>((inputFlags & SimulationCore::INPUT_LEFT) != 0);
+			const unsigned int rightKeyPressed = static_cast<unsigned int>((inputFlags & SimulationCore::INPUT_RIGHT) != 0);
+
+			playerX += leftKeyDisplacements[leftKeyPressed];
+			playerX += rightKeyDisplacements[rightKeyPressed];
+		}
+
+		template<typename GameState>
+		inline void moveBall(GameState& state, float deltaTime)
+		{
+			state.ballX() += state.ballVelocityX() * deltaTime;
+			state.ballY() += state.ballVelocityY() * deltaTime;
+		}
+
+		template<typename GameState>
+		inline void moveBonus(GameState& state, float deltaTime)
+		{
+			state.bonusY() -= static_cast<unsigned int>(state.isBonusAlive()) * gk_bonusSpeedY * deltaTime;
+		}
+
+		inline void checkPlayerBounds(float& playerX, float playerAABBMinX, float playerAABBMaxX)
+		{
+			//adjust player position inside the arena
+
+			const float playerPosXLeftBounds[2] = { playerX, gk_arenaMinX + gk_playerHalfExtents.x };
+
+			playerX = playerPosXLeftBounds[static_cast<unsigned int>(playerAABBMinX < gk_arenaMinX)];
+
+			const float playerPosXRightBounds[2] = { playerX, gk_arenaMaxX - gk_playerHalfExtents.x };
+
+			playerX = playerPosXRightBounds[static_cast<unsigned int>(playerAABBMaxX > gk_arenaMaxX)];
+		}
+
+		template<typename GameState>
+		inline void checkBallBounds(GameState& state, const XMFLOAT2& ballAABBMin, const XMFLOAT2& ballAABBMax, const XMFLOAT2& ballHalfExtents)
+		{
+			const bool outOfArenaXright = ballAABBMax.x > gk_arenaMaxX;
+			const bool outOfArenaXleft = ballAABBMin.x < gk_arenaMinX;
+			const bool outOfArenaYtop = ballAABBMax.y > gk_arenaMaxY;
+
+			const bool outOfArenaX = outOfArenaXright | outOfArenaXleft;
+
+			float& ballVelocityX = state.ballVelocityX();
+			float& ballVelocityY = state.ballVelocityY();
+
+			ballVelocityX = outOfArenaX ? -ballVelocityX : ballVelocityX;
+			ballVelocityY = outOfArenaYtop ? -ballVelocityY : ballVelocityY;
+
+			//adjust ball position inside the arena
+
+			float& ballPosX = state.ballX();
+			float& ballPosY = state.ballY();
+
+			ballPosX = outOfArenaXleft ? gk_arenaMinX + ballHalfExtents.x : ballPosX;
+			ballPosX = outOfArenaXright ? gk_arenaMaxX - ballHalfExtents.x : ballPosX;
+			ballPosY = outOfArenaYtop ? gk_arenaMaxY - ballHalfExtents.y : ballPosY;
+		}
+
+		template<typename GameState>
+		inline void bounceBallOnPlayer(GameState& state, unsigned int reverseVelocityY, float ballX, float ballHalfWidth, float playerX)
+		{
+			float& ballVelocityY = state.ballVelocityY();
+
+			const float ballVelocitiesY[2] = { ballVelocityY, -ballVelocityY };
+
+			ballVelocityY = ballVelocitiesY[reverseVelocityY];
+
+			//find ball AABB's x position nearest to the player
+			const unsigned int isBallLeftSide = static_cast<unsigned int>(ballX < playerX);
+			const float ballXPos[2] = { ballX - ballHalfWidth, ballX + ballHalfWidth };
+
+			//make the new velocity angle (wrt the player normal) proportional to the hit distance
+			const float ballXPosLocal = ballXPos[isBallLeftSide] - playerX;
+			const float velocityXDir = (ballXPosLocal / gk_playerHalfExtents.x); //normalize
+
+			state.ballVelocityX() = gk_startBallSpeed * velocityXDir;
+		}
+
+		template<typename GameState>
+		inline void bounceBallOnBrick(GameState& state, const SimulationCore::CollisionData& collisionData,
+									  const XMFLOAT2& brickAABBCenter, const XMFLOAT2& ballHalfExtents)
+		{
+			//change ball velocity (simple reflection)
+
+			const unsigned int reverseXVelocity = collisionData.fromRight | collisionData.fromLeft;
+			const unsigned int reverseYVelocity = collisionData.fromTop | collisionData.fromBottom;
+
+			float& ballVelocityX = state.ballVelocityX();
+			float& ballVelocityY = state.ballVelocityY();
+
+			const float velocitiesX[2] = { ballVelocityX, -ballVelocityX };
+			const float velocitiesY[2] = { ballVelocityY, -ballVelocityY };
+
+			ballVelocityX = velocitiesX[reverseXVelocity];
+			ballVelocityY = velocitiesY[reverseYVelocity];
+
+			//adjust ball position making it outside the brick
+
+			float& ballPosX = state.ballX();
+			float& ballPosY = state.ballY();
+
+			const float ballPosXRight[2] = { ballPosX, brickAABBCenter.x + gk_bricksHalfExtents.x + ballHalfExtents.x };
+
+			ballPosX = ballPosXRight[collisionData.fromRight];
+
+			const float ballPosXLeft[2] = { ballPosX, brickAABBCenter.x - gk_bricksHalfExtents.x - ballHalfExtents.x };
+
+			ballPosX = ballPosXLeft[collisionData.fromLeft];
+
+			const float ballPosYTop[2] = { ballPosY, brickAABBCenter.y + gk_bricksHalfExtents.y + ballHalfExtents.y };
+
+			ballPosY = ballPosYTop[collisionData.fromTop];
+
+			const float ballPosYBottom[2] = { ballPosY, brickAABBCenter.y - gk_bricksHalfExtents.y - ballHalfExtents.y };
+
+			ballPosY = ballPosYBottom[collisionData.fromBottom];
+		}
+
+		template<typename GameState>
+		inline void checkBricksCollision(GameState& state, const AABB& currBallAABB,
+										 const XMFLOAT2& lastBallAABBMin, const XMFLOAT2& lastBallAABBMax)
+		{
+			//when the ball touches more bricks, the one with the lowest index is hit:
+			//the result doesn't depend on how the simulation finds the bricks
+			const unsigned int hitBrickIndex = state.findTouchingBrick(currBallAABB);
+
+			if (hitBrickIndex == gk_bricksCount)
+			{
+				return;
+			}
+
+			const XMFLOAT2 brickAABBCenter = state.brickPosition(hitBrickIndex);
+			const AABB aabb = AABB::computeFromCenterAndHalfExtents(brickAABBCenter, gk_bricksHalfExtents);
+
+			const SimulationCore::CollisionData collisionData =
+				SimulationCore::ballAABBCollisionData(aabb, currBallAABB.min(), currBallAABB.max(), lastBallAABBMin, lastBallAABBMax);
+
+			bounceBallOnBrick(state, collisionData, brickAABBCenter, currBallAABB.halfExtents());
+
+			hitBrick(state, hitBrickIndex);
+		}
+
+		template<typename GameState>
+		inline void sweepBall(GameState& state, float deltaTime, const AABB& playerAABB)
+		{
+			float& ballPosX = state.ballX();
+			float& ballPosY = state.ballY();
+			float& ballVelocityX = state.ballVelocityX();
+			float& ballVelocityY = state.ballVelocityY();
+
+			const XMFLOAT2 playerPosition = playerAABB.center();
+
+			float remainingTime = deltaTime;
+
+			for (unsigned int contactIndex = 0; contactIndex < SimulationCore::sk_maxBallContactsPerStep; ++contactIndex)
+			{
+				const XMFLOAT2 ballPosition{ ballPosX, ballPosY };
+				const XMFLOAT2 ballDisplacement = XMFLOAT2{ ballVelocityX, ballVelocityY } * remainingTime;
+
+				const SimulationCore::SweptCollisionData wallsContact =
+					SimulationCore::ballArenaSweptCollisionData(ballPosition, gk_ballHalfExtents, ballDisplacement);
+				const SimulationCore::SweptCollisionData playerContact =
+					SimulationCore::ballAABBSweptCollisionData(playerAABB, ballPosition, gk_ballHalfExtents, ballDisplacement);
+
+				unsigned int hitBrickIndex;
+				const SimulationCore::SweptCollisionData brickContact = state.findEarliestBrickContact(ballPosition, ballDisplacement, hitBrickIndex);
+
+				const float contactTime = std::min(std::min(wallsContact.time, playerContact.time), brickContact.time);
+
+				if (contactTime > 1.0f)
+				{
+					ballPosX += ballDisplacement.x;
+					ballPosY += ballDisplacement.y;
+					return;
+				}
+
+				//on the same time the walls are resolved first, then the player, then the bricks
+				const float velocitiesX[2] = { ballVelocityX, -ballVelocityX };
+				const float velocitiesY[2] = { ballVelocityY, -ballVelocityY };
+
+				if (wallsContact.time == contactTime)
+				{
+					ballPosX = wallsContact.contactPosition.x;
+					ballPosY = wallsContact.contactPosition.y;
+
+					ballVelocityX = velocitiesX[wallsContact.alongX];
+					ballVelocityY = velocitiesY[wallsContact.alongY];
+				}
+				else if (playerContact.time == contactTime)
+				{
+					ballPosX = playerContact.contactPosition.x;
+					ballPosY = playerContact.contactPosition.y;
+
+					bounceBallOnPlayer(state, playerContact.alongY, ballPosX, gk_ballHalfExtents.x, playerPosition.x);
+				}
+				else
+				{
+					ballPosX = brickContact.contactPosition.x;
+					ballPosY = brickContact.contactPosition.y;
+
+					ballVelocityX = velocitiesX[brickContact.alongX];
+					ballVelocityY = velocitiesY[brickContact.alongY];
+
+					hitBrick(state, hitBrickIndex);
+				}
+
+				remainingTime -= remainingTime * contactTime;
+			}
+
+			//too many contacts in a single step: the rest of the step is dropped rather than moving the ball through a collider
+		}
+
+		template<typename GameState>
+		inline void updateKineticBallContact(GameState& state)
+		{
+			SimulationCore::KineticBallMotion& ballMotion = state.kineticBallMotion();
+
+			ballMotion.origin = XMFLOAT2{ state.ballX(), state.ballY() };
+			ballMotion.elapsedTime = 0.0f;
+
+			const XMFLOAT2 ballVelocity{ state.ballVelocityX(), state.ballVelocityY() };
+
+			//the walls and the bricks don't move: the contact holds until the ball changes direction or the level is restarted
+			const SimulationCore::SweptCollisionData wallsContact =
+				SimulationCore::ballArenaSweptCollisionData(ballMotion.origin, gk_ballHalfExtents, ballVelocity * SimulationCore::sk_kineticSweepTime);
+
+			//without contacts the ball reaches the end of the sweep, where the search is repeated
+			const float wallsContactTimes[2] = { SimulationCore::sk_kineticSweepTime, wallsContact.time * SimulationCore::sk_kineticSweepTime };
+			const float wallsContactTime = wallsContactTimes[static_cast<unsigned int>(wallsContact.time <= 1.0f)];
+
+			//the bricks beyond the walls can't be reached, so the bricks are searched only up to them
+			unsigned int hitBrickIndex;
+			const SimulationCore::SweptCollisionData brickContact = state.findEarliestBrickContact(ballMotion.origin, ballVelocity * wallsContactTime, hitBrickIndex);
+			const float brickContactTime = brickContact.time * wallsContactTime;
+
+			//on the same time the walls are resolved first, as in COLLISION_SWEPT
+			const unsigned int brickFirst = static_cast<unsigned int>(brickContact.time <= 1.0f && brickContactTime < wallsContactTime);
+			const SimulationCore::SweptCollisionData contacts[2] = { wallsContact, brickContact };
+			const unsigned int bricksIndices[2] = { gk_bricksCount, hitBrickIndex };
+			const float contactTimes[2] = { wallsContactTime, brickContactTime };
+
+			ballMotion.contact = contacts[brickFirst];
+			ballMotion.contactBrickIndex = bricksIndices[brickFirst];
+			ballMotion.contactTime = contactTimes[brickFirst];
+
+			ballMotion.contactValid = true;
+		}
+
+		template<typename GameState>
+		inline void hitBrick(GameState& state, unsigned int brickIndex)
+		{
+			unsigned int& brickRemainingHits = state.brickRemainingHits(brickIndex);
+			assert(brickRemainingHits != 0);
+
+			if (--brickRemainingHits == 0)
+			{
+				const XMFLOAT2 brickAABBCenter = state.brickPosition(brickIndex);
+
+				state.destroyBrick(brickIndex);
+				handleSpawnBonus(state, brickAABBCenter);
+			}
+		}
+
+		template<typename GameState>
+		inline void checkBonusCollision(GameState& state, const AABB& playerAABB)
+		{
+			float& bonusPosX = state.bonusX();
+			const float bonusPosY = state.bonusY();
+
+			const unsigned int bonusMissed = static_cast<unsigned int>(bonusPosY < gk_destroyBonusY);
+
+			const AABB bonusAABB = AABB::computeFromCenterAndHalfExtents(XMFLOAT2{ bonusPosX, bonusPosY }, gk_bonusHalfExtents);
+			const unsigned int bonusTaken = static_cast<unsigned int>(bonusAABB.intersects(playerAABB));
+
+			const unsigned int destroyBonus = bonusMissed | bonusTaken;
+
+			//destroyBonus needs to be checked only if the bonus is alive
+			state.setBonusAlive((static_cast<unsigned int>(state.isBonusAlive()) & (1 - destroyBonus)) == 1);
+
+			const unsigned int bonusDead = static_cast<unsigned int>(!state.isBonusAlive());
+
+			//if the bonus is dead, translate it out of the arena, otherwise keep it in the current position
+			bonusPosX = static_cast<float>(bonusDead) * gk_outOfArenaX + static_cast<float>(1 - bonusDead)*bonusPosX;
+		}
+
+		template<typename GameState>
+		inline void handleSpawnBonus(GameState& state, const XMFLOAT2& spawnPosition)
+		{
+			unsigned int& bonusBricksHit = state.bonusBricksHit();
+
+			++bonusBricksHit;
+
+			if (bonusBricksHit == state.nextBonusBricksHitCount())
+			{
+				bonusBricksHit = 0;
+				state.nextBonusBricksHitCount() = generateNextBonusBricksHitCount(state.randomEngine());
+
+				const unsigned int wasBonusAlive = static_cast<unsigned int>(state.isBonusAlive());
+
+				state.setBonusAlive(true);
+
+				//if wasBonusAlive the bonus position needs not to be changed to spawnPosition
+				float& bonusPosX = state.bonusX();
+				float& bonusPosY = state.bonusY();
+				bonusPosX = static_cast<float>(1 - wasBonusAlive)*spawnPosition.x + static_cast<float>(wasBonusAlive)*bonusPosX;
+				bonusPosY = static_cast<float>(1 - wasBonusAlive)*spawnPosition.y + static_cast<float>(wasBonusAlive)*bonusPosY;
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include "SweepAndPruneBroadphase.h"
+#include "MathHelper.h"
+#include <algorithm>
+
+using namespace ArkanoidGame;
+
+constexpr float SweepAndPruneBroadphase::sk_sweepMargin;
+
+SweepAndPruneBroadphase::SweepAndPruneBroadphase(const AABB&, const XMFLOAT2& objectsHalfExtents,
+												 unsigned int objectsCapacity) : m_objectsHalfExtents{ objectsHalfExtents }
+{
+	m_objects.reserve(objectsCapacity);
+}
+
+void SweepAndPruneBroadphase::insert(const XMFLOAT2& objectCenter, unsigned int objectData)
+{
+	const SortedObject object{ objectCenter.x, objectCenter.y, objectData };
+	m_objects.insert(std::upper_bound(m_objects.begin(), m_objects.end(), object, &precedes), object);
+}
+
+void SweepAndPruneBroadphase::build(const AABB&, const XMFLOAT2* objectsCenters, const unsigned int* objectsDatas, unsigned int objectsCount)
+{
+	assert(objectsCount == 0 || (objectsCenters != nullptr && objectsDatas != nullptr));
+
+	m_objects.clear();
+
+	for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+	{
+		m_objects.push_back(SortedObject{ objectsCenters[objectIndex].x, objectsCenters[objectIndex].y, objectsDatas[objectIndex] });
+	}
+
+	//the bricks are placed row by row, so they are far from sorted along x: sorting once is cheaper than inserting each
+	std::sort(m_objects.begin(), m_objects.end(), &precedes);
+}
+
+unsigned int SweepAndPruneBroadphase::findPotentialColliders(const AABB& objectAABB, unsigned int* foundObjects)const
+{
+	assert(foundObjects != nullptr);
+
+	const XMFLOAT2& center = objectAABB.center();
+	const XMFLOAT2& halfExtents = objectAABB.halfExtents();
+
+	//the same sums of AABB::intersects(), where objectAABB is the left operand
+	const float maxDistanceX = halfExtents.x + m_objectsHalfExtents.x;
+	const float maxDistanceY = halfExtents.y + m_objectsHalfExtents.y;
+
+	const float sweepMinX = center.x - maxDistanceX - sk_sweepMargin;
+	const float sweepMaxX = center.x + maxDistanceX + sk_sweepMargin;
+
+	auto objectBefore = [](const SortedObject& object, float x)
+	{
+		return object.centerX < x;
+	};
+
+	unsigned int foundObjectsCount = 0;
+
+	for (auto objectIt = std::lower_bound(m_objects.begin(), m_objects.end(), sweepMinX, objectBefore);
+		 objectIt != m_objects.end() && objectIt->centerX <= sweepMaxX; ++objectIt)
+	{
+		const bool xIntersects = lessEqualf(std::abs(center.x - objectIt->centerX), maxDistanceX);
+		const bool yIntersects = lessEqualf(std::abs(center.y - objectIt->centerY), maxDistanceY);
+
+		foundObjects[foundObjectsCount] = objectIt->data;
+		foundObjectsCount += static_cast<unsigned int>(xIntersects & yIntersects);
+	}
+
+	return foundObjectsCount;
+}
+
+bool SweepAndPruneBroadphase::remove(const XMFLOAT2& objectCenter, unsigned int objectData)
+{
+	const SortedObject object{ objectCenter.x, objectCenter.y, objectData };
+
+	const auto objectIt = std::lower_bound(m_objects.begin(), m_objects.end(), object, &precedes);
+	if (objectIt == m_objects.end() || objectIt->centerX != objectCenter.x || objectIt->data != objectData)
+	{
+		return false;
+	}
+
+	assert(objectIt->centerY == objectCenter.y);
+
+	m_objects.erase(objectIt);
+
+	return true;
+}
\ No newline at end of file
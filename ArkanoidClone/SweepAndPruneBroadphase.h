@@ -0,0 +1,103 @@
+#pragma once
+#include "Engine.h"
+#include "MathCommon.h"
+#include "AABB.h"
+#include <vector>
+#include <cassert>
+
+namespace ArkanoidGame
+{
+	/*
+	a broadphase for objects of the same size, kept sorted along x: a query finds with two binary searches the objects
+	whose x range can overlap it and tests only those, with the same test of AABB::intersects().
+	the bricks rows are wide and short, so a ball sweeps the few bricks of a narrow slab of columns.
+	it exposes the construction, insertion and query interface of Quadtree, so the two can be swapped.
+	*/
+	class SweepAndPruneBroadphase
+	{
+	public:
+		//ctors
+		//the area is not needed, it is accepted to be constructed like a Quadtree.
+		//the objects are reserved for objectsCapacity objects, so insert() and build() don't allocate up to it
+		explicit SweepAndPruneBroadphase(const AABB& area, const XMFLOAT2& objectsHalfExtents, unsigned int objectsCapacity);
+
+		//dtor
+		~SweepAndPruneBroadphase() = default;
+
+		//copy
+		SweepAndPruneBroadphase(const SweepAndPruneBroadphase&) = default;
+		SweepAndPruneBroadphase& operator=(const SweepAndPruneBroadphase&) = default;
+
+		//move
+		SweepAndPruneBroadphase(SweepAndPruneBroadphase&&) = default;
+		SweepAndPruneBroadphase& operator=(SweepAndPruneBroadphase&&) = default;
+
+		//the objects after the new one along x are shifted by one place
+		void insert(const XMFLOAT2& objectCenter, unsigned int objectData);
+
+		//replaces all the objects with the given ones, sorting them once
+		void build(const AABB& area, const XMFLOAT2* objectsCenters, const unsigned int* objectsDatas, unsigned int objectsCount);
+
+		//the same as build()
+		void buildBulk(const AABB& area, const XMFLOAT2* objectsCenters, const unsigned int* objectsDatas, unsigned int objectsCount);
+
+		//foundObjects must point to an array of objectsCount() elements at least
+		//the number of objects actually found is returned, in increasing x order
+		unsigned int findPotentialColliders(const AABB& objectAABB, unsigned int* foundObjects)const;
+
+		//objectCenter must be the one given to insert(). returns false if the object is not in the broadphase
+		bool remove(const XMFLOAT2& objectCenter, unsigned int objectData);
+
+		//returns false if the object is not in the broadphase
+		bool update(const XMFLOAT2& oldObjectCenter, const XMFLOAT2& newObjectCenter, unsigned int objectData);
+
+		unsigned int objectsCount()const;
+
+	private:
+		//the x range searched by a query is grown by it, then the objects found are tested exactly:
+		//the rounding errors of the range never drop the objects just touched
+		static constexpr float sk_sweepMargin = 0.001f;
+
+		struct SortedObject
+		{
+			float centerX;
+			float centerY;
+			unsigned int data;
+		};
+
+		//along x, the objects on the same x are sorted by data, so the order never depends on the insertion one
+		static bool precedes(const SortedObject& object1, const SortedObject& object2);
+
+		//the objects, sorted by precedes()
+		std::vector<SortedObject> m_objects;
+
+		XMFLOAT2 m_objectsHalfExtents;
+	};
+
+	inline void SweepAndPruneBroadphase::buildBulk(const AABB& area, const XMFLOAT2* objectsCenters, const unsigned int* objectsDatas, unsigned int objectsCount)
+	{
+		build(area, objectsCenters, objectsDatas, objectsCount);
+	}
+
+	inline bool SweepAndPruneBroadphase::update(const XMFLOAT2& oldObjectCenter, const XMFLOAT2& newObjectCenter, unsigned int objectData)
+	{
+		if (!remove(oldObjectCenter, objectData))
+		{
+			return false;
+		}
+
+		insert(newObjectCenter, objectData);
+
+		return true;
+	}
+
+	inline unsigned int SweepAndPruneBroadphase::objectsCount()const
+	{
+		return static_cast<unsigned int>(m_objects.size());
+	}
+
+	inline bool SweepAndPruneBroadphase::precedes(const SortedObject& object1, const SortedObject& object2)
+	{
+		return object1.centerX < object2.centerX || (object1.centerX == object2.centerX && object1.data < object2.data);
+	}
+}
\ No newline at end of file
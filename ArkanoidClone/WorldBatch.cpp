@@ -0,0 +1,376 @@
+#include "WorldBatch.h"
+#include "AABB.h"
+#include "GameplayConstants.h"
+#include "LevelGenerator.h"
+#include "SimulationCore.h"
+#include "SimulationRules.h"
+#include "SimdBroadphase.h"
+#include <chrono>
+#include <algorithm>
+
+using namespace ArkanoidGame;
+
+constexpr unsigned int WorldBatch::sk_worldsPerTask;
+
+class WorldBatch::GameState
+{
+public:
+	//ctors
+	explicit GameState(WorldBatch& batch, unsigned int worldIndex);
+
+	float& ballX();
+	float& ballY();
+	float& ballVelocityX();
+	float& ballVelocityY();
+
+	float& playerX();
+
+	float& bonusX();
+	float& bonusY();
+	bool isBonusAlive()const;
+	void setBonusAlive(bool alive);
+	unsigned int& bonusBricksHit();
+	unsigned int& nextBonusBricksHitCount();
+	std::minstd_rand& randomEngine();
+
+	XMFLOAT2 brickPosition(unsigned int brickIndex)const;
+	unsigned int& brickRemainingHits(unsigned int brickIndex);
+	void destroyBrick(unsigned int brickIndex);
+	unsigned int findTouchingBrick(const AABB& ballAABB)const;
+	SimulationCore::SweptCollisionData findEarliestBrickContact(const XMFLOAT2& ballPosition, const XMFLOAT2& ballDisplacement,
+																unsigned int& hitBrickIndex)const;
+
+	SimulationCore::KineticBallMotion& kineticBallMotion();
+
+	void restartLevel();
+
+private:
+	WorldBatch& m_batch;
+	unsigned int m_worldIndex;
+};
+
+inline WorldBatch::GameState::GameState(WorldBatch& batch, unsigned int worldIndex) : m_batch(batch),
+																					  m_worldIndex{ worldIndex }
+{
+	assert(worldIndex < batch.m_worldsCount);
+}
+
+inline float& WorldBatch::GameState::ballX()
+{
+	return m_batch.m_ballsX[m_worldIndex];
+}
+
+inline float& WorldBatch::GameState::ballY()
+{
+	return m_batch.m_ballsY[m_worldIndex];
+}
+
+inline float& WorldBatch::GameState::ballVelocityX()
+{
+	return m_batch.m_ballsVelocityX[m_worldIndex];
+}
+
+inline float& WorldBatch::GameState::ballVelocityY()
+{
+	return m_batch.m_ballsVelocityY[m_worldIndex];
+}
+
+inline float& WorldBatch::GameState::playerX()
+{
+	return m_batch.m_playersX[m_worldIndex];
+}
+
+inline float& WorldBatch::GameState::bonusX()
+{
+	return m_batch.m_bonusesX[m_worldIndex];
+}
+
+inline float& WorldBatch::GameState::bonusY()
+{
+	return m_batch.m_bonusesY[m_worldIndex];
+}
+
+inline bool WorldBatch::GameState::isBonusAlive()const
+{
+	return m_batch.m_bonusesAlive[m_worldIndex] != 0;
+}
+
+inline void WorldBatch::GameState::setBonusAlive(bool alive)
+{
+	m_batch.m_bonusesAlive[m_worldIndex] = static_cast<unsigned char>(alive);
+}
+
+inline unsigned int& WorldBatch::GameState::bonusBricksHit()
+{
+	return m_batch.m_bonusesBricksHit[m_worldIndex];
+}
+
+inline unsigned int& WorldBatch::GameState::nextBonusBricksHitCount()
+{
+	return m_batch.m_nextBonusesBricksHitCounts[m_worldIndex];
+}
+
+inline std::minstd_rand& WorldBatch::GameState::randomEngine()
+{
+	return m_batch.m_randomEngines[m_worldIndex];
+}
+
+inline XMFLOAT2 WorldBatch::GameState::brickPosition(unsigned int brickIndex)const
+{
+	return m_batch.brickPosition(m_worldIndex, brickIndex);
+}
+
+inline unsigned int& WorldBatch::GameState::brickRemainingHits(unsigned int brickIndex)
+{
+	return m_batch.m_bricksRemainingHits[m_batch.brickSlot(m_worldIndex, brickIndex)];
+}
+
+inline void WorldBatch::GameState::destroyBrick(unsigned int brickIndex)
+{
+	assert(m_batch.m_aliveBricks[m_worldIndex].test(brickIndex));
+
+	//there is no broadphase to keep in sync, the bit of the brick masks it out of the next queries
+	m_batch.m_aliveBricks[m_worldIndex].reset(brickIndex);
+	m_batch.m_bricksX[m_batch.brickSlot(m_worldIndex, brickIndex)] = gk_outOfArenaX;
+}
+
+inline unsigned int WorldBatch::GameState::findTouchingBrick(const AABB& ballAABB)const
+{
+	return m_batch.findTouchingBrick(m_worldIndex, ballAABB);
+}
+
+inline SimulationCore::SweptCollisionData WorldBatch::GameState::findEarliestBrickContact(const XMFLOAT2& ballPosition, const XMFLOAT2& ballDisplacement,
+																						 unsigned int& hitBrickIndex)const
+{
+	return m_batch.findEarliestBrickContact(m_worldIndex, ballPosition, ballDisplacement, hitBrickIndex);
+}
+
+inline SimulationCore::KineticBallMotion& WorldBatch::GameState::kineticBallMotion()
+{
+	return m_batch.m_kineticBallMotions[m_worldIndex];
+}
+
+inline void WorldBatch::GameState::restartLevel()
+{
+	m_batch.restartLevel(m_worldIndex);
+}
+
+WorldBatch::WorldBatch(unsigned int worldsCount, unsigned int firstRandomSeed, unsigned int threadsCount,
+					   SimulationCore::ECollisionMode collisionMode) : m_worldsCount{ worldsCount },
+																	   m_collisionMode{ collisionMode },
+																	   m_threadPool{ threadsCount },
+																	   m_ballsX(worldsCount),
+																	   m_ballsY(worldsCount),
+																	   m_ballsVelocityX(worldsCount),
+																	   m_ballsVelocityY(worldsCount),
+																	   m_playersX(worldsCount),
+																	   m_bonusesX(worldsCount),
+																	   m_bonusesY(worldsCount),
+																	   m_bonusesBricksHit(worldsCount),
+																	   m_nextBonusesBricksHitCounts(worldsCount),
+																	   m_bonusesAlive(worldsCount),
+																	   m_levelsRestarted(worldsCount),
+																	   m_kineticBallMotions(worldsCount),
+																	   m_bricksX(worldsCount * gk_bricksCount),
+																	   m_bricksY(worldsCount * gk_bricksCount),
+																	   m_bricksRemainingHits(worldsCount * gk_bricksCount),
+																	   m_bricksTypes(worldsCount * gk_bricksCount),
+																	   m_aliveBricks(worldsCount)
+{
+	m_randomEngines.reserve(worldsCount);
+
+	for (unsigned int worldIndex = 0; worldIndex < worldsCount; ++worldIndex)
+	{
+		m_randomEngines.emplace_back(firstRandomSeed + worldIndex);
+		restartLevel(worldIndex);
+	}
+}
+
+unsigned int WorldBatch::step(float deltaTime, const unsigned int* worldsInputFlags)
+{
+	assert(worldsInputFlags != nullptr || m_worldsCount == 0);
+
+	const auto startTime = std::chrono::steady_clock::now();
+
+	const unsigned int tasksCount = (m_worldsCount + sk_worldsPerTask - 1) / sk_worldsPerTask;
+
+	m_threadPool.parallelFor(tasksCount, [this, deltaTime, worldsInputFlags](unsigned int taskIndex)
+	{
+		const unsigned int firstWorldIndex = taskIndex * sk_worldsPerTask;
+		const unsigned int lastWorldIndex = std::min(firstWorldIndex + sk_worldsPerTask, m_worldsCount);
+
+		for (unsigned int worldIndex = firstWorldIndex; worldIndex < lastWorldIndex; ++worldIndex)
+		{
+			m_levelsRestarted[worldIndex] = static_cast<unsigned char>(stepWorld(worldIndex, deltaTime, worldsInputFlags[worldIndex]));
+		}
+	});
+
+	unsigned int restartsCount = 0;
+	for (unsigned char levelRestarted : m_levelsRestarted)
+	{
+		restartsCount += levelRestarted;
+	}
+
+	const std::chrono::duration<double> steppingTime = std::chrono::steady_clock::now() - startTime;
+
+	++m_counters.stepsCount;
+	m_counters.worldStepsCount += m_worldsCount;
+	m_counters.restartsCount += restartsCount;
+	m_counters.steppingSeconds += steppingTime.count();
+
+	return restartsCount;
+}
+
+void WorldBatch::restartLevel(unsigned int worldIndex)
+{
+	assert(worldIndex < m_worldsCount);
+
+	std::minstd_rand& randomEngine = m_randomEngines[worldIndex];
+
+	//bricks
+	BricksLayout bricksLayout;
+	generateBricksLayout(randomEngine, bricksLayout);
+
+	for (unsigned int brickIndex = 0; brickIndex < gk_bricksCount; ++brickIndex)
+	{
+		const unsigned int slot = brickSlot(worldIndex, brickIndex);
+
+		if (brickIndex < bricksLayout.placedBricksCount)
+		{
+			const unsigned int brickTypeIndex = bricksLayout.types[brickIndex];
+			assert(brickTypeIndex < gk_brickTypesCount);
+
+			m_bricksX[slot] = bricksLayout.transforms[brickIndex].x;
+			m_bricksY[slot] = bricksLayout.transforms[brickIndex].y;
+			m_bricksTypes[slot] = brickTypeIndex;
+			m_bricksRemainingHits[slot] = gk_bricksHitsCounts[brickTypeIndex];
+		}
+		else
+		{
+			//hide unplaced bricks, like SimulationCore the y is left untouched
+			m_bricksX[slot] = gk_outOfArenaX;
+			m_bricksRemainingHits[slot] = 0;
+		}
+	}
+
+	m_aliveBricks[worldIndex].setFirst(bricksLayout.placedBricksCount);
+
+	//ball
+	const XMFLOAT4 ballTransform = startBallTransform();
+	const XMFLOAT2 ballVelocity = startBallVelocity();
+	m_ballsX[worldIndex] = ballTransform.x;
+	m_ballsY[worldIndex] = ballTransform.y;
+	m_ballsVelocityX[worldIndex] = ballVelocity.x;
+	m_ballsVelocityY[worldIndex] = ballVelocity.y;
+
+	//player
+	m_playersX[worldIndex] = startPlayerTransform().x;
+
+	//bonus
+	const XMFLOAT4 bonusTransform = startBonusTransform();
+	m_bonusesX[worldIndex] = bonusTransform.x;
+	m_bonusesY[worldIndex] = bonusTransform.y;
+
+	m_bonusesAlive[worldIndex] = 0;
+	m_bonusesBricksHit[worldIndex] = 0;
+	m_nextBonusesBricksHitCounts[worldIndex] = generateNextBonusBricksHitCount(randomEngine);
+
+	m_kineticBallMotions[worldIndex].contactValid = false;
+}
+
+bool WorldBatch::stepWorld(unsigned int worldIndex, float deltaTime, unsigned int inputFlags)
+{
+	//the rules of SimulationCore::step(), so that the results are identical
+	GameState state{ *this, worldIndex };
+
+	if (m_collisionMode == SimulationCore::COLLISION_SWEPT)
+	{
+		return SimulationRules::stepSwept(state, deltaTime, inputFlags);
+	}
+
+	if (m_collisionMode == SimulationCore::COLLISION_KINETIC)
+	{
+		return SimulationRules::stepKinetic(state, deltaTime, inputFlags);
+	}
+
+	return SimulationRules::stepDiscrete(state, deltaTime, inputFlags);
+}
+
+unsigned int WorldBatch::findTouchingBrick(unsigned int worldIndex, const AABB& currBallAABB)const
+{
+	const unsigned int firstSlot = brickSlot(worldIndex, 0);
+
+	//the bricks of a world are a few contiguous cache lines: all of them are tested, without a broadphase.
+	//the destroyed and the unplaced bricks are masked out by their bits, the groups of them are not even loaded
+	unsigned int touchingBricks[gk_bricksCount];
+	const unsigned int touchingBricksCount = findTouchingBoxes(&m_bricksX[firstSlot], &m_bricksY[firstSlot], gk_bricksCount, gk_bricksHalfExtents,
+															   currBallAABB, touchingBricks, m_aliveBricks[worldIndex].words());
+
+	if (touchingBricksCount == 0)
+	{
+		return gk_bricksCount;
+	}
+
+	//the indices are sorted, so this is the lowest one as in SimulationCore
+	return touchingBricks[0];
+}
+
+SimulationCore::SweptCollisionData WorldBatch::findEarliestBrickContact(unsigned int worldIndex, const XMFLOAT2& ballPosition,
+																		const XMFLOAT2& ballDisplacement, unsigned int& hitBrickIndex)const
+{
+	const unsigned int firstSlot = brickSlot(worldIndex, 0);
+
+	const float* bricksX = &m_bricksX[firstSlot];
+	const float* bricksY = &m_bricksY[firstSlot];
+
+	//the bricks touched by the ball during the displacement are inside the AABB enclosing its start and end AABBs.
+	//the indices are sorted, so on the same time the lowest one is kept as in SimulationCore
+	const XMFLOAT2 endBallPosition = ballPosition + ballDisplacement;
+	const XMFLOAT2 sweptMin{ std::min(ballPosition.x, endBallPosition.x), std::min(ballPosition.y, endBallPosition.y) };
+	const XMFLOAT2 sweptMax{ std::max(ballPosition.x, endBallPosition.x), std::max(ballPosition.y, endBallPosition.y) };
+	const AABB sweptBallAABB = AABB::computeFromMinMax(sweptMin - gk_ballHalfExtents, sweptMax + gk_ballHalfExtents);
+
+	unsigned int touchingBricks[gk_bricksCount];
+	const unsigned int touchingBricksCount = findTouchingBoxes(bricksX, bricksY, gk_bricksCount, gk_bricksHalfExtents, sweptBallAABB, touchingBricks,
+															   m_aliveBricks[worldIndex].words());
+
+	SimulationCore::SweptCollisionData earliestContact{ SimulationCore::sk_noContactTime, 0, 0, endBallPosition };
+	hitBrickIndex = gk_bricksCount;
+
+	for (unsigned int touchingBrickIndex = 0; touchingBrickIndex < touchingBricksCount; ++touchingBrickIndex)
+	{
+		const unsigned int brickIndex = touchingBricks[touchingBrickIndex];
+
+		const AABB aabb = AABB::computeFromCenterAndHalfExtents(XMFLOAT2{ bricksX[brickIndex], bricksY[brickIndex] }, gk_bricksHalfExtents);
+
+		const SimulationCore::SweptCollisionData contact =
+			SimulationCore::ballAABBSweptCollisionData(aabb, ballPosition, gk_ballHalfExtents, ballDisplacement);
+
+		if (contact.time <= 1.0f && contact.time < earliestContact.time)
+		{
+			earliestContact = contact;
+			hitBrickIndex = brickIndex;
+		}
+	}
+
+	return earliestContact;
+}
+
+void WorldBatch::fillTransforms(unsigned int worldIndex, ArkanoidRenderer::TransformsConstantBuffer& transforms)const
+{
+	assert(worldIndex < m_worldsCount);
+
+	transforms.translationAndScales[gk_arenaIndex] = startArenaTransform();
+
+	transforms.translationAndScales[gk_ballIndex] = XMFLOAT4{ m_ballsX[worldIndex], m_ballsY[worldIndex], gk_ballHalfWidth, gk_ballHalfHeight };
+
+	transforms.translationAndScales[gk_playerIndex] = XMFLOAT4{ m_playersX[worldIndex], static_cast<float>(gk_arenaMinY), gk_playerHalfWidth, gk_playerHalfHeight };
+
+	transforms.translationAndScales[gk_bonusIndex] = XMFLOAT4{ m_bonusesX[worldIndex], m_bonusesY[worldIndex], gk_bonusHalfWidth, gk_bonusHalfHeight };
+
+	for (unsigned int brickIndex = 0; brickIndex < gk_bricksCount; ++brickIndex)
+	{
+		const unsigned int slot = brickSlot(worldIndex, brickIndex);
+		transforms.translationAndScales[gk_bricksStartIndex + brickIndex] = XMFLOAT4{ m_bricksX[slot], m_bricksY[slot], gk_bricksHalfWidth, gk_bricksHalfHeight };
+	}
+}
\ No newline at end of file
@@ -0,0 +1,248 @@
+#pragma once
+#include "Engine.h"
+#include "MathCommon.h"
+#include "ArkanoidRenderer.h"
+#include "Dimensions.h"
+#include "ThreadPool.h"
+#include "SimulationCore.h"
+#include "BricksBitset.h"
+#include <vector>
+#include <random>
+#include <cassert>
+
+namespace ArkanoidGame
+{
+	class AABB;
+
+	struct WorldBatchCounters
+	{
+		unsigned long long stepsCount{ 0 }; //step() calls
+		unsigned long long worldStepsCount{ 0 }; //worlds stepped, summed over the step() calls
+		unsigned long long restartsCount{ 0 };
+		double steppingSeconds{ 0.0 }; //wall time spent inside step()
+	};
+
+	/*
+	many independent games stepped together, for the workloads which don't need a window (bots training, replays).
+	each world follows the rules of SimulationCore: the same seed and per-step inputs give the same state.
+	the state is stored as structure of arrays, one array per field, and the bricks of a world are contiguous.
+	the worlds are split in chunks which are stepped in parallel by a work-stealing ThreadPool.
+	*/
+	class WorldBatch
+	{
+	public:
+		//ctors
+		//world i is seeded with firstRandomSeed + i. threadsCount == 0 uses one thread per hardware thread.
+		//the worlds collide the ball like a SimulationCore with the same collisionMode
+		explicit WorldBatch(unsigned int worldsCount, unsigned int firstRandomSeed, unsigned int threadsCount = 0,
+							SimulationCore::ECollisionMode collisionMode = SimulationCore::COLLISION_DISCRETE);
+
+		//dtor
+		~WorldBatch() = default;
+
+		//copy
+		WorldBatch(const WorldBatch&) = delete;
+		WorldBatch& operator=(const WorldBatch&) = delete;
+
+		//move
+		WorldBatch(WorldBatch&&) = delete;
+		WorldBatch& operator=(WorldBatch&&) = delete;
+
+		//deltaTime is in seconds. worldsInputFlags holds one SimulationCore::EInputFlags bitmask per world.
+		//returns the number of worlds whose level has been restarted during the step
+		unsigned int step(float deltaTime, const unsigned int* worldsInputFlags);
+
+		void restartLevel(unsigned int worldIndex);
+
+		unsigned int worldsCount()const;
+		unsigned int threadsCount()const;
+
+		SimulationCore::ECollisionMode collisionMode()const;
+
+		//true if the level of the world has been restarted during the last step()
+		bool hasRestarted(unsigned int worldIndex)const;
+
+		XMFLOAT2 ballPosition(unsigned int worldIndex)const;
+		XMFLOAT2 ballVelocity(unsigned int worldIndex)const;
+		float playerPositionX(unsigned int worldIndex)const;
+		XMFLOAT2 bonusPosition(unsigned int worldIndex)const;
+		bool isBonusAlive(unsigned int worldIndex)const;
+
+		XMFLOAT2 brickPosition(unsigned int worldIndex, unsigned int brickIndex)const;
+		unsigned int brickType(unsigned int worldIndex, unsigned int brickIndex)const;
+		unsigned int brickRemainingHits(unsigned int worldIndex, unsigned int brickIndex)const;
+
+		//the placed bricks not destroyed yet
+		unsigned int aliveBricksCount(unsigned int worldIndex)const;
+
+		//true if all the bricks of the world have been destroyed, a cheap check to stop a batch run
+		bool isLevelCleared(unsigned int worldIndex)const;
+
+		//writes the world with the layout of SimulationCore::transforms(), to render it or compare it
+		void fillTransforms(unsigned int worldIndex, ArkanoidRenderer::TransformsConstantBuffer& transforms)const;
+
+		const WorldBatchCounters& counters()const;
+		void resetCounters();
+
+		//from the counters
+		double worldStepsPerSecond()const;
+
+		//worlds stepped by a single task: big enough to amortize the stealing, small enough to balance the load
+		static constexpr unsigned int sk_worldsPerTask = 64;
+
+	private:
+		//the accessor of the fields of a world given to the SimulationRules
+		class GameState;
+
+		//returns true if the level has been restarted
+		bool stepWorld(unsigned int worldIndex, float deltaTime, unsigned int inputFlags);
+
+		//the alive brick with the lowest index touching the ball, gk_bricksCount if none
+		unsigned int findTouchingBrick(unsigned int worldIndex, const AABB& currBallAABB)const;
+
+		//as SimulationCore::findEarliestBrickContact()
+		SimulationCore::SweptCollisionData findEarliestBrickContact(unsigned int worldIndex, const XMFLOAT2& ballPosition,
+																	const XMFLOAT2& ballDisplacement, unsigned int& hitBrickIndex)const;
+
+		unsigned int brickSlot(unsigned int worldIndex, unsigned int brickIndex)const;
+
+		unsigned int m_worldsCount;
+
+		SimulationCore::ECollisionMode m_collisionMode;
+
+		ArkanoidEngine::ThreadPool m_threadPool;
+
+		//one element per world
+		std::vector<float> m_ballsX;
+		std::vector<float> m_ballsY;
+		std::vector<float> m_ballsVelocityX;
+		std::vector<float> m_ballsVelocityY;
+
+		std::vector<float> m_playersX; //the player never leaves the bottom of the arena
+
+		std::vector<float> m_bonusesX;
+		std::vector<float> m_bonusesY;
+		std::vector<unsigned int> m_bonusesBricksHit;
+		std::vector<unsigned int> m_nextBonusesBricksHitCounts;
+		std::vector<unsigned char> m_bonusesAlive;
+
+		std::vector<unsigned char> m_levelsRestarted;
+
+		std::vector<SimulationCore::KineticBallMotion> m_kineticBallMotions; //COLLISION_KINETIC only
+
+		std::vector<std::minstd_rand> m_randomEngines;
+
+		//gk_bricksCount elements per world
+		std::vector<float> m_bricksX;
+		std::vector<float> m_bricksY;
+		std::vector<unsigned int> m_bricksRemainingHits;
+		std::vector<unsigned int> m_bricksTypes;
+
+		//one element per world, kept in sync with m_bricksRemainingHits
+		std::vector<BricksBitset> m_aliveBricks;
+
+		WorldBatchCounters m_counters{};
+	};
+
+	inline unsigned int WorldBatch::worldsCount()const
+	{
+		return m_worldsCount;
+	}
+
+	inline unsigned int WorldBatch::threadsCount()const
+	{
+		return m_threadPool.threadsCount();
+	}
+
+	inline SimulationCore::ECollisionMode WorldBatch::collisionMode()const
+	{
+		return m_collisionMode;
+	}
+
+	inline bool WorldBatch::hasRestarted(unsigned int worldIndex)const
+	{
+		assert(worldIndex < m_worldsCount);
+		return m_levelsRestarted[worldIndex] != 0;
+	}
+
+	inline XMFLOAT2 WorldBatch::ballPosition(unsigned int worldIndex)const
+	{
+		assert(worldIndex < m_worldsCount);
+		return XMFLOAT2{ m_ballsX[worldIndex], m_ballsY[worldIndex] };
+	}
+
+	inline XMFLOAT2 WorldBatch::ballVelocity(unsigned int worldIndex)const
+	{
+		assert(worldIndex < m_worldsCount);
+		return XMFLOAT2{ m_ballsVelocityX[worldIndex], m_ballsVelocityY[worldIndex] };
+	}
+
+	inline float WorldBatch::playerPositionX(unsigned int worldIndex)const
+	{
+		assert(worldIndex < m_worldsCount);
+		return m_playersX[worldIndex];
+	}
+
+	inline XMFLOAT2 WorldBatch::bonusPosition(unsigned int worldIndex)const
+	{
+		assert(worldIndex < m_worldsCount);
+		return XMFLOAT2{ m_bonusesX[worldIndex], m_bonusesY[worldIndex] };
+	}
+
+	inline bool WorldBatch::isBonusAlive(unsigned int worldIndex)const
+	{
+		assert(worldIndex < m_worldsCount);
+		return m_bonusesAlive[worldIndex] != 0;
+	}
+
+	inline unsigned int WorldBatch::brickSlot(unsigned int worldIndex, unsigned int brickIndex)const
+	{
+		assert(worldIndex < m_worldsCount);
+		assert(brickIndex < gk_bricksCount);
+		return worldIndex * gk_bricksCount + brickIndex;
+	}
+
+	inline XMFLOAT2 WorldBatch::brickPosition(unsigned int worldIndex, unsigned int brickIndex)const
+	{
+		const unsigned int slot = brickSlot(worldIndex, brickIndex);
+		return XMFLOAT2{ m_bricksX[slot], m_bricksY[slot] };
+	}
+
+	inline unsigned int WorldBatch::brickType(unsigned int worldIndex, unsigned int brickIndex)const
+	{
+		return m_bricksTypes[brickSlot(worldIndex, brickIndex)];
+	}
+
+	inline unsigned int WorldBatch::brickRemainingHits(unsigned int worldIndex, unsigned int brickIndex)const
+	{
+		return m_bricksRemainingHits[brickSlot(worldIndex, brickIndex)];
+	}
+
+	inline unsigned int WorldBatch::aliveBricksCount(unsigned int worldIndex)const
+	{
+		assert(worldIndex < m_worldsCount);
+		return m_aliveBricks[worldIndex].count();
+	}
+
+	inline bool WorldBatch::isLevelCleared(unsigned int worldIndex)const
+	{
+		assert(worldIndex < m_worldsCount);
+		return m_aliveBricks[worldIndex].none();
+	}
+
+	inline const WorldBatchCounters& WorldBatch::counters()const
+	{
+		return m_counters;
+	}
+
+	inline void WorldBatch::resetCounters()
+	{
+		m_counters = WorldBatchCounters{};
+	}
+
+	inline double WorldBatch::worldStepsPerSecond()const
+	{
+		const double seconds[2] = { m_counters.steppingSeconds, 1.0 };
+		return static_cast<double>(m_counters.worldStepsCount) / seconds[static_cast<unsigned int>(m_counters.steppingSeconds <= 0.0)];
+	}
+}
\ No newline at end of file
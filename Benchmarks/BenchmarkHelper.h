@@ -0,0 +1,61 @@
+#pragma once
+#include "Timer.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+
+namespace ArkanoidBenchmarks
+{
+	//the command line of every benchmark: --quick runs the smallest sizes once, as ctest does to check they still run
+	struct BenchmarkOptions
+	{
+		bool quick;
+	};
+
+	inline BenchmarkOptions parseBenchmarkOptions(int argc, char** argv)
+	{
+		BenchmarkOptions options{ false };
+
+		for (int argIndex = 1; argIndex < argc; ++argIndex)
+		{
+			if (std::strcmp(argv[argIndex], "--quick") == 0)
+			{
+				options.quick = true;
+			}
+		}
+
+		return options;
+	}
+
+	//the repeats of a measure taking about the same total time whatever the size: the quick runs measure once
+	inline unsigned int computeRepeatsCount(const BenchmarkOptions& options, unsigned int size, unsigned int maxRepeatsCount = 20)
+	{
+		return options.quick ? 1 : std::max(3u, std::min(maxRepeatsCount, 20000u / std::max(size, 1u)));
+	}
+
+	//the fastest of repeatsCount calls of function, in milliseconds: the slower ones were disturbed by the rest of the system
+	template<typename Function>
+	inline float measureMinMilliseconds(unsigned int repeatsCount, Function&& function)
+	{
+		float minMilliseconds = 0.0f;
+
+		for (unsigned int repeatIndex = 0; repeatIndex < repeatsCount; ++repeatIndex)
+		{
+			ArkanoidEngine::Timer timer;
+			timer.start();
+			function();
+			timer.tick();
+
+			minMilliseconds = repeatIndex == 0 ? timer.deltaTime() : std::min(minMilliseconds, timer.deltaTime());
+		}
+
+		return minMilliseconds;
+	}
+
+	//keeps the compiler from dropping the computations whose results only the benchmark sees
+	inline void consumeResult(unsigned int result)
+	{
+		static volatile unsigned int sink = 0;
+		sink = sink + result;
+	}
+}
\ No newline at end of file
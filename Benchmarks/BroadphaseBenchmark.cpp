@@ -0,0 +1,238 @@
+#include "BenchmarkHelper.h"
+#include "TestHelper.h"
+#include "Broadphase.h"
+#include "SimulationCore.h"
+
+/*
+times each broadphase on the same scenes: insertion one object after another, build(), buildBulk(), ball sized queries
+scattered over the area and the update of every object moving a little, as the moving objects of a frame.
+GridBroadphase and the Quadtree are compared again on columns out of the lattice of the grid cells.
+the swept queries of a slow and a fast ball are timed on the game layouts, through the quadrants crossed by the Quadtree
+and through the AABB enclosing the motion.
+--quick runs the game layouts and the smallest random scene once
+*/
+
+using namespace ArkanoidTests;
+using namespace ArkanoidBenchmarks;
+
+namespace
+{
+	constexpr unsigned int gk_queriesCount = 4096;
+
+	template<typename MakeBroadphase>
+	void benchmarkBroadphase(const char* broadphaseName, const ObjectsScene& scene, const std::vector<AABB>& queries,
+							 const BenchmarkOptions& options, MakeBroadphase makeBroadphase)
+	{
+		const unsigned int objectsCount = static_cast<unsigned int>(scene.objectsCenters.size());
+		const unsigned int repeatsCount = computeRepeatsCount(options, objectsCount);
+
+		auto broadphase = makeBroadphase(scene.area, scene.objectsHalfExtents, objectsCount);
+
+		const float insertMilliseconds = measureMinMilliseconds(repeatsCount, [&]()
+		{
+			broadphase.build(scene.area, nullptr, nullptr, 0);
+
+			for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+			{
+				broadphase.insert(scene.objectsCenters[objectIndex], scene.objectsDatas[objectIndex]);
+			}
+		});
+
+		const float buildMilliseconds = measureMinMilliseconds(repeatsCount, [&]()
+		{
+			broadphase.build(scene.area, scene.objectsCenters.data(), scene.objectsDatas.data(), objectsCount);
+		});
+
+		const float buildBulkMilliseconds = measureMinMilliseconds(repeatsCount, [&]()
+		{
+			broadphase.buildBulk(scene.area, scene.objectsCenters.data(), scene.objectsDatas.data(), objectsCount);
+		});
+
+		std::vector<unsigned int> foundObjects(std::max(objectsCount, 1u));
+		unsigned int foundObjectsCount = 0;
+
+		const float queriesMilliseconds = measureMinMilliseconds(repeatsCount, [&]()
+		{
+			foundObjectsCount = 0;
+			for (const AABB& queryAABB : queries)
+			{
+				foundObjectsCount += broadphase.findPotentialColliders(queryAABB, foundObjects.data());
+			}
+			consumeResult(foundObjectsCount);
+		});
+
+		//each object moves by a fraction of its size and back, so every repeat starts from the same objects
+		const XMFLOAT2 displacement = scene.objectsHalfExtents * 0.25f;
+
+		const float updatesMilliseconds = measureMinMilliseconds(repeatsCount, [&]()
+		{
+			for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+			{
+				const XMFLOAT2& objectCenter = scene.objectsCenters[objectIndex];
+				broadphase.update(objectCenter, objectCenter + displacement, scene.objectsDatas[objectIndex]);
+			}
+
+			for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+			{
+				const XMFLOAT2& objectCenter = scene.objectsCenters[objectIndex];
+				broadphase.update(objectCenter + displacement, objectCenter, scene.objectsDatas[objectIndex]);
+			}
+		});
+
+		const float queriesCount = static_cast<float>(queries.size());
+		const float updatesCount = static_cast<float>(std::max(2 * objectsCount, 1u));
+
+		std::printf("%-26s %-22s %8u %12.1f %12.1f %12.1f %10.1f %8.2f %10.1f\n", broadphaseName, scene.name.c_str(), objectsCount,
+					insertMilliseconds * 1000.0f, buildMilliseconds * 1000.0f, buildBulkMilliseconds * 1000.0f,
+					queriesMilliseconds * 1000000.0f / queriesCount, foundObjectsCount / queriesCount,
+					updatesMilliseconds * 1000000.0f / updatesCount);
+	}
+
+	template<typename Broadphase>
+	void benchmarkBroadphase(const char* broadphaseName, const ObjectsScene& scene, const std::vector<AABB>& queries,
+							 const BenchmarkOptions& options)
+	{
+		benchmarkBroadphase(broadphaseName, scene, queries, options, [](const AABB& area, const XMFLOAT2& objectsHalfExtents, unsigned int objectsCapacity)
+		{
+			return Broadphase{ area, objectsHalfExtents, objectsCapacity };
+		});
+	}
+
+	/*
+	balls starting anywhere in the area, moving at the start speed for duration in any direction: a frame of 1/60 s is
+	the slow ball, a long step of the kinetic mode the fast one
+	*/
+	std::vector<SweptQuery> generateBallMotions(const ObjectsScene& scene, float duration, unsigned int randomSeed)
+	{
+		std::mt19937 randomEngine{ randomSeed };
+		std::uniform_real_distribution<float> xDistribution{ scene.area.min().x, scene.area.max().x };
+		std::uniform_real_distribution<float> yDistribution{ scene.area.min().y, scene.area.max().y };
+		std::uniform_real_distribution<float> angleDistribution{ 0.0f, 2.0f * XM_PI };
+
+		std::vector<SweptQuery> motions;
+		for (unsigned int motionIndex = 0; motionIndex < gk_queriesCount; ++motionIndex)
+		{
+			const float angle = angleDistribution(randomEngine);
+			const float distance = gk_startBallSpeed * duration;
+
+			motions.push_back(SweptQuery{ XMFLOAT2{ xDistribution(randomEngine), yDistribution(randomEngine) },
+										  XMFLOAT2{ std::cos(angle) * distance, std::sin(angle) * distance } });
+		}
+
+		return motions;
+	}
+
+	//findSweptObjects(broadphase, motion, foundObjects) answers a swept query
+	template<typename Broadphase, typename FindSweptObjects>
+	void benchmarkSweptQueries(const char* broadphaseName, const char* motionName, const ObjectsScene& scene, const std::vector<SweptQuery>& motions,
+							   const BenchmarkOptions& options, FindSweptObjects findSweptObjects)
+	{
+		const unsigned int objectsCount = static_cast<unsigned int>(scene.objectsCenters.size());
+		const unsigned int repeatsCount = computeRepeatsCount(options, objectsCount);
+
+		Broadphase broadphase{ scene.area, scene.objectsHalfExtents, objectsCount };
+		broadphase.build(scene.area, scene.objectsCenters.data(), scene.objectsDatas.data(), objectsCount);
+
+		std::vector<unsigned int> foundObjects(std::max(objectsCount, 1u));
+		unsigned int foundObjectsCount = 0;
+
+		const float queriesMilliseconds = measureMinMilliseconds(repeatsCount, [&]()
+		{
+			foundObjectsCount = 0;
+			for (const SweptQuery& motion : motions)
+			{
+				foundObjectsCount += findSweptObjects(broadphase, motion, foundObjects.data());
+			}
+			consumeResult(foundObjectsCount);
+		});
+
+		const float queriesCount = static_cast<float>(motions.size());
+
+		std::printf("%-26s %-22s %-12s %10.1f %8.2f\n", broadphaseName, scene.name.c_str(), motionName,
+					queriesMilliseconds * 1000000.0f / queriesCount, foundObjectsCount / queriesCount);
+	}
+
+	//the Quadtree of the game through the quadrants crossed and through the enclosing AABB, as the other broadphases
+	void benchmarkSweptQueries(const ObjectsScene& scene, const BenchmarkOptions& options)
+	{
+		const unsigned int randomSeed = static_cast<unsigned int>(scene.objectsCenters.size());
+
+		const std::pair<const char*, float> ballMotions[] = { { "slow 1/60 s", 1.0f / 60.0f }, { "fast 1/2 s", 0.5f } };
+
+		for (const auto& ballMotion : ballMotions)
+		{
+			const std::vector<SweptQuery> motions = generateBallMotions(scene, ballMotion.second, randomSeed);
+
+			benchmarkSweptQueries<SimulationCore::Quadtree>("Quadtree (game) crossed", ballMotion.first, scene, motions, options,
+															[](const SimulationCore::Quadtree& quadtree, const SweptQuery& motion, unsigned int* foundObjects)
+			{
+				return quadtree.findSweptPotentialColliders(motion.start, motion.displacement, gk_ballHalfExtents, foundObjects);
+			});
+
+			benchmarkSweptQueries<SimulationCore::Quadtree>("Quadtree (game) enclosing", ballMotion.first, scene, motions, options,
+															[](const SimulationCore::Quadtree& quadtree, const SweptQuery& motion, unsigned int* foundObjects)
+			{
+				//the overload of the other broadphases
+				return findSweptPotentialColliders<SimulationCore::Quadtree>(quadtree, motion.start, motion.displacement, gk_ballHalfExtents, foundObjects);
+			});
+		}
+	}
+
+	void benchmarkBroadphases(const ObjectsScene& scene, const BenchmarkOptions& options)
+	{
+		const std::vector<AABB> queries = generateBallQueries(scene, gk_queriesCount, static_cast<unsigned int>(scene.objectsCenters.size()));
+
+		benchmarkBroadphase<SimulationCore::Quadtree>("Quadtree (game)", scene, queries, options);
+		benchmarkBroadphase<Quadtree<unsigned int, 6>>("Quadtree depth 6", scene, queries, options);
+		benchmarkBroadphase<GridBroadphase>("GridBroadphase", scene, queries, options);
+		benchmarkBroadphase<SweepAndPruneBroadphase>("SweepAndPruneBroadphase", scene, queries, options);
+		benchmarkBroadphase<SimdBroadphase>("SimdBroadphase", scene, queries, options);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const BenchmarkOptions options = parseBenchmarkOptions(argc, argv);
+
+	std::printf("%-26s %-22s %8s %12s %12s %12s %10s %8s %10s\n", "broadphase", "scene", "objects",
+				"insert us", "build us", "bulk us", "query ns", "found", "update ns");
+
+	for (unsigned int layoutIndex = 0; layoutIndex < gk_bricksLayoutsCount; ++layoutIndex)
+	{
+		benchmarkBroadphases(bricksLayoutScene(layoutIndex), options);
+	}
+
+	//GridBroadphase against the Quadtree it replaced in the game, as the columns leave the lattice of the grid cells:
+	//their bricks overlap more cells, so the grid holds more entries per brick and visits more of them per query
+	const float columnsSpacings[] = { gk_bricksWidth, gk_bricksWidth * 1.33f, gk_bricksWidth * 1.8f };
+
+	for (float columnsSpacing : columnsSpacings)
+	{
+		const unsigned int columnsCount = static_cast<unsigned int>((gk_arenaWidth - gk_bricksWidth - 1.0f) / columnsSpacing) + 1;
+		const ObjectsScene scene = spacedColumnsScene(columnsCount, 15, columnsSpacing, gk_bricksHeight * 1.33f, XMFLOAT2{ 0.0f, 0.0f });
+		const std::vector<AABB> queries = generateBallQueries(scene, gk_queriesCount, static_cast<unsigned int>(scene.objectsCenters.size()));
+
+		benchmarkBroadphase<SimulationCore::Quadtree>("Quadtree (game)", scene, queries, options);
+		benchmarkBroadphase<GridBroadphase>("GridBroadphase", scene, queries, options);
+	}
+
+	//bricks sized objects scattered over areas growing with their count, so the density stays the one of the levels
+	const unsigned int maxObjectsCount = options.quick ? 1000 : 100000;
+
+	for (unsigned int objectsCount = 1000; objectsCount <= maxObjectsCount; objectsCount *= 10)
+	{
+		const AABB area = levelDensityArea(objectsCount);
+		benchmarkBroadphases(randomScene("random " + std::to_string(objectsCount), area, gk_bricksHalfExtents, objectsCount, objectsCount), options);
+	}
+
+	//a quadrant crossed costs more to test than one touching the enclosing AABB: it pays off when the enclosing AABB of a
+	//fast ball holds many bricks the ball never reaches
+	std::printf("\n%-26s %-22s %-12s %10s %8s\n", "swept broadphase", "scene", "ball", "query ns", "found");
+
+	for (unsigned int layoutIndex = 0; layoutIndex < gk_bricksLayoutsCount; ++layoutIndex)
+	{
+		benchmarkSweptQueries(bricksLayoutScene(layoutIndex), options);
+	}
+
+	return 0;
+}
\ No newline at end of file
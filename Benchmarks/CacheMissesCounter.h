@@ -0,0 +1,103 @@
+#pragma once
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include <cstring>
+
+namespace ArkanoidBenchmarks
+{
+	/*
+	counts the cache misses of the calling thread, from the last level cache, with the performance counters of the CPU.
+	only Linux gives them to the process, through perf_event_open(), and not on every machine or virtual machine:
+	available() is false when they can't be read, then the benchmarks print n/a
+	*/
+	class CacheMissesCounter
+	{
+	public:
+		//ctors
+		CacheMissesCounter();
+
+		//dtor
+		~CacheMissesCounter();
+
+		//copy
+		CacheMissesCounter(const CacheMissesCounter&) = delete;
+		CacheMissesCounter& operator=(const CacheMissesCounter&) = delete;
+
+		//move
+		CacheMissesCounter(CacheMissesCounter&&) = delete;
+		CacheMissesCounter& operator=(CacheMissesCounter&&) = delete;
+
+		bool available()const;
+
+		//the misses of the calls of function, 0 when the counter is not available
+		template<typename Function>
+		unsigned long long measure(Function&& function);
+
+	private:
+		int m_fileDescriptor{ -1 };
+	};
+
+	//CacheMissesCounter implementation
+
+	inline CacheMissesCounter::CacheMissesCounter()
+	{
+#ifdef __linux__
+		perf_event_attr eventAttributes;
+		std::memset(&eventAttributes, 0, sizeof(eventAttributes));
+		eventAttributes.size = sizeof(eventAttributes);
+		eventAttributes.type = PERF_TYPE_HARDWARE;
+		eventAttributes.config = PERF_COUNT_HW_CACHE_MISSES;
+		eventAttributes.disabled = 1;
+		eventAttributes.exclude_kernel = 1;
+		eventAttributes.exclude_hv = 1;
+
+		m_fileDescriptor = static_cast<int>(syscall(SYS_perf_event_open, &eventAttributes, 0, -1, -1, 0));
+#endif
+	}
+
+	inline CacheMissesCounter::~CacheMissesCounter()
+	{
+#ifdef __linux__
+		if (available())
+		{
+			close(m_fileDescriptor);
+		}
+#endif
+	}
+
+	inline bool CacheMissesCounter::available()const
+	{
+		return m_fileDescriptor >= 0;
+	}
+
+	template<typename Function>
+	inline unsigned long long CacheMissesCounter::measure(Function&& function)
+	{
+		unsigned long long missesCount = 0;
+
+#ifdef __linux__
+		if (available())
+		{
+			ioctl(m_fileDescriptor, PERF_EVENT_IOC_RESET, 0);
+			ioctl(m_fileDescriptor, PERF_EVENT_IOC_ENABLE, 0);
+			function();
+			ioctl(m_fileDescriptor, PERF_EVENT_IOC_DISABLE, 0);
+
+			if (read(m_fileDescriptor, &missesCount, sizeof(missesCount)) != sizeof(missesCount))
+			{
+				missesCount = 0;
+			}
+
+			return missesCount;
+		}
+#endif
+
+		function();
+
+		return missesCount;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include "BenchmarkHelper.h"
+#include "SimulationCore.h"
+#include <random>
+
+/*
+plays the same games with each collision mode of SimulationCore and prints the cost of a simulated second.
+COLLISION_DISCRETE and COLLISION_SWEPT step at 60 Hz, COLLISION_KINETIC at 60 Hz and with the long steps it allows, as a
+headless run (a replay, a bot) would use them: its cost follows the events, not the steps.
+the input changes every simulated second, from the same random sequence for all the runs, so that the steps of a run never
+change the input within one of them. the simulations go on through the restarts.
+--quick plays 10 simulated seconds
+*/
+
+using namespace ArkanoidGame;
+using namespace ArkanoidBenchmarks;
+
+namespace
+{
+	constexpr unsigned int gk_gamesCount = 8;
+
+	//the wall time of a simulated second, in microseconds
+	float measureSecondMicroseconds(SimulationCore::ECollisionMode collisionMode, unsigned int stepsPerSecond,
+									unsigned int simulatedSecondsCount, const BenchmarkOptions& options, unsigned int& restartsCount)
+	{
+		const float deltaTime = 1.0f / stepsPerSecond;
+
+		const unsigned int repeatsCount = computeRepeatsCount(options, 1, 5);
+
+		const float milliseconds = measureMinMilliseconds(repeatsCount, [&]()
+		{
+			restartsCount = 0;
+
+			for (unsigned int gameIndex = 0; gameIndex < gk_gamesCount; ++gameIndex)
+			{
+				SimulationCore simulation{ gameIndex + 1, collisionMode };
+
+				std::mt19937 randomEngine{ gameIndex };
+				std::uniform_int_distribution<unsigned int> inputDistribution{ 0, SimulationCore::INPUT_LEFT | SimulationCore::INPUT_RIGHT };
+
+				for (unsigned int secondIndex = 0; secondIndex < simulatedSecondsCount; ++secondIndex)
+				{
+					const unsigned int inputFlags = inputDistribution(randomEngine);
+
+					for (unsigned int stepIndex = 0; stepIndex < stepsPerSecond; ++stepIndex)
+					{
+						restartsCount += static_cast<unsigned int>(simulation.step(deltaTime, inputFlags));
+					}
+				}
+
+				consumeResult(simulation.aliveBricksCount());
+			}
+		});
+
+		return milliseconds * 1000.0f / (gk_gamesCount * simulatedSecondsCount);
+	}
+
+	void benchmarkMode(const char* modeName, SimulationCore::ECollisionMode collisionMode, unsigned int stepsPerSecond,
+					   unsigned int simulatedSecondsCount, const BenchmarkOptions& options, float discreteMicroseconds)
+	{
+		unsigned int restartsCount = 0;
+		const float secondMicroseconds = measureSecondMicroseconds(collisionMode, stepsPerSecond, simulatedSecondsCount, options, restartsCount);
+
+		std::printf("%10s %8u %16.2f %10.2f %9u\n", modeName, stepsPerSecond, secondMicroseconds, discreteMicroseconds / secondMicroseconds, restartsCount);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const BenchmarkOptions options = parseBenchmarkOptions(argc, argv);
+
+	const unsigned int simulatedSecondsCount = options.quick ? 10 : 300;
+
+	std::printf("%10s %8s %16s %10s %9s\n", "mode", "steps/s", "us per sim. s", "speedup", "restarts");
+	std::printf("(%u games of %u simulated seconds, the speedup is against discrete at 60 steps/s)\n", gk_gamesCount, simulatedSecondsCount);
+
+	unsigned int discreteRestartsCount = 0;
+	const float discreteMicroseconds = measureSecondMicroseconds(SimulationCore::COLLISION_DISCRETE, 60, simulatedSecondsCount, options,
+																 discreteRestartsCount);
+
+	std::printf("%10s %8u %16.2f %10.2f %9u\n", "discrete", 60u, discreteMicroseconds, 1.0f, discreteRestartsCount);
+	benchmarkMode("swept", SimulationCore::COLLISION_SWEPT, 60, simulatedSecondsCount, options, discreteMicroseconds);
+	benchmarkMode("kinetic", SimulationCore::COLLISION_KINETIC, 60, simulatedSecondsCount, options, discreteMicroseconds);
+	benchmarkMode("kinetic", SimulationCore::COLLISION_KINETIC, 4, simulatedSecondsCount, options, discreteMicroseconds);
+	benchmarkMode("kinetic", SimulationCore::COLLISION_KINETIC, 1, simulatedSecondsCount, options, discreteMicroseconds);
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include "BenchmarkHelper.h"
+#include "TestHelper.h"
+#include "DynamicQuadtree.h"
+#include "Quadtree.h"
+#include <memory>
+
+/*
+compares DynamicQuadtree with the Quadtree of the same maximum depth: the bytes each one owns, the insertion of all the
+objects after clear() and ball sized queries, from 120 bricks as a level to 100k bricks at the same density.
+--quick stops at 1k bricks
+*/
+
+using namespace ArkanoidTests;
+using namespace ArkanoidBenchmarks;
+
+namespace
+{
+	constexpr unsigned int gk_queriesCount = 4096;
+
+	struct QuadtreeMeasures
+	{
+		size_t memoryUsage;
+		float insertMilliseconds;
+		float queriesMilliseconds;
+	};
+
+	template<typename AnyQuadtree>
+	QuadtreeMeasures measureQuadtree(AnyQuadtree& quadtree, const ObjectsScene& scene, const std::vector<AABB>& queries,
+									 const BenchmarkOptions& options)
+	{
+		const unsigned int objectsCount = static_cast<unsigned int>(scene.objectsCenters.size());
+		const unsigned int repeatsCount = computeRepeatsCount(options, objectsCount);
+
+		QuadtreeMeasures measures{};
+
+		measures.insertMilliseconds = measureMinMilliseconds(repeatsCount, [&]()
+		{
+			quadtree.clear();
+
+			for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+			{
+				quadtree.insert(scene.objectsCenters[objectIndex], scene.objectsDatas[objectIndex]);
+			}
+		});
+
+		std::vector<unsigned int> foundObjects(std::max(objectsCount, 1u));
+
+		measures.queriesMilliseconds = measureMinMilliseconds(repeatsCount, [&]()
+		{
+			unsigned int foundObjectsCount = 0;
+			for (const AABB& queryAABB : queries)
+			{
+				foundObjectsCount += quadtree.findPotentialColliders(queryAABB, foundObjects.data());
+			}
+			consumeResult(foundObjectsCount);
+		});
+
+		measures.memoryUsage = quadtree.memoryUsage();
+
+		return measures;
+	}
+
+	template<unsigned int MAX_DEPTH>
+	void benchmarkDepth(const ObjectsScene& scene, const std::vector<AABB>& queries, const BenchmarkOptions& options)
+	{
+		const unsigned int objectsCount = static_cast<unsigned int>(scene.objectsCenters.size());
+
+		//the Quadtree holds its quadrants as members, so the biggest ones can't be on the stack
+		std::unique_ptr<Quadtree<unsigned int, MAX_DEPTH>> quadtree{ new Quadtree<unsigned int, MAX_DEPTH>{ scene.area, scene.objectsHalfExtents, objectsCount } };
+		DynamicQuadtree<> dynamicQuadtree{ scene.area, scene.objectsHalfExtents, MAX_DEPTH, objectsCount };
+
+		const QuadtreeMeasures quadtreeMeasures = measureQuadtree(*quadtree, scene, queries, options);
+		const QuadtreeMeasures dynamicMeasures = measureQuadtree(dynamicQuadtree, scene, queries, options);
+
+		const float queriesCount = static_cast<float>(queries.size());
+
+		std::printf("%5u %8u %14zu %14zu %12.1f %12.1f %10.1f %10.1f\n", MAX_DEPTH, objectsCount,
+					quadtreeMeasures.memoryUsage, dynamicMeasures.memoryUsage,
+					quadtreeMeasures.insertMilliseconds * 1000.0f, dynamicMeasures.insertMilliseconds * 1000.0f,
+					quadtreeMeasures.queriesMilliseconds * 1000000.0f / queriesCount, dynamicMeasures.queriesMilliseconds * 1000000.0f / queriesCount);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const BenchmarkOptions options = parseBenchmarkOptions(argc, argv);
+
+	std::printf("%5s %8s %14s %14s %12s %12s %10s %10s\n", "depth", "objects", "Quadtree B", "Dynamic B",
+				"Quadtree us", "Dynamic us", "Quadtree ns", "Dynamic ns");
+	std::printf("(bytes owned, insertion of all the objects, ball sized query)\n");
+
+	const unsigned int objectsCounts[] = { gk_bricksCount, 1000, 10000, 100000 };
+
+	for (unsigned int objectsCount : objectsCounts)
+	{
+		if (options.quick && objectsCount > 1000)
+		{
+			continue;
+		}
+
+		const ObjectsScene scene = randomScene("bricks", levelDensityArea(objectsCount), gk_bricksHalfExtents, objectsCount, objectsCount);
+
+		const std::vector<AABB> queries = generateBallQueries(scene, gk_queriesCount, objectsCount);
+
+		benchmarkDepth<3>(scene, queries, options);
+		benchmarkDepth<5>(scene, queries, options);
+		benchmarkDepth<7>(scene, queries, options);
+	}
+
+	return 0;
+}
\ No newline at end of file
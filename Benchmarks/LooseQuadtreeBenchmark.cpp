@@ -0,0 +1,208 @@
+#include "BenchmarkHelper.h"
+#include "TestHelper.h"
+#include "LooseQuadtree.h"
+#include "Quadtree.h"
+#include "GridBroadphase.h"
+#include <memory>
+
+/*
+thousands of ball sized objects bouncing in an area, as the balls of many games: each step moves all of them, updates
+the broadphase and queries it with the AABB of each object. LooseQuadtree updates its objects in place, the Quadtree
+is rebuilt by buildBulk() each step and GridBroadphase relinks the objects changing cells.
+--quick runs 1k objects for a few steps
+*/
+
+using namespace ArkanoidTests;
+using namespace ArkanoidBenchmarks;
+
+namespace
+{
+	//the objects of a run, moved the same way for each broadphase
+	struct MovingObjects
+	{
+		std::vector<XMFLOAT2> centers;
+		std::vector<XMFLOAT2> velocities;
+		std::vector<unsigned int> datas;
+	};
+
+	MovingObjects makeMovingObjects(const AABB& area, unsigned int objectsCount)
+	{
+		const ObjectsScene scene = randomScene("moving", area, gk_ballHalfExtents, objectsCount, objectsCount);
+
+		MovingObjects objects{ scene.objectsCenters, {}, scene.objectsDatas };
+
+		//the speed of the ball, a step of the game at 60 Hz
+		std::mt19937 randomEngine{ objectsCount };
+		std::uniform_real_distribution<float> velocityDistribution{ -gk_startBallSpeed / 60.0f, gk_startBallSpeed / 60.0f };
+
+		for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+		{
+			objects.velocities.push_back(XMFLOAT2{ velocityDistribution(randomEngine), velocityDistribution(randomEngine) });
+		}
+
+		return objects;
+	}
+
+	//the objects bounce on the sides of the area
+	void moveObject(MovingObjects& objects, unsigned int objectIndex, const AABB& area)
+	{
+		XMFLOAT2& center = objects.centers[objectIndex];
+		XMFLOAT2& velocity = objects.velocities[objectIndex];
+
+		center = center + velocity;
+
+		if (center.x - gk_ballHalfWidth < area.min().x || center.x + gk_ballHalfWidth > area.max().x)
+		{
+			velocity.x = -velocity.x;
+		}
+		if (center.y - gk_ballHalfHeight < area.min().y || center.y + gk_ballHalfHeight > area.max().y)
+		{
+			velocity.y = -velocity.y;
+		}
+	}
+
+	struct StepsMeasures
+	{
+		float updateMilliseconds;
+		float queriesMilliseconds;
+		unsigned int foundObjectsCount;
+	};
+
+	//updateObjects(objects) moves the objects and updates the broadphase, findPotentialColliders(aabb, foundObjects) queries it
+	template<typename UpdateObjects, typename FindPotentialColliders>
+	StepsMeasures measureSteps(MovingObjects objects, unsigned int stepsCount, UpdateObjects updateObjects,
+							   FindPotentialColliders findPotentialColliders)
+	{
+		const unsigned int objectsCount = static_cast<unsigned int>(objects.centers.size());
+		std::vector<unsigned int> foundObjects(std::max(objectsCount, 1u));
+
+		StepsMeasures measures{ 0.0f, 0.0f, 0 };
+
+		for (unsigned int stepIndex = 0; stepIndex < stepsCount; ++stepIndex)
+		{
+			measures.updateMilliseconds += measureMinMilliseconds(1, [&]()
+			{
+				updateObjects(objects);
+			});
+
+			measures.queriesMilliseconds += measureMinMilliseconds(1, [&]()
+			{
+				for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+				{
+					const AABB objectAABB = AABB::computeFromCenterAndHalfExtents(objects.centers[objectIndex], gk_ballHalfExtents);
+					measures.foundObjectsCount += findPotentialColliders(objectAABB, foundObjects.data());
+				}
+			});
+		}
+
+		consumeResult(measures.foundObjectsCount);
+
+		return measures;
+	}
+
+	void printMeasures(const char* broadphaseName, unsigned int objectsCount, unsigned int stepsCount, const StepsMeasures& measures,
+					   unsigned long long relocationsCount)
+	{
+		const float microsecondsPerStepScale = 1000.0f / stepsCount;
+		const float queriesCount = static_cast<float>(objectsCount) * stepsCount;
+
+		std::printf("%-24s %8u %12.1f %12.1f %10.2f %14.2f\n", broadphaseName, objectsCount,
+					measures.updateMilliseconds * microsecondsPerStepScale, measures.queriesMilliseconds * microsecondsPerStepScale,
+					measures.foundObjectsCount / queriesCount, relocationsCount * 100.0 / queriesCount);
+	}
+
+	void benchmarkMovingObjects(unsigned int objectsCount, unsigned int stepsCount)
+	{
+		const AABB area = levelDensityArea(objectsCount);
+		const MovingObjects objects = makeMovingObjects(area, objectsCount);
+
+		{
+			std::unique_ptr<LooseQuadtree<unsigned int, 6>> looseQuadtree{ new LooseQuadtree<unsigned int, 6>{ area, objectsCount } };
+
+			std::vector<unsigned int> objectsIds;
+			for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+			{
+				objectsIds.push_back(looseQuadtree->insert(objects.centers[objectIndex], gk_ballHalfExtents, objects.datas[objectIndex]));
+			}
+
+			const StepsMeasures measures = measureSteps(objects, stepsCount, [&](MovingObjects& movingObjects)
+			{
+				for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+				{
+					moveObject(movingObjects, objectIndex, area);
+					looseQuadtree->update(objectsIds[objectIndex], movingObjects.centers[objectIndex]);
+				}
+			},
+			[&](const AABB& objectAABB, unsigned int* foundObjects)
+			{
+				return looseQuadtree->findPotentialColliders(objectAABB, foundObjects);
+			});
+
+			printMeasures("LooseQuadtree depth 6", objectsCount, stepsCount, measures, looseQuadtree->relocationsCount());
+		}
+
+		{
+			std::unique_ptr<Quadtree<unsigned int, 6>> quadtree{ new Quadtree<unsigned int, 6>{ area, gk_ballHalfExtents, objectsCount } };
+
+			const StepsMeasures measures = measureSteps(objects, stepsCount, [&](MovingObjects& movingObjects)
+			{
+				for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+				{
+					moveObject(movingObjects, objectIndex, area);
+				}
+
+				quadtree->buildBulk(area, movingObjects.centers.data(), movingObjects.datas.data(), objectsCount);
+			},
+			[&](const AABB& objectAABB, unsigned int* foundObjects)
+			{
+				return quadtree->findPotentialColliders(objectAABB, foundObjects);
+			});
+
+			printMeasures("Quadtree 6 buildBulk", objectsCount, stepsCount, measures, 0);
+		}
+
+		{
+			GridBroadphase grid{ area, gk_ballHalfExtents, objectsCount };
+			grid.build(area, objects.centers.data(), objects.datas.data(), objectsCount);
+
+			const StepsMeasures measures = measureSteps(objects, stepsCount, [&](MovingObjects& movingObjects)
+			{
+				for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+				{
+					const XMFLOAT2 oldObjectCenter = movingObjects.centers[objectIndex];
+					moveObject(movingObjects, objectIndex, area);
+					grid.update(oldObjectCenter, movingObjects.centers[objectIndex], movingObjects.datas[objectIndex]);
+				}
+			},
+			[&](const AABB& objectAABB, unsigned int* foundObjects)
+			{
+				return grid.findPotentialColliders(objectAABB, foundObjects);
+			});
+
+			printMeasures("GridBroadphase update", objectsCount, stepsCount, measures, 0);
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const BenchmarkOptions options = parseBenchmarkOptions(argc, argv);
+
+	std::printf("%-24s %8s %12s %12s %10s %14s\n", "broadphase", "objects", "update us", "queries us", "found", "relocations %");
+	std::printf("(per step: every object moved, then queried with its AABB)\n");
+
+	const unsigned int objectsCounts[] = { 1000, 4000, 16000 };
+	const unsigned int stepsCount = options.quick ? 5 : 120;
+
+	for (unsigned int objectsCount : objectsCounts)
+	{
+		if (options.quick && objectsCount > 1000)
+		{
+			continue;
+		}
+
+		benchmarkMovingObjects(objectsCount, stepsCount);
+	}
+
+	return 0;
+}
\ No newline at end of file
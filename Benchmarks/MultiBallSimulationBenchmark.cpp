@@ -0,0 +1,101 @@
+#include "BenchmarkHelper.h"
+#include "TestHelper.h"
+#include "MultiBallSimulation.h"
+#include <cmath>
+
+/*
+steps a MultiBallSimulation with 1k and 10k balls at 60 Hz, with random inputs, and prints the cost of a step against the
+16.67 ms of a 60 fps frame. after each step the lost balls are replaced by new ones, low in the arena and moving up, and a
+cleared level is restarted, so that the balls keep hitting the bricks: the replacements are timed with the steps.
+--quick runs 1k balls for one simulated second
+*/
+
+using namespace ArkanoidTests;
+using namespace ArkanoidBenchmarks;
+
+namespace
+{
+	constexpr float gk_deltaTime = 1.0f / 60.0f;
+	constexpr float gk_frameMilliseconds = 1000.0f / 60.0f;
+
+	struct BallsRefill
+	{
+		std::mt19937 randomEngine;
+		unsigned int addedBallsCount;
+		unsigned int restartsCount;
+	};
+
+	//tops the balls up to ballsCount, restarting the level first if it is cleared
+	void refillBalls(MultiBallSimulation& multiBall, unsigned int ballsCount, BallsRefill& refill)
+	{
+		if (multiBall.isLevelCleared())
+		{
+			multiBall.restartLevel();
+			++refill.restartsCount;
+		}
+
+		std::uniform_real_distribution<float> xDistribution{ gk_arenaMinX + gk_ballHalfWidth, gk_arenaMaxX - gk_ballHalfWidth };
+		std::uniform_real_distribution<float> yDistribution{ gk_arenaMinY + 4.0f, 0.0f };
+		std::uniform_real_distribution<float> angleDistribution{ 0.25f, 2.89f };
+
+		while (multiBall.ballsCount() < ballsCount)
+		{
+			const float angle = angleDistribution(refill.randomEngine);
+			const XMFLOAT2 position{ xDistribution(refill.randomEngine), yDistribution(refill.randomEngine) };
+			const XMFLOAT2 velocity{ gk_startBallSpeed * std::cos(angle), gk_startBallSpeed * std::sin(angle) };
+
+			multiBall.addBall(position, velocity, gk_ballHalfExtents);
+			++refill.addedBallsCount;
+		}
+	}
+
+	void benchmarkBalls(unsigned int ballsCount, unsigned int stepsCount, const BenchmarkOptions& options)
+	{
+		MultiBallSimulation multiBall{ 1, ballsCount };
+
+		BallsRefill refill{ std::mt19937{ ballsCount }, 0, 0 };
+		refillBalls(multiBall, ballsCount, refill);
+		refill.addedBallsCount = 0;
+
+		std::uniform_int_distribution<unsigned int> inputDistribution{ 0, SimulationCore::INPUT_LEFT | SimulationCore::INPUT_RIGHT };
+
+		//the repeats go on with the balls of the previous one: the game doesn't settle, the lost balls are replaced
+		const unsigned int repeatsCount = computeRepeatsCount(options, 1, 5);
+
+		const float milliseconds = measureMinMilliseconds(repeatsCount, [&]()
+		{
+			for (unsigned int stepIndex = 0; stepIndex < stepsCount; ++stepIndex)
+			{
+				multiBall.step(gk_deltaTime, inputDistribution(refill.randomEngine));
+				refillBalls(multiBall, ballsCount, refill);
+			}
+			consumeResult(multiBall.aliveBricksCount());
+		});
+
+		const float stepMilliseconds = milliseconds / stepsCount;
+		const unsigned int totalStepsCount = stepsCount * repeatsCount;
+
+		std::printf("%8u %8u %10.4f %12.1f %9.2f %12.2f %9u\n", ballsCount, stepsCount, stepMilliseconds,
+					stepMilliseconds * 1000000.0f / ballsCount, stepMilliseconds * 100.0f / gk_frameMilliseconds,
+					static_cast<float>(refill.addedBallsCount) / totalStepsCount, refill.restartsCount);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const BenchmarkOptions options = parseBenchmarkOptions(argc, argv);
+
+	std::printf("%8s %8s %10s %12s %9s %12s %9s\n", "balls", "steps", "step ms", "ns per ball", "frame %", "lost / step", "restarts");
+	std::printf("(the steps are of 1/60 s, frame %% is the step cost against a 60 fps frame)\n");
+
+	const unsigned int stepsCount = options.quick ? 60 : 600;
+
+	benchmarkBalls(1000, stepsCount, options);
+
+	if (!options.quick)
+	{
+		benchmarkBalls(10000, stepsCount, options);
+	}
+
+	return 0;
+}
\ No newline at end of file
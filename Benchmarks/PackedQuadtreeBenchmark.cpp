@@ -0,0 +1,174 @@
+#include "BenchmarkHelper.h"
+#include "CacheMissesCounter.h"
+#include "TestHelper.h"
+#include "PackedQuadtree.h"
+#include <memory>
+
+/*
+compares PackedQuadtree with the Quadtree it is built from, on bricks at the density of a level with one brick out of 7
+removed, so some quadrants are merged: the nodes tested per ball sized query, which must be the same, the cache misses
+per query when the CPU counters can be read, the time per query and the bytes owned. the results of both must be the
+same, otherwise the benchmark fails. --quick stops at 1k bricks
+*/
+
+using namespace ArkanoidTests;
+using namespace ArkanoidBenchmarks;
+
+namespace
+{
+	constexpr unsigned int gk_queriesCount = 4096;
+
+	struct QueriesMeasures
+	{
+		float visitedQuadrantsCount;
+		float cacheMissesCount;
+		float nanoseconds;
+	};
+
+	//the queries through findQuery(queryAABB, foundObjects, visitedQuadrantsCount), per query
+	template<typename FindQuery>
+	QueriesMeasures measureQueries(const std::vector<AABB>& queries, unsigned int objectsCount, CacheMissesCounter& cacheMissesCounter,
+								   const BenchmarkOptions& options, FindQuery findQuery)
+	{
+		std::vector<unsigned int> foundObjects(std::max(objectsCount, 1u));
+		const float queriesCount = static_cast<float>(queries.size());
+
+		QueriesMeasures measures{};
+
+		unsigned long long visitedQuadrantsCount = 0;
+		for (const AABB& queryAABB : queries)
+		{
+			unsigned int queryVisitedQuadrantsCount = 0;
+			findQuery(queryAABB, foundObjects.data(), queryVisitedQuadrantsCount);
+			visitedQuadrantsCount += queryVisitedQuadrantsCount;
+		}
+
+		measures.visitedQuadrantsCount = visitedQuadrantsCount / queriesCount;
+
+		auto runQueries = [&]()
+		{
+			unsigned int foundObjectsCount = 0;
+			unsigned int queryVisitedQuadrantsCount = 0;
+			for (const AABB& queryAABB : queries)
+			{
+				foundObjectsCount += findQuery(queryAABB, foundObjects.data(), queryVisitedQuadrantsCount);
+			}
+			consumeResult(foundObjectsCount);
+		};
+
+		measures.cacheMissesCount = cacheMissesCounter.measure(runQueries) / queriesCount;
+		measures.nanoseconds = measureMinMilliseconds(computeRepeatsCount(options, objectsCount), runQueries) * 1000000.0f / queriesCount;
+
+		return measures;
+	}
+
+	template<typename AnyQuadtree, typename AnyPackedQuadtree>
+	unsigned int countDifferentQueries(const AnyQuadtree& quadtree, const AnyPackedQuadtree& packedQuadtree, const std::vector<AABB>& queries)
+	{
+		const unsigned int objectsCount = quadtree.objectsCount();
+		std::vector<unsigned int> foundObjects(std::max(objectsCount, 1u));
+		std::vector<unsigned int> packedFoundObjects(std::max(objectsCount, 1u));
+
+		unsigned int differentQueriesCount = 0;
+		for (const AABB& queryAABB : queries)
+		{
+			unsigned int visitedQuadrantsCount = 0;
+			unsigned int packedVisitedQuadrantsCount = 0;
+
+			const unsigned int foundObjectsCount = quadtree.findPotentialColliders(queryAABB, foundObjects.data(), visitedQuadrantsCount);
+			const unsigned int packedFoundObjectsCount = packedQuadtree.findPotentialColliders(queryAABB, packedFoundObjects.data(),
+																							   packedVisitedQuadrantsCount);
+
+			const bool sameQuery = foundObjectsCount == packedFoundObjectsCount && visitedQuadrantsCount == packedVisitedQuadrantsCount &&
+								   std::equal(foundObjects.begin(), foundObjects.begin() + foundObjectsCount, packedFoundObjects.begin());
+
+			differentQueriesCount += sameQuery ? 0 : 1;
+		}
+
+		return differentQueriesCount;
+	}
+
+	void printCacheMisses(float cacheMissesCount, const CacheMissesCounter& cacheMissesCounter)
+	{
+		if (cacheMissesCounter.available())
+		{
+			std::printf(" %9.2f", cacheMissesCount);
+		}
+		else
+		{
+			std::printf(" %9s", "n/a");
+		}
+	}
+
+	//returns the number of queries whose results differ
+	template<unsigned int MAX_DEPTH>
+	unsigned int benchmarkDepth(unsigned int objectsCount, CacheMissesCounter& cacheMissesCounter, const BenchmarkOptions& options)
+	{
+		const ObjectsScene scene = randomScene("bricks", levelDensityArea(objectsCount), gk_bricksHalfExtents, objectsCount, objectsCount);
+
+		//the Quadtree holds its quadrants as members, so the deep ones can't be on the stack
+		std::unique_ptr<Quadtree<unsigned int, MAX_DEPTH>> quadtree{ new Quadtree<unsigned int, MAX_DEPTH>{ scene.area, scene.objectsHalfExtents, objectsCount } };
+
+		for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+		{
+			quadtree->insert(scene.objectsCenters[objectIndex], scene.objectsDatas[objectIndex]);
+		}
+
+		for (unsigned int objectIndex = 0; objectIndex < objectsCount; objectIndex += 7)
+		{
+			quadtree->remove(scene.objectsCenters[objectIndex], scene.objectsDatas[objectIndex]);
+		}
+
+		PackedQuadtree<unsigned int, MAX_DEPTH> packedQuadtree;
+		packedQuadtree.build(*quadtree);
+
+		const std::vector<AABB> queries = generateBallQueries(scene, gk_queriesCount, objectsCount);
+
+		const unsigned int differentQueriesCount = countDifferentQueries(*quadtree, packedQuadtree, queries);
+
+		const QueriesMeasures quadtreeMeasures = measureQueries(queries, objectsCount, cacheMissesCounter, options,
+																[&](const AABB& queryAABB, unsigned int* foundObjects, unsigned int& visitedQuadrantsCount)
+		{
+			return quadtree->findPotentialColliders(queryAABB, foundObjects, visitedQuadrantsCount);
+		});
+
+		const QueriesMeasures packedMeasures = measureQueries(queries, objectsCount, cacheMissesCounter, options,
+															  [&](const AABB& queryAABB, unsigned int* foundObjects, unsigned int& visitedQuadrantsCount)
+		{
+			return packedQuadtree.findPotentialColliders(queryAABB, foundObjects, visitedQuadrantsCount);
+		});
+
+		std::printf("%5u %8u %9.1f %9.1f", MAX_DEPTH, objectsCount, quadtreeMeasures.visitedQuadrantsCount, packedMeasures.visitedQuadrantsCount);
+		printCacheMisses(quadtreeMeasures.cacheMissesCount, cacheMissesCounter);
+		printCacheMisses(packedMeasures.cacheMissesCount, cacheMissesCounter);
+		std::printf(" %9.1f %9.1f %11zu %11zu %10u\n", quadtreeMeasures.nanoseconds, packedMeasures.nanoseconds,
+					quadtree->memoryUsage(), packedQuadtree.memoryUsage(), differentQueriesCount);
+
+		return differentQueriesCount;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const BenchmarkOptions options = parseBenchmarkOptions(argc, argv);
+
+	CacheMissesCounter cacheMissesCounter;
+
+	std::printf("%5s %8s %9s %9s %9s %9s %9s %9s %11s %11s %10s\n", "depth", "objects", "nodes", "packed", "misses", "packed",
+				"ns", "packed", "bytes", "packed", "different");
+	std::printf("(per ball sized query, Quadtree then PackedQuadtree%s)\n",
+				cacheMissesCounter.available() ? "" : ", the cache misses counter is not available here");
+
+	unsigned int differentQueriesCount = 0;
+
+	differentQueriesCount += benchmarkDepth<2>(gk_bricksCount, cacheMissesCounter, options);
+	differentQueriesCount += benchmarkDepth<4>(1000, cacheMissesCounter, options);
+
+	if (!options.quick)
+	{
+		differentQueriesCount += benchmarkDepth<6>(10000, cacheMissesCounter, options);
+		differentQueriesCount += benchmarkDepth<7>(100000, cacheMissesCounter, options);
+	}
+
+	return differentQueriesCount == 0 ? 0 : 1;
+}
\ No newline at end of file
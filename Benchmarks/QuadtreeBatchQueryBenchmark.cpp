@@ -0,0 +1,119 @@
+#include "BenchmarkHelper.h"
+#include "TestHelper.h"
+#include "QuadtreeBatchQuery.h"
+#include <memory>
+#include <thread>
+
+/*
+times QuadtreeBatchQuery over 1 to 8 threads against the queries answered one after another, with ball sized queries on
+bricks at the density of a level, the queries in the given order and sorted. the memory of the batch query is the one of
+the objects found, whatever the quadtree size: it is printed next to the objects found. the ranges of every batch must hold
+the objects findPotentialColliders() finds, otherwise the benchmark fails. --quick runs the smallest batch on 1 and 2 threads
+*/
+
+using namespace ArkanoidTests;
+using namespace ArkanoidBenchmarks;
+
+namespace
+{
+	using BenchmarkQuadtree = Quadtree<unsigned int, 6>;
+
+	//returns the number of queries whose range differs from the objects found by findPotentialColliders()
+	unsigned int countDifferentRanges(const BenchmarkQuadtree& quadtree, const std::vector<AABB>& queries,
+									  const std::vector<QuadtreeFoundObjects<>>& foundObjectsRanges)
+	{
+		std::vector<unsigned int> foundObjects(std::max(quadtree.objectsCount(), 1u));
+
+		unsigned int differentRangesCount = 0;
+		for (size_t queryIndex = 0; queryIndex < queries.size(); ++queryIndex)
+		{
+			const unsigned int foundObjectsCount = quadtree.findPotentialColliders(queries[queryIndex], foundObjects.data());
+			const QuadtreeFoundObjects<>& foundObjectsRange = foundObjectsRanges[queryIndex];
+
+			const bool sameRange = foundObjectsRange.objectsCount == foundObjectsCount &&
+								   std::equal(foundObjects.begin(), foundObjects.begin() + foundObjectsCount, foundObjectsRange.objects);
+
+			differentRangesCount += sameRange ? 0 : 1;
+		}
+
+		return differentRangesCount;
+	}
+
+	//returns the number of queries whose range differs
+	unsigned int benchmarkBatch(unsigned int objectsCount, unsigned int queriesCount, const std::vector<unsigned int>& threadsCounts,
+								const BenchmarkOptions& options)
+	{
+		const ObjectsScene scene = randomScene("bricks", levelDensityArea(objectsCount), gk_bricksHalfExtents, objectsCount, objectsCount);
+		const std::vector<AABB> queries = generateBallQueries(scene, queriesCount, objectsCount);
+
+		//the Quadtree holds its quadrants as members, so the deep ones can't be on the stack
+		std::unique_ptr<BenchmarkQuadtree> quadtree{ new BenchmarkQuadtree{ scene.area, scene.objectsHalfExtents, objectsCount } };
+		quadtree->buildBulk(scene.area, scene.objectsCenters.data(), scene.objectsDatas.data(), objectsCount);
+
+		const unsigned int repeatsCount = computeRepeatsCount(options, queriesCount / 16);
+
+		std::vector<unsigned int> foundObjects(std::max(objectsCount, 1u));
+		unsigned int foundObjectsCount = 0;
+
+		const float sequentialMilliseconds = measureMinMilliseconds(repeatsCount, [&]()
+		{
+			foundObjectsCount = 0;
+			for (const AABB& queryAABB : queries)
+			{
+				foundObjectsCount += quadtree->findPotentialColliders(queryAABB, foundObjects.data());
+			}
+			consumeResult(foundObjectsCount);
+		});
+
+		std::printf("%8u %8u %10u %8s %12.2f %9s %9s %12s\n", objectsCount, queriesCount, foundObjectsCount, "loop",
+					sequentialMilliseconds, "1.00", "1.00", "-");
+
+		std::vector<QuadtreeFoundObjects<>> foundObjectsRanges(queriesCount);
+		unsigned int differentRangesCount = 0;
+
+		for (unsigned int threadsCount : threadsCounts)
+		{
+			QuadtreeBatchQuery<> batchQuery{ threadsCount };
+
+			float perOrderMilliseconds[2];
+			for (unsigned int sortQueries = 0; sortQueries < 2; ++sortQueries)
+			{
+				perOrderMilliseconds[sortQueries] = measureMinMilliseconds(repeatsCount, [&]()
+				{
+					consumeResult(batchQuery.queryBatch(*quadtree, queries.data(), queriesCount, foundObjectsRanges.data(), sortQueries != 0));
+				});
+
+				differentRangesCount += countDifferentRanges(*quadtree, queries, foundObjectsRanges);
+			}
+
+			char threadsName[16];
+			std::snprintf(threadsName, sizeof(threadsName), "%u", threadsCount);
+
+			std::printf("%8u %8u %10u %8s %12.2f %9.2f %9.2f %12zu\n", objectsCount, queriesCount, foundObjectsCount, threadsName,
+						perOrderMilliseconds[0], sequentialMilliseconds / perOrderMilliseconds[0], sequentialMilliseconds / perOrderMilliseconds[1],
+						batchQuery.memoryUsage());
+		}
+
+		return differentRangesCount;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const BenchmarkOptions options = parseBenchmarkOptions(argc, argv);
+
+	std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+	std::printf("%8s %8s %10s %8s %12s %9s %9s %12s\n", "objects", "queries", "found", "threads", "batch ms", "speedup", "sorted", "batch bytes");
+	std::printf("(the speedups are against the loop, in the given order and with the queries sorted)\n");
+
+	const std::vector<unsigned int> threadsCounts = options.quick ? std::vector<unsigned int>{ 1, 2 } : std::vector<unsigned int>{ 1, 2, 4, 8 };
+
+	unsigned int differentRangesCount = benchmarkBatch(1000, 16384, threadsCounts, options);
+
+	if (!options.quick)
+	{
+		differentRangesCount += benchmarkBatch(10000, 65536, threadsCounts, options);
+	}
+
+	return differentRangesCount == 0 ? 0 : 1;
+}
\ No newline at end of file
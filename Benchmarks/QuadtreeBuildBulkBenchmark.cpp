@@ -0,0 +1,79 @@
+#include "BenchmarkHelper.h"
+#include "TestHelper.h"
+#include "SimulationCore.h"
+#include <memory>
+
+/*
+times Quadtree::buildBulk() against build() and the insertion of the objects one after another, from 120 bricks as a level
+to 1M bricks at the same density, with the depth of the game and a deeper quadtree for the big counts: buildBulk() is linear
+in the objects count, so its time per object stays flat. --quick stops at 1k bricks
+*/
+
+using namespace ArkanoidTests;
+using namespace ArkanoidBenchmarks;
+
+namespace
+{
+	template<typename AnyQuadtree>
+	void benchmarkBuilds(const char* quadtreeName, const ObjectsScene& scene, const BenchmarkOptions& options)
+	{
+		const unsigned int objectsCount = static_cast<unsigned int>(scene.objectsCenters.size());
+		const unsigned int repeatsCount = computeRepeatsCount(options, objectsCount);
+
+		//the Quadtree holds its quadrants as members, so the deep ones can't be on the stack
+		std::unique_ptr<AnyQuadtree> quadtree{ new AnyQuadtree{ scene.area, scene.objectsHalfExtents, objectsCount } };
+
+		const float insertMilliseconds = measureMinMilliseconds(repeatsCount, [&]()
+		{
+			quadtree->clear();
+
+			for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+			{
+				quadtree->insert(scene.objectsCenters[objectIndex], scene.objectsDatas[objectIndex]);
+			}
+		});
+
+		const float buildMilliseconds = measureMinMilliseconds(repeatsCount, [&]()
+		{
+			quadtree->build(scene.area, scene.objectsCenters.data(), scene.objectsDatas.data(), objectsCount);
+		});
+
+		const float buildBulkMilliseconds = measureMinMilliseconds(repeatsCount, [&]()
+		{
+			quadtree->buildBulk(scene.area, scene.objectsCenters.data(), scene.objectsDatas.data(), objectsCount);
+		});
+
+		const float nanosecondsPerObject = 1000000.0f / objectsCount;
+
+		std::printf("%-18s %8u %12.1f %12.1f %12.1f %10.1f %10.1f %10.1f\n", quadtreeName, objectsCount,
+					insertMilliseconds * 1000.0f, buildMilliseconds * 1000.0f, buildBulkMilliseconds * 1000.0f,
+					insertMilliseconds * nanosecondsPerObject, buildMilliseconds * nanosecondsPerObject,
+					buildBulkMilliseconds * nanosecondsPerObject);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const BenchmarkOptions options = parseBenchmarkOptions(argc, argv);
+
+	std::printf("%-18s %8s %12s %12s %12s %10s %10s %10s\n", "quadtree", "objects", "insert us", "build us", "bulk us",
+				"insert ns", "build ns", "bulk ns");
+	std::printf("(whole rebuild, then per object)\n");
+
+	const unsigned int objectsCounts[] = { gk_bricksCount, 1000, 10000, 100000, 1000000 };
+
+	for (unsigned int objectsCount : objectsCounts)
+	{
+		if (options.quick && objectsCount > 1000)
+		{
+			continue;
+		}
+
+		const ObjectsScene scene = randomScene("bricks", levelDensityArea(objectsCount), gk_bricksHalfExtents, objectsCount, objectsCount);
+
+		benchmarkBuilds<SimulationCore::Quadtree>("Quadtree (game)", scene, options);
+		benchmarkBuilds<Quadtree<unsigned int, 8>>("Quadtree depth 8", scene, options);
+	}
+
+	return 0;
+}
\ No newline at end of file
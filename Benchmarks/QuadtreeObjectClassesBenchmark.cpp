@@ -0,0 +1,226 @@
+#include "BenchmarkHelper.h"
+#include "TestHelper.h"
+#include "SimulationCore.h"
+#include <memory>
+
+/*
+the collisions of a frame of the game, the ball against the bricks and the player, the bonus against the player, checked
+two ways: the bricks in a quadtree with the player and the bonus tested apart, as SimulationCore does, or all of them in one
+quadtree, the player and the bonus with their own object classes and updated each frame. both ways must find the same hits,
+otherwise the benchmark fails. --quick runs fewer frames
+*/
+
+using namespace ArkanoidTests;
+using namespace ArkanoidBenchmarks;
+
+namespace
+{
+	constexpr unsigned int gk_playerObjectClass = 1;
+	constexpr unsigned int gk_bonusObjectClass = 2;
+
+	constexpr unsigned int gk_playerData = gk_bricksCount;
+	constexpr unsigned int gk_bonusData = gk_bricksCount + 1;
+
+	//the positions of the moving entities, one frame at 60 Hz after the other
+	struct Frame
+	{
+		XMFLOAT2 ballCenter;
+		XMFLOAT2 playerCenter;
+		XMFLOAT2 bonusCenter;
+	};
+
+	std::vector<Frame> generateFrames(const ObjectsScene& bricksScene, unsigned int framesCount)
+	{
+		const float frameTime = 1.0f / 60.0f;
+		const float playerY = gk_arenaMinY + 2.0f;
+
+		Frame frame{ XMFLOAT2{ 0.0f, playerY + 3.0f }, XMFLOAT2{ 0.0f, playerY }, bricksScene.objectsCenters.front() };
+
+		const float startBallVelocityLength = std::sqrt(gk_startBallVelocityX * gk_startBallVelocityX + gk_startBallVelocityY * gk_startBallVelocityY);
+		XMFLOAT2 ballVelocity{ gk_startBallVelocityX * gk_startBallSpeed * frameTime / startBallVelocityLength,
+							   gk_startBallVelocityY * gk_startBallSpeed * frameTime / startBallVelocityLength };
+		float playerVelocityX = gk_playerSpeed * frameTime;
+
+		std::vector<Frame> frames;
+
+		for (unsigned int frameIndex = 0; frameIndex < framesCount; ++frameIndex)
+		{
+			//the ball bounces on the arena, the player goes from side to side
+			frame.ballCenter = frame.ballCenter + ballVelocity;
+			if (std::abs(frame.ballCenter.x) + gk_ballHalfWidth > gk_arenaMaxX)
+			{
+				ballVelocity.x = -ballVelocity.x;
+			}
+			if (frame.ballCenter.y + gk_ballHalfHeight > gk_arenaMaxY || frame.ballCenter.y - gk_ballHalfHeight < playerY)
+			{
+				ballVelocity.y = -ballVelocity.y;
+			}
+
+			frame.playerCenter.x += playerVelocityX;
+			if (std::abs(frame.playerCenter.x) + gk_playerHalfWidth > gk_arenaMaxX)
+			{
+				playerVelocityX = -playerVelocityX;
+			}
+
+			//the bonus falls from the bricks one after another
+			frame.bonusCenter.y -= gk_bonusSpeedY * frameTime;
+			if (frame.bonusCenter.y < gk_destroyBonusY)
+			{
+				frame.bonusCenter = bricksScene.objectsCenters[frameIndex % bricksScene.objectsCenters.size()];
+			}
+
+			frames.push_back(frame);
+		}
+
+		return frames;
+	}
+
+	bool intersects(const XMFLOAT2& center, const XMFLOAT2& halfExtents, const XMFLOAT2& otherCenter, const XMFLOAT2& otherHalfExtents)
+	{
+		return AABB::computeFromCenterAndHalfExtents(center, halfExtents).intersects(AABB::computeFromCenterAndHalfExtents(otherCenter, otherHalfExtents));
+	}
+
+	//the hits of all the frames, bricks and player by the ball, then player by the bonus
+	template<typename AnyQuadtree>
+	unsigned int checkSeparateCollisions(const AnyQuadtree& bricksQuadtree, const ObjectsScene& bricksScene, const std::vector<Frame>& frames,
+										 unsigned int* foundObjects)
+	{
+		unsigned int hitsCount = 0;
+
+		for (const Frame& frame : frames)
+		{
+			const unsigned int foundObjectsCount = bricksQuadtree.findPotentialColliders(
+				AABB::computeFromCenterAndHalfExtents(frame.ballCenter, gk_ballHalfExtents), foundObjects);
+
+			for (unsigned int foundIndex = 0; foundIndex < foundObjectsCount; ++foundIndex)
+			{
+				const XMFLOAT2& brickCenter = bricksScene.objectsCenters[foundObjects[foundIndex]];
+				hitsCount += intersects(frame.ballCenter, gk_ballHalfExtents, brickCenter, gk_bricksHalfExtents) ? 1 : 0;
+			}
+
+			hitsCount += intersects(frame.ballCenter, gk_ballHalfExtents, frame.playerCenter, gk_playerHalfExtents) ? 1 : 0;
+			hitsCount += intersects(frame.bonusCenter, gk_bonusHalfExtents, frame.playerCenter, gk_playerHalfExtents) ? 1 : 0;
+		}
+
+		return hitsCount;
+	}
+
+	//as above, the player and the bonus are moved in the quadtree holding the bricks
+	template<typename AnyQuadtree>
+	unsigned int checkUnifiedCollisions(AnyQuadtree& quadtree, const ObjectsScene& bricksScene, const std::vector<Frame>& frames,
+										unsigned int* foundObjects)
+	{
+		unsigned int hitsCount = 0;
+
+		XMFLOAT2 playerCenter = frames.front().playerCenter;
+		XMFLOAT2 bonusCenter = frames.front().bonusCenter;
+
+		quadtree.insert(playerCenter, gk_playerData, gk_playerObjectClass);
+		quadtree.insert(bonusCenter, gk_bonusData, gk_bonusObjectClass);
+
+		for (const Frame& frame : frames)
+		{
+			quadtree.update(playerCenter, frame.playerCenter, gk_playerData, gk_playerObjectClass);
+			quadtree.update(bonusCenter, frame.bonusCenter, gk_bonusData, gk_bonusObjectClass);
+			playerCenter = frame.playerCenter;
+			bonusCenter = frame.bonusCenter;
+
+			const unsigned int foundObjectsCount = quadtree.findPotentialColliders(
+				AABB::computeFromCenterAndHalfExtents(frame.ballCenter, gk_ballHalfExtents), foundObjects);
+
+			for (unsigned int foundIndex = 0; foundIndex < foundObjectsCount; ++foundIndex)
+			{
+				const unsigned int objectData = foundObjects[foundIndex];
+
+				if (objectData == gk_playerData)
+				{
+					hitsCount += intersects(frame.ballCenter, gk_ballHalfExtents, playerCenter, gk_playerHalfExtents) ? 1 : 0;
+				}
+				else if (objectData != gk_bonusData)
+				{
+					const XMFLOAT2& brickCenter = bricksScene.objectsCenters[objectData];
+					hitsCount += intersects(frame.ballCenter, gk_ballHalfExtents, brickCenter, gk_bricksHalfExtents) ? 1 : 0;
+				}
+			}
+
+			const unsigned int foundByBonusCount = quadtree.findPotentialColliders(
+				AABB::computeFromCenterAndHalfExtents(bonusCenter, gk_bonusHalfExtents), foundObjects);
+
+			for (unsigned int foundIndex = 0; foundIndex < foundByBonusCount; ++foundIndex)
+			{
+				if (foundObjects[foundIndex] == gk_playerData)
+				{
+					hitsCount += intersects(bonusCenter, gk_bonusHalfExtents, playerCenter, gk_playerHalfExtents) ? 1 : 0;
+				}
+			}
+		}
+
+		quadtree.remove(playerCenter, gk_playerData, gk_playerObjectClass);
+		quadtree.remove(bonusCenter, gk_bonusData, gk_bonusObjectClass);
+
+		return hitsCount;
+	}
+
+	//returns true if both ways found the same hits
+	template<typename AnyQuadtree>
+	bool benchmarkObjectClasses(const char* quadtreeName, const ObjectsScene& bricksScene, const std::vector<Frame>& frames,
+								const BenchmarkOptions& options)
+	{
+		const unsigned int bricksCount = static_cast<unsigned int>(bricksScene.objectsCenters.size());
+		const unsigned int repeatsCount = computeRepeatsCount(options, static_cast<unsigned int>(frames.size()));
+
+		std::unique_ptr<AnyQuadtree> bricksQuadtree{ new AnyQuadtree{ bricksScene.area, gk_bricksHalfExtents, bricksCount } };
+		bricksQuadtree->build(bricksScene.area, bricksScene.objectsCenters.data(), bricksScene.objectsDatas.data(), bricksCount);
+
+		std::unique_ptr<AnyQuadtree> unifiedQuadtree{ new AnyQuadtree{ bricksScene.area, gk_bricksHalfExtents, bricksCount + 2 } };
+		unifiedQuadtree->setObjectClassHalfExtents(gk_playerObjectClass, gk_playerHalfExtents);
+		unifiedQuadtree->setObjectClassHalfExtents(gk_bonusObjectClass, gk_bonusHalfExtents);
+		unifiedQuadtree->build(bricksScene.area, bricksScene.objectsCenters.data(), bricksScene.objectsDatas.data(), bricksCount);
+
+		std::vector<unsigned int> foundObjects(bricksCount + 2);
+
+		unsigned int separateHitsCount = 0;
+		const float separateMilliseconds = measureMinMilliseconds(repeatsCount, [&]()
+		{
+			separateHitsCount = checkSeparateCollisions(*bricksQuadtree, bricksScene, frames, foundObjects.data());
+		});
+
+		unsigned int unifiedHitsCount = 0;
+		const float unifiedMilliseconds = measureMinMilliseconds(repeatsCount, [&]()
+		{
+			unifiedHitsCount = checkUnifiedCollisions(*unifiedQuadtree, bricksScene, frames, foundObjects.data());
+		});
+
+		consumeResult(separateHitsCount + unifiedHitsCount);
+
+		const float nanosecondsPerFrame = 1000000.0f / frames.size();
+
+		std::printf("%-16s %-18s %7u %12.1f %12.1f %8u %8u\n", bricksScene.name.c_str(), quadtreeName, bricksCount,
+					separateMilliseconds * nanosecondsPerFrame, unifiedMilliseconds * nanosecondsPerFrame, separateHitsCount, unifiedHitsCount);
+
+		return separateHitsCount == unifiedHitsCount;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const BenchmarkOptions options = parseBenchmarkOptions(argc, argv);
+
+	std::printf("%-16s %-18s %7s %12s %12s %8s %8s\n", "layout", "quadtree", "bricks", "separate ns", "unified ns", "hits", "unified");
+	std::printf("(per frame: the ball against the bricks and the player, the bonus against the player)\n");
+
+	const unsigned int framesCount = options.quick ? 600 : 6000;
+
+	bool sameHits = true;
+
+	for (unsigned int layoutIndex = 0; layoutIndex < gk_bricksLayoutsCount; ++layoutIndex)
+	{
+		const ObjectsScene bricksScene = bricksLayoutScene(layoutIndex);
+		const std::vector<Frame> frames = generateFrames(bricksScene, framesCount);
+
+		sameHits &= benchmarkObjectClasses<Quadtree<unsigned int, 2>>("Quadtree depth 2", bricksScene, frames, options);
+		sameHits &= benchmarkObjectClasses<SimulationCore::Quadtree>("Quadtree (game)", bricksScene, frames, options);
+	}
+
+	return sameHits ? 0 : 1;
+}
\ No newline at end of file
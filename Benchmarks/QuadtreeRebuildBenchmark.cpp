@@ -0,0 +1,137 @@
+#include "BenchmarkHelper.h"
+#include "TestHelper.h"
+#include "SimulationCore.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/*
+times the rebuilds of the bricks Quadtree of each level layout, build(), buildBulk() and clear() followed by the insertion
+of every brick, and the restartLevel() of SimulationCore, counting the heap allocations each one makes: the global
+operator new of this executable counts them. the Quadtree must not allocate after its construction, so the benchmark
+fails when one of its rebuilds does
+*/
+
+static std::atomic<unsigned long long> gs_allocationsCount{ 0 };
+
+void* operator new(std::size_t size)
+{
+	++gs_allocationsCount;
+
+	if (void* memory = std::malloc(size != 0 ? size : 1))
+	{
+		return memory;
+	}
+
+	throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+using namespace ArkanoidTests;
+using namespace ArkanoidBenchmarks;
+
+namespace
+{
+	constexpr unsigned int gk_rebuildsCount = 1000;
+
+	//the time of one call of function, the fastest of the repeats, and the allocations per call
+	template<typename Function>
+	unsigned long long measureRebuild(const char* rebuildName, const char* layoutName, const BenchmarkOptions& options, Function&& function)
+	{
+		const unsigned int rebuildsCount = options.quick ? 10 : gk_rebuildsCount;
+
+		const unsigned long long firstAllocationsCount = gs_allocationsCount;
+		const float milliseconds = measureMinMilliseconds(computeRepeatsCount(options, gk_bricksCount), [&]()
+		{
+			for (unsigned int rebuildIndex = 0; rebuildIndex < rebuildsCount; ++rebuildIndex)
+			{
+				function();
+			}
+		});
+		const unsigned long long allocationsCount = gs_allocationsCount - firstAllocationsCount;
+
+		const unsigned int callsCount = rebuildsCount * computeRepeatsCount(options, gk_bricksCount);
+
+		std::printf("%-26s %-16s %12.2f %14.2f\n", rebuildName, layoutName, milliseconds * 1000.0f / rebuildsCount,
+					static_cast<double>(allocationsCount) / callsCount);
+
+		return allocationsCount;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const BenchmarkOptions options = parseBenchmarkOptions(argc, argv);
+
+	std::printf("%-26s %-16s %12s %14s\n", "rebuild", "layout", "us", "allocations");
+
+	unsigned long long quadtreeAllocationsCount = 0;
+
+	for (unsigned int layoutIndex = 0; layoutIndex < gk_bricksLayoutsCount; ++layoutIndex)
+	{
+		const ObjectsScene scene = bricksLayoutScene(layoutIndex);
+		const unsigned int bricksCount = static_cast<unsigned int>(scene.objectsCenters.size());
+
+		SimulationCore::Quadtree quadtree{ scene.area, scene.objectsHalfExtents, gk_bricksCount };
+
+		quadtreeAllocationsCount += measureRebuild("Quadtree::build", scene.name.c_str(), options, [&]()
+		{
+			quadtree.build(scene.area, scene.objectsCenters.data(), scene.objectsDatas.data(), bricksCount);
+		});
+
+		quadtreeAllocationsCount += measureRebuild("Quadtree::buildBulk", scene.name.c_str(), options, [&]()
+		{
+			quadtree.buildBulk(scene.area, scene.objectsCenters.data(), scene.objectsDatas.data(), bricksCount);
+		});
+
+		quadtreeAllocationsCount += measureRebuild("Quadtree::clear + insert", scene.name.c_str(), options, [&]()
+		{
+			quadtree.clear();
+
+			for (unsigned int brickIndex = 0; brickIndex < bricksCount; ++brickIndex)
+			{
+				quadtree.insert(scene.objectsCenters[brickIndex], scene.objectsDatas[brickIndex]);
+			}
+		});
+	}
+
+	//the whole level: the layout picked by the random engine, the bricks types and their broadphase
+	SimulationCore simulation{ 1 };
+
+	measureRebuild("SimulationCore::restartLevel", "random", options, [&simulation]()
+	{
+		simulation.restartLevel();
+	});
+
+	if (quadtreeAllocationsCount > 0)
+	{
+		std::printf("the Quadtree rebuilds allocated %llu times\n", quadtreeAllocationsCount);
+		return 1;
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "BenchmarkHelper.h"
+#include "TestHelper.h"
+#include "SimdBroadphase.h"
+#include "SimulationCore.h"
+
+/*
+times the ball sized queries of SimdBroadphase with each instruction set of the CPU against Quadtree::findPotentialColliders(),
+on 120 bricks as a level, 1k and 100k bricks at the same density. --quick skips the 100k bricks
+*/
+
+using namespace ArkanoidTests;
+using namespace ArkanoidBenchmarks;
+
+namespace
+{
+	constexpr unsigned int gk_queriesCount = 4096;
+
+	template<typename Broadphase>
+	void benchmarkQueries(const char* broadphaseName, const Broadphase& broadphase, const ObjectsScene& scene,
+						  const std::vector<AABB>& queries, const BenchmarkOptions& options)
+	{
+		const unsigned int objectsCount = static_cast<unsigned int>(scene.objectsCenters.size());
+
+		std::vector<unsigned int> foundObjects(std::max(objectsCount, 1u));
+		unsigned int foundObjectsCount = 0;
+
+		const float queriesMilliseconds = measureMinMilliseconds(computeRepeatsCount(options, objectsCount), [&]()
+		{
+			foundObjectsCount = 0;
+			for (const AABB& queryAABB : queries)
+			{
+				foundObjectsCount += broadphase.findPotentialColliders(queryAABB, foundObjects.data());
+			}
+			consumeResult(foundObjectsCount);
+		});
+
+		const float queriesCount = static_cast<float>(queries.size());
+
+		std::printf("%-22s %8u %12.1f %8.2f\n", broadphaseName, objectsCount, queriesMilliseconds * 1000000.0f / queriesCount,
+					foundObjectsCount / queriesCount);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const BenchmarkOptions options = parseBenchmarkOptions(argc, argv);
+
+	static const char* const simdLevelsNames[] = { "SimdBroadphase scalar", "SimdBroadphase SSE2", "SimdBroadphase AVX" };
+	const ESimdLevel cpuSimdLevel = findTouchingBoxesSimdLevel();
+
+	std::printf("widest instruction set of the CPU: %s\n", simdLevelsNames[cpuSimdLevel]);
+	std::printf("%-22s %8s %12s %8s\n", "broadphase", "bricks", "query ns", "found");
+
+	const unsigned int bricksCounts[] = { gk_bricksCount, 1000, 100000 };
+
+	for (unsigned int bricksCount : bricksCounts)
+	{
+		if (options.quick && bricksCount > 1000)
+		{
+			continue;
+		}
+
+		const ObjectsScene scene = randomScene("bricks", levelDensityArea(bricksCount), gk_bricksHalfExtents, bricksCount, bricksCount);
+
+		const std::vector<AABB> queries = generateBallQueries(scene, gk_queriesCount, bricksCount);
+
+		SimulationCore::Quadtree quadtree{ scene.area, scene.objectsHalfExtents, bricksCount };
+		quadtree.build(scene.area, scene.objectsCenters.data(), scene.objectsDatas.data(), bricksCount);
+		benchmarkQueries("Quadtree (game)", quadtree, scene, queries, options);
+
+		SimdBroadphase simdBroadphase{ scene.area, scene.objectsHalfExtents, bricksCount };
+		simdBroadphase.build(scene.area, scene.objectsCenters.data(), scene.objectsDatas.data(), bricksCount);
+
+		for (unsigned int simdLevel = SIMD_LEVEL_SCALAR; simdLevel <= cpuSimdLevel; ++simdLevel)
+		{
+			setFindTouchingBoxesMaxSimdLevel(static_cast<ESimdLevel>(simdLevel));
+			benchmarkQueries(simdLevelsNames[simdLevel], simdBroadphase, scene, queries, options);
+		}
+
+		setFindTouchingBoxesMaxSimdLevel(cpuSimdLevel);
+	}
+
+	return 0;
+}
\ No newline at end of file
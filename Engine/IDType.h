@@ -1,5 +1,7 @@
 #pragma once
+#include <cstddef>
 #include <limits>
+#include <functional>
 namespace ArkanoidEngine
 {
 	class IDType
@@ -1,5 +1,6 @@
 #pragma once
-#ifdef _DEBUG
+//the CRT debug heap, which reports the leaks, is MSVC only
+#if defined(_DEBUG) && defined(_MSC_VER)
 #define _CRTDBG_MAP_ALLOC
 #include <stdlib.h>
 #include <crtdbg.h>
@@ -0,0 +1,343 @@
+#include "NullRenderer.h"
+#include <cassert>
+#include <cstring>
+#include <cstdint>
+#include "../Mesh.h"
+#include "../Image.h"
+#include "../PipelineStateData.h"
+
+using namespace ArkanoidEngine;
+using namespace ArkanoidEngine::Null;
+
+static IDType::NativeIDType g_nextID = 0;
+
+static IDType generateResourceID()
+{
+	return IDType{ g_nextID++ };
+}
+
+static unsigned int vertexStride(EVertexType vertexType)
+{
+	switch (vertexType)
+	{
+	case EVertexType::POSITION:
+		return sizeof(VertexPos);
+	case EVertexType::POSITION_NORMAL:
+		return sizeof(VertexPosNorm);
+	case EVertexType::POSITION_TEXTCOORD:
+		return sizeof(VertexPosTextCoord);
+	case EVertexType::POSITION_NORMAL_TEXTCOORD:
+		return sizeof(VertexPosNormTextCoord);
+	default:
+		assert(false);
+		return 0;
+	}
+}
+
+static unsigned int adjustConstantBufferSize(unsigned int requiredSize)
+{
+	//keep the same size constraint of D3D11: a multiple of 16
+	constexpr unsigned int mask = (16 - 1);
+	return (requiredSize + mask) & ~mask;
+}
+
+static void onResourceCreated(ResourceCounters& resourceCounters, unsigned long long bytes)
+{
+	++resourceCounters.createdCount;
+	resourceCounters.allocatedBytes += bytes;
+}
+
+static void onResourceDestroyed(ResourceCounters& resourceCounters, unsigned long long bytes)
+{
+	assert(resourceCounters.allocatedBytes >= bytes);
+	++resourceCounters.destroyedCount;
+	resourceCounters.allocatedBytes -= bytes;
+}
+
+#ifdef _WIN32
+Renderer::Renderer(HWND, UINT windowWidth, UINT windowHeight) : Renderer{ windowWidth, windowHeight }
+{
+}
+
+void Renderer::onResize(HWND, UINT windowWidth, UINT windowHeight)
+{
+	onResize(windowWidth, windowHeight);
+}
+#endif
+
+Renderer::Renderer(unsigned int windowWidth, unsigned int windowHeight)
+	: m_width{ windowWidth }, m_height{ windowHeight }
+{
+}
+
+Renderer::~Renderer()
+{
+	assert(m_vertexShaders.size() == 0 && "Exist Vertex Shaders not destroyed");
+	assert(m_pixelShaders.size() == 0 && "Exist Pixel Shaders not destroyed");
+	assert(m_constantBuffers.size() == 0 && "Exist Constant Buffers not destroyed");
+	assert(m_textures.size() == 0 && "Exist Texture2Ds not destroyed");
+	assert(m_meshes.size() == 0 && "Exist Meshes not destroyed");
+	assert(m_pipelineStates.size() == 0 && "Exist PipelineStates not destroyed");
+	assert(m_pipelineStateDatas.size() == 0 && "Exist PipelineStateDatas not destroyed");
+}
+
+void Renderer::onResize(unsigned int windowWidth, unsigned int windowHeight)
+{
+	m_width = windowWidth;
+	m_height = windowHeight;
+}
+
+void Renderer::beginFrame()const
+{
+	//DO NOTHING
+}
+
+void Renderer::endFrame()const
+{
+	++m_counters.framesCount;
+}
+
+void Renderer::resetCallCounters()
+{
+	m_counters.framesCount = 0;
+	m_counters.drawCallsCount = 0;
+	m_counters.drawnInstancesCount = 0;
+	m_counters.drawnIndicesCount = 0;
+	m_counters.constantBufferUpdatesCount = 0;
+	m_counters.constantBufferUploadedBytes = 0;
+	m_counters.pipelineStateBindsCount = 0;
+	m_counters.pipelineStateDataBindsCount = 0;
+}
+
+IDType Renderer::createMesh(const Mesh& mesh, EVertexType vertexType)
+{
+	NullMesh nullMesh{};
+	nullMesh.verticesCount = static_cast<unsigned int>(mesh.vertexCount());
+	nullMesh.vertexStride = vertexStride(vertexType);
+	nullMesh.indicesCount = static_cast<unsigned int>(mesh.indexCount());
+	nullMesh.indexSize = nullMesh.verticesCount > UINT16_MAX ? sizeof(uint32_t) : sizeof(uint16_t);
+
+	const unsigned long long meshBytes = static_cast<unsigned long long>(nullMesh.verticesCount) * nullMesh.vertexStride +
+										 static_cast<unsigned long long>(nullMesh.indicesCount) * nullMesh.indexSize;
+
+	IDType meshID = generateResourceID();
+
+	m_meshes.emplace(meshID, nullMesh);
+	onResourceCreated(m_counters.meshes, meshBytes);
+
+	return meshID;
+}
+
+void Renderer::destroyMesh(IDType meshID)
+{
+	assert(meshID.isValid());
+
+	auto meshIt = findAndCheckResource(m_meshes, meshID);
+
+	const NullMesh& nullMesh = meshIt->second;
+	const unsigned long long meshBytes = static_cast<unsigned long long>(nullMesh.verticesCount) * nullMesh.vertexStride +
+										 static_cast<unsigned long long>(nullMesh.indicesCount) * nullMesh.indexSize;
+
+	onResourceDestroyed(m_counters.meshes, meshBytes);
+	m_meshes.erase(meshIt);
+}
+
+void Renderer::renderMesh(IDType meshID)const
+{
+	renderMeshInstanced(meshID, 1);
+}
+
+void Renderer::renderMeshInstanced(IDType meshID, unsigned int instancesCount)const
+{
+	assert(meshID.isValid());
+	auto meshIt = findAndCheckResource(m_meshes, meshID);
+
+	++m_counters.drawCallsCount;
+	m_counters.drawnInstancesCount += instancesCount;
+	m_counters.drawnIndicesCount += static_cast<unsigned long long>(meshIt->second.indicesCount) * instancesCount;
+}
+
+IDType Renderer::createShader(ResourceCounters& shaderCounters)
+{
+	onResourceCreated(shaderCounters, 0);
+	return generateResourceID();
+}
+
+IDType Renderer::createVertexShaderFromSourceFile(const std::string& shaderSourceFileName, EVertexType vertexType,
+												  const ShaderCompilationConfig*)
+{
+	assert(!shaderSourceFileName.empty());
+
+	IDType vertexShaderID = createShader(m_counters.shaders);
+	m_vertexShaders.emplace(vertexShaderID, vertexType);
+
+	return vertexShaderID;
+}
+
+IDType Renderer::createPixelShaderFromSourceFile(const std::string& shaderSourceFileName, const ShaderCompilationConfig*)
+{
+	assert(!shaderSourceFileName.empty());
+
+	IDType pixelShaderID = createShader(m_counters.shaders);
+	m_pixelShaders.emplace(pixelShaderID, true);
+
+	return pixelShaderID;
+}
+
+void Renderer::destroyShader(IDType shaderID)
+{
+	assert(shaderID.isValid());
+
+	if (m_vertexShaders.erase(shaderID) == 0)
+	{
+		removeResourceMapElement(m_pixelShaders, shaderID);
+	}
+
+	onResourceDestroyed(m_counters.shaders, 0);
+}
+
+IDType Renderer::createPipelineState(const PipelineState& pipelineState)
+{
+	assert(pipelineState.vertexShaderID().isValid());
+	assert(pipelineState.pixelShaderID().isValid());
+
+	findAndCheckResource(m_vertexShaders, pipelineState.vertexShaderID());
+	findAndCheckResource(m_pixelShaders, pipelineState.pixelShaderID());
+
+	auto checkConstantBuffers = [this](const std::vector<IDType>& constantBuffersIDs)
+	{
+		for (auto constantBufferID : constantBuffersIDs)
+		{
+			assert(constantBufferID.isValid());
+			findAndCheckResource(m_constantBuffers, constantBufferID);
+		}
+	};
+
+	checkConstantBuffers(pipelineState.vertexShaderStageConstantBuffers());
+	checkConstantBuffers(pipelineState.pixelShaderStageConstantBuffers());
+
+	IDType pipelineStateID = generateResourceID();
+
+	m_pipelineStates.emplace(pipelineStateID, pipelineState);
+	onResourceCreated(m_counters.pipelineStates, 0);
+
+	return pipelineStateID;
+}
+
+void Renderer::destroyPipelineState(IDType pipelineStateID)
+{
+	assert(pipelineStateID.isValid());
+	removeResourceMapElement(m_pipelineStates, pipelineStateID);
+	onResourceDestroyed(m_counters.pipelineStates, 0);
+}
+
+void Renderer::setPipelineState(IDType pipelineStateID)
+{
+	assert(pipelineStateID.isValid());
+	findAndCheckResource(m_pipelineStates, pipelineStateID);
+
+	m_currentPipelineStateID = pipelineStateID;
+	++m_counters.pipelineStateBindsCount;
+}
+
+IDType Renderer::createConstantBuffer(unsigned int constantBufferSize)
+{
+	assert(constantBufferSize > 0);
+
+	const unsigned int adjustedSize = adjustConstantBufferSize(constantBufferSize);
+
+	IDType constantBufferID = generateResourceID();
+
+	m_constantBuffers.emplace(constantBufferID, std::vector<unsigned char>(adjustedSize));
+	onResourceCreated(m_counters.constantBuffers, adjustedSize);
+
+	return constantBufferID;
+}
+
+void Renderer::destroyConstantBuffer(IDType constantBufferID)
+{
+	assert(constantBufferID.isValid());
+
+	auto constantBufferIt = findAndCheckResource(m_constantBuffers, constantBufferID);
+
+	onResourceDestroyed(m_counters.constantBuffers, constantBufferIt->second.size());
+	m_constantBuffers.erase(constantBufferIt);
+}
+
+void Renderer::updateConstantBuffer(IDType constantBufferID, const void* constantBufferData, unsigned int constantBufferDataSize)
+{
+	assert(constantBufferID.isValid());
+	assert(constantBufferData != nullptr);
+
+	auto constantBufferIt = findAndCheckResourceToModify(m_constantBuffers, constantBufferID);
+
+	std::vector<unsigned char>& constantBuffer = constantBufferIt->second;
+	assert(constantBufferDataSize <= constantBuffer.size());
+
+	std::memcpy(constantBuffer.data(), constantBufferData, constantBufferDataSize);
+
+	++m_counters.constantBufferUpdatesCount;
+	m_counters.constantBufferUploadedBytes += constantBufferDataSize;
+}
+
+const void* Renderer::constantBufferData(IDType constantBufferID)const
+{
+	assert(constantBufferID.isValid());
+	return findAndCheckResource(m_constantBuffers, constantBufferID)->second.data();
+}
+
+IDType Renderer::createTextureFromImage(const Image& image)
+{
+	NullTexture nullTexture{ image.width(), image.height() };
+
+	IDType textureID = generateResourceID();
+
+	m_textures.emplace(textureID, nullTexture);
+	onResourceCreated(m_counters.textures, 4ull * nullTexture.width * nullTexture.height);
+
+	return textureID;
+}
+
+IDType Renderer::createTextureFromImageFile(const std::string& imageFileName)
+{
+	return createTextureFromImage(Image::loadImageFromFile(imageFileName));
+}
+
+void Renderer::destroyTexture(IDType textureID)
+{
+	assert(textureID.isValid());
+
+	auto textureIt = findAndCheckResource(m_textures, textureID);
+
+	onResourceDestroyed(m_counters.textures, 4ull * textureIt->second.width * textureIt->second.height);
+	m_textures.erase(textureIt);
+}
+
+IDType Renderer::createPipelineStateData(const PipelineStateData& pipelineStateData)
+{
+	assert(pipelineStateData.texture2DID().isValid());
+	findAndCheckResource(m_textures, pipelineStateData.texture2DID());
+
+	IDType pipelineStateDataID = generateResourceID();
+
+	m_pipelineStateDatas.emplace(pipelineStateDataID, pipelineStateData.texture2DID());
+	onResourceCreated(m_counters.pipelineStateDatas, 0);
+
+	return pipelineStateDataID;
+}
+
+void Renderer::destroyPipelineStateData(IDType pipelineStateDataID)
+{
+	assert(pipelineStateDataID.isValid());
+	removeResourceMapElement(m_pipelineStateDatas, pipelineStateDataID);
+	onResourceDestroyed(m_counters.pipelineStateDatas, 0);
+}
+
+void Renderer::setPipelineStateData(IDType pipelineStateDataID)
+{
+	assert(pipelineStateDataID.isValid());
+	findAndCheckResource(m_pipelineStateDatas, pipelineStateDataID);
+
+	m_currentPipelineStateDataID = pipelineStateDataID;
+	++m_counters.pipelineStateDataBindsCount;
+}
\ No newline at end of file
@@ -0,0 +1,225 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <cassert>
+#ifdef _WIN32
+#include "../WindowsInclude.h"
+#endif
+#include "../VertexTypes.h"
+#include "../IDType.h"
+#include "../PipelineState.h"
+
+namespace ArkanoidEngine
+{
+	class Mesh;
+	class PipelineStateData;
+	class Image;
+	class ShaderCompilationConfig;
+
+	namespace Null
+	{
+		//lifetime statistics of one kind of resource
+		struct ResourceCounters
+		{
+			unsigned long long createdCount{ 0 };
+			unsigned long long destroyedCount{ 0 };
+			unsigned long long allocatedBytes{ 0 }; //bytes currently owned by live resources
+
+			unsigned long long liveCount()const;
+		};
+
+		struct RendererCounters
+		{
+			//per-call statistics, cleared by Renderer::resetCallCounters()
+			unsigned long long framesCount{ 0 };
+			unsigned long long drawCallsCount{ 0 };
+			unsigned long long drawnInstancesCount{ 0 };
+			unsigned long long drawnIndicesCount{ 0 };
+			unsigned long long constantBufferUpdatesCount{ 0 };
+			unsigned long long constantBufferUploadedBytes{ 0 };
+			unsigned long long pipelineStateBindsCount{ 0 };
+			unsigned long long pipelineStateDataBindsCount{ 0 };
+
+			ResourceCounters meshes{};
+			ResourceCounters shaders{};
+			ResourceCounters constantBuffers{};
+			ResourceCounters textures{};
+			ResourceCounters pipelineStates{};
+			ResourceCounters pipelineStateDatas{};
+		};
+
+		/*
+		a Renderer exposing the same interface of D3D11::Renderer which doesn't use any device:
+		every call is validated and recorded into RendererCounters, and constant buffer updates are copied
+		into system memory buffers, so that the CPU-side cost of the engine can be measured without a GPU.
+		*/
+		class Renderer
+		{
+		public:
+			//ctors
+#ifdef _WIN32
+			explicit Renderer(HWND windowHandle, UINT windowWidth, UINT windowHeight);
+#endif
+			explicit Renderer(unsigned int windowWidth = 0, unsigned int windowHeight = 0);
+
+			//dtor
+			~Renderer();
+
+			//copy
+			Renderer(const Renderer&) = delete;
+			Renderer& operator=(const Renderer&) = delete;
+
+			//move
+			Renderer(Renderer&&) = delete;
+			Renderer& operator=(Renderer&&) = delete;
+
+			void beginFrame()const;
+			void endFrame()const;
+
+			void renderMesh(IDType meshID)const;
+			void renderMeshInstanced(IDType meshID, unsigned int instancesCount)const;
+
+#ifdef _WIN32
+			void onResize(HWND windowHandle, UINT windowWidth, UINT windowHeight);
+#endif
+			void onResize(unsigned int windowWidth, unsigned int windowHeight);
+
+			IDType createMesh(const Mesh& mesh, EVertexType vertexType);
+			void destroyMesh(IDType meshID);
+
+			IDType createVertexShaderFromSourceFile(const std::string& shaderSourceFileName,
+													EVertexType vertexType,
+													const ShaderCompilationConfig* compilationConfig = nullptr);
+			IDType createPixelShaderFromSourceFile(const std::string& shaderSourceFileName,
+												   const ShaderCompilationConfig* compilationConfig = nullptr);
+			void destroyShader(IDType shaderID);
+
+			IDType createPipelineState(const PipelineState& pipelineState);
+			void destroyPipelineState(IDType pipelineStateID);
+			void setPipelineState(IDType pipelineStateID);
+
+			IDType createConstantBuffer(unsigned int constantBufferSize);
+			void destroyConstantBuffer(IDType constantBufferID);
+			void updateConstantBuffer(IDType constantBufferID, const void* constantBufferData, unsigned int constantBufferDataSize);
+
+			IDType createTextureFromImageFile(const std::string& imageFileName);
+			IDType createTextureFromImage(const Image& image);
+			void destroyTexture(IDType textureID);
+
+			IDType createPipelineStateData(const PipelineStateData& pipelineStateData);
+			void destroyPipelineStateData(IDType pipelineStateDataID);
+			void setPipelineStateData(IDType pipelineStateDataID);
+
+			const RendererCounters& counters()const;
+			void resetCallCounters();
+
+			unsigned int width()const;
+			unsigned int height()const;
+
+			//returns the system memory copy of the constant buffer, as last updated
+			const void* constantBufferData(IDType constantBufferID)const;
+
+		private:
+
+			struct NullMesh
+			{
+				unsigned int verticesCount;
+				unsigned int vertexStride;
+				unsigned int indicesCount;
+				unsigned int indexSize;
+			};
+
+			struct NullTexture
+			{
+				unsigned int width;
+				unsigned int height;
+			};
+
+			IDType createShader(ResourceCounters& shaderCounters);
+
+			template<typename T>
+			using ResourceMap = std::unordered_map<IDType, T>;
+
+			template<typename T>
+			using ResourceMapIterator = typename ResourceMap<T>::iterator;
+
+			template<typename T>
+			using ResourceMapConstIterator = typename ResourceMap<T>::const_iterator;
+
+			template<typename T>
+			ResourceMapConstIterator<T> findAndCheckResource(const ResourceMap<T>& resourceMap, IDType resourceID)const;
+
+			template<typename T>
+			ResourceMapIterator<T> findAndCheckResourceToModify(ResourceMap<T>& resourceMap, IDType resourceID);
+
+			template<typename T>
+			void removeResourceMapElement(ResourceMap<T>& resourceMap, IDType resourceID);
+
+			ResourceMap<EVertexType> m_vertexShaders{};
+			ResourceMap<bool> m_pixelShaders{};
+			ResourceMap<std::vector<unsigned char>> m_constantBuffers{};
+			ResourceMap<NullTexture> m_textures{};
+			ResourceMap<NullMesh> m_meshes{};
+			ResourceMap<PipelineState> m_pipelineStates{};
+			ResourceMap<IDType> m_pipelineStateDatas{};
+
+			//mutable because draw and frame calls are const, as in D3D11::Renderer
+			mutable RendererCounters m_counters{};
+
+			IDType m_currentPipelineStateID{};
+			IDType m_currentPipelineStateDataID{};
+
+			unsigned int m_width{ 0 };
+			unsigned int m_height{ 0 };
+		};
+
+		inline unsigned long long ResourceCounters::liveCount()const
+		{
+			assert(createdCount >= destroyedCount);
+			return createdCount - destroyedCount;
+		}
+
+		inline const RendererCounters& Renderer::counters()const
+		{
+			return m_counters;
+		}
+
+		inline unsigned int Renderer::width()const
+		{
+			return m_width;
+		}
+
+		inline unsigned int Renderer::height()const
+		{
+			return m_height;
+		}
+
+		template<typename T>
+		inline
+			Renderer::ResourceMapConstIterator<T>
+				Renderer::findAndCheckResource(const ResourceMap<T>& resourceMap, IDType resourceID)const
+		{
+			auto it = resourceMap.find(resourceID);
+			assert(it != resourceMap.end());
+			return it;
+		}
+
+		template<typename T>
+		inline
+			Renderer::ResourceMapIterator<T>
+				Renderer::findAndCheckResourceToModify(ResourceMap<T>& resourceMap, IDType resourceID)
+		{
+			auto it = resourceMap.find(resourceID);
+			assert(it != resourceMap.end());
+			return it;
+		}
+
+		template<typename T>
+		inline void Renderer::removeResourceMapElement(ResourceMap<T>& resourceMap, IDType resourceID)
+		{
+			auto it = findAndCheckResource(resourceMap, resourceID);
+			resourceMap.erase(it);
+		}
+	}
+}
\ No newline at end of file
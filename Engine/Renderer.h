@@ -1,5 +1,16 @@
 #pragma once
-#ifdef _WIN32
+
+//replaces the platform renderer with Null::Renderer, which records calls into counters instead of using a device
+//#define USE_NULL_RENDERER
+
+//replaces the platform renderer with Software::Renderer, which rasterizes on the CPU into a system memory framebuffer
+//#define USE_SOFTWARE_RENDERER
+
+#if defined(USE_NULL_RENDERER)
+#include "Null/NullRenderer.h"
+#elif defined(USE_SOFTWARE_RENDERER)
+#include "Software/SoftwareRenderer.h"
+#elif defined(_WIN32)
 #include "D3D11/Renderer.h"
 #else
 #error Unsupported Platform
@@ -7,7 +18,11 @@
 
 namespace ArkanoidEngine
 {
-#ifdef _WIN32
+#if defined(USE_NULL_RENDERER)
+	using Renderer = Null::Renderer;
+#elif defined(USE_SOFTWARE_RENDERER)
+	using Renderer = Software::Renderer;
+#elif defined(_WIN32)
 	using Renderer = D3D11::Renderer;
 #endif
 }
\ No newline at end of file
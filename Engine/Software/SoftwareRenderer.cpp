@@ -0,0 +1,805 @@
+#include "SoftwareRenderer.h"
+#include <cassert>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <fstream>
+#include "../Mesh.h"
+#include "../Image.h"
+#include "../PipelineStateData.h"
+#include "../ShaderCompilationConfig.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define SOFTWARE_RENDERER_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace ArkanoidEngine;
+using namespace ArkanoidEngine::Software;
+
+constexpr unsigned int Renderer::sk_tileSize;
+
+static IDType::NativeIDType g_nextID = 0;
+
+//clear color of D3D11::Renderer: opaque black
+static constexpr uint32_t gk_clearColor = 0xFF000000;
+
+//the w below which a vertex is considered on or behind the eye plane
+static constexpr float gk_minClipW = 1e-5f;
+
+static IDType generateResourceID()
+{
+	return IDType{ g_nextID++ };
+}
+
+//conversions between sRGB and linear values, as done by the R8G8B8A8_UNORM_SRGB texture and render target
+class SRGBTables
+{
+public:
+	SRGBTables()
+	{
+		for (unsigned int i = 0; i < 256; ++i)
+		{
+			const float c = i / 255.0f;
+			m_toLinear[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+		}
+
+		for (unsigned int i = 0; i < sk_toSRGBSize; ++i)
+		{
+			const float l = i / static_cast<float>(sk_toSRGBSize - 1);
+			const float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+			m_toSRGB[i] = static_cast<unsigned char>(c * 255.0f + 0.5f);
+		}
+	}
+
+	float toLinear(uint32_t c)const
+	{
+		return m_toLinear[c & 0xFF];
+	}
+
+	uint32_t toSRGB(float l)const
+	{
+		l = std::min(std::max(l, 0.0f), 1.0f);
+		return m_toSRGB[static_cast<unsigned int>(l * (sk_toSRGBSize - 1) + 0.5f)];
+	}
+
+private:
+	static constexpr unsigned int sk_toSRGBSize = 1 << 13;
+
+	float m_toLinear[256];
+	unsigned char m_toSRGB[sk_toSRGBSize];
+};
+
+static const SRGBTables& srgbTables()
+{
+	static const SRGBTables tables{};
+	return tables;
+}
+
+static unsigned int unsignedDefineValue(const ShaderCompilationConfig* compilationConfig, const std::string& defineName)
+{
+	assert(compilationConfig != nullptr && "Missing Shader Compilation Config");
+
+	for (const auto& define : *compilationConfig)
+	{
+		if (define.first == defineName)
+		{
+			return static_cast<unsigned int>(std::stoul(define.second));
+		}
+	}
+
+	assert(false && "Missing Define");
+	return 0;
+}
+
+static unsigned int wrapTexelCoordinate(int c, unsigned int size)
+{
+	const int s = static_cast<int>(size);
+	const int wrapped = c % s;
+	const int a[2] = { wrapped, wrapped + s };
+	return static_cast<unsigned int>(a[wrapped < 0]);
+}
+
+//D3D11_FILTER_MIN_MAG_MIP_LINEAR with D3D11_TEXTURE_ADDRESS_WRAP on a single mip texture, filtered in linear space
+static XMFLOAT3 sampleTexture(const uint32_t* texels, unsigned int width, unsigned int height, float u, float v)
+{
+	const SRGBTables& tables = srgbTables();
+
+	const float x = u * width - 0.5f;
+	const float y = v * height - 0.5f;
+	const float floorX = std::floor(x);
+	const float floorY = std::floor(y);
+	const float fracX = x - floorX;
+	const float fracY = y - floorY;
+
+	const unsigned int x0 = wrapTexelCoordinate(static_cast<int>(floorX), width);
+	const unsigned int x1 = wrapTexelCoordinate(static_cast<int>(floorX) + 1, width);
+	const unsigned int y0 = wrapTexelCoordinate(static_cast<int>(floorY), height);
+	const unsigned int y1 = wrapTexelCoordinate(static_cast<int>(floorY) + 1, height);
+
+	const uint32_t texel00 = texels[y0 * width + x0];
+	const uint32_t texel10 = texels[y0 * width + x1];
+	const uint32_t texel01 = texels[y1 * width + x0];
+	const uint32_t texel11 = texels[y1 * width + x1];
+
+	const float weight00 = (1.0f - fracX) * (1.0f - fracY);
+	const float weight10 = fracX * (1.0f - fracY);
+	const float weight01 = (1.0f - fracX) * fracY;
+	const float weight11 = fracX * fracY;
+
+	float channels[3];
+	for (unsigned int channel = 0; channel < 3; ++channel)
+	{
+		const unsigned int shift = channel * 8;
+		channels[channel] = tables.toLinear(texel00 >> shift) * weight00 + tables.toLinear(texel10 >> shift) * weight10 +
+							tables.toLinear(texel01 >> shift) * weight01 + tables.toLinear(texel11 >> shift) * weight11;
+	}
+
+	return XMFLOAT3{ channels[0], channels[1], channels[2] };
+}
+
+//everyOnePixelShader.hlsl
+static uint32_t shadePixel(const uint32_t* texels, unsigned int width, unsigned int height, float u, float v,
+						   const XMFLOAT4& colorScaleAndIndex, const XMFLOAT4& uvTranslationAndScale)
+{
+	const XMFLOAT3 textureColor = sampleTexture(texels, width, height,
+												u * uvTranslationAndScale.z + uvTranslationAndScale.x,
+												v * uvTranslationAndScale.w + uvTranslationAndScale.y);
+
+	const SRGBTables& tables = srgbTables();
+
+	return tables.toSRGB(textureColor.x * colorScaleAndIndex.x) |
+		   tables.toSRGB(textureColor.y * colorScaleAndIndex.y) << 8 |
+		   tables.toSRGB(textureColor.z * colorScaleAndIndex.z) << 16 |
+		   0xFF000000;
+}
+
+#ifdef SOFTWARE_RENDERER_SSE2
+static __m128 evaluatePlane(const float (&plane)[3], const __m128& pixelCentersX, float pixelCenterY)
+{
+	return _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane[0]), pixelCentersX), _mm_set1_ps(plane[1] * pixelCenterY + plane[2]));
+}
+#else
+static float evaluatePlane(const float (&plane)[3], float pixelCenterX, float pixelCenterY)
+{
+	return plane[0] * pixelCenterX + (plane[1] * pixelCenterY + plane[2]);
+}
+#endif
+
+static void fillSpan(uint32_t* pixels, unsigned int pixelsCount, uint32_t value)
+{
+	unsigned int pixelIndex = 0;
+
+#ifdef SOFTWARE_RENDERER_SSE2
+	const __m128i values = _mm_set1_epi32(static_cast<int>(value));
+	for (; pixelIndex + 4 <= pixelsCount; pixelIndex += 4)
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + pixelIndex), values);
+	}
+#endif
+
+	for (; pixelIndex < pixelsCount; ++pixelIndex)
+	{
+		pixels[pixelIndex] = value;
+	}
+}
+
+#ifdef _WIN32
+Renderer::Renderer(HWND, UINT windowWidth, UINT windowHeight) : Renderer{ windowWidth, windowHeight }
+{
+}
+
+void Renderer::onResize(HWND, UINT windowWidth, UINT windowHeight)
+{
+	onResize(windowWidth, windowHeight);
+}
+#endif
+
+Renderer::Renderer(unsigned int windowWidth, unsigned int windowHeight, unsigned int threadsCount)
+	: m_threadPool{ threadsCount }
+{
+	onResize(windowWidth, windowHeight);
+}
+
+Renderer::~Renderer()
+{
+	assert(m_vertexShaders.size() == 0 && "Exist Vertex Shaders not destroyed");
+	assert(m_pixelShaders.size() == 0 && "Exist Pixel Shaders not destroyed");
+	assert(m_constantBuffers.size() == 0 && "Exist Constant Buffers not destroyed");
+	assert(m_textures.size() == 0 && "Exist Texture2Ds not destroyed");
+	assert(m_meshes.size() == 0 && "Exist Meshes not destroyed");
+	assert(m_pipelineStates.size() == 0 && "Exist PipelineStates not destroyed");
+	assert(m_pipelineStateDatas.size() == 0 && "Exist PipelineStateDatas not destroyed");
+}
+
+void Renderer::onResize(unsigned int windowWidth, unsigned int windowHeight)
+{
+	m_width = windowWidth;
+	m_height = windowHeight;
+
+	m_tilesCountX = (m_width + sk_tileSize - 1) / sk_tileSize;
+	m_tilesCountY = (m_height + sk_tileSize - 1) / sk_tileSize;
+
+	const unsigned int tilesCount = m_tilesCountX * m_tilesCountY;
+
+	m_frameBuffer.assign(static_cast<size_t>(m_width) * m_height, gk_clearColor);
+	m_tilesTriangles.resize(tilesCount);
+	m_tilesShadedPixelsCounts.resize(tilesCount);
+}
+
+void Renderer::tileBounds(unsigned int tileIndex, int& minX, int& minY, int& maxX, int& maxY)const
+{
+	assert(tileIndex < m_tilesCountX * m_tilesCountY);
+
+	minX = static_cast<int>((tileIndex % m_tilesCountX) * sk_tileSize);
+	minY = static_cast<int>((tileIndex / m_tilesCountX) * sk_tileSize);
+	maxX = std::min(minX + static_cast<int>(sk_tileSize), static_cast<int>(m_width)) - 1;
+	maxY = std::min(minY + static_cast<int>(sk_tileSize), static_cast<int>(m_height)) - 1;
+}
+
+void Renderer::clearTile(unsigned int tileIndex)const
+{
+	int minX, minY, maxX, maxY;
+	tileBounds(tileIndex, minX, minY, maxX, maxY);
+
+	for (int y = minY; y <= maxY; ++y)
+	{
+		fillSpan(&m_frameBuffer[static_cast<size_t>(y) * m_width + minX], maxX - minX + 1, gk_clearColor);
+	}
+}
+
+void Renderer::beginFrame()const
+{
+	m_threadPool.parallelFor(m_tilesCountX * m_tilesCountY, [this](unsigned int tileIndex)
+	{
+		clearTile(tileIndex);
+	});
+}
+
+void Renderer::endFrame()const
+{
+	++m_counters.framesCount;
+}
+
+void Renderer::resetCounters()
+{
+	m_counters = RendererCounters{};
+}
+
+bool Renderer::saveFrameBufferToFile(const std::string& imageFileName)const
+{
+	std::ofstream imageFile{ imageFileName, std::ios::binary };
+	if (!imageFile)
+	{
+		return false;
+	}
+
+	imageFile << "P6\n" << m_width << " " << m_height << "\n255\n";
+
+	std::vector<unsigned char> row(static_cast<size_t>(m_width) * 3);
+	for (unsigned int y = 0; y < m_height; ++y)
+	{
+		for (unsigned int x = 0; x < m_width; ++x)
+		{
+			const uint32_t pixel = m_frameBuffer[static_cast<size_t>(y) * m_width + x];
+			row[x * 3 + 0] = static_cast<unsigned char>(pixel);
+			row[x * 3 + 1] = static_cast<unsigned char>(pixel >> 8);
+			row[x * 3 + 2] = static_cast<unsigned char>(pixel >> 16);
+		}
+		imageFile.write(reinterpret_cast<const char*>(row.data()), row.size());
+	}
+
+	return static_cast<bool>(imageFile);
+}
+
+IDType Renderer::createMesh(const Mesh& mesh, EVertexType vertexType)
+{
+	assert(mesh.hasPositions());
+	assert(mesh.hasIndices());
+	assert(mesh.indexCount() % 3 == 0);
+
+	SoftwareMesh softwareMesh{};
+	softwareMesh.positions = mesh.getPositions();
+
+	//vertex types without texture coordinates read zeros, like a missing input layout element
+	const bool hasTextCoords = vertexType == EVertexType::POSITION_TEXTCOORD || vertexType == EVertexType::POSITION_NORMAL_TEXTCOORD;
+	if (hasTextCoords)
+	{
+		assert(mesh.getTextCoords().size() == mesh.vertexCount());
+		softwareMesh.textCoords = mesh.getTextCoords();
+	}
+	else
+	{
+		softwareMesh.textCoords.assign(mesh.vertexCount(), XMFLOAT2{ 0.0f, 0.0f });
+	}
+
+	softwareMesh.indices.reserve(mesh.indexCount());
+	for (uint64_t index : mesh.getIndices())
+	{
+		assert(index < mesh.vertexCount());
+		softwareMesh.indices.push_back(static_cast<unsigned int>(index));
+	}
+
+	IDType meshID = generateResourceID();
+
+	m_meshes.emplace(meshID, std::move(softwareMesh));
+
+	return meshID;
+}
+
+void Renderer::destroyMesh(IDType meshID)
+{
+	assert(meshID.isValid());
+	removeResourceMapElement(m_meshes, meshID);
+}
+
+bool Renderer::setupTriangle(const XMFLOAT4 (&clipPositions)[3], const XMFLOAT2 (&textCoords)[3],
+							 unsigned int instanceID, Triangle& triangle)const
+{
+	float xs[3];
+	float ys[3];
+	float oneOverWs[3];
+
+	for (unsigned int vertexIndex = 0; vertexIndex < 3; ++vertexIndex)
+	{
+		const XMFLOAT4& clipPosition = clipPositions[vertexIndex];
+		if (clipPosition.w < gk_minClipW)
+		{
+			++m_counters.culledTrianglesCount;
+			return false;
+		}
+
+		//viewport transform, y goes down
+		oneOverWs[vertexIndex] = 1.0f / clipPosition.w;
+		xs[vertexIndex] = (clipPosition.x * oneOverWs[vertexIndex] + 1.0f) * 0.5f * m_width;
+		ys[vertexIndex] = (1.0f - clipPosition.y * oneOverWs[vertexIndex]) * 0.5f * m_height;
+	}
+
+	//edge i goes from vertex i+1 to vertex i+2 and is positive on the side of vertex i for clockwise triangles
+	for (unsigned int edgeIndex = 0; edgeIndex < 3; ++edgeIndex)
+	{
+		const unsigned int from = (edgeIndex + 1) % 3;
+		const unsigned int to = (edgeIndex + 2) % 3;
+
+		triangle.edgesA[edgeIndex] = ys[from] - ys[to];
+		triangle.edgesB[edgeIndex] = xs[to] - xs[from];
+		triangle.edgesC[edgeIndex] = xs[from] * ys[to] - xs[to] * ys[from];
+
+		const bool isTopEdge = ys[from] == ys[to] && xs[to] > xs[from];
+		const bool isLeftEdge = ys[to] < ys[from];
+		triangle.edgesTopLeft[edgeIndex] = isTopEdge || isLeftEdge;
+	}
+
+	const float doubleArea = triangle.edgesA[0] * xs[0] + triangle.edgesB[0] * ys[0] + triangle.edgesC[0];
+	if (!(doubleArea > 0.0f))
+	{
+		++m_counters.culledTrianglesCount;
+		return false;
+	}
+
+	//pixel centers at (x + 0.5, y + 0.5) inside the vertices bounds
+	const float minX = std::min({ xs[0], xs[1], xs[2] });
+	const float minY = std::min({ ys[0], ys[1], ys[2] });
+	const float maxX = std::max({ xs[0], xs[1], xs[2] });
+	const float maxY = std::max({ ys[0], ys[1], ys[2] });
+
+	triangle.minX = std::max(static_cast<int>(std::ceil(std::max(minX - 0.5f, -1.0f))), 0);
+	triangle.minY = std::max(static_cast<int>(std::ceil(std::max(minY - 0.5f, -1.0f))), 0);
+	triangle.maxX = std::min(static_cast<int>(std::floor(std::min(maxX - 0.5f, static_cast<float>(m_width)))), static_cast<int>(m_width) - 1);
+	triangle.maxY = std::min(static_cast<int>(std::floor(std::min(maxY - 0.5f, static_cast<float>(m_height)))), static_cast<int>(m_height) - 1);
+
+	if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY)
+	{
+		return false;
+	}
+
+	//perspective correct attributes: 1/w, u/w and v/w are linear in screen space
+	const float oneOverDoubleArea = 1.0f / doubleArea;
+
+	auto computePlane = [&triangle, oneOverDoubleArea](const float (&values)[3], float (&plane)[3])
+	{
+		plane[0] = (triangle.edgesA[0] * values[0] + triangle.edgesA[1] * values[1] + triangle.edgesA[2] * values[2]) * oneOverDoubleArea;
+		plane[1] = (triangle.edgesB[0] * values[0] + triangle.edgesB[1] * values[1] + triangle.edgesB[2] * values[2]) * oneOverDoubleArea;
+		plane[2] = (triangle.edgesC[0] * values[0] + triangle.edgesC[1] * values[1] + triangle.edgesC[2] * values[2]) * oneOverDoubleArea;
+	};
+
+	const float uOverWs[3] = { textCoords[0].x * oneOverWs[0], textCoords[1].x * oneOverWs[1], textCoords[2].x * oneOverWs[2] };
+	const float vOverWs[3] = { textCoords[0].y * oneOverWs[0], textCoords[1].y * oneOverWs[1], textCoords[2].y * oneOverWs[2] };
+
+	computePlane(oneOverWs, triangle.oneOverWPlane);
+	computePlane(uOverWs, triangle.uOverWPlane);
+	computePlane(vOverWs, triangle.vOverWPlane);
+
+	triangle.instanceID = instanceID;
+
+	return true;
+}
+
+void Renderer::binTriangle(unsigned int triangleIndex)const
+{
+	const Triangle& triangle = m_triangles[triangleIndex];
+
+	const unsigned int minTileX = static_cast<unsigned int>(triangle.minX) / sk_tileSize;
+	const unsigned int minTileY = static_cast<unsigned int>(triangle.minY) / sk_tileSize;
+	const unsigned int maxTileX = static_cast<unsigned int>(triangle.maxX) / sk_tileSize;
+	const unsigned int maxTileY = static_cast<unsigned int>(triangle.maxY) / sk_tileSize;
+
+	for (unsigned int tileY = minTileY; tileY <= maxTileY; ++tileY)
+	{
+		for (unsigned int tileX = minTileX; tileX <= maxTileX; ++tileX)
+		{
+			m_tilesTriangles[tileY * m_tilesCountX + tileX].push_back(triangleIndex);
+		}
+	}
+}
+
+unsigned int Renderer::rasterizeQuad(const Triangle& triangle, int x, int y, int minX, int maxX,
+									 float (&us)[4], float (&vs)[4])
+{
+	const float pixelCenterY = y + 0.5f;
+
+#ifdef SOFTWARE_RENDERER_SSE2
+	const __m128i xs = _mm_add_epi32(_mm_set1_epi32(x), _mm_set_epi32(3, 2, 1, 0));
+	const __m128 pixelCentersX = _mm_add_ps(_mm_cvtepi32_ps(xs), _mm_set1_ps(0.5f));
+	const __m128 zeros = _mm_setzero_ps();
+
+	//lanes outside the span
+	const __m128i outsideSpan = _mm_or_si128(_mm_cmplt_epi32(xs, _mm_set1_epi32(minX)), _mm_cmpgt_epi32(xs, _mm_set1_epi32(maxX)));
+	__m128 coverage = _mm_castsi128_ps(_mm_andnot_si128(outsideSpan, _mm_set1_epi32(-1)));
+
+	for (unsigned int edgeIndex = 0; edgeIndex < 3; ++edgeIndex)
+	{
+		const __m128 edges = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(triangle.edgesA[edgeIndex]), pixelCentersX),
+										_mm_set1_ps(triangle.edgesB[edgeIndex] * pixelCenterY + triangle.edgesC[edgeIndex]));
+
+		//pixel centers exactly on an edge belong to the triangle only if the edge is a top or left one
+		const __m128 topLeft = _mm_castsi128_ps(_mm_set1_epi32(-static_cast<int>(triangle.edgesTopLeft[edgeIndex])));
+		const __m128 inside = _mm_or_ps(_mm_cmpgt_ps(edges, zeros), _mm_and_ps(_mm_cmpeq_ps(edges, zeros), topLeft));
+
+		coverage = _mm_and_ps(coverage, inside);
+	}
+
+	const unsigned int coverageMask = static_cast<unsigned int>(_mm_movemask_ps(coverage));
+	if (coverageMask == 0)
+	{
+		return 0;
+	}
+
+	const __m128 oneOverWs = evaluatePlane(triangle.oneOverWPlane, pixelCentersX, pixelCenterY);
+	_mm_storeu_ps(us, _mm_div_ps(evaluatePlane(triangle.uOverWPlane, pixelCentersX, pixelCenterY), oneOverWs));
+	_mm_storeu_ps(vs, _mm_div_ps(evaluatePlane(triangle.vOverWPlane, pixelCentersX, pixelCenterY), oneOverWs));
+
+	return coverageMask;
+#else
+	unsigned int coverageMask = 0;
+
+	for (int lane = 0; lane < 4; ++lane)
+	{
+		const int pixelX = x + lane;
+		const float pixelCenterX = pixelX + 0.5f;
+
+		bool covered = pixelX >= minX && pixelX <= maxX;
+		for (unsigned int edgeIndex = 0; edgeIndex < 3; ++edgeIndex)
+		{
+			const float edge = triangle.edgesA[edgeIndex] * pixelCenterX +
+							   (triangle.edgesB[edgeIndex] * pixelCenterY + triangle.edgesC[edgeIndex]);
+			covered = covered && (edge > 0.0f || (edge == 0.0f && triangle.edgesTopLeft[edgeIndex]));
+		}
+
+		const float oneOverW = evaluatePlane(triangle.oneOverWPlane, pixelCenterX, pixelCenterY);
+		us[lane] = evaluatePlane(triangle.uOverWPlane, pixelCenterX, pixelCenterY) / oneOverW;
+		vs[lane] = evaluatePlane(triangle.vOverWPlane, pixelCenterX, pixelCenterY) / oneOverW;
+
+		coverageMask |= static_cast<unsigned int>(covered) << lane;
+	}
+
+	return coverageMask;
+#endif
+}
+
+unsigned long long Renderer::rasterizeTile(unsigned int tileIndex, const DrawContext& drawContext)const
+{
+	int tileMinX, tileMinY, tileMaxX, tileMaxY;
+	tileBounds(tileIndex, tileMinX, tileMinY, tileMaxX, tileMaxY);
+
+	const SoftwareTexture& texture = *drawContext.texture;
+
+	unsigned long long shadedPixelsCount = 0;
+
+	//triangles are in submission order, so later instances overwrite earlier ones as with the D3D11 pipeline
+	for (unsigned int triangleIndex : m_tilesTriangles[tileIndex])
+	{
+		const Triangle& triangle = m_triangles[triangleIndex];
+
+		const int minX = std::max(triangle.minX, tileMinX);
+		const int minY = std::max(triangle.minY, tileMinY);
+		const int maxX = std::min(triangle.maxX, tileMaxX);
+		const int maxY = std::min(triangle.maxY, tileMaxY);
+
+		const XMFLOAT4& colorScaleAndIndex = drawContext.colorScaleAndIndex[triangle.instanceID];
+		const XMFLOAT4& uvTranslationAndScale = drawContext.uvTranslationAndScales[static_cast<unsigned int>(colorScaleAndIndex.w)];
+
+		for (int y = minY; y <= maxY; ++y)
+		{
+			uint32_t* row = &m_frameBuffer[static_cast<size_t>(y) * m_width];
+
+			//quads aligned to 4 pixels, tiles sizes are multiple of 4
+			for (int x = minX & ~3; x <= maxX; x += 4)
+			{
+				float us[4];
+				float vs[4];
+				const unsigned int coverageMask = rasterizeQuad(triangle, x, y, minX, maxX, us, vs);
+
+				for (unsigned int lane = 0; lane < 4; ++lane)
+				{
+					if (coverageMask & (1u << lane))
+					{
+						row[x + lane] = shadePixel(texture.texels.data(), texture.width, texture.height, us[lane], vs[lane],
+												   colorScaleAndIndex, uvTranslationAndScale);
+						++shadedPixelsCount;
+					}
+				}
+			}
+		}
+	}
+
+	return shadedPixelsCount;
+}
+
+void Renderer::renderMesh(IDType meshID)const
+{
+	renderMeshInstanced(meshID, 1);
+}
+
+void Renderer::renderMeshInstanced(IDType meshID, unsigned int instancesCount)const
+{
+	assert(meshID.isValid());
+	const SoftwareMesh& mesh = findAndCheckResource(m_meshes, meshID)->second;
+
+	++m_counters.drawCallsCount;
+
+	if (m_width == 0 || m_height == 0)
+	{
+		return;
+	}
+
+	assert(m_currentPipelineStateID.isValid() && "Missing PipelineState");
+	assert(m_currentPipelineStateDataID.isValid() && "Missing PipelineStateData");
+
+	const PipelineState& pipelineState = findAndCheckResource(m_pipelineStates, m_currentPipelineStateID)->second;
+	const SoftwarePixelShader& pixelShader = findAndCheckResource(m_pixelShaders, pipelineState.pixelShaderID())->second;
+
+	//everyOneVertexShader.hlsl: SceneConstantBuffer at b0 and TransformsConstantBuffer at b1
+	const std::vector<IDType>& vertexShaderConstantBuffers = pipelineState.vertexShaderStageConstantBuffers();
+	assert(vertexShaderConstantBuffers.size() >= 2);
+
+	const std::vector<XMFLOAT4>& sceneConstantBuffer = findAndCheckResource(m_constantBuffers, vertexShaderConstantBuffers[0])->second;
+	const std::vector<XMFLOAT4>& transformsConstantBuffer = findAndCheckResource(m_constantBuffers, vertexShaderConstantBuffers[1])->second;
+	assert(sceneConstantBuffer.size() >= 4);
+	assert(transformsConstantBuffer.size() >= instancesCount);
+
+	//everyOnePixelShader.hlsl: ColorsAndUVTransformsConstantBuffer at b0
+	const std::vector<IDType>& pixelShaderConstantBuffers = pipelineState.pixelShaderStageConstantBuffers();
+	assert(pixelShaderConstantBuffers.size() >= 1);
+
+	const std::vector<XMFLOAT4>& colorsAndUVTransformsConstantBuffer = findAndCheckResource(m_constantBuffers, pixelShaderConstantBuffers[0])->second;
+	assert(instancesCount <= pixelShader.instancesCount);
+	assert(colorsAndUVTransformsConstantBuffer.size() > pixelShader.instancesCount);
+
+	const IDType textureID = findAndCheckResource(m_pipelineStateDatas, m_currentPipelineStateDataID)->second;
+	const SoftwareTexture& texture = findAndCheckResource(m_textures, textureID)->second;
+
+	//viewProjection was transposed by prepareMatrixForHLSL, so each of its rows is a column of the original matrix
+	const XMFLOAT4* viewProjectionColumns = sceneConstantBuffer.data();
+
+	m_triangles.clear();
+	for (std::vector<unsigned int>& tileTriangles : m_tilesTriangles)
+	{
+		tileTriangles.clear();
+	}
+
+	const unsigned int meshTrianglesCount = static_cast<unsigned int>(mesh.indices.size() / 3);
+
+	for (unsigned int instanceID = 0; instanceID < instancesCount; ++instanceID)
+	{
+		const XMFLOAT4& translationAndScale = transformsConstantBuffer[instanceID];
+
+		for (unsigned int meshTriangleIndex = 0; meshTriangleIndex < meshTrianglesCount; ++meshTriangleIndex)
+		{
+			XMFLOAT4 clipPositions[3];
+			XMFLOAT2 textCoords[3];
+
+			for (unsigned int vertexIndex = 0; vertexIndex < 3; ++vertexIndex)
+			{
+				const unsigned int index = mesh.indices[meshTriangleIndex * 3 + vertexIndex];
+				const XMFLOAT3& position = mesh.positions[index];
+
+				//everyOneVertexShader.hlsl, with worldPos.z = 0 and worldPos.w = 1
+				const float worldX = position.x * translationAndScale.z + translationAndScale.x;
+				const float worldY = position.y * translationAndScale.w + translationAndScale.y;
+
+				float clip[4];
+				for (unsigned int column = 0; column < 4; ++column)
+				{
+					const XMFLOAT4& viewProjectionColumn = viewProjectionColumns[column];
+					clip[column] = worldX * viewProjectionColumn.x + worldY * viewProjectionColumn.y + viewProjectionColumn.w;
+				}
+
+				clipPositions[vertexIndex] = XMFLOAT4{ clip[0], clip[1], clip[2], clip[3] };
+				textCoords[vertexIndex] = mesh.textCoords[index];
+			}
+
+			Triangle triangle;
+			if (setupTriangle(clipPositions, textCoords, instanceID, triangle))
+			{
+				m_triangles.push_back(triangle);
+				binTriangle(static_cast<unsigned int>(m_triangles.size()) - 1);
+			}
+		}
+	}
+
+	m_counters.trianglesCount += static_cast<unsigned long long>(meshTrianglesCount) * instancesCount;
+
+	const DrawContext drawContext{ &texture,
+								   colorsAndUVTransformsConstantBuffer.data(),
+								   colorsAndUVTransformsConstantBuffer.data() + pixelShader.instancesCount };
+
+	m_threadPool.parallelFor(m_tilesCountX * m_tilesCountY, [this, &drawContext](unsigned int tileIndex)
+	{
+		m_tilesShadedPixelsCounts[tileIndex] = rasterizeTile(tileIndex, drawContext);
+	});
+
+	for (unsigned long long tileShadedPixelsCount : m_tilesShadedPixelsCounts)
+	{
+		m_counters.shadedPixelsCount += tileShadedPixelsCount;
+	}
+}
+
+IDType Renderer::createVertexShaderFromSourceFile(const std::string& shaderSourceFileName, EVertexType vertexType,
+												  const ShaderCompilationConfig*)
+{
+	assert(!shaderSourceFileName.empty());
+
+	IDType vertexShaderID = generateResourceID();
+	m_vertexShaders.emplace(vertexShaderID, vertexType);
+
+	return vertexShaderID;
+}
+
+IDType Renderer::createPixelShaderFromSourceFile(const std::string& shaderSourceFileName, const ShaderCompilationConfig* compilationConfig)
+{
+	assert(!shaderSourceFileName.empty());
+
+	SoftwarePixelShader pixelShader{};
+	pixelShader.instancesCount = unsignedDefineValue(compilationConfig, "INSTANCES_COUNT");
+
+	IDType pixelShaderID = generateResourceID();
+	m_pixelShaders.emplace(pixelShaderID, pixelShader);
+
+	return pixelShaderID;
+}
+
+void Renderer::destroyShader(IDType shaderID)
+{
+	assert(shaderID.isValid());
+
+	if (m_vertexShaders.erase(shaderID) == 0)
+	{
+		removeResourceMapElement(m_pixelShaders, shaderID);
+	}
+}
+
+IDType Renderer::createPipelineState(const PipelineState& pipelineState)
+{
+	assert(pipelineState.vertexShaderID().isValid());
+	assert(pipelineState.pixelShaderID().isValid());
+
+	findAndCheckResource(m_vertexShaders, pipelineState.vertexShaderID());
+	findAndCheckResource(m_pixelShaders, pipelineState.pixelShaderID());
+
+	IDType pipelineStateID = generateResourceID();
+
+	m_pipelineStates.emplace(pipelineStateID, pipelineState);
+
+	return pipelineStateID;
+}
+
+void Renderer::destroyPipelineState(IDType pipelineStateID)
+{
+	assert(pipelineStateID.isValid());
+	removeResourceMapElement(m_pipelineStates, pipelineStateID);
+}
+
+void Renderer::setPipelineState(IDType pipelineStateID)
+{
+	assert(pipelineStateID.isValid());
+	findAndCheckResource(m_pipelineStates, pipelineStateID);
+
+	m_currentPipelineStateID = pipelineStateID;
+}
+
+IDType Renderer::createConstantBuffer(unsigned int constantBufferSize)
+{
+	assert(constantBufferSize > 0);
+
+	//keep the same size constraint of D3D11: a multiple of 16 bytes, which is one XMFLOAT4 register
+	const unsigned int registersCount = (constantBufferSize + sizeof(XMFLOAT4) - 1) / sizeof(XMFLOAT4);
+
+	IDType constantBufferID = generateResourceID();
+
+	m_constantBuffers.emplace(constantBufferID, std::vector<XMFLOAT4>(registersCount, XMFLOAT4{ 0.0f, 0.0f, 0.0f, 0.0f }));
+
+	return constantBufferID;
+}
+
+void Renderer::destroyConstantBuffer(IDType constantBufferID)
+{
+	assert(constantBufferID.isValid());
+	removeResourceMapElement(m_constantBuffers, constantBufferID);
+}
+
+void Renderer::updateConstantBuffer(IDType constantBufferID, const void* constantBufferData, unsigned int constantBufferDataSize)
+{
+	assert(constantBufferID.isValid());
+	assert(constantBufferData != nullptr);
+
+	std::vector<XMFLOAT4>& constantBuffer = findAndCheckResourceToModify(m_constantBuffers, constantBufferID)->second;
+	assert(constantBufferDataSize <= constantBuffer.size() * sizeof(XMFLOAT4));
+
+	std::memcpy(constantBuffer.data(), constantBufferData, constantBufferDataSize);
+}
+
+IDType Renderer::createTextureFromImage(const Image& image)
+{
+	assert(image.imageData() != nullptr);
+
+	SoftwareTexture texture{};
+	texture.width = image.width();
+	texture.height = image.height();
+	texture.texels.resize(static_cast<size_t>(texture.width) * texture.height);
+
+	std::memcpy(texture.texels.data(), image.imageData(), texture.texels.size() * sizeof(uint32_t));
+
+	IDType textureID = generateResourceID();
+
+	m_textures.emplace(textureID, std::move(texture));
+
+	return textureID;
+}
+
+IDType Renderer::createTextureFromImageFile(const std::string& imageFileName)
+{
+	return createTextureFromImage(Image::loadImageFromFile(imageFileName));
+}
+
+void Renderer::destroyTexture(IDType textureID)
+{
+	assert(textureID.isValid());
+	removeResourceMapElement(m_textures, textureID);
+}
+
+IDType Renderer::createPipelineStateData(const PipelineStateData& pipelineStateData)
+{
+	assert(pipelineStateData.texture2DID().isValid());
+	findAndCheckResource(m_textures, pipelineStateData.texture2DID());
+
+	IDType pipelineStateDataID = generateResourceID();
+
+	m_pipelineStateDatas.emplace(pipelineStateDataID, pipelineStateData.texture2DID());
+
+	return pipelineStateDataID;
+}
+
+void Renderer::destroyPipelineStateData(IDType pipelineStateDataID)
+{
+	assert(pipelineStateDataID.isValid());
+	removeResourceMapElement(m_pipelineStateDatas, pipelineStateDataID);
+}
+
+void Renderer::setPipelineStateData(IDType pipelineStateDataID)
+{
+	assert(pipelineStateDataID.isValid());
+	findAndCheckResource(m_pipelineStateDatas, pipelineStateDataID);
+
+	m_currentPipelineStateDataID = pipelineStateDataID;
+}
\ No newline at end of file
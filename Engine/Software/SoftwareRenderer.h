@@ -0,0 +1,274 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+#include <cassert>
+#ifdef _WIN32
+#include "../WindowsInclude.h"
+#endif
+#include "../MathCommon.h"
+#include "../VertexTypes.h"
+#include "../IDType.h"
+#include "../PipelineState.h"
+#include "../ThreadPool.h"
+
+namespace ArkanoidEngine
+{
+	class Mesh;
+	class PipelineStateData;
+	class Image;
+	class ShaderCompilationConfig;
+
+	namespace Software
+	{
+		struct RendererCounters
+		{
+			unsigned long long framesCount{ 0 };
+			unsigned long long drawCallsCount{ 0 };
+			unsigned long long trianglesCount{ 0 };
+			unsigned long long culledTrianglesCount{ 0 }; //back facing, degenerate or crossing the eye plane
+			unsigned long long shadedPixelsCount{ 0 };
+		};
+
+		/*
+		a Renderer exposing the same interface of D3D11::Renderer which rasterizes on the CPU into a r8g8b8a8 sRGB framebuffer.
+		HLSL is not compiled: the bound shaders are assumed to be everyOneVertexShader.hlsl and everyOnePixelShader.hlsl,
+		whose behaviour is reproduced here (instance translation and scale, viewProjection, atlas UV remap,
+		bilinear wrap sampling of a sRGB texture and color modulation).
+		the pixel shader must be created with the INSTANCES_COUNT define, which gives the offset of uvTranslationAndScales.
+		as in the D3D11 default rasterizer state, clockwise triangles are front facing and counterclockwise ones are culled.
+		there is no near plane clipping (triangles crossing the eye plane are dropped) and no depth test.
+		the framebuffer is split in tiles rasterized in parallel, 4 pixels at a time with SSE2 where available.
+		*/
+		class Renderer
+		{
+		public:
+			//ctors
+#ifdef _WIN32
+			explicit Renderer(HWND windowHandle, UINT windowWidth, UINT windowHeight);
+#endif
+			explicit Renderer(unsigned int windowWidth = 0, unsigned int windowHeight = 0, unsigned int threadsCount = 0);
+
+			//dtor
+			~Renderer();
+
+			//copy
+			Renderer(const Renderer&) = delete;
+			Renderer& operator=(const Renderer&) = delete;
+
+			//move
+			Renderer(Renderer&&) = delete;
+			Renderer& operator=(Renderer&&) = delete;
+
+			void beginFrame()const;
+			void endFrame()const;
+
+			void renderMesh(IDType meshID)const;
+			void renderMeshInstanced(IDType meshID, unsigned int instancesCount)const;
+
+#ifdef _WIN32
+			void onResize(HWND windowHandle, UINT windowWidth, UINT windowHeight);
+#endif
+			void onResize(unsigned int windowWidth, unsigned int windowHeight);
+
+			IDType createMesh(const Mesh& mesh, EVertexType vertexType);
+			void destroyMesh(IDType meshID);
+
+			IDType createVertexShaderFromSourceFile(const std::string& shaderSourceFileName,
+													EVertexType vertexType,
+													const ShaderCompilationConfig* compilationConfig = nullptr);
+			IDType createPixelShaderFromSourceFile(const std::string& shaderSourceFileName,
+												   const ShaderCompilationConfig* compilationConfig = nullptr);
+			void destroyShader(IDType shaderID);
+
+			IDType createPipelineState(const PipelineState& pipelineState);
+			void destroyPipelineState(IDType pipelineStateID);
+			void setPipelineState(IDType pipelineStateID);
+
+			IDType createConstantBuffer(unsigned int constantBufferSize);
+			void destroyConstantBuffer(IDType constantBufferID);
+			void updateConstantBuffer(IDType constantBufferID, const void* constantBufferData, unsigned int constantBufferDataSize);
+
+			IDType createTextureFromImageFile(const std::string& imageFileName);
+			IDType createTextureFromImage(const Image& image);
+			void destroyTexture(IDType textureID);
+
+			IDType createPipelineStateData(const PipelineStateData& pipelineStateData);
+			void destroyPipelineStateData(IDType pipelineStateDataID);
+			void setPipelineStateData(IDType pipelineStateDataID);
+
+			const RendererCounters& counters()const;
+			void resetCounters();
+
+			unsigned int width()const;
+			unsigned int height()const;
+
+			//width()*height() pixels, row by row from the top, each one stored as r8g8b8a8 sRGB
+			const unsigned char* frameBufferData()const;
+
+			//writes the framebuffer as a binary PPM image. returns false if the file can't be written
+			bool saveFrameBufferToFile(const std::string& imageFileName)const;
+
+			static constexpr unsigned int sk_tileSize = 64;
+
+		private:
+
+			struct SoftwareMesh
+			{
+				std::vector<XMFLOAT3> positions;
+				std::vector<XMFLOAT2> textCoords;
+				std::vector<unsigned int> indices;
+			};
+
+			struct SoftwareTexture
+			{
+				std::vector<uint32_t> texels;
+				unsigned int width;
+				unsigned int height;
+			};
+
+			struct SoftwarePixelShader
+			{
+				unsigned int instancesCount;
+			};
+
+			//a screen space triangle: edge functions and attributes are planes a*x + b*y + c evaluated at pixel centers
+			struct Triangle
+			{
+				float edgesA[3];
+				float edgesB[3];
+				float edgesC[3];
+				bool edgesTopLeft[3];
+
+				float oneOverWPlane[3];
+				float uOverWPlane[3];
+				float vOverWPlane[3];
+
+				//inclusive pixel bounds, clamped to the framebuffer
+				int minX;
+				int minY;
+				int maxX;
+				int maxY;
+
+				unsigned int instanceID;
+			};
+
+			//everything a tile needs to shade the triangles of a draw
+			struct DrawContext
+			{
+				const SoftwareTexture* texture;
+				const XMFLOAT4* colorScaleAndIndex;
+				const XMFLOAT4* uvTranslationAndScales;
+			};
+
+			bool setupTriangle(const XMFLOAT4 (&clipPositions)[3], const XMFLOAT2 (&textCoords)[3],
+							   unsigned int instanceID, Triangle& triangle)const;
+
+			void binTriangle(unsigned int triangleIndex)const;
+
+			//evaluates the 4 pixels of row y starting from column x: returns the coverage bitmask and the texture coordinates
+			static unsigned int rasterizeQuad(const Triangle& triangle, int x, int y, int minX, int maxX,
+											  float (&us)[4], float (&vs)[4]);
+
+			unsigned long long rasterizeTile(unsigned int tileIndex, const DrawContext& drawContext)const;
+
+			void clearTile(unsigned int tileIndex)const;
+
+			void tileBounds(unsigned int tileIndex, int& minX, int& minY, int& maxX, int& maxY)const;
+
+			template<typename T>
+			using ResourceMap = std::unordered_map<IDType, T>;
+
+			template<typename T>
+			using ResourceMapIterator = typename ResourceMap<T>::iterator;
+
+			template<typename T>
+			using ResourceMapConstIterator = typename ResourceMap<T>::const_iterator;
+
+			template<typename T>
+			ResourceMapConstIterator<T> findAndCheckResource(const ResourceMap<T>& resourceMap, IDType resourceID)const;
+
+			template<typename T>
+			ResourceMapIterator<T> findAndCheckResourceToModify(ResourceMap<T>& resourceMap, IDType resourceID);
+
+			template<typename T>
+			void removeResourceMapElement(ResourceMap<T>& resourceMap, IDType resourceID);
+
+			ResourceMap<EVertexType> m_vertexShaders{};
+			ResourceMap<SoftwarePixelShader> m_pixelShaders{};
+			ResourceMap<std::vector<XMFLOAT4>> m_constantBuffers{};
+			ResourceMap<SoftwareTexture> m_textures{};
+			ResourceMap<SoftwareMesh> m_meshes{};
+			ResourceMap<PipelineState> m_pipelineStates{};
+			ResourceMap<IDType> m_pipelineStateDatas{};
+
+			IDType m_currentPipelineStateID{};
+			IDType m_currentPipelineStateDataID{};
+
+			unsigned int m_width{ 0 };
+			unsigned int m_height{ 0 };
+			unsigned int m_tilesCountX{ 0 };
+			unsigned int m_tilesCountY{ 0 };
+
+			//mutable because draw and frame calls are const, as in D3D11::Renderer
+			mutable std::vector<uint32_t> m_frameBuffer{};
+
+			//per draw scratch memory, kept across draws to avoid allocations
+			mutable std::vector<Triangle> m_triangles{};
+			mutable std::vector<std::vector<unsigned int>> m_tilesTriangles{};
+			mutable std::vector<unsigned long long> m_tilesShadedPixelsCounts{};
+
+			mutable RendererCounters m_counters{};
+
+			mutable ThreadPool m_threadPool;
+		};
+
+		inline const RendererCounters& Renderer::counters()const
+		{
+			return m_counters;
+		}
+
+		inline unsigned int Renderer::width()const
+		{
+			return m_width;
+		}
+
+		inline unsigned int Renderer::height()const
+		{
+			return m_height;
+		}
+
+		inline const unsigned char* Renderer::frameBufferData()const
+		{
+			return reinterpret_cast<const unsigned char*>(m_frameBuffer.data());
+		}
+
+		template<typename T>
+		inline
+			Renderer::ResourceMapConstIterator<T>
+				Renderer::findAndCheckResource(const ResourceMap<T>& resourceMap, IDType resourceID)const
+		{
+			auto it = resourceMap.find(resourceID);
+			assert(it != resourceMap.end());
+			return it;
+		}
+
+		template<typename T>
+		inline
+			Renderer::ResourceMapIterator<T>
+				Renderer::findAndCheckResourceToModify(ResourceMap<T>& resourceMap, IDType resourceID)
+		{
+			auto it = resourceMap.find(resourceID);
+			assert(it != resourceMap.end());
+			return it;
+		}
+
+		template<typename T>
+		inline void Renderer::removeResourceMapElement(ResourceMap<T>& resourceMap, IDType resourceID)
+		{
+			auto it = findAndCheckResource(resourceMap, resourceID);
+			resourceMap.erase(it);
+		}
+	}
+}
\ No newline at end of file
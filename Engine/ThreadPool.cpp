@@ -0,0 +1,192 @@
+#include "ThreadPool.h"
+#include <cassert>
+
+using namespace ArkanoidEngine;
+
+ThreadPool::ThreadPool(unsigned int threadsCount)
+{
+	if (threadsCount == 0)
+	{
+		threadsCount = std::thread::hardware_concurrency();
+	}
+
+	//hardware_concurrency() may return 0 when the value is not computable
+	const unsigned int workersCount = threadsCount > 1 ? threadsCount - 1 : 0;
+
+	m_tasksRanges.reset(new TasksRange[workersCount + 1]);
+
+	m_workers.reserve(workersCount);
+	for (unsigned int workerIndex = 0; workerIndex < workersCount; ++workerIndex)
+	{
+		m_workers.emplace_back(&ThreadPool::workerLoop, this, workerIndex + 1);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+		m_stopping = true;
+	}
+
+	m_workAvailable.notify_all();
+
+	for (std::thread& worker : m_workers)
+	{
+		worker.join();
+	}
+}
+
+void ThreadPool::run(unsigned int tasksCount, TaskInvoker taskInvoker, const void* task)
+{
+	assert(taskInvoker != nullptr);
+	assert(task != nullptr);
+
+	if (m_workers.empty() || tasksCount <= 1)
+	{
+		for (unsigned int taskIndex = 0; taskIndex < tasksCount; ++taskIndex)
+		{
+			taskInvoker(task, taskIndex);
+		}
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+		assert(m_busyWorkersCount == 0 && "parallelFor is not reentrant");
+
+		m_taskInvoker = taskInvoker;
+		m_task = task;
+
+		//even split, the first (tasksCount % threadsCount) threads get one more task
+		const unsigned int rangesCount = threadsCount();
+		const unsigned int tasksPerRange = tasksCount / rangesCount;
+		const unsigned int remainingTasks = tasksCount % rangesCount;
+
+		unsigned int begin = 0;
+		for (unsigned int rangeIndex = 0; rangeIndex < rangesCount; ++rangeIndex)
+		{
+			const unsigned int end = begin + tasksPerRange + static_cast<unsigned int>(rangeIndex < remainingTasks);
+			m_tasksRanges[rangeIndex].packedRange.store(packRange(begin, end), std::memory_order_relaxed);
+			begin = end;
+		}
+		assert(begin == tasksCount);
+
+		m_busyWorkersCount = static_cast<unsigned int>(m_workers.size());
+		++m_generation;
+	}
+
+	m_workAvailable.notify_all();
+
+	executeTasks(0);
+
+	std::unique_lock<std::mutex> lock{ m_mutex };
+	m_workCompleted.wait(lock, [this]() { return m_busyWorkersCount == 0; });
+}
+
+void ThreadPool::workerLoop(unsigned int threadIndex)
+{
+	unsigned long long lastGeneration = 0;
+
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock{ m_mutex };
+			m_workAvailable.wait(lock, [this, lastGeneration]() { return m_stopping || m_generation != lastGeneration; });
+
+			if (m_stopping)
+			{
+				return;
+			}
+
+			lastGeneration = m_generation;
+		}
+
+		executeTasks(threadIndex);
+
+		{
+			std::lock_guard<std::mutex> lock{ m_mutex };
+			--m_busyWorkersCount;
+			if (m_busyWorkersCount == 0)
+			{
+				m_workCompleted.notify_one();
+			}
+		}
+	}
+}
+
+void ThreadPool::executeTasks(unsigned int threadIndex)
+{
+	for (;;)
+	{
+		unsigned int taskIndex;
+		while (popTask(threadIndex, taskIndex))
+		{
+			m_taskInvoker(m_task, taskIndex);
+		}
+
+		if (!stealTasks(threadIndex))
+		{
+			return;
+		}
+	}
+}
+
+bool ThreadPool::popTask(unsigned int threadIndex, unsigned int& taskIndex)
+{
+	std::atomic<uint64_t>& packedRange = m_tasksRanges[threadIndex].packedRange;
+
+	uint64_t range = packedRange.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		const unsigned int begin = rangeBegin(range);
+		const unsigned int end = rangeEnd(range);
+
+		if (begin >= end)
+		{
+			return false;
+		}
+
+		//on failure range is reloaded, because a thief shrank it
+		if (packedRange.compare_exchange_weak(range, packRange(begin + 1, end), std::memory_order_relaxed))
+		{
+			taskIndex = begin;
+			return true;
+		}
+	}
+}
+
+bool ThreadPool::stealTasks(unsigned int threadIndex)
+{
+	const unsigned int rangesCount = threadsCount();
+
+	for (unsigned int victimOffset = 1; victimOffset < rangesCount; ++victimOffset)
+	{
+		const unsigned int victimIndex = (threadIndex + victimOffset) % rangesCount;
+		std::atomic<uint64_t>& victimPackedRange = m_tasksRanges[victimIndex].packedRange;
+
+		uint64_t range = victimPackedRange.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			const unsigned int begin = rangeBegin(range);
+			const unsigned int end = rangeEnd(range);
+
+			if (begin >= end)
+			{
+				break;
+			}
+
+			//leave [begin, middle) to the victim and take [middle, end), at least one task
+			const unsigned int middle = begin + (end - begin) / 2;
+
+			if (victimPackedRange.compare_exchange_weak(range, packRange(begin, middle), std::memory_order_relaxed))
+			{
+				//the own range is empty, so no thief is splitting it
+				m_tasksRanges[threadIndex].packedRange.store(packRange(middle, end), std::memory_order_relaxed);
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <type_traits>
+
+namespace ArkanoidEngine
+{
+	/*
+	a fixed set of threads executing the iterations of parallelFor() calls.
+	the calling thread takes part in the work, so a pool of N threads spawns N-1 workers.
+	the iterations are split in one contiguous range per thread: each thread consumes its own range from the front
+	and, once it is empty, steals the back half of the range of another thread.
+	parallelFor() must not be called from inside a task or from more than one thread at a time.
+	*/
+	class ThreadPool
+	{
+	public:
+		//ctors
+		//threadsCount == 0 uses one thread per hardware thread
+		explicit ThreadPool(unsigned int threadsCount = 0);
+
+		//dtor
+		~ThreadPool();
+
+		//copy
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		//move
+		ThreadPool(ThreadPool&&) = delete;
+		ThreadPool& operator=(ThreadPool&&) = delete;
+
+		//workers plus the calling thread
+		unsigned int threadsCount()const;
+
+		//calls task(taskIndex) for each taskIndex in [0, tasksCount) and returns when all of them have completed.
+		//the execution order is not defined
+		template<typename Task>
+		void parallelFor(unsigned int tasksCount, Task&& task);
+
+	private:
+		using TaskInvoker = void(*)(const void* task, unsigned int taskIndex);
+
+		//[begin, end) packed in a single atomic, so that the owner and the thieves can update it with one CAS
+		struct TasksRange
+		{
+			std::atomic<uint64_t> packedRange{ 0 };
+			char padding[64 - sizeof(std::atomic<uint64_t>)]; //avoids false sharing between threads
+		};
+
+		static uint64_t packRange(unsigned int begin, unsigned int end);
+		static unsigned int rangeBegin(uint64_t packedRange);
+		static unsigned int rangeEnd(uint64_t packedRange);
+
+		void run(unsigned int tasksCount, TaskInvoker taskInvoker, const void* task);
+		void workerLoop(unsigned int threadIndex);
+		void executeTasks(unsigned int threadIndex);
+
+		bool popTask(unsigned int threadIndex, unsigned int& taskIndex);
+		bool stealTasks(unsigned int threadIndex);
+
+		std::vector<std::thread> m_workers{};
+
+		std::mutex m_mutex{};
+		std::condition_variable m_workAvailable{};
+		std::condition_variable m_workCompleted{};
+
+		TaskInvoker m_taskInvoker{ nullptr };
+		const void* m_task{ nullptr };
+
+		//one per thread, the calling thread is the first one
+		std::unique_ptr<TasksRange[]> m_tasksRanges{};
+
+		unsigned int m_busyWorkersCount{ 0 };
+		unsigned long long m_generation{ 0 };
+		bool m_stopping{ false };
+	};
+
+	inline unsigned int ThreadPool::threadsCount()const
+	{
+		return static_cast<unsigned int>(m_workers.size()) + 1;
+	}
+
+	inline uint64_t ThreadPool::packRange(unsigned int begin, unsigned int end)
+	{
+		return static_cast<uint64_t>(begin) | (static_cast<uint64_t>(end) << 32);
+	}
+
+	inline unsigned int ThreadPool::rangeBegin(uint64_t packedRange)
+	{
+		return static_cast<unsigned int>(packedRange);
+	}
+
+	inline unsigned int ThreadPool::rangeEnd(uint64_t packedRange)
+	{
+		return static_cast<unsigned int>(packedRange >> 32);
+	}
+
+	template<typename Task>
+	inline void ThreadPool::parallelFor(unsigned int tasksCount, Task&& task)
+	{
+		using TaskType = typename std::remove_reference<Task>::type;
+
+		//no type erasure allocation: the task is referenced through a plain function pointer
+		TaskInvoker taskInvoker = [](const void* taskToInvoke, unsigned int taskIndex)
+		{
+			(*static_cast<TaskType*>(const_cast<void*>(taskToInvoke)))(taskIndex);
+		};
+
+		run(tasksCount, taskInvoker, &task);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include "TestHelper.h"
+#include "BricksBitset.h"
+
+/*
+BricksBitset at the boundaries of its words: setFirst() with 0, 31, 32, 33 and gk_bricksCount bricks must leave alive
+exactly the bricks below the count, as test(), count(), none() and the words see them. set() and reset() of the bricks
+on either side of a word boundary must change their bit only
+*/
+
+using namespace ArkanoidTests;
+
+namespace
+{
+	constexpr unsigned int gk_boundaryBricksCounts[] = { 0, 31, 32, 33, gk_bricksCount };
+
+	static_assert(gk_bricksCount == 120, "the boundaries are chosen for 120 bricks in 4 words");
+	static_assert(BricksBitset::sk_wordsCount == 4, "the boundaries are chosen for 120 bricks in 4 words");
+
+	//the bits the first aliveBricksCount bricks set in the word wordIndex
+	unsigned int expectedWord(unsigned int aliveBricksCount, unsigned int wordIndex)
+	{
+		unsigned int word = 0;
+		for (unsigned int bit = 0; bit < BricksBitset::sk_bitsPerWord; ++bit)
+		{
+			if (wordIndex * BricksBitset::sk_bitsPerWord + bit < aliveBricksCount)
+			{
+				word |= 1u << bit;
+			}
+		}
+		return word;
+	}
+
+	//the bricks alive are the ones below aliveBricksCount but deadBrickIndex, if any
+	bool sameBricks(const BricksBitset& bricks, unsigned int aliveBricksCount, unsigned int deadBrickIndex = gk_bricksCount)
+	{
+		unsigned int differentBricksCount = 0;
+		for (unsigned int brickIndex = 0; brickIndex < gk_bricksCount; ++brickIndex)
+		{
+			const bool alive = brickIndex < aliveBricksCount && brickIndex != deadBrickIndex;
+			differentBricksCount += static_cast<unsigned int>(bricks.test(brickIndex) != alive);
+		}
+		return differentBricksCount == 0;
+	}
+
+	void checkSetFirst()
+	{
+		for (unsigned int aliveBricksCount : gk_boundaryBricksCounts)
+		{
+			const std::string context = std::to_string(aliveBricksCount) + " bricks";
+
+			//from all the bricks dead and from all the bricks alive, so that setFirst() must clear the bits too
+			BricksBitset bricks{};
+			bricks.setFirst(aliveBricksCount);
+
+			BricksBitset aliveBricks{};
+			aliveBricks.setFirst(gk_bricksCount);
+			aliveBricks.setFirst(aliveBricksCount);
+
+			for (const BricksBitset* checkedBricks : { &bricks, &aliveBricks })
+			{
+				ARKANOID_CHECK_CONTEXT(checkedBricks->count() == aliveBricksCount, context);
+				ARKANOID_CHECK_CONTEXT(checkedBricks->none() == (aliveBricksCount == 0), context);
+				ARKANOID_CHECK_CONTEXT(sameBricks(*checkedBricks, aliveBricksCount), context);
+
+				for (unsigned int wordIndex = 0; wordIndex < BricksBitset::sk_wordsCount; ++wordIndex)
+				{
+					ARKANOID_CHECK_CONTEXT(checkedBricks->words()[wordIndex] == expectedWord(aliveBricksCount, wordIndex),
+										   context + ", word " + std::to_string(wordIndex));
+				}
+			}
+		}
+
+		//the bricks past gk_bricksCount in the last word are never alive
+		BricksBitset bricks{};
+		bricks.setFirst(gk_bricksCount);
+		ARKANOID_CHECK(bricks.words()[BricksBitset::sk_wordsCount - 1] >> (gk_bricksCount % BricksBitset::sk_bitsPerWord) == 0);
+	}
+
+	void checkSetAndReset()
+	{
+		const unsigned int boundaryBricksIndices[] = { 0, 31, 32, 33, gk_bricksCount - 1 };
+
+		for (unsigned int brickIndex : boundaryBricksIndices)
+		{
+			const std::string context = "brick " + std::to_string(brickIndex);
+
+			BricksBitset bricks{};
+			bricks.setFirst(gk_bricksCount);
+
+			bricks.reset(brickIndex);
+			ARKANOID_CHECK_CONTEXT(!bricks.test(brickIndex), context);
+			ARKANOID_CHECK_CONTEXT(bricks.count() == gk_bricksCount - 1, context);
+			ARKANOID_CHECK_CONTEXT(!bricks.none(), context);
+			ARKANOID_CHECK_CONTEXT(sameBricks(bricks, gk_bricksCount, brickIndex), context);
+
+			//a dead brick stays dead
+			bricks.reset(brickIndex);
+			ARKANOID_CHECK_CONTEXT(bricks.count() == gk_bricksCount - 1, context);
+
+			bricks.set(brickIndex);
+			ARKANOID_CHECK_CONTEXT(bricks.count() == gk_bricksCount, context);
+			ARKANOID_CHECK_CONTEXT(sameBricks(bricks, gk_bricksCount), context);
+
+			//the only brick alive
+			BricksBitset brick{};
+			brick.set(brickIndex);
+			ARKANOID_CHECK_CONTEXT(brick.test(brickIndex), context);
+			ARKANOID_CHECK_CONTEXT(brick.count() == 1, context);
+			ARKANOID_CHECK_CONTEXT(!brick.none(), context);
+
+			brick.reset(brickIndex);
+			ARKANOID_CHECK_CONTEXT(brick.count() == 0, context);
+			ARKANOID_CHECK_CONTEXT(brick.none(), context);
+		}
+
+		//killing the bricks one after another, the last one dead leaves none()
+		BricksBitset bricks{};
+		bricks.setFirst(33);
+		for (unsigned int brickIndex = 0; brickIndex < 33; ++brickIndex)
+		{
+			ARKANOID_CHECK(!bricks.none());
+			bricks.reset(brickIndex);
+			ARKANOID_CHECK(bricks.count() == 33 - brickIndex - 1);
+		}
+		ARKANOID_CHECK(bricks.none());
+	}
+
+	void checkCountSetBits()
+	{
+		ARKANOID_CHECK(countSetBits(0u) == 0);
+		ARKANOID_CHECK(countSetBits(1u) == 1);
+		ARKANOID_CHECK(countSetBits(0x80000000u) == 1);
+		ARKANOID_CHECK(countSetBits(0x7FFFFFFFu) == 31);
+		ARKANOID_CHECK(countSetBits(~0u) == 32);
+		ARKANOID_CHECK(countSetBits(0x55555555u) == 16);
+	}
+}
+
+int main()
+{
+	checkCountSetBits();
+	checkSetFirst();
+	checkSetAndReset();
+
+	return testsResult("BricksBitsetTests");
+}
\ No newline at end of file
@@ -0,0 +1,826 @@
+#include "TestHelper.h"
+#include "Broadphase.h"
+#include "SimulationCore.h"
+#include "QuadtreeSubdivision.h"
+
+/*
+runs each broadphase through the same checks against the brute force AABB::intersects(), after insert(), build(),
+buildBulk(), remove(), update() and the insertion of the removed objects again: every object touching a query must be
+found, no object is found twice, only the stored objects are found and nothing is written past objectsCount() objects.
+the swept queries of a ball go through the same checks against the brute force clipping of its motion, and the Quadtree
+must visit the quadrants crossed by the motion in the order it reaches them. visitPotentialColliders() must visit the
+objects findPotentialColliders() finds, stop when told and visit the nearest quadrants first when asked. the quadtree of the game goes through the checks
+with each subdivision its tuning may pick
+*/
+
+using namespace ArkanoidTests;
+
+namespace
+{
+	//the objects a broadphase must hold at a step of the checks
+	struct StoredObjects
+	{
+		std::vector<XMFLOAT2> centers;
+		std::vector<unsigned int> datas;
+	};
+
+	/*
+	findObjects(queryIndex, foundObjects) writes the objects found by the broadphase for a query and returns their count,
+	findTouchingObjects(queryIndex) returns the ones the brute force finds
+	*/
+	template<typename Broadphase, typename FindObjects, typename FindTouchingObjects>
+	void checkFoundObjects(const Broadphase& broadphase, const ObjectsScene& scene, const StoredObjects& storedObjects, size_t queriesCount,
+						   FindObjects&& findObjects, FindTouchingObjects&& findTouchingObjects, const std::string& context)
+	{
+		if (!ARKANOID_CHECK_CONTEXT(broadphase.objectsCount() == storedObjects.datas.size(), context))
+		{
+			return;
+		}
+
+		//the datas of the checks are below twice the scene objects count
+		const size_t maxObjectData = 2 * scene.objectsDatas.size() + 1;
+		std::vector<unsigned char> isStored(maxObjectData, 0);
+		std::vector<unsigned char> isFound(maxObjectData, 0);
+
+		for (unsigned int objectData : storedObjects.datas)
+		{
+			isStored[objectData] = 1;
+		}
+
+		//a guard after the room given to the broadphase, which must not be written. the room past the objects found may be
+		//written, by the branchless scans
+		constexpr unsigned int guardObjectsCount = 8;
+		constexpr unsigned int guardObjectData = ~0u;
+		std::vector<unsigned int> foundObjects(broadphase.objectsCount() + guardObjectsCount);
+
+		for (size_t queryIndex = 0; queryIndex < queriesCount; ++queryIndex)
+		{
+			std::fill(foundObjects.begin(), foundObjects.end(), guardObjectData);
+			const unsigned int foundObjectsCount = findObjects(queryIndex, foundObjects.data());
+
+			if (!ARKANOID_CHECK_CONTEXT(foundObjectsCount <= broadphase.objectsCount(), context + ", query " + std::to_string(queryIndex)))
+			{
+				continue;
+			}
+
+			bool isGuardKept = true;
+			for (size_t guardIndex = broadphase.objectsCount(); guardIndex < foundObjects.size(); ++guardIndex)
+			{
+				isGuardKept = isGuardKept && foundObjects[guardIndex] == guardObjectData;
+			}
+
+			unsigned int unknownObjectsCount = 0;
+			unsigned int duplicatedObjectsCount = 0;
+			for (unsigned int foundIndex = 0; foundIndex < foundObjectsCount; ++foundIndex)
+			{
+				const unsigned int objectData = foundObjects[foundIndex];
+
+				if (objectData >= maxObjectData || !isStored[objectData])
+				{
+					++unknownObjectsCount;
+				}
+				else if (isFound[objectData])
+				{
+					++duplicatedObjectsCount;
+				}
+				else
+				{
+					isFound[objectData] = 1;
+				}
+			}
+
+			unsigned int missedObjectsCount = 0;
+			for (unsigned int touchingObject : findTouchingObjects(queryIndex))
+			{
+				missedObjectsCount += isFound[touchingObject] ? 0 : 1;
+			}
+
+			for (unsigned int foundIndex = 0; foundIndex < foundObjectsCount; ++foundIndex)
+			{
+				if (foundObjects[foundIndex] < maxObjectData)
+				{
+					isFound[foundObjects[foundIndex]] = 0;
+				}
+			}
+
+			if (!isGuardKept || unknownObjectsCount > 0 || duplicatedObjectsCount > 0 || missedObjectsCount > 0)
+			{
+				const std::string queryContext = context + ", query " + std::to_string(queryIndex);
+				ARKANOID_CHECK_CONTEXT(isGuardKept, queryContext);
+				ARKANOID_CHECK_CONTEXT(unknownObjectsCount == 0, queryContext);
+				ARKANOID_CHECK_CONTEXT(duplicatedObjectsCount == 0, queryContext);
+				ARKANOID_CHECK_CONTEXT(missedObjectsCount == 0, queryContext);
+			}
+		}
+	}
+
+	//the game queries its SwitchableBroadphase, which forwards to the Quadtree or to the enclosing AABB
+	template<typename Broadphase>
+	unsigned int findSweptObjects(const Broadphase& broadphase, const SweptQuery& query, unsigned int* foundObjects)
+	{
+		return findSweptPotentialColliders(broadphase, query.start, query.displacement, gk_ballHalfExtents, foundObjects);
+	}
+
+	template<unsigned int QUADTREE_MAX_DEPTH, typename SubdivisionPolicy>
+	unsigned int findSweptObjects(const SwitchableBroadphase<QUADTREE_MAX_DEPTH, SubdivisionPolicy>& broadphase, const SweptQuery& query,
+								  unsigned int* foundObjects)
+	{
+		return broadphase.findSweptPotentialColliders(query.start, query.displacement, gk_ballHalfExtents, foundObjects);
+	}
+
+	//the queries are checked against AABB::intersects(), the swept queries of a ball against the brute force clipping of
+	//its motion
+	template<typename Broadphase>
+	void checkQueries(const Broadphase& broadphase, const ObjectsScene& scene, const StoredObjects& storedObjects,
+					  const std::vector<AABB>& queries, const std::vector<SweptQuery>& sweptQueries, const std::string& context)
+	{
+		checkFoundObjects(broadphase, scene, storedObjects, queries.size(),
+						  [&](size_t queryIndex, unsigned int* foundObjects)
+		{
+			return broadphase.findPotentialColliders(queries[queryIndex], foundObjects);
+		},
+						  [&](size_t queryIndex)
+		{
+			return findTouchingObjects(storedObjects.centers, storedObjects.datas, scene.objectsHalfExtents, queries[queryIndex]);
+		}, context);
+
+		checkFoundObjects(broadphase, scene, storedObjects, sweptQueries.size(),
+						  [&](size_t queryIndex, unsigned int* foundObjects)
+		{
+			return findSweptObjects(broadphase, sweptQueries[queryIndex], foundObjects);
+		},
+						  [&](size_t queryIndex)
+		{
+			return findSweptTouchingObjects(storedObjects.centers, storedObjects.datas, scene.objectsHalfExtents, sweptQueries[queryIndex]);
+		}, context + ", swept");
+	}
+
+	//makeBroadphase(area, objectsHalfExtents, objectsCapacity) constructs the broadphase checked
+	template<typename MakeBroadphase>
+	void checkBroadphase(const std::string& broadphaseName, const ObjectsScene& scene, MakeBroadphase makeBroadphase)
+	{
+		const std::string context = broadphaseName + ", " + scene.name;
+		const unsigned int objectsCount = static_cast<unsigned int>(scene.objectsCenters.size());
+		const std::vector<AABB> queries = generateQueries(scene, 512, objectsCount);
+		const std::vector<SweptQuery> sweptQueries = generateSweptQueries(scene, 512, objectsCount);
+
+		const StoredObjects sceneObjects{ scene.objectsCenters, scene.objectsDatas };
+
+		//one object after another
+		{
+			auto broadphase = makeBroadphase(scene.area, scene.objectsHalfExtents, objectsCount);
+
+			for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+			{
+				broadphase.insert(scene.objectsCenters[objectIndex], scene.objectsDatas[objectIndex]);
+			}
+
+			checkQueries(broadphase, scene, sceneObjects, queries, sweptQueries, context + ", insert");
+		}
+
+		//the objects inserted before a build are removed by it
+		const unsigned int replacedObjectsCount = std::min(objectsCount, 8u);
+
+		{
+			auto broadphase = makeBroadphase(scene.area, scene.objectsHalfExtents, objectsCount);
+
+			for (unsigned int objectIndex = 0; objectIndex < replacedObjectsCount; ++objectIndex)
+			{
+				broadphase.insert(scene.objectsCenters[objectIndex], objectsCount + objectIndex);
+			}
+
+			broadphase.buildBulk(scene.area, scene.objectsCenters.data(), scene.objectsDatas.data(), objectsCount);
+
+			checkQueries(broadphase, scene, sceneObjects, queries, sweptQueries, context + ", buildBulk");
+		}
+
+		auto broadphase = makeBroadphase(scene.area, scene.objectsHalfExtents, objectsCount);
+
+		for (unsigned int objectIndex = 0; objectIndex < replacedObjectsCount; ++objectIndex)
+		{
+			broadphase.insert(scene.objectsCenters[objectIndex], objectsCount + objectIndex);
+		}
+
+		broadphase.build(scene.area, scene.objectsCenters.data(), scene.objectsDatas.data(), objectsCount);
+
+		checkQueries(broadphase, scene, sceneObjects, queries, sweptQueries, context + ", build");
+
+		//every other object, in a random order
+		std::mt19937 randomEngine{ objectsCount };
+
+		std::vector<unsigned int> objectsIndices(objectsCount);
+		for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+		{
+			objectsIndices[objectIndex] = objectIndex;
+		}
+		std::shuffle(objectsIndices.begin(), objectsIndices.end(), randomEngine);
+
+		const unsigned int removedObjectsCount = objectsCount / 2;
+		std::vector<unsigned char> isRemoved(objectsCount, 0);
+
+		for (unsigned int removedIndex = 0; removedIndex < removedObjectsCount; ++removedIndex)
+		{
+			const unsigned int objectIndex = objectsIndices[removedIndex];
+
+			ARKANOID_CHECK_CONTEXT(broadphase.remove(scene.objectsCenters[objectIndex], scene.objectsDatas[objectIndex]), context + ", remove");
+			ARKANOID_CHECK_CONTEXT(!broadphase.remove(scene.objectsCenters[objectIndex], scene.objectsDatas[objectIndex]), context + ", remove twice");
+			isRemoved[objectIndex] = 1;
+		}
+
+		if (objectsCount > 0)
+		{
+			ARKANOID_CHECK_CONTEXT(!broadphase.remove(scene.objectsCenters[0], 2 * objectsCount), context + ", remove an unknown object");
+		}
+
+		StoredObjects storedObjects;
+		for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+		{
+			if (!isRemoved[objectIndex])
+			{
+				storedObjects.centers.push_back(scene.objectsCenters[objectIndex]);
+				storedObjects.datas.push_back(scene.objectsDatas[objectIndex]);
+			}
+		}
+
+		checkQueries(broadphase, scene, storedObjects, queries, sweptQueries, context + ", remove");
+
+		//a third of the objects left move anywhere in the area, out of the cells or quadrants of the others
+		const XMFLOAT2 areaMin = scene.area.min() + scene.objectsHalfExtents;
+		const XMFLOAT2 areaMax = scene.area.max() - scene.objectsHalfExtents;
+		std::uniform_real_distribution<float> xDistribution{ areaMin.x, areaMax.x };
+		std::uniform_real_distribution<float> yDistribution{ areaMin.y, areaMax.y };
+
+		for (size_t storedIndex = 0; storedIndex < storedObjects.centers.size(); storedIndex += 3)
+		{
+			const XMFLOAT2 newObjectCenter{ xDistribution(randomEngine), yDistribution(randomEngine) };
+
+			ARKANOID_CHECK_CONTEXT(broadphase.update(storedObjects.centers[storedIndex], newObjectCenter, storedObjects.datas[storedIndex]),
+								   context + ", update");
+			storedObjects.centers[storedIndex] = newObjectCenter;
+		}
+
+		if (removedObjectsCount > 0)
+		{
+			const unsigned int objectIndex = objectsIndices[0];
+			ARKANOID_CHECK_CONTEXT(!broadphase.update(scene.objectsCenters[objectIndex], scene.objectsCenters[objectIndex], scene.objectsDatas[objectIndex]),
+								   context + ", update a removed object");
+		}
+
+		checkQueries(broadphase, scene, storedObjects, queries, sweptQueries, context + ", update");
+
+		//the removed objects come back, in the room they left
+		for (unsigned int removedIndex = 0; removedIndex < removedObjectsCount; ++removedIndex)
+		{
+			const unsigned int objectIndex = objectsIndices[removedIndex];
+
+			broadphase.insert(scene.objectsCenters[objectIndex], scene.objectsDatas[objectIndex]);
+			storedObjects.centers.push_back(scene.objectsCenters[objectIndex]);
+			storedObjects.datas.push_back(scene.objectsDatas[objectIndex]);
+		}
+
+		checkQueries(broadphase, scene, storedObjects, queries, sweptQueries, context + ", insert again");
+
+		for (size_t storedIndex = 0; storedIndex < storedObjects.centers.size(); ++storedIndex)
+		{
+			ARKANOID_CHECK_CONTEXT(broadphase.remove(storedObjects.centers[storedIndex], storedObjects.datas[storedIndex]), context + ", remove all");
+		}
+
+		checkQueries(broadphase, scene, StoredObjects{}, queries, sweptQueries, context + ", remove all");
+	}
+
+	template<typename Broadphase>
+	void checkBroadphase(const std::string& broadphaseName, const ObjectsScene& scene)
+	{
+		checkBroadphase(broadphaseName, scene, [](const AABB& area, const XMFLOAT2& objectsHalfExtents, unsigned int objectsCapacity)
+		{
+			return Broadphase{ area, objectsHalfExtents, objectsCapacity };
+		});
+	}
+
+	void checkBroadphases(const ObjectsScene& scene)
+	{
+		checkBroadphase<Quadtree<unsigned int, 3>>("Quadtree depth 3", scene);
+		checkBroadphase<Quadtree<unsigned int, 6>>("Quadtree depth 6", scene);
+		checkBroadphase<GridBroadphase>("GridBroadphase", scene);
+		checkBroadphase<SweepAndPruneBroadphase>("SweepAndPruneBroadphase", scene);
+		checkBroadphase<SimdBroadphase>("SimdBroadphase", scene);
+
+		//as the game stores its bricks
+		static const char* const broadphasesTypesNames[gk_broadphaseTypesCount] = { "quadtree", "grid", "sweep and prune", "simd scan" };
+
+		for (unsigned int type = 0; type < gk_broadphaseTypesCount; ++type)
+		{
+			checkBroadphase(std::string{ "SwitchableBroadphase " } + broadphasesTypesNames[type], scene,
+							[type](const AABB& area, const XMFLOAT2& objectsHalfExtents, unsigned int objectsCapacity)
+			{
+				return SimulationCore::BricksBroadphase{ area, objectsHalfExtents, objectsCapacity, static_cast<EBroadphaseType>(type) };
+			});
+		}
+	}
+
+	//the subdivision policies on hand computed cases, at their thresholds
+	void checkSubdivisionPolicies()
+	{
+		ARKANOID_CHECK(!CountThresholdSubdivisionPolicy<2>::shouldSubdivideQuadrant(2));
+		ARKANOID_CHECK(CountThresholdSubdivisionPolicy<2>::shouldSubdivideQuadrant(3));
+
+		TunableSubdivisionPolicy policy;
+		const XMFLOAT2 quadrantSize{ 8.0f, 8.0f };
+
+		SubdivisionSettings settings{};
+		settings.maxDepth = 2;
+		settings.maxLeafObjectsCount = 2;
+		policy.setSubdivisionSettings(settings);
+		ARKANOID_CHECK(!policy.shouldSubdivideQuadrant(2, 0, quadrantSize) && policy.shouldSubdivideQuadrant(3, 0, quadrantSize));
+		ARKANOID_CHECK(policy.shouldSubdivideQuadrant(3, 1, quadrantSize) && !policy.shouldSubdivideQuadrant(100, 2, quadrantSize));
+
+		//queries of 2 x 2 touch a child 36 / 100 as often as the quadrant: 0.64 of the objects are saved
+		settings.type = SUBDIVISION_AREA_COST;
+		settings.queriesHalfExtents = XMFLOAT2{ 1.0f, 1.0f };
+		settings.quadrantVisitCost = 1.0f;
+		policy.setSubdivisionSettings(settings);
+		ARKANOID_CHECK(!policy.shouldSubdivideQuadrant(6, 0, quadrantSize) && policy.shouldSubdivideQuadrant(7, 0, quadrantSize));
+
+		settings.quadrantVisitCost = 2.0f;
+		policy.setSubdivisionSettings(settings);
+		ARKANOID_CHECK(!policy.shouldSubdivideQuadrant(12, 0, quadrantSize) && policy.shouldSubdivideQuadrant(13, 0, quadrantSize));
+
+		//objects of 2 x 1 over a quarter of the quadrant: 8 of them fill it
+		settings.type = SUBDIVISION_LEAF_OCCUPANCY;
+		settings.objectsHalfExtents = XMFLOAT2{ 1.0f, 0.5f };
+		settings.maxLeafOccupancy = 0.25f;
+		policy.setSubdivisionSettings(settings);
+		ARKANOID_CHECK(!policy.shouldSubdivideQuadrant(8, 0, quadrantSize) && policy.shouldSubdivideQuadrant(9, 0, quadrantSize));
+		ARKANOID_CHECK(!policy.shouldSubdivideQuadrant(9, 2, quadrantSize));
+	}
+
+	//the quadtree of the game with each subdivision its tuning may pick, on the levels
+	void checkSubdivisionCandidates(const ObjectsScene& scene)
+	{
+		const std::vector<SubdivisionSettings> candidates = generateSubdivisionCandidates(SimulationCore::sk_quadtreeMaxDepth,
+																						  gk_bricksHalfExtents, gk_ballHalfExtents);
+
+		for (size_t candidateIndex = 0; candidateIndex < candidates.size(); ++candidateIndex)
+		{
+			const SubdivisionSettings& settings = candidates[candidateIndex];
+
+			checkBroadphase("Quadtree (game) candidate " + std::to_string(candidateIndex), scene,
+							[&settings](const AABB& area, const XMFLOAT2& objectsHalfExtents, unsigned int objectsCapacity)
+			{
+				SimulationCore::Quadtree quadtree{ area, objectsHalfExtents, objectsCapacity };
+				quadtree.setSubdivisionSettings(settings);
+				return quadtree;
+			});
+		}
+	}
+
+	/*
+	GridBroadphase aligns its cells of the bricks size to the first object, so the bricks out of that lattice overlap up
+	to four cells and are found in the first cell a query shares with them: the Quadtree, which the game used before,
+	checks the same scenes. the spacings go from the lattice to twice the bricks size, on each axis
+	*/
+	void checkSpacedColumns()
+	{
+		const float spacingsScales[] = { 1.0f, 1.1f, 1.33f, 1.5f, 1.8f, 2.0f };
+		const XMFLOAT2 firstBrickOffsets[] = { XMFLOAT2{ 0.0f, 0.0f }, XMFLOAT2{ 0.37f, -0.61f } };
+
+		for (float columnsSpacingScale : spacingsScales)
+		{
+			for (float rowsSpacingScale : spacingsScales)
+			{
+				for (const XMFLOAT2& firstBrickOffset : firstBrickOffsets)
+				{
+					const float columnsSpacing = gk_bricksWidth * columnsSpacingScale;
+					const float rowsSpacing = gk_bricksHeight * rowsSpacingScale;
+					const unsigned int columnsCount = static_cast<unsigned int>((gk_arenaWidth - gk_bricksWidth - 1.0f) / columnsSpacing) + 1;
+					const unsigned int rowsCount = static_cast<unsigned int>((gk_arenaHeight * 0.5f) / rowsSpacing);
+
+					const ObjectsScene scene = spacedColumnsScene(columnsCount, rowsCount, columnsSpacing, rowsSpacing, firstBrickOffset);
+
+					checkBroadphase<GridBroadphase>("GridBroadphase", scene);
+					checkBroadphase<SimulationCore::Quadtree>("Quadtree (game)", scene);
+				}
+			}
+		}
+	}
+
+	//Quadrant::crossed() for a ball of half extents 0.5 and a quadrant of 4 x 4 at the origin
+	void checkQuadrantCrossed()
+	{
+		Quadrant quadrant;
+		quadrant.min() = XMFLOAT2{ 0.0f, 0.0f };
+
+		const XMFLOAT2 quadrantSize{ 4.0f, 4.0f };
+		const XMFLOAT2 halfExtents{ 0.5f, 0.5f };
+
+		auto crossed = [&](const XMFLOAT2& start, const XMFLOAT2& displacement, float& enterTime)
+		{
+			const XMFLOAT2 inverseDisplacement{ displacement.x != 0.0f ? 1.0f / displacement.x : 0.0f,
+												displacement.y != 0.0f ? 1.0f / displacement.y : 0.0f };
+			return quadrant.crossed(start, inverseDisplacement, halfExtents, quadrantSize, enterTime);
+		};
+
+		auto isNear = [](float value, float expectedValue)
+		{
+			return std::abs(value - expectedValue) < 1e-5f;
+		};
+
+		float enterTime = -1.0f;
+
+		//inside, moving or not
+		ARKANOID_CHECK(crossed(XMFLOAT2{ 2.0f, 2.0f }, XMFLOAT2{ 10.0f, 3.0f }, enterTime) && enterTime == 0.0f);
+		ARKANOID_CHECK(crossed(XMFLOAT2{ 2.0f, 2.0f }, XMFLOAT2{ 0.0f, 0.0f }, enterTime) && enterTime == 0.0f);
+
+		//touching the left side when it starts, moving away from it
+		ARKANOID_CHECK(crossed(XMFLOAT2{ -0.5f, 2.0f }, XMFLOAT2{ -10.0f, 0.0f }, enterTime) && enterTime == 0.0f);
+
+		//reaching the grown left side at x == -0.5 after a quarter of the displacement, on each side of it
+		ARKANOID_CHECK(crossed(XMFLOAT2{ -3.0f, 2.0f }, XMFLOAT2{ 10.0f, 0.0f }, enterTime) && isNear(enterTime, 0.25f));
+		ARKANOID_CHECK(crossed(XMFLOAT2{ 7.0f, 2.0f }, XMFLOAT2{ -10.0f, 0.0f }, enterTime) && isNear(enterTime, 0.25f));
+		ARKANOID_CHECK(crossed(XMFLOAT2{ -2.0f, -2.0f }, XMFLOAT2{ 4.0f, 4.0f }, enterTime) && isNear(enterTime, 0.375f));
+
+		//stopping at the grown side, before it and moving away
+		ARKANOID_CHECK(crossed(XMFLOAT2{ -3.0f, 2.0f }, XMFLOAT2{ 2.5f, 0.0f }, enterTime) && isNear(enterTime, 1.0f));
+		ARKANOID_CHECK(!crossed(XMFLOAT2{ -3.0f, 2.0f }, XMFLOAT2{ 2.0f, 0.0f }, enterTime));
+		ARKANOID_CHECK(!crossed(XMFLOAT2{ -3.0f, 2.0f }, XMFLOAT2{ -10.0f, 0.0f }, enterTime));
+
+		//without displacement or along an axis, out of the quadrant on the other axis
+		ARKANOID_CHECK(!crossed(XMFLOAT2{ -1.0f, 2.0f }, XMFLOAT2{ 0.0f, 0.0f }, enterTime));
+		ARKANOID_CHECK(!crossed(XMFLOAT2{ -3.0f, 5.0f }, XMFLOAT2{ 10.0f, 0.0f }, enterTime));
+
+		//passing by the corner, the segment crosses the grown quadrant on each axis but not at the same time
+		ARKANOID_CHECK(!crossed(XMFLOAT2{ -3.0f, 3.0f }, XMFLOAT2{ 4.0f, 4.0f }, enterTime));
+	}
+
+	//one small object in each quadrant at depth gk_leavesDepth, which a quadtree subdividing any quadrant holding an object
+	//puts there: the data of an object tells its leaf, the order in which two objects are visited the one of their ancestors
+	constexpr unsigned int gk_leavesDepth = 3;
+	constexpr unsigned int gk_leavesPerSide = 1 << gk_leavesDepth;
+
+	using LeavesQuadtree = Quadtree<unsigned int, gk_leavesDepth, CountThresholdSubdivisionPolicy<0>>;
+
+	ObjectsScene leavesScene()
+	{
+		const AABB area = arenaArea();
+		const XMFLOAT2 cellSize = (area.max() - area.min()) * (1.0f / gk_leavesPerSide);
+
+		ObjectsScene scene{ "a small object per leaf", area, XMFLOAT2{ 0.2f, 0.2f }, {}, {} };
+		for (unsigned int cellY = 0; cellY < gk_leavesPerSide; ++cellY)
+		{
+			for (unsigned int cellX = 0; cellX < gk_leavesPerSide; ++cellX)
+			{
+				scene.objectsCenters.push_back(area.min() + XMFLOAT2{ (cellX + 0.5f) * cellSize.x, (cellY + 0.5f) * cellSize.y });
+				scene.objectsDatas.push_back(cellY * gk_leavesPerSide + cellX);
+			}
+		}
+
+		return scene;
+	}
+
+	//the quadrant at depth holding the object, placed as the quadtree places it: gk_epsilon apart from its siblings
+	Quadrant leafAncestor(const AABB& area, unsigned int objectData, unsigned int depth, XMFLOAT2& quadrantSize)
+	{
+		Quadrant quadrant;
+		quadrant.min() = area.min();
+		quadrantSize = area.max() - area.min();
+
+		for (unsigned int childDepth = 1; childDepth <= depth; ++childDepth)
+		{
+			quadrantSize = quadrantSize * 0.5f;
+
+			const unsigned int shift = gk_leavesDepth - childDepth;
+			const float offsetX = ((objectData % gk_leavesPerSide) >> shift) & 1 ? quadrantSize.x + gk_epsilon : 0.0f;
+			const float offsetY = ((objectData / gk_leavesPerSide) >> shift) & 1 ? quadrantSize.y + gk_epsilon : 0.0f;
+			quadrant.min() = quadrant.min() + XMFLOAT2{ offsetX, offsetY };
+		}
+
+		return quadrant;
+	}
+
+	//the depth of the first ancestors which differ, the siblings the quadtree has ordered. one object per leaf, so two
+	//objects have different ancestors at gk_leavesDepth at the latest
+	unsigned int firstDifferentAncestorsDepth(unsigned int objectData, unsigned int otherObjectData)
+	{
+		unsigned int depth = 1;
+		for (; depth < gk_leavesDepth; ++depth)
+		{
+			const unsigned int shift = gk_leavesDepth - depth;
+			if (((objectData % gk_leavesPerSide) >> shift) != ((otherObjectData % gk_leavesPerSide) >> shift) ||
+				((objectData / gk_leavesPerSide) >> shift) != ((otherObjectData / gk_leavesPerSide) >> shift))
+			{
+				break;
+			}
+		}
+
+		return depth;
+	}
+
+	/*
+	visitSweptPotentialColliders() on the leaves scene must visit the objects of the quadrants which Quadrant::crossed()
+	tells the ball crosses, from the root down, and no other. of two objects visited one after the other, the first has the
+	lower enter time in the first ancestors which differ, as the siblings are visited in the order the motion reaches them.
+	a visitor returning false stops the visit at once
+	*/
+	void checkSweptVisitOrder()
+	{
+		const ObjectsScene scene = leavesScene();
+		const AABB& area = scene.area;
+
+		const unsigned int objectsCount = static_cast<unsigned int>(scene.objectsDatas.size());
+		LeavesQuadtree quadtree{ area, scene.objectsHalfExtents, objectsCount };
+		quadtree.build(area, scene.objectsCenters.data(), scene.objectsDatas.data(), objectsCount);
+
+		for (const SweptQuery& query : generateSweptQueries(scene, 1024, objectsCount))
+		{
+			const XMFLOAT2 inverseDisplacement{ query.displacement.x != 0.0f ? 1.0f / query.displacement.x : 0.0f,
+												query.displacement.y != 0.0f ? 1.0f / query.displacement.y : 0.0f };
+
+			//the enter times in the quadrants holding each object, from the root, negative if a quadrant is not crossed
+			std::vector<float> enterTimes(objectsCount * (gk_leavesDepth + 1));
+			std::vector<unsigned int> crossedObjects;
+
+			for (unsigned int objectData = 0; objectData < objectsCount; ++objectData)
+			{
+				bool isCrossed = true;
+
+				for (unsigned int depth = 0; depth <= gk_leavesDepth; ++depth)
+				{
+					XMFLOAT2 quadrantSize;
+					const Quadrant quadrant = leafAncestor(area, objectData, depth, quadrantSize);
+
+					float enterTime;
+					isCrossed = isCrossed && quadrant.crossed(query.start, inverseDisplacement, gk_ballHalfExtents, quadrantSize, enterTime);
+					enterTimes[objectData * (gk_leavesDepth + 1) + depth] = isCrossed ? enterTime : -1.0f;
+				}
+
+				if (isCrossed)
+				{
+					crossedObjects.push_back(objectData);
+				}
+			}
+
+			std::vector<unsigned int> visitedObjects;
+			quadtree.visitSweptPotentialColliders(query.start, query.displacement, gk_ballHalfExtents,
+												  [&visitedObjects](unsigned int objectData, const XMFLOAT2&)
+			{
+				visitedObjects.push_back(objectData);
+				return true;
+			});
+
+			const std::string context = "start (" + std::to_string(query.start.x) + ", " + std::to_string(query.start.y) +
+										"), displacement (" + std::to_string(query.displacement.x) + ", " + std::to_string(query.displacement.y) + ")";
+
+			std::vector<unsigned int> sortedVisitedObjects = visitedObjects;
+			std::sort(sortedVisitedObjects.begin(), sortedVisitedObjects.end());
+			ARKANOID_CHECK_CONTEXT(sortedVisitedObjects == crossedObjects, context);
+
+			unsigned int misorderedObjectsCount = 0;
+			for (size_t visitedIndex = 1; visitedIndex < visitedObjects.size(); ++visitedIndex)
+			{
+				const float* previousEnterTimes = &enterTimes[visitedObjects[visitedIndex - 1] * (gk_leavesDepth + 1)];
+				const float* nextEnterTimes = &enterTimes[visitedObjects[visitedIndex] * (gk_leavesDepth + 1)];
+
+				//the siblings of the first ancestors which differ are visited by increasing enter time
+				const unsigned int depth = firstDifferentAncestorsDepth(visitedObjects[visitedIndex - 1], visitedObjects[visitedIndex]);
+				misorderedObjectsCount += previousEnterTimes[depth] > nextEnterTimes[depth] ? 1 : 0;
+			}
+			ARKANOID_CHECK_CONTEXT(misorderedObjectsCount == 0, context);
+
+			//stopped half way
+			const unsigned int stopCount = static_cast<unsigned int>(visitedObjects.size() / 2);
+			unsigned int visitsCount = 0;
+			const bool completed = quadtree.visitSweptPotentialColliders(query.start, query.displacement, gk_ballHalfExtents,
+																		 [&visitsCount, stopCount](unsigned int, const XMFLOAT2&)
+			{
+				return ++visitsCount <= stopCount;
+			});
+
+			ARKANOID_CHECK_CONTEXT(completed == visitedObjects.empty(), context);
+			ARKANOID_CHECK_CONTEXT(visitsCount == (visitedObjects.empty() ? 0 : stopCount + 1), context);
+		}
+	}
+
+	//visits the objects of the quadtree for queryAABB, the visitor returning false after stopCount objects
+	template<typename Quadtree>
+	std::vector<unsigned int> visitObjects(const Quadtree& quadtree, const AABB& queryAABB, EQuadrantsVisitOrder visitOrder,
+										   unsigned int stopCount, bool& completed)
+	{
+		std::vector<unsigned int> visitedObjects;
+		completed = quadtree.visitPotentialColliders(queryAABB, [&visitedObjects, stopCount](unsigned int objectData, const XMFLOAT2&)
+		{
+			visitedObjects.push_back(objectData);
+			return visitedObjects.size() <= stopCount;
+		}, visitOrder);
+
+		return visitedObjects;
+	}
+
+	/*
+	visitPotentialColliders() visits the objects findPotentialColliders() finds, in its order with QUADRANTS_VISIT_IN_ORDER.
+	a visitor returning false stops the visit at once, after the objects visited before in either order
+	*/
+	template<typename Quadtree>
+	void checkVisit(const ObjectsScene& scene, const std::string& quadtreeName)
+	{
+		const unsigned int objectsCount = static_cast<unsigned int>(scene.objectsDatas.size());
+		Quadtree quadtree{ scene.area, scene.objectsHalfExtents, objectsCount };
+		quadtree.build(scene.area, scene.objectsCenters.data(), scene.objectsDatas.data(), objectsCount);
+
+		std::vector<unsigned int> foundObjects(objectsCount);
+		const unsigned int allObjects = ~0u;
+
+		for (const AABB& queryAABB : generateQueries(scene, 256, objectsCount))
+		{
+			const std::string context = quadtreeName + ", " + scene.name;
+
+			const unsigned int foundObjectsCount = quadtree.findPotentialColliders(queryAABB, foundObjects.data());
+			const std::vector<unsigned int> expectedObjects(foundObjects.begin(), foundObjects.begin() + foundObjectsCount);
+
+			bool completed;
+			const std::vector<unsigned int> inOrderObjects = visitObjects(quadtree, queryAABB, QUADRANTS_VISIT_IN_ORDER, allObjects, completed);
+			ARKANOID_CHECK_CONTEXT(completed && inOrderObjects == expectedObjects, context + ", in order");
+
+			std::vector<unsigned int> nearestFirstObjects = visitObjects(quadtree, queryAABB, QUADRANTS_VISIT_NEAREST_FIRST, allObjects, completed);
+			const std::vector<unsigned int> fullNearestFirstObjects = nearestFirstObjects;
+			std::vector<unsigned int> sortedExpectedObjects = expectedObjects;
+			std::sort(nearestFirstObjects.begin(), nearestFirstObjects.end());
+			std::sort(sortedExpectedObjects.begin(), sortedExpectedObjects.end());
+			ARKANOID_CHECK_CONTEXT(completed && nearestFirstObjects == sortedExpectedObjects, context + ", nearest first");
+
+			//stopped on the first object, half way and on the last one
+			for (unsigned int stopCount : { 0u, foundObjectsCount / 2, foundObjectsCount - 1 })
+			{
+				if (stopCount >= foundObjectsCount)
+				{
+					continue;
+				}
+
+				const std::vector<unsigned int> stoppedObjects = visitObjects(quadtree, queryAABB, QUADRANTS_VISIT_IN_ORDER, stopCount, completed);
+				ARKANOID_CHECK_CONTEXT(!completed && stoppedObjects.size() == stopCount + 1 &&
+									   std::equal(stoppedObjects.begin(), stoppedObjects.end(), expectedObjects.begin()), context + ", in order stopped");
+
+				const std::vector<unsigned int> stoppedNearestObjects = visitObjects(quadtree, queryAABB, QUADRANTS_VISIT_NEAREST_FIRST, stopCount, completed);
+				ARKANOID_CHECK_CONTEXT(!completed && stoppedNearestObjects.size() == stopCount + 1 &&
+									   std::equal(stoppedNearestObjects.begin(), stoppedNearestObjects.end(), fullNearestFirstObjects.begin()),
+									   context + ", nearest first stopped");
+			}
+		}
+	}
+
+	/*
+	QUADRANTS_VISIT_NEAREST_FIRST on the leaves scene: of two objects visited one after the other, the first ancestors
+	which differ are in nondecreasing distance of their centers from the query center
+	*/
+	void checkNearestFirstVisitOrder()
+	{
+		const ObjectsScene scene = leavesScene();
+		const unsigned int objectsCount = static_cast<unsigned int>(scene.objectsDatas.size());
+
+		LeavesQuadtree quadtree{ scene.area, scene.objectsHalfExtents, objectsCount };
+		quadtree.build(scene.area, scene.objectsCenters.data(), scene.objectsDatas.data(), objectsCount);
+
+		auto ancestorDistance = [&scene](unsigned int objectData, unsigned int depth, const XMFLOAT2& queryCenter)
+		{
+			XMFLOAT2 quadrantSize;
+			const Quadrant quadrant = leafAncestor(scene.area, objectData, depth, quadrantSize);
+			const XMFLOAT2 offset = quadrant.min() + quadrantSize * 0.5f - queryCenter;
+			return offset.x * offset.x + offset.y * offset.y;
+		};
+
+		unsigned int orderedPairsCount = 0;
+
+		for (const AABB& queryAABB : generateQueries(scene, 512, objectsCount))
+		{
+			bool completed;
+			const std::vector<unsigned int> visitedObjects = visitObjects(quadtree, queryAABB, QUADRANTS_VISIT_NEAREST_FIRST, ~0u, completed);
+
+			unsigned int misorderedObjectsCount = 0;
+			for (size_t visitedIndex = 1; visitedIndex < visitedObjects.size(); ++visitedIndex)
+			{
+				const unsigned int previousObject = visitedObjects[visitedIndex - 1];
+				const unsigned int nextObject = visitedObjects[visitedIndex];
+				const unsigned int depth = firstDifferentAncestorsDepth(previousObject, nextObject);
+
+				misorderedObjectsCount += ancestorDistance(previousObject, depth, queryAABB.center()) >
+										  ancestorDistance(nextObject, depth, queryAABB.center()) ? 1 : 0;
+				++orderedPairsCount;
+			}
+
+			ARKANOID_CHECK_CONTEXT(misorderedObjectsCount == 0, "query center (" + std::to_string(queryAABB.center().x) + ", " +
+																 std::to_string(queryAABB.center().y) + ")");
+		}
+
+		//the large queries visit many leaves, otherwise little has been ordered
+		ARKANOID_CHECK(orderedPairsCount > 500);
+	}
+
+
+	/*
+	findTouchingBoxes() against the brute force, for each instruction set of the CPU: the counts of boxes leave some of
+	them to the narrower paths, the masks kill single boxes and whole groups of 4 and 8
+	*/
+	void checkFindTouchingBoxes()
+	{
+		static const char* const simdLevelsNames[] = { "scalar", "SSE2", "AVX" };
+
+		const ESimdLevel cpuSimdLevel = findTouchingBoxesSimdLevel();
+		std::mt19937 randomEngine{ 4 };
+
+		for (unsigned int simdLevel = SIMD_LEVEL_SCALAR; simdLevel <= cpuSimdLevel; ++simdLevel)
+		{
+			setFindTouchingBoxesMaxSimdLevel(static_cast<ESimdLevel>(simdLevel));
+
+			for (unsigned int boxesCount : { 0u, 3u, 4u, 7u, 8u, 13u, 64u, 123u })
+			{
+				const ObjectsScene scene = randomScene("boxes", arenaArea(), gk_bricksHalfExtents, boxesCount, boxesCount);
+
+				std::vector<float> centersX;
+				std::vector<float> centersY;
+				for (const XMFLOAT2& center : scene.objectsCenters)
+				{
+					centersX.push_back(center.x);
+					centersY.push_back(center.y);
+				}
+
+				//alive boxes: all, one out of 3, none in the groups of 8 starting at multiples of 16
+				std::vector<unsigned int> boxesMask((boxesCount + 31) / 32 + 1, 0);
+				std::vector<unsigned char> isAlive(boxesCount, 0);
+				std::bernoulli_distribution aliveDistribution{ 1.0 / 3.0 };
+
+				for (unsigned int boxIndex = 0; boxIndex < boxesCount; ++boxIndex)
+				{
+					isAlive[boxIndex] = (boxIndex % 16) >= 8 && aliveDistribution(randomEngine);
+					boxesMask[boxIndex / 32] |= static_cast<unsigned int>(isAlive[boxIndex]) << (boxIndex % 32);
+				}
+
+				std::vector<unsigned int> foundIndices(boxesCount + 1);
+
+				for (const AABB& queryAABB : generateQueries(scene, 128, boxesCount))
+				{
+					const std::vector<unsigned int> touchingBoxes = findTouchingObjects(scene.objectsCenters, scene.objectsDatas,
+																						scene.objectsHalfExtents, queryAABB);
+					const std::string context = std::string{ simdLevelsNames[simdLevel] } + ", " + std::to_string(boxesCount) + " boxes";
+
+					unsigned int foundCount = findTouchingBoxes(centersX.data(), centersY.data(), boxesCount, scene.objectsHalfExtents,
+																queryAABB, foundIndices.data());
+					ARKANOID_CHECK_CONTEXT(std::vector<unsigned int>(foundIndices.begin(), foundIndices.begin() + foundCount) == touchingBoxes, context);
+
+					std::vector<unsigned int> touchingAliveBoxes;
+					for (unsigned int boxIndex : touchingBoxes)
+					{
+						if (isAlive[boxIndex])
+						{
+							touchingAliveBoxes.push_back(boxIndex);
+						}
+					}
+
+					foundCount = findTouchingBoxes(centersX.data(), centersY.data(), boxesCount, scene.objectsHalfExtents,
+												   queryAABB, foundIndices.data(), boxesMask.data());
+					ARKANOID_CHECK_CONTEXT(std::vector<unsigned int>(foundIndices.begin(), foundIndices.begin() + foundCount) == touchingAliveBoxes,
+										   context + ", masked");
+				}
+			}
+
+			//the broadphase of the game on the levels, with the same instruction set
+			for (unsigned int layoutIndex = 0; layoutIndex < gk_bricksLayoutsCount; ++layoutIndex)
+			{
+				checkBroadphase<SimdBroadphase>(std::string{ "SimdBroadphase " } + simdLevelsNames[simdLevel], bricksLayoutScene(layoutIndex));
+			}
+		}
+
+		setFindTouchingBoxesMaxSimdLevel(cpuSimdLevel);
+	}
+}
+
+int main()
+{
+	checkFindTouchingBoxes();
+
+	checkQuadrantCrossed();
+	checkSweptVisitOrder();
+	checkNearestFirstVisitOrder();
+	checkVisit<LeavesQuadtree>(leavesScene(), "Quadtree of leaves");
+
+	checkSubdivisionPolicies();
+
+	for (unsigned int layoutIndex = 0; layoutIndex < gk_bricksLayoutsCount; ++layoutIndex)
+	{
+		checkBroadphases(bricksLayoutScene(layoutIndex));
+		checkSubdivisionCandidates(bricksLayoutScene(layoutIndex));
+		checkVisit<SimulationCore::Quadtree>(bricksLayoutScene(layoutIndex), "Quadtree (game)");
+		checkVisit<Quadtree<unsigned int, 6>>(bricksLayoutScene(layoutIndex), "Quadtree depth 6");
+	}
+
+	//out of the bricks lattice, as the spaced columns layout with other spacings and offsets
+	checkBroadphases(spacedColumnsScene(6, 20, 7.2f, gk_bricksHeight, XMFLOAT2{ 0.0f, 0.0f }));
+	checkBroadphases(spacedColumnsScene(5, 20, 5.3f, gk_bricksHeight, XMFLOAT2{ 1.3f, -0.7f }));
+
+	checkSpacedColumns();
+
+	const AABB area = arenaArea();
+	checkBroadphases(randomScene("random bricks", area, gk_bricksHalfExtents, 400, 1));
+	checkBroadphases(randomScene("random small objects", area, XMFLOAT2{ 0.3f, 0.2f }, 1000, 2));
+	checkBroadphases(randomScene("no object", area, gk_bricksHalfExtents, 0, 3));
+
+	return testsResult("BroadphaseTests");
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include "TestHelper.h"
+#include "DynamicQuadtree.h"
+#include "Quadtree.h"
+
+/*
+DynamicQuadtree follows the rules of Quadtree: with the same maximum depth, both must find the same objects in the same
+order after each insertion, removal, update and clear(), and those objects must include the ones touching the query
+*/
+
+using namespace ArkanoidTests;
+
+namespace
+{
+	template<unsigned int MAX_DEPTH>
+	void checkFoundObjects(const Quadtree<unsigned int, MAX_DEPTH>& quadtree, const DynamicQuadtree<>& dynamicQuadtree,
+						   const ObjectsScene& scene, const std::vector<XMFLOAT2>& storedCenters, const std::vector<unsigned int>& storedDatas,
+						   const std::vector<AABB>& queries, const std::string& context)
+	{
+		if (!ARKANOID_CHECK_CONTEXT(dynamicQuadtree.objectsCount() == quadtree.objectsCount(), context))
+		{
+			return;
+		}
+
+		std::vector<unsigned int> foundObjects(std::max(quadtree.objectsCount(), 1u));
+		std::vector<unsigned int> dynamicFoundObjects(foundObjects.size());
+
+		unsigned int differentQueriesCount = 0;
+		unsigned int missedObjectsCount = 0;
+
+		for (const AABB& queryAABB : queries)
+		{
+			const unsigned int foundObjectsCount = quadtree.findPotentialColliders(queryAABB, foundObjects.data());
+			const unsigned int dynamicFoundObjectsCount = dynamicQuadtree.findPotentialColliders(queryAABB, dynamicFoundObjects.data());
+
+			if (foundObjectsCount != dynamicFoundObjectsCount ||
+				!std::equal(foundObjects.begin(), foundObjects.begin() + foundObjectsCount, dynamicFoundObjects.begin()))
+			{
+				++differentQueriesCount;
+				continue;
+			}
+
+			for (unsigned int touchingObject : findTouchingObjects(storedCenters, storedDatas, scene.objectsHalfExtents, queryAABB))
+			{
+				const auto dynamicFoundObjectsEnd = dynamicFoundObjects.begin() + dynamicFoundObjectsCount;
+				missedObjectsCount += std::find(dynamicFoundObjects.begin(), dynamicFoundObjectsEnd, touchingObject) == dynamicFoundObjectsEnd ? 1 : 0;
+			}
+		}
+
+		ARKANOID_CHECK_CONTEXT(differentQueriesCount == 0, context);
+		ARKANOID_CHECK_CONTEXT(missedObjectsCount == 0, context);
+	}
+
+	template<unsigned int MAX_DEPTH>
+	void checkDynamicQuadtree(const ObjectsScene& scene)
+	{
+		const std::string context = scene.name + ", depth " + std::to_string(MAX_DEPTH);
+		const unsigned int objectsCount = static_cast<unsigned int>(scene.objectsCenters.size());
+		const std::vector<AABB> queries = generateQueries(scene, 512, objectsCount);
+
+		Quadtree<unsigned int, MAX_DEPTH> quadtree{ scene.area, scene.objectsHalfExtents, objectsCount };
+		DynamicQuadtree<> dynamicQuadtree{ scene.area, scene.objectsHalfExtents, MAX_DEPTH, objectsCount };
+
+		ARKANOID_CHECK_CONTEXT(dynamicQuadtree.maxDepth() == MAX_DEPTH, context);
+		ARKANOID_CHECK_CONTEXT(dynamicQuadtree.objectsCapacity() == objectsCount, context);
+
+		for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+		{
+			quadtree.insert(scene.objectsCenters[objectIndex], scene.objectsDatas[objectIndex]);
+			dynamicQuadtree.insert(scene.objectsCenters[objectIndex], scene.objectsDatas[objectIndex]);
+		}
+
+		std::vector<XMFLOAT2> storedCenters = scene.objectsCenters;
+		std::vector<unsigned int> storedDatas = scene.objectsDatas;
+
+		checkFoundObjects(quadtree, dynamicQuadtree, scene, storedCenters, storedDatas, queries, context + ", insert");
+
+		//every other object, so some quadrants get empty and merge
+		std::vector<XMFLOAT2> removedCenters;
+		std::vector<unsigned int> removedDatas;
+
+		for (size_t storedIndex = 0; storedIndex < storedCenters.size(); ++storedIndex)
+		{
+			const bool removed = dynamicQuadtree.remove(storedCenters[storedIndex], storedDatas[storedIndex]);
+			quadtree.remove(storedCenters[storedIndex], storedDatas[storedIndex]);
+
+			ARKANOID_CHECK_CONTEXT(removed, context + ", remove");
+			ARKANOID_CHECK_CONTEXT(!dynamicQuadtree.remove(storedCenters[storedIndex], storedDatas[storedIndex]), context + ", remove twice");
+
+			removedCenters.push_back(storedCenters[storedIndex]);
+			removedDatas.push_back(storedDatas[storedIndex]);
+			storedCenters.erase(storedCenters.begin() + storedIndex);
+			storedDatas.erase(storedDatas.begin() + storedIndex);
+		}
+
+		checkFoundObjects(quadtree, dynamicQuadtree, scene, storedCenters, storedDatas, queries, context + ", remove");
+
+		std::mt19937 randomEngine{ objectsCount };
+		std::uniform_real_distribution<float> xDistribution{ scene.area.min().x + scene.objectsHalfExtents.x, scene.area.max().x - scene.objectsHalfExtents.x };
+		std::uniform_real_distribution<float> yDistribution{ scene.area.min().y + scene.objectsHalfExtents.y, scene.area.max().y - scene.objectsHalfExtents.y };
+
+		for (size_t storedIndex = 0; storedIndex < storedCenters.size(); storedIndex += 3)
+		{
+			const XMFLOAT2 newObjectCenter{ xDistribution(randomEngine), yDistribution(randomEngine) };
+
+			ARKANOID_CHECK_CONTEXT(dynamicQuadtree.update(storedCenters[storedIndex], newObjectCenter, storedDatas[storedIndex]), context + ", update");
+			quadtree.update(storedCenters[storedIndex], newObjectCenter, storedDatas[storedIndex]);
+			storedCenters[storedIndex] = newObjectCenter;
+		}
+
+		if (!removedCenters.empty())
+		{
+			ARKANOID_CHECK_CONTEXT(!dynamicQuadtree.update(removedCenters[0], removedCenters[0], removedDatas[0]), context + ", update a removed object");
+		}
+
+		checkFoundObjects(quadtree, dynamicQuadtree, scene, storedCenters, storedDatas, queries, context + ", update");
+
+		//the removed objects take the freed slots
+		for (size_t removedIndex = 0; removedIndex < removedCenters.size(); ++removedIndex)
+		{
+			quadtree.insert(removedCenters[removedIndex], removedDatas[removedIndex]);
+			dynamicQuadtree.insert(removedCenters[removedIndex], removedDatas[removedIndex]);
+			storedCenters.push_back(removedCenters[removedIndex]);
+			storedDatas.push_back(removedDatas[removedIndex]);
+		}
+
+		checkFoundObjects(quadtree, dynamicQuadtree, scene, storedCenters, storedDatas, queries, context + ", insert again");
+
+		//the allocation is kept
+		const size_t memoryUsage = dynamicQuadtree.memoryUsage();
+
+		quadtree.clear();
+		dynamicQuadtree.clear();
+
+		ARKANOID_CHECK_CONTEXT(dynamicQuadtree.objectsCount() == 0, context + ", clear");
+		ARKANOID_CHECK_CONTEXT(dynamicQuadtree.memoryUsage() == memoryUsage, context + ", clear");
+
+		for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+		{
+			quadtree.insert(scene.objectsCenters[objectIndex], scene.objectsDatas[objectIndex]);
+			dynamicQuadtree.insert(scene.objectsCenters[objectIndex], scene.objectsDatas[objectIndex]);
+		}
+
+		checkFoundObjects(quadtree, dynamicQuadtree, scene, scene.objectsCenters, scene.objectsDatas, queries, context + ", clear");
+	}
+
+	void checkDynamicQuadtrees(const ObjectsScene& scene)
+	{
+		checkDynamicQuadtree<1>(scene);
+		checkDynamicQuadtree<3>(scene);
+		checkDynamicQuadtree<6>(scene);
+	}
+}
+
+int main()
+{
+	for (unsigned int layoutIndex = 0; layoutIndex < gk_bricksLayoutsCount; ++layoutIndex)
+	{
+		checkDynamicQuadtrees(bricksLayoutScene(layoutIndex));
+	}
+
+	checkDynamicQuadtrees(randomScene("random bricks", levelDensityArea(1000), gk_bricksHalfExtents, 1000, 1));
+	checkDynamicQuadtrees(randomScene("random small objects", arenaArea(), XMFLOAT2{ 0.3f, 0.2f }, 1000, 2));
+
+	return testsResult("DynamicQuadtreeTests");
+}
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "TestHelper.h"
+#include "FixedTimestepSimulation.h"
+#include <cstring>
+
+/*
+FixedTimestepSimulation runs the same steps whatever the frame times: two sequences of frame times covering the same time,
+with the same inputs, must give bit-identical games, the ones of a SimulationCore stepped directly.
+the steps are of 1/128 s and the frame times multiples of 1/1024 s, and the inputs change every second: the times are
+summed without rounding errors, so both sequences have run the same steps when an input changes.
+the interpolated transforms must be between the ones before and after the last step, and the time beyond the steps cap
+of an update must be dropped and counted
+*/
+
+using namespace ArkanoidTests;
+
+namespace
+{
+	constexpr unsigned int gk_stepsPerSecond = 128;
+	constexpr float gk_frameTimeQuantum = 1.0f / 1024.0f;
+	constexpr unsigned int gk_secondsCount = 30;
+
+	using Transforms = ArkanoidRenderer::TransformsConstantBuffer;
+
+	bool sameGame(const SimulationCore& simulation, const SimulationCore& otherSimulation)
+	{
+		const XMFLOAT2 ballVelocity = simulation.ballVelocity();
+		const XMFLOAT2 otherBallVelocity = otherSimulation.ballVelocity();
+
+		return std::memcmp(simulation.transforms(), otherSimulation.transforms(), sizeof(Transforms)) == 0 &&
+			   std::memcmp(&ballVelocity, &otherBallVelocity, sizeof(XMFLOAT2)) == 0 &&
+			   simulation.aliveBricksCount() == otherSimulation.aliveBricksCount() &&
+			   simulation.isBonusAlive() == otherSimulation.isBonusAlive();
+	}
+
+	bool isBetween(float value, float bound, float otherBound)
+	{
+		return std::min(bound, otherBound) <= value && value <= std::max(bound, otherBound);
+	}
+
+	//every instance between the transforms before and after the last step, or at the last one if it has been teleported
+	bool areInterpolated(const Transforms& interpolatedTransforms, const Transforms& previousTransforms, const Transforms& currentTransforms)
+	{
+		const float maxSquaredDistance = FixedTimestepSimulation::sk_maxInterpolatedDistance * FixedTimestepSimulation::sk_maxInterpolatedDistance;
+
+		for (unsigned int instanceIndex = 0; instanceIndex < gk_instancesCount; ++instanceIndex)
+		{
+			const XMFLOAT4& interpolated = interpolatedTransforms.translationAndScales[instanceIndex];
+			const XMFLOAT4& previous = previousTransforms.translationAndScales[instanceIndex];
+			const XMFLOAT4& current = currentTransforms.translationAndScales[instanceIndex];
+
+			const float dx = current.x - previous.x;
+			const float dy = current.y - previous.y;
+			const XMFLOAT4& bound = dx * dx + dy * dy > maxSquaredDistance ? current : previous;
+
+			if (!isBetween(interpolated.x, bound.x, current.x) || !isBetween(interpolated.y, bound.y, current.y) ||
+				interpolated.z != current.z || interpolated.w != current.w)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/*
+	plays gk_secondsCount seconds with frame times of frameTimeQuanta quanta, cut at the end of each second. reference is
+	stepped directly by the steps each update runs: the games must be the same, and the transforms interpolated between
+	the ones of reference before and after the last step
+	*/
+	template<typename FrameTimeQuanta>
+	FixedTimestepSimulation playSeconds(unsigned int randomSeed, FrameTimeQuanta&& frameTimeQuanta, const std::string& context)
+	{
+		FixedTimestepSimulation fixedTimestep{ randomSeed, gk_stepsPerSecond };
+		SimulationCore reference{ randomSeed };
+		Transforms previousTransforms = *reference.transforms();
+
+		std::mt19937 inputsEngine{ randomSeed };
+		std::uniform_int_distribution<unsigned int> inputDistribution{ 0, SimulationCore::INPUT_LEFT | SimulationCore::INPUT_RIGHT };
+
+		const unsigned int secondQuantaCount = static_cast<unsigned int>(1.0f / gk_frameTimeQuantum);
+
+		unsigned int differentGamesCount = 0;
+		unsigned int wrongInterpolationsCount = 0;
+
+		for (unsigned int secondIndex = 0; secondIndex < gk_secondsCount; ++secondIndex)
+		{
+			const unsigned int inputFlags = inputDistribution(inputsEngine);
+
+			for (unsigned int secondQuantaIndex = 0; secondQuantaIndex < secondQuantaCount;)
+			{
+				const unsigned int quantaCount = std::min(frameTimeQuanta(), secondQuantaCount - secondQuantaIndex);
+				secondQuantaIndex += quantaCount;
+
+				const unsigned long long stepsCount = fixedTimestep.stepsCount();
+				const bool restarted = fixedTimestep.update(quantaCount * gk_frameTimeQuantum, inputFlags);
+
+				bool referenceRestarted = false;
+				for (unsigned long long stepIndex = stepsCount; stepIndex < fixedTimestep.stepsCount(); ++stepIndex)
+				{
+					previousTransforms = *reference.transforms();
+
+					//a restart moves everything: the interpolation starts again from the restarted level
+					if (reference.step(fixedTimestep.stepTime(), inputFlags))
+					{
+						referenceRestarted = true;
+						previousTransforms = *reference.transforms();
+					}
+				}
+
+				differentGamesCount += static_cast<unsigned int>(restarted != referenceRestarted || !sameGame(fixedTimestep.simulation(), reference));
+
+				wrongInterpolationsCount += static_cast<unsigned int>(!areInterpolated(*fixedTimestep.transforms(), previousTransforms, *reference.transforms()));
+
+				wrongInterpolationsCount += static_cast<unsigned int>(fixedTimestep.interpolationFactor() < 0.0f || fixedTimestep.interpolationFactor() >= 1.0f);
+			}
+		}
+
+		ARKANOID_CHECK_CONTEXT(differentGamesCount == 0, context);
+		ARKANOID_CHECK_CONTEXT(wrongInterpolationsCount == 0, context);
+		ARKANOID_CHECK_CONTEXT(fixedTimestep.droppedStepsCount() == 0, context);
+		ARKANOID_CHECK_CONTEXT(fixedTimestep.stepsCount() == gk_secondsCount * gk_stepsPerSecond, context);
+
+		return fixedTimestep;
+	}
+
+	void checkFrameTimes(unsigned int randomSeed)
+	{
+		const std::string context = "seed " + std::to_string(randomSeed);
+
+		//two steps per frame
+		const FixedTimestepSimulation steadyFrames = playSeconds(randomSeed, []() { return 16u; }, context + ", steady frames");
+
+		//from 1 ms to 58 ms, under the steps cap
+		std::mt19937 framesEngine{ randomSeed };
+		std::uniform_int_distribution<unsigned int> quantaDistribution{ 1, 60 };
+		const FixedTimestepSimulation randomFrames = playSeconds(randomSeed, [&]() { return quantaDistribution(framesEngine); }, context + ", random frames");
+
+		ARKANOID_CHECK_CONTEXT(sameGame(steadyFrames.simulation(), randomFrames.simulation()), context);
+	}
+
+	//an update longer than the steps cap runs the cap and drops the whole steps beyond, keeping the fraction of a step
+	void checkDroppedSteps()
+	{
+		FixedTimestepSimulation fixedTimestep{ 1, gk_stepsPerSecond };
+
+		const unsigned int maxStepsPerUpdate = fixedTimestep.maxStepsPerUpdate();
+		ARKANOID_CHECK(maxStepsPerUpdate == FixedTimestepSimulation::sk_defaultMaxStepsPerUpdate);
+
+		fixedTimestep.update(maxStepsPerUpdate * fixedTimestep.stepTime(), SimulationCore::INPUT_NONE);
+		ARKANOID_CHECK(fixedTimestep.stepsCount() == maxStepsPerUpdate && fixedTimestep.droppedStepsCount() == 0);
+
+		//a frame stalled for a second, with half a step more
+		fixedTimestep.update(1.0f + 0.5f * fixedTimestep.stepTime(), SimulationCore::INPUT_NONE);
+		ARKANOID_CHECK(fixedTimestep.stepsCount() == 2 * maxStepsPerUpdate);
+		ARKANOID_CHECK(fixedTimestep.droppedStepsCount() == gk_stepsPerSecond - maxStepsPerUpdate);
+		ARKANOID_CHECK(fixedTimestep.interpolationFactor() == 0.5f);
+
+		//the half step left completes the next one
+		fixedTimestep.update(0.5f * fixedTimestep.stepTime(), SimulationCore::INPUT_NONE);
+		ARKANOID_CHECK(fixedTimestep.stepsCount() == 2 * maxStepsPerUpdate + 1);
+		ARKANOID_CHECK(fixedTimestep.droppedStepsCount() == gk_stepsPerSecond - maxStepsPerUpdate);
+		ARKANOID_CHECK(fixedTimestep.interpolationFactor() == 0.0f);
+	}
+}
+
+int main()
+{
+	for (unsigned int randomSeed = 1; randomSeed <= 4; ++randomSeed)
+	{
+		checkFrameTimes(randomSeed);
+	}
+
+	checkDroppedSteps();
+
+	return testsResult("FixedTimestepSimulationTests");
+}
\ No newline at end of file
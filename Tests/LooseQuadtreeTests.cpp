@@ -0,0 +1,210 @@
+#include "TestHelper.h"
+#include "LooseQuadtree.h"
+
+/*
+moves objects of many sizes through a LooseQuadtree for many steps, in and out of its area, and checks the queries
+against the brute force after each step: LooseQuadtree finds exactly the objects touching a query, as AABB::intersects()
+tells, once each. the relocations must be the update() calls returning true
+*/
+
+using namespace ArkanoidTests;
+
+namespace
+{
+	//the objects of the brute force, in the order of their ids
+	struct MovingObject
+	{
+		XMFLOAT2 center;
+		XMFLOAT2 halfExtents;
+		XMFLOAT2 velocity;
+		unsigned int data;
+		unsigned int id;
+		bool alive;
+	};
+
+	template<unsigned int MAX_DEPTH>
+	void checkQueries(const LooseQuadtree<unsigned int, MAX_DEPTH>& quadtree, const std::vector<MovingObject>& objects,
+					  const std::vector<AABB>& queries, const std::string& context)
+	{
+		unsigned int aliveObjectsCount = 0;
+		for (const MovingObject& object : objects)
+		{
+			aliveObjectsCount += object.alive ? 1 : 0;
+		}
+
+		if (!ARKANOID_CHECK_CONTEXT(quadtree.objectsCount() == aliveObjectsCount, context))
+		{
+			return;
+		}
+
+		std::vector<unsigned int> foundObjects(std::max(aliveObjectsCount, 1u));
+		unsigned int differentQueriesCount = 0;
+
+		for (const AABB& queryAABB : queries)
+		{
+			const unsigned int foundObjectsCount = quadtree.findPotentialColliders(queryAABB, foundObjects.data());
+
+			std::vector<unsigned int> touchingObjects;
+			for (const MovingObject& object : objects)
+			{
+				if (object.alive && AABB::computeFromCenterAndHalfExtents(object.center, object.halfExtents).intersects(queryAABB))
+				{
+					touchingObjects.push_back(object.data);
+				}
+			}
+
+			std::vector<unsigned int> sortedFoundObjects(foundObjects.begin(), foundObjects.begin() + foundObjectsCount);
+			std::sort(sortedFoundObjects.begin(), sortedFoundObjects.end());
+
+			differentQueriesCount += sortedFoundObjects == touchingObjects ? 0 : 1;
+		}
+
+		ARKANOID_CHECK_CONTEXT(differentQueriesCount == 0, context);
+	}
+
+	template<unsigned int MAX_DEPTH>
+	void checkLooseQuadtree(unsigned int objectsCount, unsigned int randomSeed)
+	{
+		const std::string context = std::to_string(objectsCount) + " objects, depth " + std::to_string(MAX_DEPTH);
+
+		const AABB area = arenaArea();
+		const XMFLOAT2 areaMin = area.min();
+		const XMFLOAT2 areaMax = area.max();
+
+		std::mt19937 randomEngine{ randomSeed };
+
+		//centers out of the area by half of its size, velocities crossing it in a few dozens of steps
+		std::uniform_real_distribution<float> xDistribution{ areaMin.x * 1.5f, areaMax.x * 1.5f };
+		std::uniform_real_distribution<float> yDistribution{ areaMin.y * 1.5f, areaMax.y * 1.5f };
+		std::uniform_real_distribution<float> velocityDistribution{ -3.0f, 3.0f };
+
+		//from the balls to objects bigger than the area, which only the root holds
+		const XMFLOAT2 halfExtents[] = { gk_ballHalfExtents, gk_bricksHalfExtents, XMFLOAT2{ 0.1f, 0.1f }, XMFLOAT2{ 6.0f, 1.0f },
+										 XMFLOAT2{ 25.0f, 40.0f } };
+		std::uniform_int_distribution<unsigned int> halfExtentsDistribution{ 0, 3 };
+
+		auto makeObject = [&](unsigned int objectData)
+		{
+			//one object out of 50 is the biggest
+			const unsigned int halfExtentsIndex = objectData % 50 == 49 ? 4 : halfExtentsDistribution(randomEngine);
+
+			return MovingObject{ XMFLOAT2{ xDistribution(randomEngine), yDistribution(randomEngine) }, halfExtents[halfExtentsIndex],
+								 XMFLOAT2{ velocityDistribution(randomEngine), velocityDistribution(randomEngine) }, objectData, 0, true };
+		};
+
+		LooseQuadtree<unsigned int, MAX_DEPTH> quadtree{ area, objectsCount };
+
+		std::vector<MovingObject> objects;
+		for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+		{
+			objects.push_back(makeObject(objectIndex));
+			objects.back().id = quadtree.insert(objects.back().center, objects.back().halfExtents, objects.back().data);
+		}
+
+		//the queries touching the sides of the first objects, at their start, and scattered ones
+		ObjectsScene queriesScene{ "queries", area, gk_ballHalfExtents, {}, {} };
+		for (size_t objectIndex = 0; objectIndex < std::min(objects.size(), size_t{ 64 }); ++objectIndex)
+		{
+			queriesScene.objectsCenters.push_back(objects[objectIndex].center);
+		}
+
+		const std::vector<AABB> queries = generateQueries(queriesScene, 256, randomSeed);
+
+		checkQueries(quadtree, objects, queries, context + ", insert");
+
+		unsigned long long relocationsCount = quadtree.relocationsCount();
+		unsigned int updatesCount = 0;
+
+		for (unsigned int stepIndex = 0; stepIndex < 40; ++stepIndex)
+		{
+			unsigned int stepRelocationsCount = 0;
+
+			//the objects leaving the area by half of its size come back
+			for (MovingObject& object : objects)
+			{
+				object.center = object.center + object.velocity;
+
+				if (std::abs(object.center.x) > areaMax.x * 1.5f)
+				{
+					object.velocity.x = -object.velocity.x;
+				}
+				if (std::abs(object.center.y) > areaMax.y * 1.5f)
+				{
+					object.velocity.y = -object.velocity.y;
+				}
+
+				if (object.alive)
+				{
+					stepRelocationsCount += quadtree.update(object.id, object.center) ? 1 : 0;
+					++updatesCount;
+
+					ARKANOID_CHECK_CONTEXT(quadtree.objectCenter(object.id).x == object.center.x &&
+										   quadtree.objectCenter(object.id).y == object.center.y, context + ", update");
+				}
+			}
+
+			relocationsCount += stepRelocationsCount;
+			ARKANOID_CHECK_CONTEXT(quadtree.relocationsCount() == relocationsCount, context + ", relocations");
+
+			//some objects are removed, their ids are given to the new ones
+			if (stepIndex % 10 == 5)
+			{
+				for (size_t objectIndex = stepIndex % 3; objectIndex < objects.size(); objectIndex += 3)
+				{
+					MovingObject& object = objects[objectIndex];
+					if (object.alive)
+					{
+						quadtree.remove(object.id);
+						object.alive = false;
+					}
+				}
+			}
+			else if (stepIndex % 10 == 8)
+			{
+				for (MovingObject& object : objects)
+				{
+					if (!object.alive)
+					{
+						object = makeObject(object.data);
+						object.id = quadtree.insert(object.center, object.halfExtents, object.data);
+
+						ARKANOID_CHECK_CONTEXT(quadtree.objectData(object.id) == object.data, context + ", insert again");
+					}
+				}
+			}
+
+			checkQueries(quadtree, objects, queries, context + ", step " + std::to_string(stepIndex));
+		}
+
+		//the objects move by about a quadrant per step, so some of them must change quadrants
+		ARKANOID_CHECK_CONTEXT(objectsCount == 0 || MAX_DEPTH == 0 || relocationsCount > 0, context + ", relocations");
+		ARKANOID_CHECK_CONTEXT(relocationsCount <= updatesCount, context + ", relocations");
+
+		quadtree.clear();
+
+		for (MovingObject& object : objects)
+		{
+			object.alive = false;
+		}
+
+		checkQueries(quadtree, objects, queries, context + ", clear");
+	}
+
+	void checkLooseQuadtrees(unsigned int objectsCount, unsigned int randomSeed)
+	{
+		checkLooseQuadtree<0>(objectsCount, randomSeed);
+		checkLooseQuadtree<1>(objectsCount, randomSeed);
+		checkLooseQuadtree<4>(objectsCount, randomSeed);
+		checkLooseQuadtree<6>(objectsCount, randomSeed);
+	}
+}
+
+int main()
+{
+	checkLooseQuadtrees(0, 1);
+	checkLooseQuadtrees(1, 2);
+	checkLooseQuadtrees(120, 3);
+	checkLooseQuadtrees(1000, 4);
+
+	return testsResult("LooseQuadtreeTests");
+}
\ No newline at end of file
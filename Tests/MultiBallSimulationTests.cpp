@@ -0,0 +1,228 @@
+#include "TestHelper.h"
+#include "MultiBallSimulation.h"
+#include "SimulationCore.h"
+#include <cstring>
+
+/*
+steps a MultiBallSimulation with its single ball in lockstep with a SimulationCore in the COLLISION_DISCRETE mode, with the
+same seeds and random inputs: after each step the ball, the player, the bonus and the bricks must be the same, bit for bit,
+and the levels must restart on the same steps. then checks the balls of a MultiBallSimulation: the lost ones are removed
+keeping the order of the others, addBall() refuses the balls past the capacity and the level restarts only when the last
+ball is lost
+*/
+
+using namespace ArkanoidTests;
+
+namespace
+{
+	constexpr unsigned int gk_seedsCount = 8;
+	constexpr unsigned int gk_stepsCount = 4000;
+	constexpr float gk_deltaTime = 1.0f / 60.0f;
+
+	bool sameFloat(float value, float otherValue)
+	{
+		return std::memcmp(&value, &otherValue, sizeof(float)) == 0;
+	}
+
+	bool samePosition(const XMFLOAT2& position, const XMFLOAT4& transform)
+	{
+		return sameFloat(position.x, transform.x) && sameFloat(position.y, transform.y);
+	}
+
+	//returns true if the game with one ball is the same of the simulation
+	bool sameGame(const MultiBallSimulation& multiBall, const SimulationCore& simulation)
+	{
+		if (multiBall.ballsCount() != 1)
+		{
+			return false;
+		}
+
+		for (unsigned int brickIndex = 0; brickIndex < gk_bricksCount; ++brickIndex)
+		{
+			if (!samePosition(multiBall.brickPosition(brickIndex), simulation.brickTransform(brickIndex)) ||
+				multiBall.brickRemainingHits(brickIndex) != simulation.brickRemainingHits(brickIndex) ||
+				multiBall.brickType(brickIndex) != simulation.brickType(brickIndex))
+			{
+				return false;
+			}
+		}
+
+		const XMFLOAT2 ballVelocity = multiBall.ballVelocity(0);
+
+		return samePosition(multiBall.ballPosition(0), simulation.ballTransform()) &&
+			   sameFloat(ballVelocity.x, simulation.ballVelocity().x) && sameFloat(ballVelocity.y, simulation.ballVelocity().y) &&
+			   sameFloat(multiBall.playerPositionX(), simulation.playerTransform().x) &&
+			   samePosition(multiBall.bonusPosition(), simulation.bonusTransform()) &&
+			   multiBall.isBonusAlive() == simulation.isBonusAlive() &&
+			   multiBall.aliveBricksCount() == simulation.aliveBricksCount();
+	}
+
+	void checkLockstep()
+	{
+		std::mt19937 randomEngine{ 3 };
+		std::uniform_int_distribution<unsigned int> inputDistribution{ 0, SimulationCore::INPUT_LEFT | SimulationCore::INPUT_RIGHT | SimulationCore::INPUT_FIRE };
+
+		unsigned int restartsCount = 0;
+
+		for (unsigned int randomSeed = 1; randomSeed <= gk_seedsCount; ++randomSeed)
+		{
+			MultiBallSimulation multiBall{ randomSeed, 1 };
+			SimulationCore simulation{ randomSeed, SimulationCore::COLLISION_DISCRETE };
+
+			if (!ARKANOID_CHECK_CONTEXT(sameGame(multiBall, simulation), "seed " + std::to_string(randomSeed) + ", start"))
+			{
+				continue;
+			}
+
+			//a seed is checked until its first difference, so a bug doesn't print a line per step
+			for (unsigned int stepIndex = 0; stepIndex < gk_stepsCount; ++stepIndex)
+			{
+				const unsigned int inputFlags = inputDistribution(randomEngine);
+
+				const bool restarted = simulation.step(gk_deltaTime, inputFlags);
+				restartsCount += restarted ? 1 : 0;
+
+				const std::string context = "seed " + std::to_string(randomSeed) + ", step " + std::to_string(stepIndex);
+
+				const bool sameStep = ARKANOID_CHECK_CONTEXT(multiBall.step(gk_deltaTime, inputFlags) == restarted, context) &&
+									  ARKANOID_CHECK_CONTEXT(sameGame(multiBall, simulation), context);
+
+				if (!sameStep)
+				{
+					break;
+				}
+			}
+		}
+
+		//the random inputs lose the ball now and then: the restarts must have been compared too
+		ARKANOID_CHECK(restartsCount > 0);
+	}
+
+	//balls low in the arena, away from the bricks and the player, moving slowly enough to stay there for a step
+	XMFLOAT2 keptBallPosition(unsigned int ballIndex)
+	{
+		return XMFLOAT2{ gk_arenaMinX + 4.0f + ballIndex * 4.0f, gk_arenaMinY + 12.0f };
+	}
+
+	XMFLOAT2 keptBallVelocity(unsigned int ballIndex)
+	{
+		return XMFLOAT2{ 1.0f + ballIndex, -1.0f - ballIndex };
+	}
+
+	//below gk_gameOverBallY and moving down: lost by the next step
+	const XMFLOAT2 gk_lostBallPosition{ 0.0f, gk_gameOverBallY - 1.0f };
+	const XMFLOAT2 gk_lostBallVelocity{ 0.0f, -1.0f };
+
+	void checkRemoveLostBalls()
+	{
+		MultiBallSimulation multiBall{ 1, 8 };
+
+		const XMFLOAT2 startBallVelocity = multiBall.ballVelocity(0);
+
+		//the start ball, then the kept and the lost balls interleaved
+		ARKANOID_CHECK(multiBall.addBall(gk_lostBallPosition, gk_lostBallVelocity, gk_ballHalfExtents));
+		ARKANOID_CHECK(multiBall.addBall(keptBallPosition(0), keptBallVelocity(0), gk_ballHalfExtents));
+		ARKANOID_CHECK(multiBall.addBall(gk_lostBallPosition, gk_lostBallVelocity, gk_ballHalfExtents));
+		ARKANOID_CHECK(multiBall.addBall(gk_lostBallPosition, gk_lostBallVelocity, gk_ballHalfExtents));
+		ARKANOID_CHECK(multiBall.addBall(keptBallPosition(1), keptBallVelocity(1), gk_ballHalfExtents));
+		ARKANOID_CHECK(multiBall.addBall(gk_lostBallPosition, gk_lostBallVelocity, gk_ballHalfExtents));
+		ARKANOID_CHECK(multiBall.addBall(keptBallPosition(2), keptBallVelocity(2), gk_ballHalfExtents));
+
+		ARKANOID_CHECK(!multiBall.step(gk_deltaTime, SimulationCore::INPUT_NONE));
+
+		if (!ARKANOID_CHECK(multiBall.ballsCount() == 4))
+		{
+			return;
+		}
+
+		//nothing touched the balls, so they are told apart by their velocities
+		ARKANOID_CHECK(sameFloat(multiBall.ballVelocity(0).x, startBallVelocity.x) && sameFloat(multiBall.ballVelocity(0).y, startBallVelocity.y));
+
+		for (unsigned int keptBallIndex = 0; keptBallIndex < 3; ++keptBallIndex)
+		{
+			const XMFLOAT2 ballVelocity = multiBall.ballVelocity(keptBallIndex + 1);
+			const XMFLOAT2 expectedPosition = keptBallPosition(keptBallIndex) + keptBallVelocity(keptBallIndex) * gk_deltaTime;
+
+			const std::string context = "kept ball " + std::to_string(keptBallIndex);
+			ARKANOID_CHECK_CONTEXT(sameFloat(ballVelocity.x, keptBallVelocity(keptBallIndex).x), context);
+			ARKANOID_CHECK_CONTEXT(sameFloat(ballVelocity.y, keptBallVelocity(keptBallIndex).y), context);
+			ARKANOID_CHECK_CONTEXT(sameFloat(multiBall.ballPosition(keptBallIndex + 1).x, expectedPosition.x), context);
+			ARKANOID_CHECK_CONTEXT(sameFloat(multiBall.ballPosition(keptBallIndex + 1).y, expectedPosition.y), context);
+		}
+
+		//the freed places take new balls
+		ARKANOID_CHECK(multiBall.addBall(keptBallPosition(3), keptBallVelocity(3), gk_ballHalfExtents));
+		ARKANOID_CHECK(multiBall.ballsCount() == 5);
+	}
+
+	void checkBallsCapacity()
+	{
+		const unsigned int ballsCapacity = 4;
+
+		MultiBallSimulation multiBall{ 1, ballsCapacity };
+		ARKANOID_CHECK(multiBall.ballsCapacity() == ballsCapacity);
+		ARKANOID_CHECK(multiBall.ballsCount() == 1);
+
+		for (unsigned int ballIndex = 1; ballIndex < ballsCapacity; ++ballIndex)
+		{
+			ARKANOID_CHECK(multiBall.addBall(keptBallPosition(ballIndex), keptBallVelocity(ballIndex), gk_ballHalfExtents));
+		}
+
+		ARKANOID_CHECK(!multiBall.addBall(keptBallPosition(0), keptBallVelocity(0), gk_ballHalfExtents));
+		ARKANOID_CHECK(multiBall.ballsCount() == ballsCapacity);
+
+		//the refused ball changed nothing
+		ARKANOID_CHECK(!multiBall.step(gk_deltaTime, SimulationCore::INPUT_NONE));
+		ARKANOID_CHECK(multiBall.ballsCount() == ballsCapacity);
+
+		//a restarted level has the single start ball, and room for the others again
+		multiBall.restartLevel();
+		ARKANOID_CHECK(multiBall.ballsCount() == 1);
+		ARKANOID_CHECK(multiBall.addBall(keptBallPosition(0), keptBallVelocity(0), gk_ballHalfExtents));
+	}
+
+	void checkRestartAfterLastBall()
+	{
+		MultiBallSimulation multiBall{ 1, 4 };
+		const MultiBallSimulation startMultiBall = multiBall;
+
+		//one of the two balls lost: the level goes on
+		ARKANOID_CHECK(multiBall.addBall(gk_lostBallPosition, gk_lostBallVelocity, gk_ballHalfExtents));
+		ARKANOID_CHECK(!multiBall.step(gk_deltaTime, SimulationCore::INPUT_NONE));
+		ARKANOID_CHECK(multiBall.ballsCount() == 1);
+
+		//the player runs to the left wall and stays there, until the start ball is lost too
+		const unsigned int maxStepsCount = 20000;
+		unsigned int stepIndex = 0;
+		bool restarted = false;
+
+		for (; stepIndex < maxStepsCount && !restarted; ++stepIndex)
+		{
+			restarted = multiBall.step(gk_deltaTime, SimulationCore::INPUT_LEFT);
+			ARKANOID_CHECK_CONTEXT(multiBall.ballsCount() == 1, "step " + std::to_string(stepIndex));
+		}
+
+		if (!ARKANOID_CHECK(restarted))
+		{
+			return;
+		}
+
+		//the level starts again as a new simulation does
+		ARKANOID_CHECK(samePosition(multiBall.ballPosition(0), startBallTransform()));
+		ARKANOID_CHECK(sameFloat(multiBall.ballVelocity(0).x, startMultiBall.ballVelocity(0).x));
+		ARKANOID_CHECK(sameFloat(multiBall.ballVelocity(0).y, startMultiBall.ballVelocity(0).y));
+		ARKANOID_CHECK(sameFloat(multiBall.playerPositionX(), startMultiBall.playerPositionX()));
+		ARKANOID_CHECK(!multiBall.isBonusAlive());
+		ARKANOID_CHECK(multiBall.aliveBricksCount() > 0);
+	}
+}
+
+int main()
+{
+	checkLockstep();
+	checkRemoveLostBalls();
+	checkBallsCapacity();
+	checkRestartAfterLastBall();
+
+	return testsResult("MultiBallSimulationTests");
+}
\ No newline at end of file
@@ -0,0 +1,219 @@
+#include "TestHelper.h"
+#include "Null/NullRenderer.h"
+#include "Image.h"
+#include "Mesh.h"
+#include "PipelineState.h"
+#include "PipelineStateData.h"
+#include <cstring>
+
+/*
+creates the resources of a frame through Null::Renderer, draws with them and destroys them, checking the counters after
+each step: the created, destroyed and live resources with the bytes they own, the draw calls with their instances and
+indices, the constant buffer updates with the bytes uploaded, and the binds. resetCallCounters() clears the per-call
+counters only, the resources counters follow the resources
+*/
+
+using namespace ArkanoidTests;
+using namespace ArkanoidEngine;
+
+namespace
+{
+	constexpr unsigned int gk_textureWidth = 8;
+	constexpr unsigned int gk_textureHeight = 4;
+	constexpr unsigned int gk_instancesCount = 7;
+
+	//not a multiple of 16: the buffer is rounded up as D3D11 requires
+	constexpr unsigned int gk_constantBufferSize = 20;
+	constexpr unsigned int gk_adjustedConstantBufferSize = 32;
+
+	Mesh createQuadMesh()
+	{
+		Mesh mesh{};
+
+		XMFLOAT3 vertices[]{
+			{ -1.0f, -1.0f, 0.0f },
+			{ -1.0f, +1.0f, 0.0f },
+			{ +1.0f, +1.0f, 0.0f },
+			{ +1.0f, -1.0f, 0.0f }
+		};
+
+		mesh.setPositions(vertices, sizeof(vertices) / sizeof(XMFLOAT3));
+
+		XMFLOAT2 textCoords[]{
+			{ 0.0f, 1.0f },
+			{ 0.0f, 0.0f },
+			{ 1.0f, 0.0f },
+			{ 1.0f, 1.0f }
+		};
+
+		mesh.setTextCoords(textCoords, sizeof(textCoords) / sizeof(XMFLOAT2));
+
+		uint64_t indices[]{
+			0, 1, 2,
+			0, 2, 3
+		};
+
+		mesh.setIndices(indices, sizeof(indices) / sizeof(uint64_t));
+
+		return mesh;
+	}
+
+	bool sameResourceCounters(const Null::ResourceCounters& resourceCounters, unsigned long long createdCount,
+							  unsigned long long destroyedCount, unsigned long long allocatedBytes)
+	{
+		return resourceCounters.createdCount == createdCount && resourceCounters.destroyedCount == destroyedCount &&
+			   resourceCounters.allocatedBytes == allocatedBytes && resourceCounters.liveCount() == createdCount - destroyedCount;
+	}
+
+	bool callCountersCleared(const Null::RendererCounters& counters)
+	{
+		return counters.framesCount == 0 && counters.drawCallsCount == 0 && counters.drawnInstancesCount == 0 &&
+			   counters.drawnIndicesCount == 0 && counters.constantBufferUpdatesCount == 0 && counters.constantBufferUploadedBytes == 0 &&
+			   counters.pipelineStateBindsCount == 0 && counters.pipelineStateDataBindsCount == 0;
+	}
+
+	void checkCounters()
+	{
+		Null::Renderer renderer{ 640, 480 };
+		const Null::RendererCounters& counters = renderer.counters();
+
+		ARKANOID_CHECK(callCountersCleared(counters));
+		ARKANOID_CHECK(sameResourceCounters(counters.meshes, 0, 0, 0));
+
+		//creation
+		const unsigned long long meshBytes = 4 * sizeof(VertexPosTextCoord) + 6 * sizeof(uint16_t);
+		const unsigned long long textureBytes = 4ull * gk_textureWidth * gk_textureHeight;
+
+		const IDType meshID = renderer.createMesh(createQuadMesh(), EVertexType::POSITION_TEXTCOORD);
+		const IDType vertexShaderID = renderer.createVertexShaderFromSourceFile("everyOneVertexShader.hlsl", EVertexType::POSITION_TEXTCOORD);
+		const IDType pixelShaderID = renderer.createPixelShaderFromSourceFile("everyOnePixelShader.hlsl");
+		const IDType vertexConstantBufferID = renderer.createConstantBuffer(gk_constantBufferSize);
+		const IDType pixelConstantBufferID = renderer.createConstantBuffer(sizeof(XMFLOAT4X4));
+
+		PipelineState pipelineState{ vertexShaderID, pixelShaderID };
+		pipelineState.setStageConstantBuffers(EPipelineStage::VERTEX_SHADER, { vertexConstantBufferID });
+		pipelineState.setStageConstantBuffers(EPipelineStage::PIXEL_SHADER, { pixelConstantBufferID });
+		const IDType pipelineStateID = renderer.createPipelineState(pipelineState);
+
+		//the Image owns the pixels, the Null::Renderer keeps their size only
+		const IDType textureID = renderer.createTextureFromImage(Image{ new unsigned char[textureBytes]{}, gk_textureWidth, gk_textureHeight });
+		const IDType pipelineStateDataID = renderer.createPipelineStateData(PipelineStateData{ textureID });
+
+		ARKANOID_CHECK_CONTEXT(sameResourceCounters(counters.meshes, 1, 0, meshBytes), "created");
+		ARKANOID_CHECK_CONTEXT(sameResourceCounters(counters.shaders, 2, 0, 0), "created");
+		ARKANOID_CHECK_CONTEXT(sameResourceCounters(counters.constantBuffers, 2, 0, gk_adjustedConstantBufferSize + sizeof(XMFLOAT4X4)), "created");
+		ARKANOID_CHECK_CONTEXT(sameResourceCounters(counters.textures, 1, 0, textureBytes), "created");
+		ARKANOID_CHECK_CONTEXT(sameResourceCounters(counters.pipelineStates, 1, 0, 0), "created");
+		ARKANOID_CHECK_CONTEXT(sameResourceCounters(counters.pipelineStateDatas, 1, 0, 0), "created");
+		ARKANOID_CHECK_CONTEXT(callCountersCleared(counters), "created");
+
+		//a frame: the constant buffers are updated and the quad drawn once alone and once instanced
+		unsigned char vertexConstantBufferData[gk_constantBufferSize];
+		for (unsigned int byteIndex = 0; byteIndex < gk_constantBufferSize; ++byteIndex)
+		{
+			vertexConstantBufferData[byteIndex] = static_cast<unsigned char>(byteIndex + 1);
+		}
+
+		XMFLOAT4X4 pixelConstantBufferData{};
+		pixelConstantBufferData._11 = 1.0f;
+		pixelConstantBufferData._22 = 2.0f;
+		pixelConstantBufferData._33 = 3.0f;
+		pixelConstantBufferData._44 = 4.0f;
+
+		renderer.updateConstantBuffer(vertexConstantBufferID, vertexConstantBufferData, gk_constantBufferSize);
+		renderer.updateConstantBuffer(pixelConstantBufferID, &pixelConstantBufferData, sizeof(XMFLOAT4X4));
+
+		ARKANOID_CHECK(std::memcmp(renderer.constantBufferData(vertexConstantBufferID), vertexConstantBufferData, gk_constantBufferSize) == 0);
+		ARKANOID_CHECK(std::memcmp(renderer.constantBufferData(pixelConstantBufferID), &pixelConstantBufferData, sizeof(XMFLOAT4X4)) == 0);
+
+		renderer.setPipelineState(pipelineStateID);
+		renderer.setPipelineStateData(pipelineStateDataID);
+
+		renderer.beginFrame();
+		renderer.renderMesh(meshID);
+		renderer.renderMeshInstanced(meshID, gk_instancesCount);
+		renderer.endFrame();
+
+		ARKANOID_CHECK_CONTEXT(counters.framesCount == 1, "frame");
+		ARKANOID_CHECK_CONTEXT(counters.drawCallsCount == 2, "frame");
+		ARKANOID_CHECK_CONTEXT(counters.drawnInstancesCount == 1 + gk_instancesCount, "frame");
+		ARKANOID_CHECK_CONTEXT(counters.drawnIndicesCount == 6 * (1 + gk_instancesCount), "frame");
+		ARKANOID_CHECK_CONTEXT(counters.constantBufferUpdatesCount == 2, "frame");
+		ARKANOID_CHECK_CONTEXT(counters.constantBufferUploadedBytes == gk_constantBufferSize + sizeof(XMFLOAT4X4), "frame");
+		ARKANOID_CHECK_CONTEXT(counters.pipelineStateBindsCount == 1, "frame");
+		ARKANOID_CHECK_CONTEXT(counters.pipelineStateDataBindsCount == 1, "frame");
+
+		//a second frame adds up to the first one
+		renderer.beginFrame();
+		renderer.renderMeshInstanced(meshID, gk_instancesCount);
+		renderer.endFrame();
+
+		ARKANOID_CHECK_CONTEXT(counters.framesCount == 2, "second frame");
+		ARKANOID_CHECK_CONTEXT(counters.drawCallsCount == 3, "second frame");
+		ARKANOID_CHECK_CONTEXT(counters.drawnInstancesCount == 1 + 2 * gk_instancesCount, "second frame");
+		ARKANOID_CHECK_CONTEXT(counters.drawnIndicesCount == 6 * (1 + 2 * gk_instancesCount), "second frame");
+
+		//the per-call counters are cleared, the resources are still there
+		renderer.resetCallCounters();
+
+		ARKANOID_CHECK_CONTEXT(callCountersCleared(counters), "reset");
+		ARKANOID_CHECK_CONTEXT(sameResourceCounters(counters.meshes, 1, 0, meshBytes), "reset");
+		ARKANOID_CHECK_CONTEXT(sameResourceCounters(counters.constantBuffers, 2, 0, gk_adjustedConstantBufferSize + sizeof(XMFLOAT4X4)), "reset");
+		ARKANOID_CHECK_CONTEXT(sameResourceCounters(counters.textures, 1, 0, textureBytes), "reset");
+
+		//destruction, in the order of ArkanoidRenderer. a texture destroyed gives back its bytes at once
+		renderer.destroyPipelineStateData(pipelineStateDataID);
+		renderer.destroyTexture(textureID);
+
+		ARKANOID_CHECK_CONTEXT(sameResourceCounters(counters.textures, 1, 1, 0), "texture destroyed");
+		ARKANOID_CHECK_CONTEXT(sameResourceCounters(counters.meshes, 1, 0, meshBytes), "texture destroyed");
+
+		renderer.destroyPipelineState(pipelineStateID);
+		renderer.destroyConstantBuffer(pixelConstantBufferID);
+
+		ARKANOID_CHECK_CONTEXT(sameResourceCounters(counters.constantBuffers, 2, 1, gk_adjustedConstantBufferSize), "constant buffer destroyed");
+
+		renderer.destroyConstantBuffer(vertexConstantBufferID);
+		renderer.destroyShader(pixelShaderID);
+		renderer.destroyShader(vertexShaderID);
+		renderer.destroyMesh(meshID);
+
+		ARKANOID_CHECK_CONTEXT(sameResourceCounters(counters.meshes, 1, 1, 0), "destroyed");
+		ARKANOID_CHECK_CONTEXT(sameResourceCounters(counters.shaders, 2, 2, 0), "destroyed");
+		ARKANOID_CHECK_CONTEXT(sameResourceCounters(counters.constantBuffers, 2, 2, 0), "destroyed");
+		ARKANOID_CHECK_CONTEXT(sameResourceCounters(counters.textures, 1, 1, 0), "destroyed");
+		ARKANOID_CHECK_CONTEXT(sameResourceCounters(counters.pipelineStates, 1, 1, 0), "destroyed");
+		ARKANOID_CHECK_CONTEXT(sameResourceCounters(counters.pipelineStateDatas, 1, 1, 0), "destroyed");
+		ARKANOID_CHECK_CONTEXT(callCountersCleared(counters), "destroyed");
+	}
+
+	//a mesh of more than 65535 vertices needs 32 bit indices, as D3D11::Renderer chooses them
+	void checkLargeMeshBytes()
+	{
+		Null::Renderer renderer{};
+		const Null::RendererCounters& counters = renderer.counters();
+
+		constexpr unsigned int verticesCount = 65536;
+		constexpr unsigned int indicesCount = 3;
+
+		Mesh mesh{};
+		mesh.setPositions(std::vector<XMFLOAT3>(verticesCount, XMFLOAT3{ 0.0f, 0.0f, 0.0f }));
+		mesh.setIndices(std::vector<uint64_t>{ 0, 1, verticesCount - 1 });
+
+		const IDType meshID = renderer.createMesh(mesh, EVertexType::POSITION);
+
+		ARKANOID_CHECK(sameResourceCounters(counters.meshes, 1, 0, verticesCount * sizeof(VertexPos) + indicesCount * sizeof(uint32_t)));
+
+		renderer.destroyMesh(meshID);
+
+		ARKANOID_CHECK(sameResourceCounters(counters.meshes, 1, 1, 0));
+	}
+}
+
+int main()
+{
+	checkCounters();
+	checkLargeMeshBytes();
+
+	return testsResult("NullRendererTests");
+}
\ No newline at end of file
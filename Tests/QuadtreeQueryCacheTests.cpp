@@ -0,0 +1,185 @@
+#include "TestHelper.h"
+#include "QuadtreeQueryCache.h"
+#include "Quadtree.h"
+
+/*
+QuadtreeQueryCache answers a query from the cache exactly when the query AABB is inside the grown AABB of the query which
+filled it and the quadtree hasn't been modified since. a ball sized AABB walks over the bricks layouts, moving by less than
+the margin and now and then jumping away, while some bricks are removed: the hits and misses must be the ones expected,
+the saved visits those of the filling queries, and the objects found those the quadtree finds for the grown AABB, which
+include the ones it finds for the query AABB and the ones touching it
+*/
+
+using namespace ArkanoidTests;
+
+namespace
+{
+	constexpr unsigned int gk_quadtreeMaxDepth = 3;
+	constexpr float gk_cacheMargin = 2.0f;
+
+	using BricksQuadtree = Quadtree<unsigned int, gk_quadtreeMaxDepth>;
+
+	bool containsAll(const unsigned int* objects, unsigned int objectsCount, const unsigned int* containedObjects, unsigned int containedObjectsCount)
+	{
+		for (unsigned int objectIndex = 0; objectIndex < containedObjectsCount; ++objectIndex)
+		{
+			if (std::find(objects, objects + objectsCount, containedObjects[objectIndex]) == objects + objectsCount)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	AABB growAABB(const AABB& aabb)
+	{
+		return AABB::computeFromCenterAndHalfExtents(aabb.center(), aabb.halfExtents() + XMFLOAT2{ gk_cacheMargin, gk_cacheMargin });
+	}
+
+	bool containsAABB(const AABB& aabb, const AABB& containedAABB)
+	{
+		return aabb.min().x <= containedAABB.min().x && containedAABB.max().x <= aabb.max().x &&
+			   aabb.min().y <= containedAABB.min().y && containedAABB.max().y <= aabb.max().y;
+	}
+
+	void checkWalk(const ObjectsScene& scene)
+	{
+		const unsigned int objectsCount = static_cast<unsigned int>(scene.objectsCenters.size());
+
+		BricksQuadtree quadtree{ scene.area, scene.objectsHalfExtents, objectsCount };
+		quadtree.build(scene.area, scene.objectsCenters.data(), scene.objectsDatas.data(), objectsCount);
+
+		std::vector<XMFLOAT2> storedCenters = scene.objectsCenters;
+		std::vector<unsigned int> storedDatas = scene.objectsDatas;
+
+		QuadtreeQueryCache<> cache{ XMFLOAT2{ gk_cacheMargin, gk_cacheMargin } };
+		cache.bind(quadtree);
+
+		std::vector<unsigned int> directObjects(objectsCount);
+		std::vector<unsigned int> grownObjects(objectsCount);
+
+		std::mt19937 randomEngine{ objectsCount };
+		std::uniform_real_distribution<float> xDistribution{ scene.area.min().x, scene.area.max().x };
+		std::uniform_real_distribution<float> yDistribution{ scene.area.min().y, scene.area.max().y };
+		std::uniform_real_distribution<float> moveDistribution{ -0.5f, 0.5f };
+
+		//the expected state of the cache
+		bool filled = false;
+		AABB filledAABB = scene.area;
+		unsigned int filledVisitedQuadrantsCount = 0;
+		QuadtreeQueryCacheCounters expectedCounters{};
+
+		XMFLOAT2 ballCenter{ xDistribution(randomEngine), yDistribution(randomEngine) };
+
+		for (unsigned int queryIndex = 0; queryIndex < 2000; ++queryIndex)
+		{
+			const std::string context = scene.name + ", query " + std::to_string(queryIndex);
+
+			if (queryIndex % 50 == 49)
+			{
+				ballCenter = XMFLOAT2{ xDistribution(randomEngine), yDistribution(randomEngine) };
+			}
+			else
+			{
+				ballCenter = ballCenter + XMFLOAT2{ moveDistribution(randomEngine), moveDistribution(randomEngine) };
+			}
+
+			//a brick is destroyed
+			if (queryIndex % 40 == 39 && !storedDatas.empty())
+			{
+				const unsigned int removedIndex = static_cast<unsigned int>(randomEngine() % storedDatas.size());
+				ARKANOID_CHECK_CONTEXT(quadtree.remove(storedCenters[removedIndex], storedDatas[removedIndex]), context);
+
+				storedCenters.erase(storedCenters.begin() + removedIndex);
+				storedDatas.erase(storedDatas.begin() + removedIndex);
+				filled = false;
+			}
+
+			const AABB queryAABB = AABB::computeFromCenterAndHalfExtents(ballCenter, gk_ballHalfExtents);
+
+			const bool expectedHit = filled && containsAABB(filledAABB, queryAABB);
+			if (expectedHit)
+			{
+				++expectedCounters.hitsCount;
+				expectedCounters.savedQuadrantVisitsCount += filledVisitedQuadrantsCount;
+			}
+			else
+			{
+				++expectedCounters.missesCount;
+				filled = true;
+				filledAABB = growAABB(queryAABB);
+			}
+
+			const unsigned int* foundObjects;
+			const unsigned int foundObjectsCount = cache.findPotentialColliders(quadtree, queryAABB, foundObjects);
+
+			const unsigned int grownObjectsCount = quadtree.findPotentialColliders(filledAABB, grownObjects.data(), filledVisitedQuadrantsCount);
+			const unsigned int directObjectsCount = quadtree.findPotentialColliders(queryAABB, directObjects.data());
+			const std::vector<unsigned int> touchingObjects = findTouchingObjects(storedCenters, storedDatas, scene.objectsHalfExtents, queryAABB);
+
+			ARKANOID_CHECK_CONTEXT(cache.counters().hitsCount == expectedCounters.hitsCount, context);
+			ARKANOID_CHECK_CONTEXT(cache.counters().missesCount == expectedCounters.missesCount, context);
+			ARKANOID_CHECK_CONTEXT(cache.counters().savedQuadrantVisitsCount == expectedCounters.savedQuadrantVisitsCount, context);
+
+			ARKANOID_CHECK_CONTEXT(foundObjectsCount == grownObjectsCount &&
+								   std::equal(foundObjects, foundObjects + foundObjectsCount, grownObjects.begin()), context);
+			ARKANOID_CHECK_CONTEXT(containsAll(foundObjects, foundObjectsCount, directObjects.data(), directObjectsCount), context);
+			ARKANOID_CHECK_CONTEXT(containsAll(foundObjects, foundObjectsCount, touchingObjects.data(), static_cast<unsigned int>(touchingObjects.size())), context);
+		}
+
+		//the walk must have been answered from the cache and by the quadtree, otherwise little has been checked
+		ARKANOID_CHECK_CONTEXT(expectedCounters.hitsCount > expectedCounters.missesCount, scene.name);
+		ARKANOID_CHECK_CONTEXT(expectedCounters.missesCount > 40, scene.name);
+
+		ARKANOID_CHECK_CONTEXT(cache.hitRate() == static_cast<float>(expectedCounters.hitsCount) /
+												  static_cast<float>(expectedCounters.hitsCount + expectedCounters.missesCount), scene.name);
+
+		cache.resetCounters();
+		ARKANOID_CHECK_CONTEXT(cache.counters().hitsCount == 0 && cache.counters().missesCount == 0 && cache.hitRate() == 0.0f, scene.name);
+	}
+
+	//invalidate() and another quadtree make the next query search the quadtree
+	void checkInvalidation()
+	{
+		const ObjectsScene scene = bricksLayoutScene(0);
+		const unsigned int objectsCount = static_cast<unsigned int>(scene.objectsCenters.size());
+
+		BricksQuadtree quadtree{ scene.area, scene.objectsHalfExtents, objectsCount };
+		quadtree.build(scene.area, scene.objectsCenters.data(), scene.objectsDatas.data(), objectsCount);
+
+		const BricksQuadtree otherQuadtree = quadtree;
+
+		QuadtreeQueryCache<> cache{ XMFLOAT2{ gk_cacheMargin, gk_cacheMargin } };
+		cache.bind(quadtree);
+
+		const AABB queryAABB = AABB::computeFromCenterAndHalfExtents(scene.objectsCenters[0], gk_ballHalfExtents);
+
+		const unsigned int* foundObjects;
+		cache.findPotentialColliders(quadtree, queryAABB, foundObjects);
+		cache.findPotentialColliders(quadtree, queryAABB, foundObjects);
+		ARKANOID_CHECK(cache.counters().hitsCount == 1 && cache.counters().missesCount == 1);
+
+		cache.invalidate();
+		cache.findPotentialColliders(quadtree, queryAABB, foundObjects);
+		ARKANOID_CHECK(cache.counters().hitsCount == 1 && cache.counters().missesCount == 2);
+
+		cache.findPotentialColliders(otherQuadtree, queryAABB, foundObjects);
+		ARKANOID_CHECK(cache.counters().hitsCount == 1 && cache.counters().missesCount == 3);
+
+		cache.findPotentialColliders(otherQuadtree, queryAABB, foundObjects);
+		ARKANOID_CHECK(cache.counters().hitsCount == 2 && cache.counters().missesCount == 3);
+	}
+}
+
+int main()
+{
+	for (unsigned int layoutIndex = 0; layoutIndex < gk_bricksLayoutsCount; ++layoutIndex)
+	{
+		checkWalk(bricksLayoutScene(layoutIndex));
+	}
+
+	checkInvalidation();
+
+	return testsResult("QuadtreeQueryCacheTests");
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "TestHelper.h"
+#include "QuadtreeHelper.h"
+
+/*
+the QuadtreeTopology tables, computed at compile time, against the quadrants laid out at run time as Quadtree did before
+them: from the root, the children of a quadrant at depth computeSiblingsOffset(depth + 1, maxDepth) apart, each one
+followed by its subtree. the depth, parent and sibling index of every quadrant and the children offset of every depth must
+be the same, for several MAX_DEPTH
+*/
+
+using namespace ArkanoidTests;
+
+namespace
+{
+	struct QuadrantTopology
+	{
+		unsigned int depth;
+		unsigned int parent;
+		unsigned int siblingIndex;
+	};
+
+	//the root is its own parent and the first of its siblings, as in the tables
+	void layOutQuadrant(unsigned int quadrantIndex, unsigned int parentIndex, unsigned int siblingIndex, unsigned int depth,
+						unsigned int maxDepth, std::vector<QuadrantTopology>& quadrants)
+	{
+		quadrants[quadrantIndex] = QuadrantTopology{ depth, parentIndex, siblingIndex };
+
+		if (depth == maxDepth)
+		{
+			return;
+		}
+
+		const unsigned int siblingsOffset = computeSiblingsOffset(depth + 1, maxDepth);
+
+		for (unsigned int child = 0; child < 4; ++child)
+		{
+			layOutQuadrant(quadrantIndex + 1 + child * siblingsOffset, quadrantIndex, child, depth + 1, maxDepth, quadrants);
+		}
+	}
+
+	template<unsigned int MAX_DEPTH>
+	void checkTopology()
+	{
+		using Topology = QuadtreeTopology<MAX_DEPTH>;
+
+		const std::string context = "max depth " + std::to_string(MAX_DEPTH);
+		constexpr unsigned int maxQuadrantsCount = quadrantsCount(MAX_DEPTH);
+
+		ARKANOID_CHECK_CONTEXT(maxQuadrantsCount == (uiPow(4, MAX_DEPTH + 1) - 1) / 3, context);
+		ARKANOID_CHECK_CONTEXT(maxQuadrantsCount == computeSiblingsOffset(0, MAX_DEPTH), context);
+
+		ARKANOID_CHECK_CONTEXT(sizeof(Topology::sk_perQuadrantDepth) / sizeof(unsigned int) == maxQuadrantsCount, context);
+		ARKANOID_CHECK_CONTEXT(sizeof(Topology::sk_perQuadrantParent) / sizeof(unsigned int) == maxQuadrantsCount, context);
+		ARKANOID_CHECK_CONTEXT(sizeof(Topology::sk_perQuadrantSiblingIndex) / sizeof(unsigned int) == maxQuadrantsCount, context);
+		ARKANOID_CHECK_CONTEXT(sizeof(Topology::sk_childrenOffsets) / sizeof(unsigned int) == MAX_DEPTH + 1, context);
+
+		std::vector<QuadrantTopology> quadrants(maxQuadrantsCount, QuadrantTopology{ ~0u, ~0u, ~0u });
+		layOutQuadrant(0, 0, 0, 0, MAX_DEPTH, quadrants);
+
+		unsigned int differentQuadrantsCount = 0;
+		for (unsigned int quadrantIndex = 0; quadrantIndex < maxQuadrantsCount; ++quadrantIndex)
+		{
+			const QuadrantTopology& quadrant = quadrants[quadrantIndex];
+
+			differentQuadrantsCount += static_cast<unsigned int>(Topology::sk_perQuadrantDepth[quadrantIndex] != quadrant.depth ||
+																 Topology::sk_perQuadrantParent[quadrantIndex] != quadrant.parent ||
+																 Topology::sk_perQuadrantSiblingIndex[quadrantIndex] != quadrant.siblingIndex);
+		}
+		ARKANOID_CHECK_CONTEXT(differentQuadrantsCount == 0, context);
+
+		for (unsigned int depth = 0; depth < MAX_DEPTH; ++depth)
+		{
+			ARKANOID_CHECK_CONTEXT(Topology::sk_childrenOffsets[depth] == computeSiblingsOffset(depth + 1, MAX_DEPTH),
+								   context + ", depth " + std::to_string(depth));
+		}
+
+		//the leaves have no children
+		ARKANOID_CHECK_CONTEXT(Topology::sk_childrenOffsets[MAX_DEPTH] == 0, context);
+	}
+}
+
+int main()
+{
+	checkTopology<0>();
+	checkTopology<1>();
+	checkTopology<2>();
+	checkTopology<3>();
+	checkTopology<4>();
+	checkTopology<5>();
+	checkTopology<6>();
+
+	return testsResult("QuadtreeTopologyTests");
+}
\ No newline at end of file
@@ -0,0 +1,455 @@
+#include "TestHelper.h"
+#include "SimulationCore.h"
+#include <cstring>
+
+/*
+checks the collision modes of SimulationCore on their own promises.
+COLLISION_KINETIC: a long step must give the game of the many short steps covering the same time with the same input,
+the same bricks hit, bonus and restarts, the positions up to the rounding errors of the summed times; and the ball must never
+end a step inside a brick, a wall or the player, nor stop moving.
+COLLISION_SWEPT: at large steps the ball must not pass through a brick or a wall, nor end inside one, and must hit every brick
+it crosses.
+tuneBricksSubdivision() must pick one of the candidate subdivisions and leave the game bit for bit the one of the untuned
+bricks quadtree, in each mode
+*/
+
+using namespace ArkanoidTests;
+
+namespace
+{
+	//the positions of the long and the short steps differ by the rounding errors of the times summed in a different order
+	constexpr float gk_positionTolerance = 1e-3f;
+
+	//a ball touching a collider from outside may overlap it by the rounding errors of the contact position
+	constexpr float gk_overlapTolerance = 1e-3f;
+
+	bool nearlyEqual(float value, float otherValue)
+	{
+		return std::abs(value - otherValue) <= gk_positionTolerance;
+	}
+
+	//returns the collider the ball overlaps by more than gk_overlapTolerance, nullptr if none
+	const char* findOverlappedCollider(const SimulationCore& simulation)
+	{
+		const XMFLOAT4& ballTransform = simulation.ballTransform();
+		const AABB ballAABB = AABB::computeFromCenterAndHalfExtents(XMFLOAT2{ ballTransform.x, ballTransform.y }, gk_ballHalfExtents);
+
+		if (ballAABB.min().x < gk_arenaMinX - gk_overlapTolerance || ballAABB.max().x > gk_arenaMaxX + gk_overlapTolerance)
+		{
+			return "side wall";
+		}
+
+		if (ballAABB.max().y > gk_arenaMaxY + gk_overlapTolerance)
+		{
+			return "top wall";
+		}
+
+		auto overlaps = [&ballAABB](const XMFLOAT4& transform, const XMFLOAT2& halfExtents)
+		{
+			const XMFLOAT2 overlap = (ballAABB.halfExtents() + halfExtents) - XMFLOAT2{ std::abs(ballAABB.center().x - transform.x),
+																						 std::abs(ballAABB.center().y - transform.y) };
+			return overlap.x > gk_overlapTolerance && overlap.y > gk_overlapTolerance;
+		};
+
+		if (overlaps(simulation.playerTransform(), gk_playerHalfExtents))
+		{
+			return "player";
+		}
+
+		for (unsigned int brickIndex = 0; brickIndex < gk_bricksCount; ++brickIndex)
+		{
+			if (simulation.brickRemainingHits(brickIndex) != 0 && overlaps(simulation.brickTransform(brickIndex), gk_bricksHalfExtents))
+			{
+				return "brick";
+			}
+		}
+
+		return nullptr;
+	}
+
+	bool checkNoOverlap(const SimulationCore& simulation, const std::string& context)
+	{
+		const char* overlappedCollider = findOverlappedCollider(simulation);
+		return ARKANOID_CHECK_CONTEXT(overlappedCollider == nullptr, context + ", inside " + (overlappedCollider ? overlappedCollider : ""));
+	}
+
+	//returns true if the games are the same, the positions up to gk_positionTolerance
+	bool sameKineticGame(const SimulationCore& simulation, const SimulationCore& otherSimulation)
+	{
+		for (unsigned int brickIndex = 0; brickIndex < gk_bricksCount; ++brickIndex)
+		{
+			if (simulation.brickRemainingHits(brickIndex) != otherSimulation.brickRemainingHits(brickIndex))
+			{
+				return false;
+			}
+		}
+
+		const XMFLOAT4& ballTransform = simulation.ballTransform();
+		const XMFLOAT4& otherBallTransform = otherSimulation.ballTransform();
+
+		return nearlyEqual(ballTransform.x, otherBallTransform.x) && nearlyEqual(ballTransform.y, otherBallTransform.y) &&
+			   nearlyEqual(simulation.ballVelocity().x, otherSimulation.ballVelocity().x) &&
+			   nearlyEqual(simulation.ballVelocity().y, otherSimulation.ballVelocity().y) &&
+			   nearlyEqual(simulation.playerTransform().x, otherSimulation.playerTransform().x) &&
+			   nearlyEqual(simulation.bonusTransform().y, otherSimulation.bonusTransform().y) &&
+			   simulation.isBonusAlive() == otherSimulation.isBonusAlive() &&
+			   simulation.aliveBricksCount() == otherSimulation.aliveBricksCount();
+	}
+
+	/*
+	from the same game, one simulation takes a step of gk_kineticLongStepTime, the other gk_kineticShortStepsCount steps
+	covering the same time, with the same input. the long step drops the rest of its time when the level restarts, so after
+	a restart only the restart is compared. each long step starts from the game of the previous one, so the differences
+	of a step don't add up over the next ones
+	*/
+	constexpr float gk_kineticLongStepTime = 0.5f;
+	constexpr unsigned int gk_kineticShortStepsCount = 30;
+	constexpr unsigned int gk_kineticLongStepsCount = 400;
+
+	void checkKineticLongSteps()
+	{
+		const unsigned int inputsFlags[3] = { SimulationCore::INPUT_NONE, SimulationCore::INPUT_LEFT, SimulationCore::INPUT_RIGHT };
+		std::mt19937 randomEngine{ 7 };
+		std::uniform_int_distribution<unsigned int> inputDistribution{ 0, 2 };
+
+		const float shortStepTime = gk_kineticLongStepTime / gk_kineticShortStepsCount;
+
+		unsigned int restartsCount = 0;
+		unsigned int bricksHitsCount = 0;
+
+		for (unsigned int randomSeed = 1; randomSeed <= 16; ++randomSeed)
+		{
+			SimulationCore longSimulation{ randomSeed, SimulationCore::COLLISION_KINETIC };
+
+			for (unsigned int longStepIndex = 0; longStepIndex < gk_kineticLongStepsCount; ++longStepIndex)
+			{
+				const unsigned int inputFlags = inputsFlags[inputDistribution(randomEngine)];
+
+				SimulationCore shortSimulation = longSimulation;
+
+				const std::string context = "seed " + std::to_string(randomSeed) + ", long step " + std::to_string(longStepIndex);
+
+				const unsigned int aliveBricksCount = longSimulation.aliveBricksCount();
+				unsigned int remainingHitsCount = 0;
+				for (unsigned int brickIndex = 0; brickIndex < gk_bricksCount; ++brickIndex)
+				{
+					remainingHitsCount += longSimulation.brickRemainingHits(brickIndex);
+				}
+
+				const bool longRestarted = longSimulation.step(gk_kineticLongStepTime, inputFlags);
+
+				bool shortRestarted = false;
+				for (unsigned int shortStepIndex = 0; shortStepIndex < gk_kineticShortStepsCount && !shortRestarted; ++shortStepIndex)
+				{
+					shortRestarted = shortSimulation.step(shortStepTime, inputFlags);
+					checkNoOverlap(shortSimulation, context + ", short step " + std::to_string(shortStepIndex));
+				}
+
+				checkNoOverlap(longSimulation, context);
+				ARKANOID_CHECK_CONTEXT(longRestarted == shortRestarted, context);
+
+				if (longRestarted)
+				{
+					++restartsCount;
+					continue;
+				}
+
+				ARKANOID_CHECK_CONTEXT(sameKineticGame(longSimulation, shortSimulation), context);
+
+				for (unsigned int brickIndex = 0; brickIndex < gk_bricksCount; ++brickIndex)
+				{
+					remainingHitsCount -= longSimulation.brickRemainingHits(brickIndex);
+				}
+				bricksHitsCount += remainingHitsCount;
+
+				ARKANOID_CHECK_CONTEXT(longSimulation.aliveBricksCount() <= aliveBricksCount, context);
+			}
+		}
+
+		//the long steps must have hit bricks and lost the ball, otherwise little has been compared
+		ARKANOID_CHECK(bricksHitsCount > 0);
+		ARKANOID_CHECK(restartsCount > 0);
+	}
+
+	/*
+	the ball moves at every step: a ball pinched between the player and a wall used to bounce between them without time
+	passing, until the events cap of each step, and never moved again. the inputs change every simulated second, as in
+	CollisionModesBenchmark where it was found
+	*/
+	void checkKineticProgress()
+	{
+		for (unsigned int gameIndex = 0; gameIndex < 8; ++gameIndex)
+		{
+			SimulationCore simulation{ gameIndex + 1, SimulationCore::COLLISION_KINETIC };
+
+			std::mt19937 randomEngine{ gameIndex };
+			std::uniform_int_distribution<unsigned int> inputDistribution{ 0, SimulationCore::INPUT_LEFT | SimulationCore::INPUT_RIGHT };
+
+			unsigned int stalledStepsCount = 0;
+
+			for (unsigned int secondIndex = 0; secondIndex < 300; ++secondIndex)
+			{
+				const unsigned int inputFlags = inputDistribution(randomEngine);
+
+				for (unsigned int stepIndex = 0; stepIndex < 60; ++stepIndex)
+				{
+					const XMFLOAT4 ballTransform = simulation.ballTransform();
+					const bool restarted = simulation.step(1.0f / 60.0f, inputFlags);
+
+					stalledStepsCount += static_cast<unsigned int>(!restarted && ballTransform.x == simulation.ballTransform().x &&
+																  ballTransform.y == simulation.ballTransform().y);
+				}
+			}
+
+			ARKANOID_CHECK_CONTEXT(stalledStepsCount == 0, "game " + std::to_string(gameIndex) + ", " + std::to_string(stalledStepsCount) + " stalled steps");
+		}
+	}
+
+	//the distance between the positions of the ball sampled along its path, small against the bricks half extents
+	constexpr float gk_pathSamplesSpacing = 0.05f;
+
+	//brute force: samples the ball moving in a straight line, returns true if it overlaps one of the alive bricks on the way
+	bool pathOverlapsAliveBrick(const SimulationCore& simulation, const XMFLOAT2& ballPosition, const XMFLOAT2& ballDisplacement)
+	{
+		const float pathLength = std::sqrt(ballDisplacement.x * ballDisplacement.x + ballDisplacement.y * ballDisplacement.y);
+		const unsigned int samplesCount = static_cast<unsigned int>(pathLength / gk_pathSamplesSpacing) + 2;
+
+		for (unsigned int sampleIndex = 0; sampleIndex < samplesCount; ++sampleIndex)
+		{
+			const XMFLOAT2 samplePosition = ballPosition + ballDisplacement * (static_cast<float>(sampleIndex) / (samplesCount - 1));
+
+			for (unsigned int brickIndex = 0; brickIndex < gk_bricksCount; ++brickIndex)
+			{
+				const XMFLOAT4& brickTransform = simulation.brickTransform(brickIndex);
+				const XMFLOAT2 overlap = (gk_ballHalfExtents + gk_bricksHalfExtents) - XMFLOAT2{ std::abs(samplePosition.x - brickTransform.x),
+																									std::abs(samplePosition.y - brickTransform.y) };
+
+				if (simulation.brickRemainingHits(brickIndex) != 0 && overlap.x > gk_overlapTolerance && overlap.y > gk_overlapTolerance)
+				{
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	bool sameBricks(const SimulationCore& simulation, const SimulationCore& otherSimulation)
+	{
+		for (unsigned int brickIndex = 0; brickIndex < gk_bricksCount; ++brickIndex)
+		{
+			if (simulation.brickRemainingHits(brickIndex) != otherSimulation.brickRemainingHits(brickIndex))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/*
+	COLLISION_SWEPT at the large steps of a stalled frame: a step moves the ball by several times its size.
+	the ball must end every step outside the walls and the alive bricks, and a step which neither bounces it nor hits a brick
+	must not have crossed any, which is checked by sampling the straight path.
+	a step must also hit the bricks hit by gk_sweptSubstepsCount steps covering the same time: those move the ball by a fraction
+	of its size, so a contact the sweep misses leaves the ball inside the brick, and the brick is still hit by the next sweep.
+	the player moves to its final position before the ball is swept, so the substeps see it elsewhere: the player stands still
+	for that comparison
+	*/
+	constexpr unsigned int gk_sweptSubstepsCount = 64;
+	constexpr unsigned int gk_sweptStepsCount = 600;
+
+	void checkSweptLargeSteps(float deltaTime, const std::string& deltaTimeName)
+	{
+		std::mt19937 randomEngine{ 11 };
+		std::uniform_int_distribution<unsigned int> inputDistribution{ 0, SimulationCore::INPUT_LEFT | SimulationCore::INPUT_RIGHT };
+
+		const float substepTime = deltaTime / gk_sweptSubstepsCount;
+
+		unsigned int bricksHitStepsCount = 0;
+		unsigned int straightStepsCount = 0;
+
+		for (unsigned int randomSeed = 1; randomSeed <= 8; ++randomSeed)
+		{
+			SimulationCore simulation{ randomSeed, SimulationCore::COLLISION_SWEPT };
+
+			for (unsigned int stepIndex = 0; stepIndex < gk_sweptStepsCount; ++stepIndex)
+			{
+				const std::string context = deltaTimeName + ", seed " + std::to_string(randomSeed) + ", step " + std::to_string(stepIndex);
+
+				//half of the steps with the player standing still, for the comparison with the substeps
+				const bool playerStill = (stepIndex / 20) % 2 == 0;
+				const unsigned int inputFlags = playerStill ? SimulationCore::INPUT_NONE : inputDistribution(randomEngine);
+
+				const SimulationCore previousSimulation = simulation;
+				const XMFLOAT2 ballPosition{ simulation.ballTransform().x, simulation.ballTransform().y };
+				const XMFLOAT2 ballVelocity = simulation.ballVelocity();
+
+				if (simulation.step(deltaTime, inputFlags))
+				{
+					continue;
+				}
+
+				checkNoOverlap(simulation, context);
+
+				const bool bricksHit = !sameBricks(simulation, previousSimulation);
+				bricksHitStepsCount += static_cast<unsigned int>(bricksHit);
+
+				const bool straight = !bricksHit && ballVelocity.x == simulation.ballVelocity().x && ballVelocity.y == simulation.ballVelocity().y;
+				if (straight)
+				{
+					++straightStepsCount;
+
+					const XMFLOAT2 ballDisplacement = XMFLOAT2{ simulation.ballTransform().x, simulation.ballTransform().y } - ballPosition;
+					ARKANOID_CHECK_CONTEXT(!pathOverlapsAliveBrick(previousSimulation, ballPosition, ballDisplacement), context + ", crossed a brick");
+				}
+
+				if (playerStill)
+				{
+					SimulationCore substepsSimulation = previousSimulation;
+
+					bool substepsRestarted = false;
+					for (unsigned int substepIndex = 0; substepIndex < gk_sweptSubstepsCount && !substepsRestarted; ++substepIndex)
+					{
+						substepsRestarted = substepsSimulation.step(substepTime, SimulationCore::INPUT_NONE);
+					}
+
+					ARKANOID_CHECK_CONTEXT(substepsRestarted || sameBricks(simulation, substepsSimulation), context + ", bricks hit by the substeps");
+				}
+			}
+		}
+
+		//the steps must have hit bricks and flown by them, otherwise little has been checked
+		ARKANOID_CHECK_CONTEXT(bricksHitStepsCount > 0, deltaTimeName);
+		ARKANOID_CHECK_CONTEXT(straightStepsCount > 0, deltaTimeName);
+	}
+	bool sameSubdivision(const SubdivisionSettings& settings, const SubdivisionSettings& otherSettings)
+	{
+		return settings.type == otherSettings.type && settings.maxDepth == otherSettings.maxDepth &&
+			   settings.maxLeafObjectsCount == otherSettings.maxLeafObjectsCount &&
+			   settings.queriesHalfExtents.x == otherSettings.queriesHalfExtents.x &&
+			   settings.queriesHalfExtents.y == otherSettings.queriesHalfExtents.y &&
+			   settings.quadrantVisitCost == otherSettings.quadrantVisitCost &&
+			   settings.objectsHalfExtents.x == otherSettings.objectsHalfExtents.x &&
+			   settings.objectsHalfExtents.y == otherSettings.objectsHalfExtents.y &&
+			   settings.maxLeafOccupancy == otherSettings.maxLeafOccupancy;
+	}
+
+	//the whole game, bit for bit
+	bool sameGame(const SimulationCore& simulation, const SimulationCore& otherSimulation)
+	{
+		const XMFLOAT2 ballVelocity = simulation.ballVelocity();
+		const XMFLOAT2 otherBallVelocity = otherSimulation.ballVelocity();
+
+		for (unsigned int brickIndex = 0; brickIndex < gk_bricksCount; ++brickIndex)
+		{
+			if (simulation.brickRemainingHits(brickIndex) != otherSimulation.brickRemainingHits(brickIndex))
+			{
+				return false;
+			}
+		}
+
+		return std::memcmp(simulation.transforms(), otherSimulation.transforms(), sizeof(ArkanoidRenderer::TransformsConstantBuffer)) == 0 &&
+			   std::memcmp(&ballVelocity, &otherBallVelocity, sizeof(XMFLOAT2)) == 0 &&
+			   simulation.isBonusAlive() == otherSimulation.isBonusAlive();
+	}
+
+	/*
+	a game recording its ball queries is tuned twice and plays on by the side of the same game never tuned, with the same
+	inputs: the subdivision tuned is one of the candidates and becomes the one of the layout, and the games stay the same.
+	a level with another layout may leave no query recorded, then the subdivision is kept
+	*/
+	void checkBricksSubdivisionTuning()
+	{
+		const std::vector<SubdivisionSettings> candidates = generateSubdivisionCandidates(SimulationCore::sk_quadtreeMaxDepth,
+																						  gk_bricksHalfExtents, gk_ballHalfExtents);
+
+		const SimulationCore::ECollisionMode collisionModes[] = { SimulationCore::COLLISION_DISCRETE, SimulationCore::COLLISION_SWEPT,
+																  SimulationCore::COLLISION_KINETIC };
+		static const char* const collisionModesNames[] = { "discrete", "swept", "kinetic" };
+
+		constexpr unsigned int stepsCount = 3600;
+		constexpr float stepTime = 1.0f / 60.0f;
+
+		for (SimulationCore::ECollisionMode collisionMode : collisionModes)
+		{
+			unsigned int tuningsCount = 0;
+
+			for (unsigned int randomSeed = 1; randomSeed <= 4; ++randomSeed)
+			{
+				const std::string context = std::string{ collisionModesNames[collisionMode] } + ", seed " + std::to_string(randomSeed);
+
+				SimulationCore tunedSimulation{ randomSeed, collisionMode };
+				SimulationCore simulation{ randomSeed, collisionMode };
+				tunedSimulation.setBallQueriesRecording(true);
+
+				std::mt19937 inputsEngine{ randomSeed };
+				std::uniform_int_distribution<unsigned int> inputDistribution{ 0, SimulationCore::INPUT_LEFT | SimulationCore::INPUT_RIGHT };
+				unsigned int inputFlags = SimulationCore::INPUT_NONE;
+
+				unsigned int differentStepsCount = 0;
+
+				for (unsigned int stepIndex = 0; stepIndex < stepsCount; ++stepIndex)
+				{
+					if (stepIndex % 60 == 0)
+					{
+						inputFlags = inputDistribution(inputsEngine);
+					}
+
+					if (stepIndex == 1200 || stepIndex == 2400)
+					{
+						const unsigned int recordedQueriesCount = tunedSimulation.recordedBallQueriesCount();
+						const SubdivisionTuningResult result = tunedSimulation.tuneBricksSubdivision();
+
+						const bool isCandidate = std::any_of(candidates.begin(), candidates.end(), [&result](const SubdivisionSettings& candidate)
+						{
+							return sameSubdivision(candidate, result.settings);
+						});
+
+						unsigned int tunedLayoutsCount = 0;
+						for (unsigned int layoutIndex = 0; layoutIndex < gk_bricksLayoutsCount; ++layoutIndex)
+						{
+							tunedLayoutsCount += static_cast<unsigned int>(sameSubdivision(tunedSimulation.bricksSubdivision(layoutIndex), result.settings));
+						}
+
+						ARKANOID_CHECK_CONTEXT(tunedLayoutsCount > 0, context);
+
+						if (recordedQueriesCount > 0)
+						{
+							ARKANOID_CHECK_CONTEXT(isCandidate, context);
+							ARKANOID_CHECK_CONTEXT(result.queryNanoseconds > 0.0f, context);
+							++tuningsCount;
+						}
+						else
+						{
+							ARKANOID_CHECK_CONTEXT(result.queryNanoseconds == 0.0f, context);
+						}
+					}
+
+					const bool tunedRestarted = tunedSimulation.step(stepTime, inputFlags);
+					const bool restarted = simulation.step(stepTime, inputFlags);
+
+					differentStepsCount += static_cast<unsigned int>(tunedRestarted != restarted || !sameGame(tunedSimulation, simulation));
+				}
+
+				ARKANOID_CHECK_CONTEXT(differentStepsCount == 0, context);
+			}
+
+			//the ball queries of the bricks quadtree must have been recorded and replayed, otherwise little has been checked
+			ARKANOID_CHECK_CONTEXT(tuningsCount > 0, collisionModesNames[collisionMode]);
+		}
+	}
+}
+
+int main()
+{
+	checkKineticLongSteps();
+	checkKineticProgress();
+
+	checkSweptLargeSteps(1.0f / 15.0f, "1/15 s");
+	checkSweptLargeSteps(1.0f / 8.0f, "1/8 s");
+
+	checkBricksSubdivisionTuning();
+
+	return testsResult("SimulationCoreTests");
+}
\ No newline at end of file
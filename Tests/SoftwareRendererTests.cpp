@@ -0,0 +1,293 @@
+#include "TestHelper.h"
+#include "SimulationCore.h"
+#include "Software/SoftwareRenderer.h"
+#include "Camera.h"
+#include "Image.h"
+#include "Mesh.h"
+#include "PipelineState.h"
+#include "PipelineStateData.h"
+#include "HLSLUtils.h"
+#include "ShaderCompilationConfig.h"
+#include "Resources.h"
+#include <fstream>
+#include <cstring>
+
+/*
+renders the first level of a fixed seed through Software::Renderer, set up as ArkanoidLogic and ArkanoidRenderer set up
+the platform renderer, and compares the frame with the reference one: a pixel differs when one of its channels is farther
+than gk_channelTolerance from the reference, the frame when more than gk_maxDifferentPixelsRatio of its pixels differ.
+the tolerance absorbs the rounding of the SSE2 and scalar paths. --update writes the rendered frame as the new reference
+*/
+
+using namespace ArkanoidTests;
+using namespace ArkanoidEngine;
+
+namespace
+{
+	//as in ArkanoidLogic
+	constexpr unsigned int gk_arenaUVTransformIndex = 0;
+	constexpr unsigned int gk_bricksUVTransformIndex = gk_arenaUVTransformIndex + 1;
+	constexpr unsigned int gk_ballUVTransformIndex = gk_bricksUVTransformIndex + 1;
+	constexpr unsigned int gk_playerUVTransformIndex = gk_ballUVTransformIndex + 1;
+	constexpr unsigned int gk_bonusUVTransformIndex = gk_playerUVTransformIndex + 1;
+
+	const XMFLOAT4 gk_bricksColors[gk_brickTypesCount] =
+	{
+		XMFLOAT4{ 1.0f, 0.0f, 0.0f, static_cast<float>(gk_bricksUVTransformIndex) },
+		XMFLOAT4{ 0.0f, 1.0f, 0.0f, static_cast<float>(gk_bricksUVTransformIndex) },
+		XMFLOAT4{ 0.0f, 0.0f, 1.0f, static_cast<float>(gk_bricksUVTransformIndex) }
+	};
+
+	constexpr unsigned int gk_frameWidth = 320;
+	constexpr unsigned int gk_frameHeight = 240;
+	constexpr unsigned int gk_levelRandomSeed = 1;
+
+	constexpr int gk_channelTolerance = 2;
+	constexpr double gk_maxDifferentPixelsRatio = 0.001;
+
+	//from the working directory of the tests
+	const char* const gk_referenceFrameFileName = "../Tests/ReferenceFrames/initialLevel.ppm";
+
+	//the quad of ArkanoidRenderer
+	Mesh createQuadMesh()
+	{
+		Mesh mesh{};
+
+		XMFLOAT3 vertices[]{
+			{ -1.0f, -1.0f, 0.0f },
+			{ -1.0f, +1.0f, 0.0f },
+			{ +1.0f, +1.0f, 0.0f },
+			{ +1.0f, -1.0f, 0.0f }
+		};
+
+		mesh.setPositions(vertices, sizeof(vertices) / sizeof(XMFLOAT3));
+
+		XMFLOAT2 textCoords[]{
+			{ 0.0f, 1.0f },
+			{ 0.0f, 0.0f },
+			{ 1.0f, 0.0f },
+			{ 1.0f, 1.0f }
+		};
+
+		mesh.setTextCoords(textCoords, sizeof(textCoords) / sizeof(XMFLOAT2));
+
+		uint64_t indices[]{
+			0, 1, 2,
+			0, 2, 3
+		};
+
+		mesh.setIndices(indices, sizeof(indices) / sizeof(uint64_t));
+
+		return mesh;
+	}
+
+	//as ArkanoidLogic::setupColors() and ArkanoidLogic::fillUVTransforms()
+	bool fillColorsAndUVTransforms(const SimulationCore& simulation, unsigned int atlasWidth, unsigned int atlasHeight,
+								   ArkanoidRenderer::ColorsAndUVTransformsConstantBuffer& colorsAndUVTransforms)
+	{
+		colorsAndUVTransforms.colorScaleAndIndex[gk_ballIndex] = XMFLOAT4{ 1.0f, 1.0f, 1.0f, static_cast<float>(gk_ballUVTransformIndex) };
+		colorsAndUVTransforms.colorScaleAndIndex[gk_playerIndex] = XMFLOAT4{ 1.0f, 1.0f, 1.0f, static_cast<float>(gk_playerUVTransformIndex) };
+		colorsAndUVTransforms.colorScaleAndIndex[gk_arenaIndex] = XMFLOAT4{ 1.0f, 1.0f, 1.0f, static_cast<float>(gk_arenaUVTransformIndex) };
+		colorsAndUVTransforms.colorScaleAndIndex[gk_bonusIndex] = XMFLOAT4{ 1.0f, 1.0f, 1.0f, static_cast<float>(gk_bonusUVTransformIndex) };
+
+		for (unsigned int brickIndex = 0; brickIndex < gk_bricksCount; ++brickIndex)
+		{
+			colorsAndUVTransforms.colorScaleAndIndex[gk_bricksStartIndex + brickIndex] = gk_bricksColors[simulation.brickType(brickIndex)];
+		}
+
+		std::ifstream atlasDescriptorFile{ gk_texturesPath + "atlas.txt" };
+		if (!atlasDescriptorFile.is_open())
+		{
+			return false;
+		}
+
+		const std::pair<const char*, unsigned int> entitiesUVTransformsIndices[] =
+		{
+			{ "brick", gk_bricksUVTransformIndex },
+			{ "ball", gk_ballUVTransformIndex },
+			{ "vaus", gk_playerUVTransformIndex },
+			{ "arena", gk_arenaUVTransformIndex },
+			{ "bonus", gk_bonusUVTransformIndex }
+		};
+
+		for (unsigned int entity = 0; entity < gk_entitiesCount; ++entity)
+		{
+			std::string textureName;
+			char ignore;
+			float x;
+			float y;
+			float width;
+			float height;
+
+			if (!(atlasDescriptorFile >> textureName >> ignore >> x >> y >> width >> height))
+			{
+				return false;
+			}
+
+			for (const auto& entityUVTransformIndex : entitiesUVTransformsIndices)
+			{
+				if (textureName == entityUVTransformIndex.first)
+				{
+					colorsAndUVTransforms.uvTranslationAndScales[entityUVTransformIndex.second] =
+						XMFLOAT4{ x / atlasWidth, y / atlasHeight, width / atlasWidth, height / atlasHeight };
+				}
+			}
+		}
+
+		return true;
+	}
+
+	//the frame of the first level, as the game shows it before the first update. returns false if the resources are missing
+	bool renderInitialLevel(Software::Renderer& renderer)
+	{
+		const SimulationCore simulation{ gk_levelRandomSeed };
+
+		const Image atlas = Image::loadImageFromFile("atlas.png");
+		if (atlas.width() == 0 || atlas.height() == 0)
+		{
+			return false;
+		}
+
+		ArkanoidRenderer::ColorsAndUVTransformsConstantBuffer colorsAndUVTransforms{};
+		if (!fillColorsAndUVTransforms(simulation, atlas.width(), atlas.height(), colorsAndUVTransforms))
+		{
+			return false;
+		}
+
+		const IDType meshID = renderer.createMesh(createQuadMesh(), EVertexType::POSITION_TEXTCOORD);
+
+		const IDType sceneConstantBufferID = renderer.createConstantBuffer(sizeof(XMFLOAT4X4));
+		const IDType transformsConstantBufferID = renderer.createConstantBuffer(sizeof(ArkanoidRenderer::TransformsConstantBuffer));
+		const IDType colorsAndUVTransformsConstantBufferID = renderer.createConstantBuffer(sizeof(ArkanoidRenderer::ColorsAndUVTransformsConstantBuffer));
+
+		ShaderCompilationConfig shaderCompilationConfig{};
+		shaderCompilationConfig.define("INSTANCES_COUNT", std::to_string(gk_instancesCount));
+		shaderCompilationConfig.define("ENTITIES_COUNT", std::to_string(gk_entitiesCount));
+		const IDType vertexShaderID = renderer.createVertexShaderFromSourceFile("everyOneVertexShader.hlsl", EVertexType::POSITION_TEXTCOORD,
+																				&shaderCompilationConfig);
+		const IDType pixelShaderID = renderer.createPixelShaderFromSourceFile("everyOnePixelShader.hlsl", &shaderCompilationConfig);
+
+		PipelineState pipelineState{ vertexShaderID, pixelShaderID };
+		pipelineState.setStageConstantBuffers(EPipelineStage::VERTEX_SHADER, { sceneConstantBufferID, transformsConstantBufferID });
+		pipelineState.setStageConstantBuffers(EPipelineStage::PIXEL_SHADER, { colorsAndUVTransformsConstantBufferID });
+		pipelineState.setDepthState(DepthState{ false });
+
+		const IDType pipelineStateID = renderer.createPipelineState(pipelineState);
+
+		const IDType textureID = renderer.createTextureFromImage(atlas);
+		const IDType pipelineStateDataID = renderer.createPipelineStateData(PipelineStateData{ textureID });
+
+		Camera camera{};
+		camera.makePerspective(static_cast<float>(gk_frameWidth) / gk_frameHeight, XM_PI * 0.5f, 1.0f, 50.0f);
+		camera.lookAt(XMFLOAT3{ 0.0f, 0.0f, -35.0f }, XMFLOAT3{ 0.0f, 0.0f, 0.0f });
+
+		XMFLOAT4X4 viewProj = camera.viewProj();
+		prepareMatrixForHLSL(&viewProj);
+
+		renderer.updateConstantBuffer(sceneConstantBufferID, &viewProj, sizeof(XMFLOAT4X4));
+		renderer.updateConstantBuffer(colorsAndUVTransformsConstantBufferID, &colorsAndUVTransforms, sizeof(colorsAndUVTransforms));
+		renderer.updateConstantBuffer(transformsConstantBufferID, simulation.transforms(), sizeof(ArkanoidRenderer::TransformsConstantBuffer));
+
+		renderer.setPipelineState(pipelineStateID);
+		renderer.setPipelineStateData(pipelineStateDataID);
+
+		renderer.beginFrame();
+		renderer.renderMeshInstanced(meshID, gk_instancesCount);
+		renderer.endFrame();
+
+		//as ArkanoidRenderer, the renderer asserts that no resource is left
+		renderer.destroyPipelineStateData(pipelineStateDataID);
+		renderer.destroyTexture(textureID);
+		renderer.destroyPipelineState(pipelineStateID);
+		renderer.destroyConstantBuffer(sceneConstantBufferID);
+		renderer.destroyConstantBuffer(transformsConstantBufferID);
+		renderer.destroyConstantBuffer(colorsAndUVTransformsConstantBufferID);
+		renderer.destroyShader(vertexShaderID);
+		renderer.destroyShader(pixelShaderID);
+		renderer.destroyMesh(meshID);
+
+		return true;
+	}
+
+	//the rgb pixels of a binary PPM image, as Software::Renderer::saveFrameBufferToFile() writes it
+	bool loadPPM(const std::string& imageFileName, unsigned int& width, unsigned int& height, std::vector<unsigned char>& pixels)
+	{
+		std::ifstream imageFile{ imageFileName, std::ios::binary };
+
+		std::string magic;
+		unsigned int maxValue = 0;
+		if (!(imageFile >> magic >> width >> height >> maxValue) || magic != "P6" || maxValue != 255)
+		{
+			return false;
+		}
+
+		//a single whitespace ends the header
+		imageFile.get();
+
+		pixels.resize(static_cast<size_t>(width) * height * 3);
+		imageFile.read(reinterpret_cast<char*>(pixels.data()), pixels.size());
+
+		return static_cast<size_t>(imageFile.gcount()) == pixels.size();
+	}
+
+	void checkInitialLevelFrame(const Software::Renderer& renderer)
+	{
+		unsigned int referenceWidth = 0;
+		unsigned int referenceHeight = 0;
+		std::vector<unsigned char> referencePixels;
+
+		if (!ARKANOID_CHECK_CONTEXT(loadPPM(gk_referenceFrameFileName, referenceWidth, referenceHeight, referencePixels), gk_referenceFrameFileName) ||
+			!ARKANOID_CHECK(referenceWidth == renderer.width() && referenceHeight == renderer.height()))
+		{
+			return;
+		}
+
+		//the framebuffer is r8g8b8a8, the reference r8g8b8
+		const unsigned char* frameBufferData = renderer.frameBufferData();
+		const size_t pixelsCount = static_cast<size_t>(referenceWidth) * referenceHeight;
+
+		size_t differentPixelsCount = 0;
+		int maxChannelDifference = 0;
+
+		for (size_t pixelIndex = 0; pixelIndex < pixelsCount; ++pixelIndex)
+		{
+			int pixelDifference = 0;
+			for (size_t channel = 0; channel < 3; ++channel)
+			{
+				pixelDifference = std::max(pixelDifference, std::abs(static_cast<int>(frameBufferData[pixelIndex * 4 + channel]) -
+																	 static_cast<int>(referencePixels[pixelIndex * 3 + channel])));
+			}
+
+			differentPixelsCount += pixelDifference > gk_channelTolerance ? 1 : 0;
+			maxChannelDifference = std::max(maxChannelDifference, pixelDifference);
+		}
+
+		const std::string context = std::to_string(differentPixelsCount) + " pixels differ, by up to " + std::to_string(maxChannelDifference);
+
+		ARKANOID_CHECK_CONTEXT(differentPixelsCount <= pixelsCount * gk_maxDifferentPixelsRatio, context);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const bool updateReference = argc > 1 && std::strcmp(argv[1], "--update") == 0;
+
+	Software::Renderer renderer{ gk_frameWidth, gk_frameHeight };
+
+	if (!ARKANOID_CHECK_CONTEXT(renderInitialLevel(renderer), "the resources are read from " + gk_resourcesPath))
+	{
+		return testsResult("SoftwareRendererTests");
+	}
+
+	//the triangles of the arena, the ball, the player and the bricks are drawn, the bonus is out of the screen
+	ARKANOID_CHECK(renderer.counters().shadedPixelsCount > 0);
+
+	if (updateReference)
+	{
+		ARKANOID_CHECK_CONTEXT(renderer.saveFrameBufferToFile(gk_referenceFrameFileName), gk_referenceFrameFileName);
+	}
+
+	checkInitialLevelFrame(renderer);
+
+	return testsResult("SoftwareRendererTests");
+}
\ No newline at end of file
@@ -0,0 +1,351 @@
+#pragma once
+#include "Engine.h"
+#include "MathCommon.h"
+#include "AABB.h"
+#include "Dimensions.h"
+#include "GameplayConstants.h"
+#include "LevelGenerator.h"
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <cstdio>
+#include <cmath>
+
+//checks a condition, counting and printing the failures without stopping the test
+#define ARKANOID_CHECK(condition) ArkanoidTests::check((condition), #condition, __FILE__, __LINE__, "")
+
+//as ARKANOID_CHECK, context tells where the failure happened, e.g. the scene and the broadphase
+#define ARKANOID_CHECK_CONTEXT(condition, context) ArkanoidTests::check((condition), #condition, __FILE__, __LINE__, (context))
+
+namespace ArkanoidTests
+{
+	using namespace ArkanoidGame;
+
+	//the failed checks of the test executable
+	inline unsigned int& failedChecksCount()
+	{
+		static unsigned int failedChecks = 0;
+		return failedChecks;
+	}
+
+	//only the first failures are printed, the others are counted
+	constexpr unsigned int gk_maxPrintedFailuresCount = 20;
+
+	inline bool check(bool condition, const char* expression, const char* fileName, int line, const std::string& context)
+	{
+		if (!condition)
+		{
+			if (failedChecksCount()++ < gk_maxPrintedFailuresCount)
+			{
+				std::printf("%s(%d): check failed: %s%s%s\n", fileName, line, expression, context.empty() ? "" : " - ", context.c_str());
+			}
+		}
+
+		return condition;
+	}
+
+	//the exit code of the test executable
+	inline int testsResult(const char* testName)
+	{
+		if (failedChecksCount() > 0)
+		{
+			std::printf("%s: %u checks failed\n", testName, failedChecksCount());
+			return 1;
+		}
+
+		std::printf("%s: passed\n", testName);
+		return 0;
+	}
+
+	//objects of the same size, as a broadphase stores them: the data of an object is its index unless told otherwise
+	struct ObjectsScene
+	{
+		std::string name;
+		AABB area;
+		XMFLOAT2 objectsHalfExtents;
+		std::vector<XMFLOAT2> objectsCenters;
+		std::vector<unsigned int> objectsDatas;
+	};
+
+	inline AABB arenaArea()
+	{
+		return AABB::computeFromMinMax(XMFLOAT2{ static_cast<float>(gk_arenaMinX), static_cast<float>(gk_arenaMinY) },
+									   XMFLOAT2{ static_cast<float>(gk_arenaMaxX), static_cast<float>(gk_arenaMaxY) });
+	}
+
+	//the level layouts are picked by the random engine: the first seed giving layoutIndex is used
+	inline BricksLayout generateBricksLayout(unsigned int layoutIndex)
+	{
+		BricksLayout bricksLayout;
+
+		for (unsigned int randomSeed = 1;; ++randomSeed)
+		{
+			std::minstd_rand randomEngine{ randomSeed };
+			ArkanoidGame::generateBricksLayout(randomEngine, bricksLayout);
+
+			if (bricksLayout.layoutIndex == layoutIndex)
+			{
+				return bricksLayout;
+			}
+		}
+	}
+
+	//the bricks of a level layout over the arena. the layout 2 has spaced columns, out of the bricks lattice
+	inline ObjectsScene bricksLayoutScene(unsigned int layoutIndex)
+	{
+		static const char* const layoutsNames[gk_bricksLayoutsCount] = { "rows", "diamond", "spaced columns" };
+
+		const BricksLayout bricksLayout = generateBricksLayout(layoutIndex);
+
+		ObjectsScene scene{ layoutsNames[layoutIndex], arenaArea(), gk_bricksHalfExtents, {}, {} };
+
+		for (unsigned int brickIndex = 0; brickIndex < bricksLayout.placedBricksCount; ++brickIndex)
+		{
+			scene.objectsCenters.push_back(XMFLOAT2{ bricksLayout.transforms[brickIndex].x, bricksLayout.transforms[brickIndex].y });
+			scene.objectsDatas.push_back(brickIndex);
+		}
+
+		return scene;
+	}
+
+	//bricks in columnsCount columns columnsSpacing apart and rowsCount rows rowsSpacing apart, from the top left corner of
+	//the arena moved by firstBrickOffset: spacings which are not multiples of the bricks size put the bricks out of the lattice
+	inline ObjectsScene spacedColumnsScene(unsigned int columnsCount, unsigned int rowsCount, float columnsSpacing, float rowsSpacing,
+										   const XMFLOAT2& firstBrickOffset)
+	{
+		char sceneName[64];
+		std::snprintf(sceneName, sizeof(sceneName), "columns %.2f x %.2f", columnsSpacing, rowsSpacing);
+
+		ObjectsScene scene{ sceneName, arenaArea(), gk_bricksHalfExtents, {}, {} };
+
+		const XMFLOAT2 firstBrickCenter = XMFLOAT2{ gk_arenaMinX + gk_bricksHalfWidth, gk_arenaMaxY - gk_bricksHeight * 2.0f } + firstBrickOffset;
+
+		for (unsigned int row = 0; row < rowsCount; ++row)
+		{
+			for (unsigned int column = 0; column < columnsCount; ++column)
+			{
+				scene.objectsCenters.push_back(firstBrickCenter + XMFLOAT2{ column * columnsSpacing, -(row * rowsSpacing) });
+				scene.objectsDatas.push_back(static_cast<unsigned int>(scene.objectsDatas.size()));
+			}
+		}
+
+		return scene;
+	}
+
+	//the arena grown or shrunk around its center so that objectsCount bricks have the density of the levels
+	inline AABB levelDensityArea(unsigned int objectsCount)
+	{
+		const float areaScale = std::sqrt(static_cast<float>(objectsCount) / gk_bricksCount);
+		return AABB::computeFromCenterAndHalfExtents(arenaArea().center(), arenaArea().halfExtents() * areaScale);
+	}
+
+	//objectsCount objects scattered over the area, each one inside it
+	inline ObjectsScene randomScene(const std::string& name, const AABB& area, const XMFLOAT2& objectsHalfExtents,
+									unsigned int objectsCount, unsigned int randomSeed)
+	{
+		ObjectsScene scene{ name, area, objectsHalfExtents, {}, {} };
+
+		std::mt19937 randomEngine{ randomSeed };
+		std::uniform_real_distribution<float> xDistribution{ area.min().x + objectsHalfExtents.x, area.max().x - objectsHalfExtents.x };
+		std::uniform_real_distribution<float> yDistribution{ area.min().y + objectsHalfExtents.y, area.max().y - objectsHalfExtents.y };
+
+		for (unsigned int objectIndex = 0; objectIndex < objectsCount; ++objectIndex)
+		{
+			scene.objectsCenters.push_back(XMFLOAT2{ xDistribution(randomEngine), yDistribution(randomEngine) });
+			scene.objectsDatas.push_back(objectIndex);
+		}
+
+		return scene;
+	}
+
+	//brute force: the datas of the objects touching queryAABB, as AABB::intersects() tells
+	inline std::vector<unsigned int> findTouchingObjects(const std::vector<XMFLOAT2>& objectsCenters,
+														 const std::vector<unsigned int>& objectsDatas,
+														 const XMFLOAT2& objectsHalfExtents, const AABB& queryAABB)
+	{
+		std::vector<unsigned int> touchingObjects;
+
+		for (size_t objectIndex = 0; objectIndex < objectsCenters.size(); ++objectIndex)
+		{
+			const AABB objectAABB = AABB::computeFromCenterAndHalfExtents(objectsCenters[objectIndex], objectsHalfExtents);
+			if (objectAABB.intersects(queryAABB))
+			{
+				touchingObjects.push_back(objectsDatas[objectIndex]);
+			}
+		}
+
+		return touchingObjects;
+	}
+
+	//ball sized AABBs anywhere in the area, as the balls of the game roam the arena
+	inline std::vector<AABB> generateBallQueries(const ObjectsScene& scene, unsigned int queriesCount, unsigned int randomSeed)
+	{
+		std::mt19937 randomEngine{ randomSeed };
+		std::uniform_real_distribution<float> xDistribution{ scene.area.min().x, scene.area.max().x };
+		std::uniform_real_distribution<float> yDistribution{ scene.area.min().y, scene.area.max().y };
+
+		std::vector<AABB> queries;
+		for (unsigned int queryIndex = 0; queryIndex < queriesCount; ++queryIndex)
+		{
+			queries.push_back(AABB::computeFromCenterAndHalfExtents(XMFLOAT2{ xDistribution(randomEngine), yDistribution(randomEngine) },
+																	gk_ballHalfExtents));
+		}
+
+		return queries;
+	}
+
+	/*
+	the queries checked against a scene: ball sized AABBs scattered over the area and around it, AABBs just touching
+	each side and corner of the objects, where the rounding errors can drop an object, and a few large AABBs
+	spanning many objects
+	*/
+	inline std::vector<AABB> generateQueries(const ObjectsScene& scene, unsigned int randomQueriesCount, unsigned int randomSeed)
+	{
+		std::vector<AABB> queries;
+
+		std::mt19937 randomEngine{ randomSeed };
+
+		const XMFLOAT2 areaMin = scene.area.min();
+		const XMFLOAT2 areaMax = scene.area.max();
+		std::uniform_real_distribution<float> xDistribution{ areaMin.x - 2.0f, areaMax.x + 2.0f };
+		std::uniform_real_distribution<float> yDistribution{ areaMin.y - 2.0f, areaMax.y + 2.0f };
+
+		for (unsigned int queryIndex = 0; queryIndex < randomQueriesCount; ++queryIndex)
+		{
+			queries.push_back(AABB::computeFromCenterAndHalfExtents(XMFLOAT2{ xDistribution(randomEngine), yDistribution(randomEngine) },
+																	gk_ballHalfExtents));
+		}
+
+		const XMFLOAT2 touchingOffset = scene.objectsHalfExtents + gk_ballHalfExtents;
+		const float offsetsX[8] = { -1.0f, 0.0f, 1.0f, -1.0f, 1.0f, -1.0f, 0.0f, 1.0f };
+		const float offsetsY[8] = { -1.0f, -1.0f, -1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f };
+
+		for (const XMFLOAT2& objectCenter : scene.objectsCenters)
+		{
+			for (unsigned int side = 0; side < 8; ++side)
+			{
+				const XMFLOAT2 queryCenter{ objectCenter.x + offsetsX[side] * touchingOffset.x, objectCenter.y + offsetsY[side] * touchingOffset.y };
+				queries.push_back(AABB::computeFromCenterAndHalfExtents(queryCenter, gk_ballHalfExtents));
+			}
+		}
+
+		std::uniform_real_distribution<float> largeHalfExtentDistribution{ 2.0f, 12.0f };
+		for (unsigned int queryIndex = 0; queryIndex < randomQueriesCount / 8; ++queryIndex)
+		{
+			const XMFLOAT2 queryCenter{ xDistribution(randomEngine), yDistribution(randomEngine) };
+			const XMFLOAT2 queryHalfExtents{ largeHalfExtentDistribution(randomEngine), largeHalfExtentDistribution(randomEngine) };
+			queries.push_back(AABB::computeFromCenterAndHalfExtents(queryCenter, queryHalfExtents));
+		}
+
+		queries.push_back(scene.area);
+
+		return queries;
+	}
+
+	//a ball moving from start by displacement, as given to findSweptPotentialColliders()
+	struct SweptQuery
+	{
+		XMFLOAT2 start;
+		XMFLOAT2 displacement;
+	};
+
+	/*
+	brute force: the datas of the objects the ball touches on its way, as AABB::intersects() tells without its tolerance.
+	the center of the ball is clipped against each object grown by the ball half extents, in double
+	*/
+	inline std::vector<unsigned int> findSweptTouchingObjects(const std::vector<XMFLOAT2>& objectsCenters,
+															  const std::vector<unsigned int>& objectsDatas,
+															  const XMFLOAT2& objectsHalfExtents, const SweptQuery& query)
+	{
+		std::vector<unsigned int> touchingObjects;
+
+		auto clipAxis = [](double center, double halfExtent, double start, double displacement, double& enterTime, double& exitTime)
+		{
+			const double min = center - halfExtent;
+			const double max = center + halfExtent;
+
+			if (displacement == 0.0)
+			{
+				if (start < min || max < start)
+				{
+					exitTime = -1.0;
+				}
+				return;
+			}
+
+			const double minTime = (min - start) / displacement;
+			const double maxTime = (max - start) / displacement;
+			enterTime = std::max(enterTime, std::min(minTime, maxTime));
+			exitTime = std::min(exitTime, std::max(minTime, maxTime));
+		};
+
+		for (size_t objectIndex = 0; objectIndex < objectsCenters.size(); ++objectIndex)
+		{
+			double enterTime = 0.0;
+			double exitTime = 1.0;
+
+			clipAxis(objectsCenters[objectIndex].x, static_cast<double>(objectsHalfExtents.x) + gk_ballHalfExtents.x,
+					 query.start.x, query.displacement.x, enterTime, exitTime);
+			clipAxis(objectsCenters[objectIndex].y, static_cast<double>(objectsHalfExtents.y) + gk_ballHalfExtents.y,
+					 query.start.y, query.displacement.y, enterTime, exitTime);
+
+			if (enterTime <= exitTime)
+			{
+				touchingObjects.push_back(objectsDatas[objectIndex]);
+			}
+		}
+
+		return touchingObjects;
+	}
+
+	/*
+	the swept queries checked against a scene: balls moving from anywhere in and around the area in any direction, along
+	the axes and not at all, and balls sliding along each side of the objects, just touching them, and going through
+	them along each axis
+	*/
+	inline std::vector<SweptQuery> generateSweptQueries(const ObjectsScene& scene, unsigned int randomQueriesCount, unsigned int randomSeed)
+	{
+		std::vector<SweptQuery> queries;
+
+		std::mt19937 randomEngine{ randomSeed };
+
+		const XMFLOAT2 areaMin = scene.area.min();
+		const XMFLOAT2 areaMax = scene.area.max();
+		std::uniform_real_distribution<float> xDistribution{ areaMin.x - 2.0f, areaMax.x + 2.0f };
+		std::uniform_real_distribution<float> yDistribution{ areaMin.y - 2.0f, areaMax.y + 2.0f };
+		std::uniform_real_distribution<float> displacementDistribution{ -20.0f, 20.0f };
+
+		for (unsigned int queryIndex = 0; queryIndex < randomQueriesCount; ++queryIndex)
+		{
+			const XMFLOAT2 start{ xDistribution(randomEngine), yDistribution(randomEngine) };
+			XMFLOAT2 displacement{ displacementDistribution(randomEngine), displacementDistribution(randomEngine) };
+
+			//one out of 4 along x, one out of 4 along y, one out of 8 without displacement
+			const unsigned int motion = queryIndex % 8;
+			displacement.x = motion == 0 || motion == 1 ? 0.0f : displacement.x;
+			displacement.y = motion == 0 || motion == 2 || motion == 3 ? 0.0f : displacement.y;
+
+			queries.push_back(SweptQuery{ start, displacement });
+		}
+
+		const XMFLOAT2 touchingOffset = scene.objectsHalfExtents + gk_ballHalfExtents;
+		const XMFLOAT2 slideDisplacement = touchingOffset * 4.0f;
+
+		for (const XMFLOAT2& objectCenter : scene.objectsCenters)
+		{
+			const float slideStartX = objectCenter.x - slideDisplacement.x * 0.5f;
+			const float slideStartY = objectCenter.y - slideDisplacement.y * 0.5f;
+
+			queries.push_back(SweptQuery{ XMFLOAT2{ slideStartX, objectCenter.y - touchingOffset.y }, XMFLOAT2{ slideDisplacement.x, 0.0f } });
+			queries.push_back(SweptQuery{ XMFLOAT2{ slideStartX, objectCenter.y + touchingOffset.y }, XMFLOAT2{ slideDisplacement.x, 0.0f } });
+			queries.push_back(SweptQuery{ XMFLOAT2{ objectCenter.x - touchingOffset.x, slideStartY }, XMFLOAT2{ 0.0f, slideDisplacement.y } });
+			queries.push_back(SweptQuery{ XMFLOAT2{ objectCenter.x + touchingOffset.x, slideStartY }, XMFLOAT2{ 0.0f, slideDisplacement.y } });
+
+			queries.push_back(SweptQuery{ XMFLOAT2{ slideStartX, objectCenter.y }, XMFLOAT2{ slideDisplacement.x, 0.0f } });
+			queries.push_back(SweptQuery{ XMFLOAT2{ objectCenter.x, slideStartY }, XMFLOAT2{ 0.0f, slideDisplacement.y } });
+		}
+
+		return queries;
+	}
+}
\ No newline at end of file
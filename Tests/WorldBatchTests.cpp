@@ -0,0 +1,124 @@
+#include "TestHelper.h"
+#include "WorldBatch.h"
+#include "SimulationCore.h"
+#include <cstring>
+#include <memory>
+
+/*
+steps a WorldBatch and one SimulationCore per world in lockstep, with the same seeds and random inputs, in the
+COLLISION_DISCRETE, COLLISION_SWEPT and COLLISION_KINETIC modes: after each step the positions of all the entities, the ball
+velocity, the bonus and the bricks must be the same, bit for bit, and the levels must restart on the same steps.
+the worlds are more than a task, so the batch is stepped by several tasks on several threads
+*/
+
+using namespace ArkanoidTests;
+
+namespace
+{
+	constexpr unsigned int gk_worldsCount = WorldBatch::sk_worldsPerTask + 7;
+	constexpr unsigned int gk_stepsCount = 4000;
+	constexpr float gk_deltaTime = 1.0f / 60.0f;
+
+	bool sameFloat(float value, float otherValue)
+	{
+		return std::memcmp(&value, &otherValue, sizeof(float)) == 0;
+	}
+
+	//returns true if the world is the same of the simulation
+	bool sameWorld(const WorldBatch& batch, unsigned int worldIndex, const SimulationCore& simulation)
+	{
+		ArkanoidRenderer::TransformsConstantBuffer worldTransforms;
+		batch.fillTransforms(worldIndex, worldTransforms);
+
+		const ArkanoidRenderer::TransformsConstantBuffer& transforms = *simulation.transforms();
+
+		//the scales of the unplaced bricks are not part of the state
+		for (unsigned int instanceIndex = 0; instanceIndex < gk_instancesCount; ++instanceIndex)
+		{
+			if (!sameFloat(worldTransforms.translationAndScales[instanceIndex].x, transforms.translationAndScales[instanceIndex].x) ||
+				!sameFloat(worldTransforms.translationAndScales[instanceIndex].y, transforms.translationAndScales[instanceIndex].y))
+			{
+				return false;
+			}
+		}
+
+		for (unsigned int brickIndex = 0; brickIndex < gk_bricksCount; ++brickIndex)
+		{
+			if (batch.brickRemainingHits(worldIndex, brickIndex) != simulation.brickRemainingHits(brickIndex) ||
+				batch.brickType(worldIndex, brickIndex) != simulation.brickType(brickIndex))
+			{
+				return false;
+			}
+		}
+
+		const XMFLOAT2 worldBallVelocity = batch.ballVelocity(worldIndex);
+
+		return sameFloat(worldBallVelocity.x, simulation.ballVelocity().x) && sameFloat(worldBallVelocity.y, simulation.ballVelocity().y) &&
+			   batch.isBonusAlive(worldIndex) == simulation.isBonusAlive() &&
+			   batch.aliveBricksCount(worldIndex) == simulation.aliveBricksCount();
+	}
+
+	void checkLockstep(SimulationCore::ECollisionMode collisionMode, const std::string& modeName)
+	{
+		const unsigned int firstRandomSeed = 11;
+
+		WorldBatch batch{ gk_worldsCount, firstRandomSeed, 2, collisionMode };
+
+		std::vector<std::unique_ptr<SimulationCore>> simulations;
+		for (unsigned int worldIndex = 0; worldIndex < gk_worldsCount; ++worldIndex)
+		{
+			simulations.emplace_back(new SimulationCore{ firstRandomSeed + worldIndex, collisionMode });
+		}
+
+		std::mt19937 randomEngine{ 5 };
+		std::uniform_int_distribution<unsigned int> inputDistribution{ 0, SimulationCore::INPUT_LEFT | SimulationCore::INPUT_RIGHT | SimulationCore::INPUT_FIRE };
+
+		std::vector<unsigned int> worldsInputFlags(gk_worldsCount);
+
+		//a world is checked until its first difference, so a bug doesn't print a line per step
+		std::vector<unsigned char> worldsDiverged(gk_worldsCount, 0);
+
+		unsigned int restartsCount = 0;
+
+		for (unsigned int stepIndex = 0; stepIndex < gk_stepsCount; ++stepIndex)
+		{
+			for (unsigned int& inputFlags : worldsInputFlags)
+			{
+				inputFlags = inputDistribution(randomEngine);
+			}
+
+			batch.step(gk_deltaTime, worldsInputFlags.data());
+
+			for (unsigned int worldIndex = 0; worldIndex < gk_worldsCount; ++worldIndex)
+			{
+				const bool restarted = simulations[worldIndex]->step(gk_deltaTime, worldsInputFlags[worldIndex]);
+				restartsCount += restarted ? 1 : 0;
+
+				if (worldsDiverged[worldIndex] != 0)
+				{
+					continue;
+				}
+
+				const std::string context = modeName + ", world " + std::to_string(worldIndex) + ", step " + std::to_string(stepIndex);
+
+				const bool sameStep = ARKANOID_CHECK_CONTEXT(batch.hasRestarted(worldIndex) == restarted, context) &&
+									  ARKANOID_CHECK_CONTEXT(sameWorld(batch, worldIndex, *simulations[worldIndex]), context);
+
+				worldsDiverged[worldIndex] = sameStep ? 0 : 1;
+			}
+		}
+
+		//the random inputs lose the ball now and then: the restarts must have been compared too
+		ARKANOID_CHECK_CONTEXT(restartsCount > 0, modeName);
+		ARKANOID_CHECK_CONTEXT(batch.counters().restartsCount == restartsCount, modeName);
+	}
+}
+
+int main()
+{
+	checkLockstep(SimulationCore::COLLISION_DISCRETE, "discrete");
+	checkLockstep(SimulationCore::COLLISION_SWEPT, "swept");
+	checkLockstep(SimulationCore::COLLISION_KINETIC, "kinetic");
+
+	return testsResult("WorldBatchTests");
+}
\ No newline at end of file